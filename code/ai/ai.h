@@ -519,6 +519,9 @@ extern char Goal_target_names[MAX_GOAL_TARGET_NAMES][NAME_LENGTH];
 extern void update_ai_info_for_hit(int hitter_obj, int hit_obj);
 extern void ai_frame_all(void);
 
+// Runs the target selection of the turrets which will pick a new target this frame, after the physics
+extern void ai_turret_evaluate_targets();
+
 extern int find_guard_obj(void);
 
 extern ai_info Ai_info[];
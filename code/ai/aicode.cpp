@@ -52,6 +52,7 @@
 #include "object/objcollide.h"
 #include "object/object.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/waypoint.h"
 #include "parse/parselo.h"
@@ -2063,9 +2064,17 @@ int get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float ra
 	eno.check_danger_weapon_objnum = 0;
 
 	// go through the list of all ships and evaluate as potential targets
-	for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-		eno.trial_objp = &Objects[so->objnum];
-		evaluate_object_as_nearest_objnum(&eno);
+	if (obj_grid_available()) {
+		// fighters and bombers count at half their distance, see evaluate_object_as_nearest_objnum()
+		obj_grid_query_team(&Objects[objnum].pos, 2.0f * range, OBJ_GRID_TYPE_MASK(OBJ_SHIP), enemy_team_mask, [&](int trial_objnum) {
+			eno.trial_objp = &Objects[trial_objnum];
+			evaluate_object_as_nearest_objnum(&eno);
+		});
+	} else {
+		for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
+			eno.trial_objp = &Objects[so->objnum];
+			evaluate_object_as_nearest_objnum(&eno);
+		}
 	}
 
 	// check if danger_weapon_objnum has will show a stealth ship
@@ -2112,7 +2121,6 @@ int find_nearby_threat(int objnum, int enemy_team_mask, float range, int *count)
 {
 	int		nearest_objnum;
 	float		nearest_dist;
-	object	*objp;
 	ship_obj	*so;
 
 	nearest_objnum = -1;
@@ -2120,15 +2128,13 @@ int find_nearby_threat(int objnum, int enemy_team_mask, float range, int *count)
 
 	*count = 0;
 
-	for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-		objp = &Objects[so->objnum];
-
+	auto evaluate = [&](object *objp) {
 		if ( OBJ_INDEX(objp) != objnum ) {
 			if (Ships[objp->instance].flags[Ship::Ship_Flags::Dying])
-				continue;
+				return;
 
             if (Ship_info[Ships[objp->instance].ship_info_index].flags[Ship::Info_Flags::No_ship_type] || Ship_info[Ships[objp->instance].ship_info_index].flags[Ship::Info_Flags::Navbuoy])
-                continue;
+                return;
 
 			if (iff_matches_mask(Ships[objp->instance].team, enemy_team_mask)) {
 				float	dist;
@@ -2145,6 +2151,16 @@ int find_nearby_threat(int objnum, int enemy_team_mask, float range, int *count)
 				}
 			}
 		}
+	};
+
+	if (obj_grid_available()) {
+		obj_grid_query_team(&Objects[objnum].pos, range, OBJ_GRID_TYPE_MASK(OBJ_SHIP), enemy_team_mask, [&](int trial_objnum) {
+			evaluate(&Objects[trial_objnum]);
+		});
+	} else {
+		for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
+			evaluate(&Objects[so->objnum]);
+		}
 	}
 
 	return nearest_objnum;
@@ -4104,12 +4120,10 @@ void update_min_max(float val, float *min, float *max)
 //	Return value: Number of enemy objects in bounding box.
 int get_enemy_team_range(object *my_objp, float range, int enemy_team_mask, vec3d *min_vec, vec3d *max_vec)
 {
-	object	*objp;
 	ship_obj	*so;
 	int		count = 0;
 
-    for (so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so)) {
-        objp = &Objects[so->objnum];
+	auto evaluate = [&](object *objp) {
         if (iff_matches_mask(Ships[objp->instance].team, enemy_team_mask)) {
             ship_info* sip = &Ship_info[Ships[objp->instance].ship_info_index];
             if (sip->is_fighter_bomber() || sip->flags[Ship::Info_Flags::Cruiser] || sip->flags[Ship::Info_Flags::Capital] || sip->flags[Ship::Info_Flags::Supercap] || sip->flags[Ship::Info_Flags::Drydock] || sip->flags[Ship::Info_Flags::Corvette] || sip->flags[Ship::Info_Flags::Awacs] || sip->flags[Ship::Info_Flags::Gas_miner])
@@ -4127,7 +4141,17 @@ int get_enemy_team_range(object *my_objp, float range, int enemy_team_mask, vec3
                 }
 
         }
-    }
+	};
+
+	if (obj_grid_available()) {
+		obj_grid_query_team(&my_objp->pos, range, OBJ_GRID_TYPE_MASK(OBJ_SHIP), enemy_team_mask, [&](int objnum) {
+			evaluate(&Objects[objnum]);
+		});
+	} else {
+		for (so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so)) {
+			evaluate(&Objects[so->objnum]);
+		}
+	}
 
 	return count;
 }
@@ -14,10 +14,13 @@
 #include "network/multi.h"
 #include "network/multimsgs.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "scripting/scripting.h"
 #include "render/3d.h"
 #include "ship/ship.h"
 #include "ship/shipfx.h"
+#include "tracing/tracing.h"
+#include "utils/JobSystem.h"
 #include "weapon/beam.h"
 #include "weapon/flak.h"
 #include "weapon/muzzleflash.h"
@@ -85,8 +88,26 @@ typedef struct eval_enemy_obj_struct {
 
 	float			nearest_dist;						// nearest ship attacking this turret
 	int			nearest_objnum;
+
+	uint			rand_state;							// 0 to use frand(), see eeo_frand()
 }	eval_enemy_obj_struct;
 
+/**
+ * Random number for target evaluation
+ *
+ * Evaluations done by ai_turret_evaluate_targets() must not touch the global random number generator, so they are
+ * given their own sequence, see turret_target_seed().
+ */
+static float eeo_frand(eval_enemy_obj_struct *eeo)
+{
+	if (eeo->rand_state == 0) {
+		return frand();
+	}
+
+	eeo->rand_state = eeo->rand_state * 1664525u + 1013904223u;
+	return (float)(eeo->rand_state >> 8) / (float)(1u << 24);
+}
+
 /**
  * Is object in turret field of view?
  *
@@ -611,7 +632,7 @@ void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo)
 			if ( is_object_stealth_ship(objp) ) {
 				float turret_stealth_find_chance = 0.5f;
 				float speed_mod = -0.1f + vm_vec_mag_quick(&objp->phys_info.vel) / 70.0f;
-				if (frand() > (turret_stealth_find_chance + speed_mod)) {
+				if (eeo_frand(eeo) > (turret_stealth_find_chance + speed_mod)) {
 					try_anyway = TRUE;
 				}
 			}
@@ -814,8 +835,9 @@ int is_target_beam_valid(ship_weapon *swp, object *objp)
  * @param flak_flag
  * @param laser_flag
  * @param missile_flag
+ * @param rand_state			Seed for the random numbers of the evaluation, 0 to use frand()
  */
-int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subsys, int enemy_team_mask, vec3d *tpos, vec3d *tvec, int current_enemy, bool big_only_flag, bool small_only_flag, bool tagged_only_flag, bool beam_flag, bool flak_flag, bool laser_flag, bool missile_flag)
+int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subsys, int enemy_team_mask, vec3d *tpos, vec3d *tvec, int current_enemy, bool big_only_flag, bool small_only_flag, bool tagged_only_flag, bool beam_flag, bool flak_flag, bool laser_flag, bool missile_flag, uint rand_state = 0)
 {
 	//float					weapon_travel_dist;
 	int					weapon_system_ok;
@@ -868,6 +890,7 @@ int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subs
 	eeo.tpos = tpos;
 	eeo.tvec = tvec;
 	eeo.turret_subsys = turret_subsys;
+	eeo.rand_state = rand_state;
 
 	eeo.nearest_attacker_dist = 99999.0f;
 	eeo.nearest_attacker_objnum = -1;
@@ -1068,9 +1091,16 @@ int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subs
 				case 1:
 					//Return if a ship is found
 					// Ship_used_list
-					for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-						objp = &Objects[so->objnum];
-						evaluate_obj_as_target(objp, &eeo);
+					if (obj_grid_available()) {
+						// ships are only picked when they are within weapon range, see evaluate_obj_as_target()
+						obj_grid_query_team(tpos, eeo.weapon_travel_dist, OBJ_GRID_TYPE_MASK(OBJ_SHIP), enemy_team_mask, [&](int target_objnum) {
+							evaluate_obj_as_target(&Objects[target_objnum], &eeo);
+						});
+					} else {
+						for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
+							objp = &Objects[so->objnum];
+							evaluate_obj_as_target(objp, &eeo);
+						}
 					}
 
 					Assert(eeo.nearest_attacker_objnum < 0 || is_target_beam_valid(swp, &Objects[eeo.nearest_attacker_objnum]));
@@ -1120,6 +1150,246 @@ int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subs
 int Use_parent_target = 0;
 DCF_BOOL(use_parent_target, Use_parent_target)
 
+// The kinds of targets a turret is restricted to, derived from its weapons
+typedef struct turret_target_flags {
+	bool	big_only;
+	bool	small_only;
+	bool	tagged_only;
+	bool	beam;
+	bool	flak;
+	bool	laser;
+	bool	missile;
+} turret_target_flags;
+
+static void turret_get_target_flags(ship_subsys *turret_subsys, turret_target_flags *flags)
+{
+	flags->big_only = all_turret_weapons_have_flags(&turret_subsys->weapons, Weapon::Info_Flags::Huge);
+	flags->small_only = all_turret_weapons_have_flags(&turret_subsys->weapons, Weapon::Info_Flags::Small_only);
+	flags->tagged_only = all_turret_weapons_have_flags(&turret_subsys->weapons, Weapon::Info_Flags::Tagged_only) || (turret_subsys->weapons.flags[Ship::Weapon_Flags::Tagged_Only]);
+
+	flags->beam = turret_weapon_has_flags(&turret_subsys->weapons, Weapon::Info_Flags::Beam);
+	flags->flak = turret_weapon_has_flags(&turret_subsys->weapons, Weapon::Info_Flags::Flak);
+	flags->laser = turret_weapon_has_subtype(&turret_subsys->weapons, WP_LASER);
+	flags->missile = turret_weapon_has_subtype(&turret_subsys->weapons, WP_MISSILE);
+}
+
+// Picking a new target is the expensive part of turret AI since get_nearest_turret_objnum() looks at every candidate
+// object.  ai_turret_evaluate_targets() does those scans up front for all turrets which are due to look for a new
+// target this frame.  Each scan only reads game state and writes to its own entry, so they are independent of each
+// other.  find_turret_enemy() then takes the result on the main thread if the scan was done with the same inputs it
+// would use itself, otherwise it scans like it always did.
+typedef struct turret_target_eval {
+	ship_subsys	*turret;
+	int		parent_objnum;
+	int		parent_signature;
+	int		enemy_team_mask;
+	int		current_enemy;
+	uint	sibling_hash;				// what the other turrets of the ship were shooting at, see turret_sibling_hash()
+	uint	rand_state;
+	vec3d	tpos;
+	vec3d	tvec;
+	turret_target_flags	flags;
+
+	int		result;						// objnum picked by get_nearest_turret_objnum()
+	vec3d	result_pos;					// where it was at the time
+} turret_target_eval;
+
+static SCP_vector<turret_target_eval> Turret_target_evals;
+
+int turret_should_pick_new_target(ship_subsys *turret);
+
+bool Turret_target_batch = true;
+DCF_BOOL(turret_target_batch, Turret_target_batch)
+
+/**
+ * Hash of the targets of the other turrets of a ship
+ *
+ * num_turrets_attacking() makes the choice of a turret depend on what its siblings are shooting at, so a batched
+ * result is only valid if none of those changed in between.
+ */
+static uint turret_sibling_hash(ship *shipp, ship_subsys *turret)
+{
+	uint hash = 2166136261u;
+
+	for (auto ss = GET_FIRST(&shipp->subsys_list); ss != END_OF_LIST(&shipp->subsys_list); ss = GET_NEXT(ss)) {
+		if ((ss == turret) || (ss->system_info->type != SUBSYSTEM_TURRET)) {
+			continue;
+		}
+
+		// turrets which are not counted by num_turrets_attacking() all look the same
+		uint target = (uint)ss->turret_enemy_objnum;
+		if ((ss->current_hits <= 0.0f) || ss->weapons.flags[Ship::Weapon_Flags::Turret_Lock]) {
+			target = UINT_MAX;
+		}
+
+		hash = (hash ^ target) * 16777619u;
+	}
+
+	return hash;
+}
+
+/**
+ * Seed for the random numbers of a batched evaluation
+ *
+ * Taken from the turret and the frame rather than from myrand() so that batching does not change the sequence the rest
+ * of the game sees.
+ */
+static uint turret_target_seed(object *objp, int turret_index)
+{
+	uint hash = 2166136261u;
+
+	hash = (hash ^ (uint)Framecount) * 16777619u;
+	hash = (hash ^ (uint)objp->signature) * 16777619u;
+	hash = (hash ^ (uint)turret_index) * 16777619u;
+
+	// the generator must not start at 0, which means frand()
+	return hash | 1;
+}
+
+/**
+ * Gets the current target of a turret the way ai_fire_from_turret() does
+ */
+static int turret_get_current_enemy(ship_subsys *ss)
+{
+	if ((ss->turret_enemy_objnum < 0) || (ss->turret_enemy_objnum >= MAX_OBJECTS) || (ss->turret_enemy_sig != Objects[ss->turret_enemy_objnum].signature)) {
+		return -1;
+	}
+
+	return ss->turret_enemy_objnum;
+}
+
+/**
+ * Takes the batched target of a turret, if there is one and it is still valid
+ *
+ * @return @c true if @c enemy_objnum was set
+ */
+static bool turret_use_evaluated_target(ship_subsys *turret_subsys, int objnum, vec3d *tpos, vec3d *tvec, int current_enemy, int enemy_team_mask, int *enemy_objnum)
+{
+	int index = turret_subsys->turret_target_eval;
+	turret_subsys->turret_target_eval = -1;
+
+	if ((index < 0) || (index >= (int)Turret_target_evals.size())) {
+		return false;
+	}
+
+	auto eval = &Turret_target_evals[index];
+
+	if ((eval->turret != turret_subsys) || (eval->parent_objnum != objnum) || (eval->parent_signature != Objects[objnum].signature)) {
+		return false;
+	}
+
+	if ((eval->current_enemy != current_enemy) || (eval->enemy_team_mask != enemy_team_mask)) {
+		return false;
+	}
+
+	// the batch runs after the physics, so normally this is exactly where the turret was for it
+	if (!vm_vec_same(&eval->tpos, tpos) || !vm_vec_same(&eval->tvec, tvec)) {
+		return false;
+	}
+
+	if (eval->sibling_hash != turret_sibling_hash(&Ships[Objects[objnum].instance], turret_subsys)) {
+		return false;
+	}
+
+	// the target may have died or been moved since
+	if ((eval->result >= 0) && (!valid_turret_enemy(&Objects[eval->result], &Objects[objnum]) || !vm_vec_same(&eval->result_pos, &Objects[eval->result].pos))) {
+		return false;
+	}
+
+	*enemy_objnum = eval->result;
+	return true;
+}
+
+static void turret_target_evaluate(turret_target_eval *eval)
+{
+	auto flags = &eval->flags;
+
+	eval->result = get_nearest_turret_objnum(eval->parent_objnum, eval->turret, eval->enemy_team_mask, &eval->tpos, &eval->tvec, eval->current_enemy,
+		flags->big_only, flags->small_only, flags->tagged_only, flags->beam, flags->flak, flags->laser, flags->missile, eval->rand_state);
+
+	if (eval->result >= 0) {
+		eval->result_pos = Objects[eval->result].pos;
+	}
+}
+
+/**
+ * Runs the target scans for all turrets which will look for a new target this frame
+ *
+ * Called once per frame between the physics and the post-move pass of obj_move_all(), so the turrets and their
+ * targets are where they will be when the ships do their AI.  This only predicts which turrets will call
+ * find_turret_enemy(); the checks there decide whether a result is actually used.
+ */
+void ai_turret_evaluate_targets()
+{
+	TRACE_SCOPE(tracing::TurretTargetEvaluate);
+
+	Turret_target_evals.clear();
+
+	if (!Turret_target_batch || !Ai_firing_enabled) {
+		return;
+	}
+
+	// clients do not run turret AI
+	if (MULTIPLAYER_CLIENT) {
+		return;
+	}
+
+	// objects are still put back on the plane after the batch, so most results would be thrown away
+	if (The_mission.flags[Mission::Mission_Flags::Mission_2d]) {
+		return;
+	}
+
+	for (auto so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so)) {
+		object *objp = &Objects[so->objnum];
+		ship *shipp = &Ships[objp->instance];
+
+		if ((objp->flags[Object::Object_Flags::Should_be_dead]) || (shipp->flags[Ship::Ship_Flags::Dying])) {
+			continue;
+		}
+
+		int enemy_team_mask = iff_get_attackee_mask(obj_team(objp));
+		int turret_index = 0;
+
+		for (auto ss = GET_FIRST(&shipp->subsys_list); ss != END_OF_LIST(&shipp->subsys_list); ss = GET_NEXT(ss)) {
+			model_subsystem *tp = ss->system_info;
+			++turret_index;
+
+			if ((tp->type != SUBSYSTEM_TURRET) || (tp->turret_num_firing_points <= 0) || (ss->current_hits <= 0.0f)) {
+				continue;
+			}
+
+			if (ss->weapons.flags[Ship::Weapon_Flags::Turret_Lock] || ss->scripting_target_override || !turret_should_pick_new_target(ss)) {
+				continue;
+			}
+
+			// the turret matrix is set up the first time the turret fires
+			if ( !(tp->flags[Model::Subsystem_Flags::Turret_matrix]) && !(tp->turret_gun_sobj == tp->subobj_num) ) {
+				continue;
+			}
+
+			turret_target_eval eval;
+			eval.turret = ss;
+			eval.parent_objnum = so->objnum;
+			eval.parent_signature = objp->signature;
+			eval.enemy_team_mask = enemy_team_mask;
+			eval.current_enemy = turret_get_current_enemy(ss);
+			eval.sibling_hash = turret_sibling_hash(shipp, ss);
+			eval.rand_state = turret_target_seed(objp, turret_index);
+			ship_get_global_turret_info(objp, tp, &eval.tpos, &eval.tvec);
+			turret_get_target_flags(ss, &eval.flags);
+			eval.result = -1;
+
+			ss->turret_target_eval = (int)Turret_target_evals.size();
+			Turret_target_evals.push_back(eval);
+		}
+	}
+
+	// every turret only writes to its own eval
+	util::jobs::parallel_for(0, Turret_target_evals.size(), 2, &tracing::TurretTargetEvaluateJob, [](size_t i) {
+		turret_target_evaluate(&Turret_target_evals[i]);
+	});
+}
+
 /**
  * Return objnum if enemy found, else return -1;
  *		
@@ -1133,17 +1403,19 @@ int find_turret_enemy(ship_subsys *turret_subsys, int objnum, vec3d *tpos, vec3d
 {
 	int					enemy_team_mask, enemy_objnum;
 	ship_info			*sip;
+	turret_target_flags	flags;
 
 	enemy_team_mask = iff_get_attackee_mask(obj_team(&Objects[objnum]));
 
-	bool big_only_flag = all_turret_weapons_have_flags(&turret_subsys->weapons, Weapon::Info_Flags::Huge);
-	bool small_only_flag = all_turret_weapons_have_flags(&turret_subsys->weapons, Weapon::Info_Flags::Small_only);
-    bool tagged_only_flag = all_turret_weapons_have_flags(&turret_subsys->weapons, Weapon::Info_Flags::Tagged_only) || (turret_subsys->weapons.flags[Ship::Weapon_Flags::Tagged_Only]);
+	turret_get_target_flags(turret_subsys, &flags);
 
-	bool beam_flag = turret_weapon_has_flags(&turret_subsys->weapons, Weapon::Info_Flags::Beam);
-	bool flak_flag = turret_weapon_has_flags(&turret_subsys->weapons, Weapon::Info_Flags::Flak);
-	bool laser_flag = turret_weapon_has_subtype(&turret_subsys->weapons, WP_LASER);
-	bool missile_flag = turret_weapon_has_subtype(&turret_subsys->weapons, WP_MISSILE);
+	bool big_only_flag = flags.big_only;
+	bool small_only_flag = flags.small_only;
+	bool tagged_only_flag = flags.tagged_only;
+	bool beam_flag = flags.beam;
+	bool flak_flag = flags.flak;
+	bool laser_flag = flags.laser;
+	bool missile_flag = flags.missile;
 
 	//	If a small ship and target_objnum != -1, use that as goal.
 	ai_info	*aip = &Ai_info[Ships[Objects[objnum].instance].ai_index];
@@ -1215,7 +1487,9 @@ int find_turret_enemy(ship_subsys *turret_subsys, int objnum, vec3d *tpos, vec3d
 		}
 	}
 
-	enemy_objnum = get_nearest_turret_objnum(objnum, turret_subsys, enemy_team_mask, tpos, tvec, current_enemy, big_only_flag, small_only_flag, tagged_only_flag, beam_flag, flak_flag, laser_flag, missile_flag);
+	if ( !turret_use_evaluated_target(turret_subsys, objnum, tpos, tvec, current_enemy, enemy_team_mask, &enemy_objnum) ) {
+		enemy_objnum = get_nearest_turret_objnum(objnum, turret_subsys, enemy_team_mask, tpos, tvec, current_enemy, big_only_flag, small_only_flag, tagged_only_flag, beam_flag, flak_flag, laser_flag, missile_flag);
+	}
 	if ( enemy_objnum >= 0 ) {
 		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Beam_protected]) && beam_flag) );
 		Assert( !((Objects[enemy_objnum].flags[Object::Object_Flags::Flak_protected]) && flak_flag) );
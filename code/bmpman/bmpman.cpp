@@ -19,6 +19,7 @@
 #include "anim/animplay.h"
 #include "anim/packunpack.h"
 #include "bmpman/bm_internal.h"
+#include "cmdline/cmdline.h"
 #include "ddsutils/ddsutils.h"
 #include "debugconsole/console.h"
 #include "globalincs/systemvars.h"
@@ -35,12 +36,17 @@
 #include "tgautils/tgautils.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/JobSystem.h"
 
+#include <atomic>
 #include <cctype>
 #include <climits>
+#include <ctime>
 #include <iomanip>
 #include <memory>
 
+#include <md5.h>
+
 // --------------------------------------------------------------------------------------------------------------------
 // Private macros.
 
@@ -48,6 +54,10 @@
  * @todo upgrade this to an inline funciton, taking bitmap_entry and const char* as arguments
  */
 #define EFF_FILENAME_CHECK { if ( be->type == BM_TYPE_EFF ) strcpy_s( filename, be->info.ani.eff.filename ); else strcpy_s( filename, be->filename ); }
+
+// Format version and location of the decoded texture cache (-texture_cache)
+#define BM_TEXTURE_CACHE_VERSION	2
+#define BM_TEXTURE_CACHE_LOCATION	(CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT)
 // --------------------------------------------------------------------------------------------------------------------
 // Monitor variables
 MONITOR(NumBitmapPage)
@@ -96,6 +106,25 @@ static int Bm_max_ram = 0;
 static int Bm_ignore_duplicates = 0;
 static int Bm_ignore_load_count = 0;
 
+/**
+ * An image which a job has read and decoded ahead of its upload in bm_page_in_stop()
+ */
+struct bm_staged_image {
+	ubyte *data = nullptr;
+	size_t size = 0;
+	int bpp = 0;
+};
+
+// Staged images by bitmap handle. Only the main thread touches this, the jobs write to their own bm_decode_request.
+static SCP_unordered_map<int, bm_staged_image> Bm_staged_images;
+
+static bool Bm_parallel_decode = true;
+DCF_BOOL(parallel_texture_decode, Bm_parallel_decode)
+
+// Lookups in the decoded texture cache (see -texture_cache), counted from the decode jobs as well
+static std::atomic<int> Bm_texture_cache_hits(0);
+static std::atomic<int> Bm_texture_cache_misses(0);
+
 // This needs to be declared somewhere and bm_internal.h has no own source file
 gr_bitmap_info::~gr_bitmap_info() = default;
 
@@ -444,6 +473,7 @@ DCF(bmpman, "Shows/changes bitmap caching parameters and usage") {
 		dc_printf("\tflush    Unloads all bitmaps.\n");
 		dc_printf("\tram [x]  Sets max mem usage to x MB. (Set to 0 to have no limit.)\n");
 		dc_printf("\t?        Displays status of Bitmap manager.\n");
+		dc_printf("\tcache    Displays the hit rate of the decoded texture cache.\n");
 		return;
 	}
 
@@ -463,6 +493,19 @@ DCF(bmpman, "Shows/changes bitmap caching parameters and usage") {
 	}
 
 
+	if (dc_optional_string("cache")) {
+		if (!Cmdline_texture_cache) {
+			dc_printf("The decoded texture cache is disabled, use -texture_cache to enable it.\n");
+			return;
+		}
+
+		int hits = Bm_texture_cache_hits.load();
+		int misses = Bm_texture_cache_misses.load();
+		float rate = (hits + misses > 0) ? (100.0f * i2fl(hits) / i2fl(hits + misses)) : 0.0f;
+		dc_printf("Decoded texture cache: %d hits, %d misses (%.1f%% hit rate)\n", hits, misses, rate);
+		return;
+	}
+
 	if (dc_optional_string("flush")) {
 		dc_printf("Total RAM usage before flush: " SIZE_T_ARG " bytes\n", bm_texture_ram);
 		for (auto& block : bm_blocks) {
@@ -931,12 +974,46 @@ bool bm_has_alpha_channel(int handle) {
 	return (entry->bm.true_bpp == 32);
 }
 
+/**
+ * @brief Deletes decoded texture cache files which have not been written for a while
+ *
+ * Same timeout as the shader cache. Entries are named after the content of their source so old ones are never matched
+ * again once that changes.
+ */
+static void bm_texture_cache_purge()
+{
+	SCP_vector<SCP_string> cache_files;
+	SCP_vector<file_list_info> file_info;
+	cf_get_file_list(cache_files, CF_TYPE_CACHE, "*.bin", CF_SORT_NONE, &file_info, BM_TEXTURE_CACHE_LOCATION);
+
+	Assertion(cache_files.size() == file_info.size(),
+			  "cf_get_file_list returned different sizes for file names and file informations!");
+
+	const auto TIMEOUT = 2.0 * 30.0 * 24.0 * 60.0 * 60.0; // ~2 months in seconds
+	const SCP_string PREFIX = "bmp_decoded-";
+
+	auto now = std::time(nullptr);
+	for (size_t i = 0; i < cache_files.size(); ++i) {
+		if (cache_files[i].compare(0, PREFIX.size(), PREFIX) != 0) {
+			continue;
+		}
+
+		if (std::difftime(now, file_info[i].write_time) > TIMEOUT) {
+			cf_delete((cache_files[i] + ".bin").c_str(), CF_TYPE_CACHE, BM_TEXTURE_CACHE_LOCATION);
+		}
+	}
+}
+
 void bm_init() {
 	Assertion(!bm_inited, "bmpman cannot be initialized more than once!");
 
 	// Allocate one block by default
 	allocate_new_block();
 
+	if (Cmdline_texture_cache) {
+		bm_texture_cache_purge();
+	}
+
 	bm_inited = true;
 }
 
@@ -1933,6 +2010,183 @@ bitmap * bm_lock(int handle, int bpp, ubyte flags, bool nodebug) {
 	return bmp;
 }
 
+// --------------------------------------------------------------------------------------------------------------------
+// Decoded texture cache.
+
+/**
+ * @brief Gets the name of the cache file for an image
+ *
+ * The name is a hash of where the source file is, its size and modification time (for a file in a VP: its offset and
+ * the time of the VP) and of how it is decoded, so a changed file, or a file of the same name in another mod, never
+ * matches an old entry. TGA images are uncompressed so they are not cached.
+ */
+static bool bm_texture_cache_name(const char *real_filename, int dir_type, BM_TYPE type, int bpp, SCP_string &cache_name)
+{
+	char filename[MAX_FILENAME_LEN];
+	const char *ext;
+
+	switch (type) {
+	case BM_TYPE_PNG:
+		ext = ".png";
+		break;
+	case BM_TYPE_JPG:
+		ext = ".jpg";
+		break;
+	default:
+		return false;
+	}
+
+	// Same name the image readers use
+	strcpy_s(filename, real_filename);
+	char *p = strchr(filename, '.');
+	if (p) *p = 0;
+	strcat_s(filename, ext);
+
+	auto location = cf_find_file_location(filename, dir_type);
+	if (!location.found) {
+		return false;
+	}
+
+	// In-memory files have no time, and a file which was written just now could still change within the same second
+	int64_t write_time;
+	if (!cf_get_file_time(location.full_name, &write_time) || (write_time < 0)) {
+		return false;
+	}
+
+	int64_t params[] = { BM_TEXTURE_CACHE_VERSION, (int64_t)type, bpp, (int64_t)location.size, (int64_t)location.offset, write_time };
+
+	MD5 md5;
+	md5.update(location.full_name.c_str(), (MD5::size_type)location.full_name.size());
+	md5.update(reinterpret_cast<const char*>(params), (MD5::size_type)sizeof(params));
+	md5.finalize();
+
+	cache_name = SCP_string("bmp_decoded-") + md5.hexdigest() + ".bin";
+	return true;
+}
+
+static bool bm_texture_cache_load(const SCP_string &cache_name, ubyte *data, size_t size, int *bpp)
+{
+	auto cfp = cfopen(cache_name.c_str(), "rb", CFILE_NORMAL, CF_TYPE_CACHE, false, BM_TEXTURE_CACHE_LOCATION);
+	if (cfp == nullptr) {
+		return false;
+	}
+
+	char id[4];
+	bool valid = (cfread(id, sizeof(id), 1, cfp) == 1) && (memcmp(id, "BMTC", sizeof(id)) == 0);
+	valid = valid && (cfread_int(cfp) == BM_TEXTURE_CACHE_VERSION);
+
+	int cached_bpp = cfread_int(cfp);
+	int cached_size = cfread_int(cfp);
+
+	// A truncated file, e.g. from a crash while it was written, is treated like a miss
+	valid = valid && ((size_t)cached_size == size) && (cftell(cfp) + cached_size == cfilelength(cfp));
+	valid = valid && (cfread(data, 1, cached_size, cfp) == cached_size);
+
+	cfclose(cfp);
+
+	if (valid) {
+		*bpp = cached_bpp;
+	}
+	return valid;
+}
+
+static void bm_texture_cache_store(const SCP_string &cache_name, const ubyte *data, size_t size, int bpp)
+{
+	auto cfp = cfopen(cache_name.c_str(), "wb", CFILE_NORMAL, CF_TYPE_CACHE, false, BM_TEXTURE_CACHE_LOCATION);
+	if (cfp == nullptr) {
+		mprintf(("Could not open decoded texture cache file '%s'!\n", cache_name.c_str()));
+		return;
+	}
+
+	cfwrite("BMTC", 4, 1, cfp);
+	cfwrite_int(BM_TEXTURE_CACHE_VERSION, cfp);
+	cfwrite_int(bpp, cfp);
+	cfwrite_int((int)size, cfp);
+	bool written = cfwrite(data, 1, (int)size, cfp) == (int)size;
+
+	cfclose(cfp);
+
+	if (!written) {
+		mprintf(("Failed to write decoded texture cache file '%s'!\n", cache_name.c_str()));
+		cf_delete(cache_name.c_str(), CF_TYPE_CACHE, BM_TEXTURE_CACHE_LOCATION);
+	}
+}
+
+/**
+ * @brief Reads an image through the decoded texture cache
+ *
+ * With -texture_cache the image is looked up in the cache first. On a miss @c decode reads the image from its file and
+ * the result is stored for the next time. Format conversions are not cached since they depend on the flags the image
+ * is locked with. Safe to call from jobs.
+ *
+ * @param filename The name of the image, the extension is ignored
+ * @param dir_type Where to look for the image
+ * @param type Which reader @c decode uses
+ * @param data Receives the image
+ * @param size The size of @c data
+ * @param bpp The bits per pixel the image is requested with, set to the bits per pixel it was read with
+ * @param decode Reads the image into @c data, sets @c bpp and returns @c true on success
+ *
+ * @return @c true if @c data holds the image
+ */
+template<typename Decoder>
+static bool bm_read_cached(const char *filename, int dir_type, BM_TYPE type, ubyte *data, size_t size, int *bpp, Decoder decode)
+{
+	SCP_string cache_name;
+	if (!Cmdline_texture_cache || !bm_texture_cache_name(filename, dir_type, type, *bpp, cache_name)) {
+		return decode();
+	}
+
+	if (bm_texture_cache_load(cache_name, data, size, bpp)) {
+		++Bm_texture_cache_hits;
+		return true;
+	}
+	++Bm_texture_cache_misses;
+
+	if (!decode()) {
+		return false;
+	}
+
+	bm_texture_cache_store(cache_name, data, size, *bpp);
+	return true;
+}
+
+/**
+ * @brief Takes the data which a decode job has staged for a bitmap
+ *
+ * @param handle The bitmap
+ * @param size The size of the data the lock function would allocate
+ * @param bpp Set to the bits per pixel the image was read with
+ *
+ * @return The image data, which now belongs to the bitmap, or @c nullptr if the image has to be read from disk
+ */
+static ubyte *bm_take_staged_image(int handle, size_t size, int *bpp)
+{
+	auto it = Bm_staged_images.find(handle);
+	if (it == Bm_staged_images.end()) {
+		return nullptr;
+	}
+
+	auto staged = it->second;
+	Bm_staged_images.erase(it);
+
+	if (staged.size != size) {
+		vm_free(staged.data);
+		return nullptr;
+	}
+
+#ifdef BMPMAN_NDEBUG
+	// Same bookkeeping as bm_malloc()
+	auto entry = bm_get_entry(handle);
+	Assert(entry->data_size == 0);
+	entry->data_size += size;
+	bm_texture_ram += size;
+#endif
+
+	*bpp = staged.bpp;
+	return staged.data;
+}
+
 void bm_lock_ani(int /*handle*/, bitmap_slot *bs, bitmap* /*bmp*/, int bpp, ubyte flags) {
 	anim				*the_anim;
 	anim_instance	*the_anim_instance;
@@ -2123,18 +2377,26 @@ void bm_lock_dds(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, ubyte /*
 	Assert(be->mem_taken > 0);
 	Assert(&be->bm == bmp);
 
-	data = (ubyte*)bm_malloc(handle, be->mem_taken);
+	int staged_bpp;
+	data = bm_take_staged_image(handle, be->mem_taken, &staged_bpp);
 
-	if (data == NULL)
-		return;
+	if (data != nullptr) {
+		dds_bpp = (ubyte)staged_bpp;
+		error = DDS_ERROR_NONE;
+	} else {
+		data = (ubyte*)bm_malloc(handle, be->mem_taken);
 
-	memset(data, 0, be->mem_taken);
+		if (data == NULL)
+			return;
 
-	// make sure we are using the correct filename in the case of an EFF.
-	// this will populate filename[] whether it's EFF or not
-	EFF_FILENAME_CHECK;
+		memset(data, 0, be->mem_taken);
 
-	error = dds_read_bitmap(filename, data, &dds_bpp, be->dir_type);
+		// make sure we are using the correct filename in the case of an EFF.
+		// this will populate filename[] whether it's EFF or not
+		EFF_FILENAME_CHECK;
+
+		error = dds_read_bitmap(filename, data, &dds_bpp, be->dir_type);
+	}
 
 #if BYTE_ORDER == BIG_ENDIAN
 	// same as with TGA, we need to byte swap 16 & 32-bit, uncompressed, DDS images
@@ -2208,7 +2470,10 @@ void bm_lock_jpg(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, ubyte /*flag
 	// this will populate filename[] whether it's EFF or not
 	EFF_FILENAME_CHECK;
 
-	jpg_error = jpeg_read_bitmap(filename, data, NULL, d_size, be->dir_type);
+	bool read = bm_read_cached(filename, be->dir_type, BM_TYPE_JPG, data, be->mem_taken, &bpp, [&]() {
+		return jpeg_read_bitmap(filename, data, NULL, d_size, be->dir_type) == JPEG_ERROR_NONE;
+	});
+	jpg_error = read ? JPEG_ERROR_NONE : JPEG_ERROR_INVALID;
 
 	if (jpg_error != JPEG_ERROR_NONE) {
 		bm_free_data(bs);
@@ -2284,21 +2549,33 @@ void bm_lock_png(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, ubyte /*
 	bmp->bpp = 32;
 	d_size = bmp->bpp >> 3;
 	//we waste memory if it turns out to be 24-bit, but the way this whole thing works is dodgy anyway
-	data = (ubyte*)bm_malloc(handle, bmp->w * bmp->h * d_size);
-	if (data == NULL)
-		return;
-	memset(data, 0, bmp->w * bmp->h * d_size);
-	bmp->data = (ptr_u)data;
-	bmp->palette = NULL;
+	int staged_bpp;
+	data = bm_take_staged_image(handle, static_cast<size_t>(bmp->w * bmp->h * d_size), &staged_bpp);
+	if (data != nullptr) {
+		bmp->data = (ptr_u)data;
+		bmp->palette = NULL;
+		bmp->bpp = staged_bpp;
+		png_error = PNG_ERROR_NONE;
+	} else {
+		data = (ubyte*)bm_malloc(handle, bmp->w * bmp->h * d_size);
+		if (data == NULL)
+			return;
+		memset(data, 0, bmp->w * bmp->h * d_size);
+		bmp->data = (ptr_u)data;
+		bmp->palette = NULL;
 
-	Assert(&be->bm == bmp);
+		Assert(&be->bm == bmp);
 
-	// make sure we are using the correct filename in the case of an EFF.
-	// this will populate filename[] whether it's EFF or not
-	EFF_FILENAME_CHECK;
+		// make sure we are using the correct filename in the case of an EFF.
+		// this will populate filename[] whether it's EFF or not
+		EFF_FILENAME_CHECK;
 
-	//bmp->bpp gets set correctly in here after reading into memory
-	png_error = png_read_bitmap(filename, data, &bmp->bpp, d_size, be->dir_type);
+		//bmp->bpp gets set correctly in here after reading into memory
+		bool read = bm_read_cached(filename, be->dir_type, BM_TYPE_PNG, data, static_cast<size_t>(bmp->w * bmp->h * d_size), &bmp->bpp, [&]() {
+			return png_read_bitmap(filename, data, &bmp->bpp, d_size, be->dir_type) == PNG_ERROR_NONE;
+		});
+		png_error = read ? PNG_ERROR_NONE : PNG_ERROR_INVALID;
+	}
 
 	if (png_error != PNG_ERROR_NONE) {
 		bm_free_data(bs);
@@ -2334,12 +2611,18 @@ void bm_lock_tga(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, ubyte flags)
 	Assert(byte_size);
 	Assert(be->mem_taken > 0);
 
-	data = (ubyte*)bm_malloc(handle, static_cast<size_t>(bmp->w * bmp->h * byte_size));
+	int staged_bpp;
+	data = bm_take_staged_image(handle, static_cast<size_t>(bmp->w * bmp->h * byte_size), &staged_bpp);
+	bool staged = data != nullptr;
 
-	if (data) {
-		memset(data, 0, be->mem_taken);
-	} else {
-		return;
+	if (!staged) {
+		data = (ubyte*)bm_malloc(handle, static_cast<size_t>(bmp->w * bmp->h * byte_size));
+
+		if (data) {
+			memset(data, 0, be->mem_taken);
+		} else {
+			return;
+		}
 	}
 
 	bmp->bpp = bpp;
@@ -2351,13 +2634,15 @@ void bm_lock_tga(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, ubyte flags)
 	Assert(be->data_size > 0);
 #endif
 
-	int tga_error;
+	int tga_error = TARGA_ERROR_NONE;
 
-	// make sure we are using the correct filename in the case of an EFF.
-	// this will populate filename[] whether it's EFF or not
-	EFF_FILENAME_CHECK;
+	if (!staged) {
+		// make sure we are using the correct filename in the case of an EFF.
+		// this will populate filename[] whether it's EFF or not
+		EFF_FILENAME_CHECK;
 
-	tga_error = targa_read_bitmap(filename, data, nullptr, byte_size, be->dir_type);
+		tga_error = targa_read_bitmap(filename, data, nullptr, byte_size, be->dir_type);
+	}
 
 	if (tga_error != TARGA_ERROR_NONE) {
 		bm_free_data(bs);
@@ -2527,6 +2812,212 @@ void bm_page_in_start() {
 	gr_bm_page_in_start();
 }
 
+// Limits for a single batch of images which are decoded ahead of their upload. Together with the batch which is being
+// uploaded at the same time this bounds how much memory the staged images take.
+#define BM_DECODE_BATCH_BITMAPS	64
+#define BM_DECODE_BATCH_BYTES	(64 * 1024 * 1024)
+
+/**
+ * An image which is read by a job. The job only writes to its own request so it does not need any locking.
+ */
+struct bm_decode_request {
+	int handle;
+	BM_TYPE type;
+	char filename[MAX_FILENAME_LEN];
+	int dir_type;
+	size_t size;
+	int bpp;
+	ubyte *data;
+};
+
+/**
+ * @brief Checks if the image of a bitmap can be decoded by a job and fills in the request for it
+ *
+ * Only formats whose readers do not use global state are handled here. JPEG and PCX are still read when they are
+ * locked.
+ */
+static bool bm_page_in_decode_request(bitmap_entry *be, bm_decode_request *req)
+{
+	auto bmp = &be->bm;
+
+	// Already in memory, nothing to read
+	if (bmp->data != 0) {
+		return false;
+	}
+
+	BM_TYPE c_type = (be->type == BM_TYPE_EFF) ? be->info.ani.eff.type : be->type;
+
+	switch (c_type) {
+	case BM_TYPE_PNG:
+		if (be->info.ani.apng.is_apng) {
+			return false;
+		}
+		// Same size as bm_lock_png()
+		req->bpp = 32;
+		req->size = static_cast<size_t>(bmp->w * bmp->h * (req->bpp >> 3));
+		break;
+
+	case BM_TYPE_TGA:
+		if ((bmp->true_bpp != 16) && (bmp->true_bpp != 24) && (bmp->true_bpp != 32)) {
+			return false;
+		}
+		// Same size as bm_lock_tga()
+		req->bpp = bmp->true_bpp;
+		req->size = static_cast<size_t>(bmp->w * bmp->h * (req->bpp >> 3));
+		break;
+
+	case BM_TYPE_DDS:
+	case BM_TYPE_DXT1:
+	case BM_TYPE_DXT3:
+	case BM_TYPE_DXT5:
+	case BM_TYPE_CUBEMAP_DDS:
+	case BM_TYPE_CUBEMAP_DXT1:
+	case BM_TYPE_CUBEMAP_DXT3:
+	case BM_TYPE_CUBEMAP_DXT5:
+		req->bpp = 0;
+		req->size = be->mem_taken;
+		break;
+
+	default:
+		return false;
+	}
+
+	if (req->size == 0) {
+		return false;
+	}
+
+	req->handle = be->handle;
+	req->type = c_type;
+	if (be->type == BM_TYPE_EFF) {
+		strcpy_s(req->filename, be->info.ani.eff.filename);
+	} else {
+		strcpy_s(req->filename, be->filename);
+	}
+	req->dir_type = be->dir_type;
+	req->data = nullptr;
+
+	return true;
+}
+
+/**
+ * @brief Reads and decodes the image of a request, runs on any thread
+ *
+ * If anything goes wrong the request is left without data so that the lock function reads the image again on the
+ * main thread and handles the error like it always did.
+ */
+static void bm_page_in_decode(bm_decode_request *req)
+{
+	auto data = (ubyte*)vm_malloc(req->size, memory::quiet_alloc);
+	if (data == nullptr) {
+		return;
+	}
+
+	memset(data, 0, req->size);
+
+	bool success;
+	switch (req->type) {
+	case BM_TYPE_PNG: {
+		int d_size = req->bpp >> 3;
+		success = bm_read_cached(req->filename, req->dir_type, req->type, data, req->size, &req->bpp, [&]() {
+			return png_read_bitmap(req->filename, data, &req->bpp, d_size, req->dir_type) == PNG_ERROR_NONE;
+		});
+		break;
+	}
+
+	case BM_TYPE_TGA:
+		success = targa_read_bitmap(req->filename, data, nullptr, req->bpp >> 3, req->dir_type) == TARGA_ERROR_NONE;
+		break;
+
+	default: {
+		ubyte dds_bpp = 0;
+		success = dds_read_bitmap(req->filename, data, &dds_bpp, req->dir_type) == DDS_ERROR_NONE;
+		req->bpp = dds_bpp;
+		break;
+	}
+	}
+
+	if (!success) {
+		vm_free(data);
+		return;
+	}
+
+	req->data = data;
+}
+
+/**
+ * @brief Starts the jobs which decode the next batch of bitmaps
+ *
+ * @return One past the last slot which is part of the batch
+ */
+static size_t bm_page_in_start_decode(const SCP_vector<bitmap_slot*>& slots, size_t begin,
+                                      SCP_vector<bm_decode_request>& requests, util::jobs::JobCounter* counter)
+{
+	requests.clear();
+
+	size_t bytes = 0;
+	size_t end = begin;
+	for (; end < slots.size(); ++end) {
+		auto be = &slots[end]->entry;
+
+		// All frames of an animation are uploaded together so they must not be split between two batches
+		auto prev = (end > begin) ? &slots[end - 1]->entry : nullptr;
+		bool same_anim = (prev != nullptr) && bm_is_anim(be) && bm_is_anim(prev)
+			&& (be->info.ani.first_frame == prev->info.ani.first_frame);
+
+		if (!same_anim && ((end - begin >= BM_DECODE_BATCH_BITMAPS) || (bytes >= BM_DECODE_BATCH_BYTES))) {
+			break;
+		}
+
+		bm_decode_request req;
+		if (bm_page_in_decode_request(be, &req)) {
+			bytes += req.size;
+			requests.push_back(req);
+		}
+	}
+
+	// The jobs keep pointers into the vector so it must not change until they are done
+	for (auto& req : requests) {
+		auto reqp = &req;
+		util::jobs::submit([reqp]() {
+			TRACE_SCOPE(tracing::BitmapDecodeJob);
+			bm_page_in_decode(reqp);
+		}, counter);
+	}
+
+	return end;
+}
+
+/**
+ * @brief Hands the results of finished decode jobs to the lock functions
+ */
+static void bm_page_in_stage_decoded(SCP_vector<bm_decode_request>& requests)
+{
+	for (auto& req : requests) {
+		if (req.data == nullptr) {
+			continue;
+		}
+
+		bm_staged_image staged;
+		staged.data = req.data;
+		staged.size = req.size;
+		staged.bpp = req.bpp;
+		Bm_staged_images[req.handle] = staged;
+	}
+
+	requests.clear();
+}
+
+/**
+ * @brief Frees staged images which have not been locked, e.g. because the texture was already uploaded
+ */
+static void bm_page_in_free_staged()
+{
+	for (auto& staged : Bm_staged_images) {
+		vm_free(staged.second.data);
+	}
+	Bm_staged_images.clear();
+}
+
 void bm_page_in_stop() {
 	TRACE_SCOPE(tracing::PageInStop);
 
@@ -2541,6 +3032,8 @@ void bm_page_in_stop() {
 
 	int bm_preloading = 1;
 
+	SCP_vector<bitmap_slot*> preload_slots;
+
 	for (auto& block : bm_blocks) {
 		for (auto& slot : block) {
 			auto& entry = slot.entry;
@@ -2548,41 +3041,70 @@ void bm_page_in_stop() {
 			if ((entry.type != BM_TYPE_NONE) && (entry.type != BM_TYPE_RENDER_TARGET_DYNAMIC)
 				&& (entry.type != BM_TYPE_RENDER_TARGET_STATIC)) {
 				if (entry.preloaded) {
-					TRACE_SCOPE(tracing::PageInSingleBitmap);
-					if (bm_preloading) {
-						if (!gr_preload(entry.handle, (entry.preloaded == 2))) {
-							mprintf(("Out of VRAM.  Done preloading.\n"));
-							bm_preloading = 0;
-						}
-					} else {
-						bm_lock(entry.handle, (entry.used_flags == BMP_AABITMAP) ? 8 : 16, entry.used_flags);
-						if (entry.ref_count >= 1) {
-							bm_unlock(entry.handle);
-						}
-					}
+					preload_slots.push_back(&slot);
+				} else {
+					bm_unload_fast(entry.handle);
+				}
+			}
+		}
+	}
 
-					n++;
+	// Reading and decoding the images is done by jobs one batch ahead of the upload which has to stay on the main
+	// thread. Without workers that would only cost memory.
+	bool decode_ahead = Bm_parallel_decode && !Is_standalone && (util::jobs::num_threads() > 1);
 
-					multi_send_anti_timeout_ping();
+	SCP_vector<bm_decode_request> decoding;
+	util::jobs::JobCounter decode_counter;
+	size_t batch_end = decode_ahead ? bm_page_in_start_decode(preload_slots, 0, decoding, &decode_counter) : preload_slots.size();
 
-					if ((entry.info.ani.first_frame == 0) || (entry.info.ani.first_frame == entry.handle)) {
+	size_t i = 0;
+	while (i < preload_slots.size()) {
+		size_t upload_end = batch_end;
+
+		if (decode_ahead) {
+			util::jobs::wait(&decode_counter);
+			bm_page_in_stage_decoded(decoding);
+
+			// The next batch is decoded while this one is uploaded
+			batch_end = bm_page_in_start_decode(preload_slots, upload_end, decoding, &decode_counter);
+		}
+
+		for (; i < upload_end; ++i) {
+			auto& entry = preload_slots[i]->entry;
+
+			TRACE_SCOPE(tracing::PageInSingleBitmap);
+			if (bm_preloading) {
+				if (!gr_preload(entry.handle, (entry.preloaded == 2))) {
+					mprintf(("Out of VRAM.  Done preloading.\n"));
+					bm_preloading = 0;
+				}
+			} else {
+				bm_lock(entry.handle, (entry.used_flags == BMP_AABITMAP) ? 8 : 16, entry.used_flags);
+				if (entry.ref_count >= 1) {
+					bm_unlock(entry.handle);
+				}
+			}
+
+			n++;
+
+			multi_send_anti_timeout_ping();
+
+			if ((entry.info.ani.first_frame == 0) || (entry.info.ani.first_frame == entry.handle)) {
 #ifndef NDEBUG
-						memset(busy_text, 0, sizeof(busy_text));
+				memset(busy_text, 0, sizeof(busy_text));
 
-						strcat_s(busy_text, "** BmpMan: ");
-						strcat_s(busy_text, entry.filename);
-						strcat_s(busy_text, " **");
+				strcat_s(busy_text, "** BmpMan: ");
+				strcat_s(busy_text, entry.filename);
+				strcat_s(busy_text, " **");
 
-						game_busy(busy_text);
+				game_busy(busy_text);
 #else
-						game_busy();
+				game_busy();
 #endif
-					}
-				} else {
-					bm_unload_fast(entry.handle);
-				}
 			}
 		}
+
+		bm_page_in_free_staged();
 	}
 
 	nprintf(("BmpInfo", "BMPMAN: Loaded %d bitmaps that are marked as used for this level.\n", n));
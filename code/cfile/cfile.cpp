@@ -37,6 +37,7 @@
 
 
 #include <limits>
+#include <mutex>
 
 char Cfile_root_dir[CFILE_ROOT_DIRECTORY_LEN] = "";
 char Cfile_user_dir[CFILE_ROOT_DIRECTORY_LEN] = "";
@@ -103,6 +104,10 @@ static char Cfile_stack[CFILE_STACK_MAX][CFILE_ROOT_DIRECTORY_LEN];
 
 std::array<CFILE, MAX_CFILE_BLOCKS> Cfile_block_list;
 
+// Files may be opened by jobs (see bm_page_in_stop()) so taking and returning blocks has to be synchronized. Each block
+// is only used by the thread which opened it.
+static std::mutex Cfile_block_lock;
+
 static const char *Cfile_cdrom_dir = NULL;
 
 //
@@ -751,7 +756,12 @@ CFILE* _cfopen(const char* source, int line, const char* file_path, const char*
 		nprintf(("CFileDebug", "Requested file %s found at: %s\n", file_path, find_res.full_name.c_str()));
 
 		if ( type & CFILE_MEMORY_MAPPED ) {
-		
+
+			// Files from memory mapped packs are already in memory
+			if ( find_res.offset != 0 && find_res.data_ptr != nullptr ) {
+				return cf_open_memory_fill_cfblock(source, line, find_res.data_ptr, find_res.size, dir_type);
+			}
+
 			// Can't open memory mapped files out of pack or memory files
 			if ( find_res.offset == 0 && find_res.data_ptr != nullptr )	{
 #if defined _WIN32
@@ -864,6 +874,8 @@ static int cfget_cfile_block()
 	int i;
 	CFILE* cfile;
 
+	std::lock_guard<std::mutex> guard(Cfile_block_lock);
+
 	for ( i = 0; i < MAX_CFILE_BLOCKS; i++ ) {
 		cfile = &Cfile_block_list[i];
 		if (cfile->type == CFILE_BLOCK_UNUSED) {
@@ -926,7 +938,10 @@ int cfclose( CFILE * cfile )
 		// VP  do nothing
 	}
 
-	cfile->type = CFILE_BLOCK_UNUSED;
+	{
+		std::lock_guard<std::mutex> guard(Cfile_block_lock);
+		cfile->type = CFILE_BLOCK_UNUSED;
+	}
 	return result;
 }
 
@@ -1121,6 +1136,27 @@ const void *cf_returndata(CFILE *cfile)
 	return cfile->data;
 }
 
+// cf_get_memory_view() returns the contents of a file which is completely in memory, either
+// because it is a built-in file or because it is in a VP that was memory mapped with -mmap_vps.
+// This lets the caller use the data directly instead of copying it with cfread().
+//
+// returns:   the start of the file and its size in 'size', or nullptr if the file has to be read normally
+//
+const void *cf_get_memory_view(CFILE *cfile, size_t *size)
+{
+	Assert(cfile != NULL);
+
+	// Files opened with CFILE_MEMORY_MAPPED don't track their size on every platform
+	if (cfile->data == nullptr || cfile->mem_mapped) {
+		return nullptr;
+	}
+
+	if (size != nullptr) {
+		*size = cfile->size;
+	}
+	return cfile->data;
+}
+
 // cutoff point where cfread() will throw an error when it hits this limit
 // if 'len' is 0 then this check will be disabled
 void cf_set_max_read_len( CFILE * cfile, size_t len )
@@ -1614,6 +1650,30 @@ static int cf_chksum_do(CFILE *cfile, ushort *chk_short, uint *chk_long, int max
 		max_size = cfilelength(cfile);
 	}
 	
+	// no need to copy anything if the file is already in memory
+	size_t view_size;
+	auto view = reinterpret_cast<const ubyte*>(cf_get_memory_view(cfile, &view_size));
+	if (view != nullptr) {
+		auto start = (size_t)cftell(cfile);
+		auto len = MIN((size_t)max_size, view_size - start);
+
+		// the short checksum depends on how the data is split up so use the same blocks as below
+		for (size_t pos = 0; pos < len; pos += CF_CHKSUM_SAMPLE_SIZE) {
+			auto block_len = MIN((size_t)CF_CHKSUM_SAMPLE_SIZE, len - pos);
+
+			// cf_add_chksum_*() don't modify the data
+			auto data = const_cast<ubyte*>(view + start + pos);
+			if(is_long){
+				*chk_long = cf_add_chksum_long(*chk_long, data, block_len);
+			} else {
+				*chk_short = cf_add_chksum_short(*chk_short, data, (int)block_len);
+			}
+		}
+
+		cfseek(cfile, (int)(start + len), CF_SEEK_SET);
+		return 1;
+	}
+
 	cf_total = 0;
 	do {
 		// determine how much we want to read
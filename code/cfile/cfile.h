@@ -257,6 +257,10 @@ int cfeof(CFILE *cfile);
 // Return the data pointer associated with the CFILE structure (for memory mapped files)
 const void *cf_returndata(CFILE *cfile);
 
+// Returns the whole contents of a file that is already in memory (built-in files and files in VPs mapped with
+// -mmap_vps) and stores its size in 'size'. Returns nullptr if the file must be read with cfread().
+const void *cf_get_memory_view(CFILE *cfile, size_t *size);
+
 // get the 2 byte checksum of the passed filename - return 0 if operation failed, 1 if succeeded
 int cf_chksum_short(const char *filename, ushort *chksum, int max_size = -1, int cf_type = CF_TYPE_ANY );
 
@@ -384,6 +388,11 @@ struct CFileLocation {
 CFileLocation cf_find_file_location(const char* filespec, int pathtype, bool localize = false,
                                     uint32_t location_flags = CF_LOCATION_ALL);
 
+// Gets the modification time of a file or directory on disk, e.g. the full_name of a CFileLocation.  The time is -1 if
+// the file was written so recently that it could still change without the time being different.
+// Returns false if there is no such file.
+bool cf_get_file_time(const SCP_string& path, int64_t* write_time);
+
 struct CFileLocationExt : public CFileLocation {
 	int extension_index = -1;
 
@@ -21,6 +21,8 @@
 #include <direct.h>
 #include <windows.h>
 #include <winbase.h>		/* needed for memory mapping of file functions */
+#include <sys/types.h>
+#include <sys/stat.h>
 #endif
 
 #ifdef SCP_UNIX
@@ -31,6 +33,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <libgen.h>
+#include <sys/mman.h>
 #endif
 
 #include "cfile/cfile.h"
@@ -57,6 +60,8 @@ typedef struct cf_root {
 	char	path[CF_MAX_PATHNAME_LENGTH];	// Contains something like c:\projects\freespace or c:\projects\freespace\freespace.vp
 	int		roottype;						// CF_ROOTTYPE_PATH  = Path, CF_ROOTTYPE_PACK =Pack file, CF_ROOTTYPE_MEMORY=In memory
 	uint32_t location_flags;
+	const void*	pack_data;					// For pack files opened with -mmap_vps, a read-only mapping of the whole file
+	size_t		pack_data_size;				// Size of that mapping
 } cf_root;
 
 // convenient type for sorting (see cf_build_pack_list())
@@ -101,6 +106,40 @@ typedef struct cf_file_block {
 static uint Num_files = 0;
 static cf_file_block  *File_blocks[CF_MAX_FILE_BLOCKS];
 
+// Persistent copy of the file index, so that roots which haven't changed since the last run don't have to be searched
+#define CF_INDEX_CACHE_DIR			"cfile_cache"
+#define CF_INDEX_CACHE_FILENAME		"file_index.bin"
+#define CF_INDEX_CACHE_VERSION		1
+
+// A directory that was searched for a path root and its modification time at that point.  Adding, removing or renaming
+// a file changes the time of its directory, and a new subdirectory changes the time of its parent.
+typedef struct cf_cached_dir {
+	SCP_string	path;
+	int64_t		write_time;
+} cf_cached_dir;
+
+typedef struct cf_cached_file {
+	SCP_string	name_ext;
+	int			pathtype_index;
+	int64_t		write_time;
+	int			size;
+	int			pack_offset;
+	SCP_string	real_name;
+} cf_cached_file;
+
+typedef struct cf_cached_root {
+	int			roottype = CF_ROOTTYPE_PATH;
+	int64_t		pack_write_time = 0;	// For pack roots, the time and size of the VP
+	int64_t		pack_size = 0;
+	SCP_vector<cf_cached_dir> dirs;		// For path roots, all the directories that were searched
+	SCP_vector<cf_cached_file> files;
+	bool		used = false;			// Still one of our roots, so it's written back
+} cf_cached_root;
+
+// Keyed by the path of the root
+static SCP_unordered_map<SCP_string, cf_cached_root> Cf_index_cache;
+static bool Cf_index_cache_changed = false;
+
 // Return a pointer to to file 'index'.
 cf_file *cf_get_file(int index)
 {
@@ -157,7 +196,82 @@ cf_root *cf_create_root()
 
 	Num_roots++;
 
-	return &Root_blocks[block]->roots[offset];
+	cf_root *root = &Root_blocks[block]->roots[offset];
+	root->pack_data = nullptr;
+	root->pack_data_size = 0;
+
+	return root;
+}
+
+// Maps a whole pack file into memory so that files in it can be read without going through stdio.
+// Failing is not an error, the pack is then read with fread() as usual.
+static void cf_map_pack(cf_root *root, FILE *fp)
+{
+	auto length = filelength(fileno(fp));
+	if (length <= 0) {
+		return;
+	}
+
+#if defined _WIN32
+	HANDLE hMapFile = CreateFileMapping((HANDLE)_get_osfhandle(_fileno(fp)), NULL, PAGE_READONLY, 0, 0, NULL);
+	if (hMapFile == NULL) {
+		mprintf(("Could not create a file mapping for '%s', reading it normally.\n", root->path));
+		return;
+	}
+
+	// the view keeps the mapping object alive
+	void *data = MapViewOfFile(hMapFile, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(hMapFile);
+
+	if (data == NULL) {
+		mprintf(("Could not map '%s', reading it normally.\n", root->path));
+		return;
+	}
+#elif defined SCP_UNIX
+	// the mapping stays valid after the file is closed
+	void *data = mmap(nullptr, (size_t)length, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+	if (data == MAP_FAILED) {
+		mprintf(("Could not map '%s' (%s), reading it normally.\n", root->path, strerror(errno)));
+		return;
+	}
+#endif
+
+	root->pack_data = data;
+	root->pack_data_size = (size_t)length;
+}
+
+static void cf_unmap_pack(cf_root *root)
+{
+	if (root->pack_data == nullptr) {
+		return;
+	}
+
+#if defined _WIN32
+	UnmapViewOfFile(root->pack_data);
+#elif defined SCP_UNIX
+	// This const_cast is safe since the pointer returned by mmap was also non-const
+	munmap(const_cast<void*>(root->pack_data), root->pack_data_size);
+#endif
+
+	root->pack_data = nullptr;
+	root->pack_data_size = 0;
+}
+
+// Returns the contents of a packed file if its pack is memory mapped, nullptr otherwise
+static const void *cf_get_pack_file_data(cf_root *root, cf_file *f)
+{
+	if (root->pack_data == nullptr) {
+		return nullptr;
+	}
+
+	auto offset = static_cast<size_t>(f->pack_offset);
+	auto size = static_cast<size_t>(f->size);
+	if (offset > root->pack_data_size || size > root->pack_data_size - offset) {
+		// A broken index, let fread() deal with it like it did before
+		return nullptr;
+	}
+
+	return reinterpret_cast<const ubyte*>(root->pack_data) + offset;
 }
 
 // return the # of packfiles which exist
@@ -551,7 +665,58 @@ int is_ext_in_list( const char *ext_list, const char *ext )
 	return 0;
 }
 
-void cf_search_root_path(int root_index)
+// Gets the modification time (and size) of a file or directory, returns false if it doesn't exist
+static bool cf_index_cache_stat(const SCP_string &path, int64_t *write_time, int64_t *size = nullptr)
+{
+	SCP_string stat_path = path;
+
+	// stat() on Windows doesn't like trailing separators on directories
+	while (stat_path.size() > 1 && (stat_path.back() == '/' || stat_path.back() == DIR_SEPARATOR_CHAR)) {
+		stat_path.pop_back();
+	}
+
+#ifdef _WIN32
+	struct _stat64 buf;
+	if (_stat64(stat_path.c_str(), &buf) != 0) {
+		return false;
+	}
+#else
+	struct stat buf;
+	if (stat(stat_path.c_str(), &buf) != 0) {
+		return false;
+	}
+#endif
+
+	*write_time = (int64_t)buf.st_mtime;
+
+	// The time only has a resolution of a second so something that changed just now could change again without the
+	// time being different. Such a time is never matched.
+	if (*write_time >= (int64_t)time(nullptr) - 1) {
+		*write_time = -1;
+	}
+
+	if (size != nullptr) {
+		*size = (int64_t)buf.st_size;
+	}
+	return true;
+}
+
+bool cf_get_file_time(const SCP_string &path, int64_t *write_time)
+{
+	return cf_index_cache_stat(path, write_time);
+}
+
+// Remembers a directory that is about to be searched.  The time is taken before reading it so that a file which is
+// added while the directory is read makes the cache entry invalid.
+static void cf_index_cache_add_dir(SCP_vector<cf_cached_dir> &searched_dirs, const SCP_string &path)
+{
+	int64_t write_time;
+	if (cf_index_cache_stat(path, &write_time)) {
+		searched_dirs.push_back({path, write_time});
+	}
+}
+
+void cf_search_root_path(int root_index, SCP_vector<cf_cached_dir> &searched_dirs)
 {
 	int i;
 	int num_files = 0;
@@ -592,6 +757,8 @@ void cf_search_root_path(int root_index)
 		find_handle = _findfirst( search_path, &find );
 
  		if (find_handle != -1) {
+			cf_index_cache_add_dir(searched_dirs, search_directory);
+
 			do {
 				if (!(find.attrib & _A_SUBDIR)) {
 
@@ -689,6 +856,8 @@ void cf_search_root_path(int root_index)
 		}
 
 		if ( dirp ) {
+			cf_index_cache_add_dir(searched_dirs, search_dir);
+
 			struct dirent *dir = nullptr;
 			while ((dir = readdir (dirp)) != NULL)
 			{
@@ -788,6 +957,10 @@ void cf_search_root_pack(int root_index)
 
 	mprintf(( "Searching root pack '%s' ... ", root->path ));
 
+	if (Cmdline_mmap_vps) {
+		cf_map_pack(root, fp);
+	}
+
 	// Read index info
 	fseek(fp, VP_header.index_offset, SEEK_SET);
 
@@ -902,24 +1075,320 @@ void cf_search_memory_root(int root_index) {
 	mprintf(( "%i files\n", num_files ));
 }
 
+static void cf_index_cache_write_int(FILE *fp, int64_t value)
+{
+	fwrite(&value, sizeof(value), 1, fp);
+}
+
+static void cf_index_cache_write_string(FILE *fp, const SCP_string &str)
+{
+	cf_index_cache_write_int(fp, (int64_t)str.size());
+	fwrite(str.data(), 1, str.size(), fp);
+}
+
+static bool cf_index_cache_read_int(FILE *fp, int64_t *value)
+{
+	return fread(value, sizeof(*value), 1, fp) == 1;
+}
+
+static bool cf_index_cache_read_string(FILE *fp, SCP_string &str)
+{
+	int64_t len;
+	if (!cf_index_cache_read_int(fp, &len) || len < 0 || len > CF_MAX_PATHNAME_LENGTH * 4) {
+		return false;
+	}
+
+	str.resize((size_t)len);
+	return len == 0 || fread(&str[0], 1, (size_t)len, fp) == (size_t)len;
+}
+
+static bool cf_index_cache_read(FILE *fp)
+{
+	char id[4];
+	int64_t version, num_roots;
+
+	if (fread(id, sizeof(id), 1, fp) != 1 || memcmp(id, "CFIC", 4) != 0) {
+		return false;
+	}
+	if (!cf_index_cache_read_int(fp, &version) || version != CF_INDEX_CACHE_VERSION) {
+		return false;
+	}
+	if (!cf_index_cache_read_int(fp, &num_roots) || num_roots < 0 || num_roots > CF_MAX_ROOTS) {
+		return false;
+	}
+
+	for (int64_t i = 0; i < num_roots; i++) {
+		SCP_string path;
+		cf_cached_root root;
+		int64_t value, count;
+
+		if (!cf_index_cache_read_string(fp, path) || !cf_index_cache_read_int(fp, &value)) {
+			return false;
+		}
+		root.roottype = (int)value;
+		root.used = false;
+
+		if (!cf_index_cache_read_int(fp, &root.pack_write_time) || !cf_index_cache_read_int(fp, &root.pack_size)) {
+			return false;
+		}
+
+		if (!cf_index_cache_read_int(fp, &count) || count < 0 || count > CF_MAX_PATH_TYPES) {
+			return false;
+		}
+		root.dirs.resize((size_t)count);
+		for (auto &dir : root.dirs) {
+			if (!cf_index_cache_read_string(fp, dir.path) || !cf_index_cache_read_int(fp, &dir.write_time)) {
+				return false;
+			}
+		}
+
+		if (!cf_index_cache_read_int(fp, &count) || count < 0 || count > CF_NUM_FILES_PER_BLOCK * CF_MAX_FILE_BLOCKS) {
+			return false;
+		}
+		root.files.resize((size_t)count);
+		for (auto &file : root.files) {
+			int64_t pathtype_index, size, pack_offset;
+
+			if (!cf_index_cache_read_string(fp, file.name_ext) || !cf_index_cache_read_int(fp, &pathtype_index)
+				|| !cf_index_cache_read_int(fp, &file.write_time) || !cf_index_cache_read_int(fp, &size)
+				|| !cf_index_cache_read_int(fp, &pack_offset) || !cf_index_cache_read_string(fp, file.real_name)) {
+				return false;
+			}
+
+			if (file.name_ext.size() >= CF_MAX_FILENAME_LENGTH || pathtype_index < CF_TYPE_ROOT || pathtype_index >= CF_MAX_PATH_TYPES) {
+				return false;
+			}
+			file.pathtype_index = (int)pathtype_index;
+			file.size = (int)size;
+			file.pack_offset = (int)pack_offset;
+		}
+
+		Cf_index_cache[path] = std::move(root);
+	}
+
+	return true;
+}
+
+static void cf_index_cache_load()
+{
+	Cf_index_cache.clear();
+	Cf_index_cache_changed = false;
+
+	if (Cmdline_no_file_index_cache) {
+		return;
+	}
+
+	auto filename = os_get_config_path(CF_INDEX_CACHE_DIR DIR_SEPARATOR_STR CF_INDEX_CACHE_FILENAME);
+	FILE *fp = fopen(filename.c_str(), "rb");
+	if (fp == nullptr) {
+		return;
+	}
+
+	if (!cf_index_cache_read(fp)) {
+		mprintf(("File index cache '%s' is invalid, searching all roots.\n", filename.c_str()));
+		Cf_index_cache.clear();
+	}
+
+	fclose(fp);
+}
+
+static void cf_index_cache_save()
+{
+	if (Cmdline_no_file_index_cache) {
+		return;
+	}
+
+	// drop the roots that aren't used anymore, e.g. from mods that weren't loaded this time
+	for (auto iter = Cf_index_cache.begin(); iter != Cf_index_cache.end();) {
+		if (!iter->second.used) {
+			iter = Cf_index_cache.erase(iter);
+			Cf_index_cache_changed = true;
+		} else {
+			++iter;
+		}
+	}
+
+	if (!Cf_index_cache_changed) {
+		return;
+	}
+
+	// The cache doesn't go into the user root itself since writing it would then change the time of a directory
+	// that is searched
+	auto dirname = os_get_config_path(CF_INDEX_CACHE_DIR);
+#ifdef _WIN32
+	_mkdir(dirname.c_str());
+#else
+	mkdir(dirname.c_str(), 0777);
+#endif
+
+	auto filename = dirname + DIR_SEPARATOR_STR CF_INDEX_CACHE_FILENAME;
+	FILE *fp = fopen(filename.c_str(), "wb");
+	if (fp == nullptr) {
+		mprintf(("Could not write the file index cache to '%s'.\n", filename.c_str()));
+		return;
+	}
+
+	fwrite("CFIC", 4, 1, fp);
+	cf_index_cache_write_int(fp, CF_INDEX_CACHE_VERSION);
+	cf_index_cache_write_int(fp, (int64_t)Cf_index_cache.size());
+
+	for (auto &entry : Cf_index_cache) {
+		auto &root = entry.second;
+
+		cf_index_cache_write_string(fp, entry.first);
+		cf_index_cache_write_int(fp, root.roottype);
+		cf_index_cache_write_int(fp, root.pack_write_time);
+		cf_index_cache_write_int(fp, root.pack_size);
+
+		cf_index_cache_write_int(fp, (int64_t)root.dirs.size());
+		for (auto &dir : root.dirs) {
+			cf_index_cache_write_string(fp, dir.path);
+			cf_index_cache_write_int(fp, dir.write_time);
+		}
+
+		cf_index_cache_write_int(fp, (int64_t)root.files.size());
+		for (auto &file : root.files) {
+			cf_index_cache_write_string(fp, file.name_ext);
+			cf_index_cache_write_int(fp, file.pathtype_index);
+			cf_index_cache_write_int(fp, file.write_time);
+			cf_index_cache_write_int(fp, file.size);
+			cf_index_cache_write_int(fp, file.pack_offset);
+			cf_index_cache_write_string(fp, file.real_name);
+		}
+	}
+
+	if (ferror(fp)) {
+		fclose(fp);
+		remove(filename.c_str());
+		mprintf(("Could not write the file index cache to '%s'.\n", filename.c_str()));
+		return;
+	}
+
+	fclose(fp);
+}
+
+// Adds the files of a root from the cache if nothing changed since they were stored
+static bool cf_index_cache_restore(int root_index)
+{
+	cf_root *root = cf_get_root(root_index);
+
+	auto iter = Cf_index_cache.find(root->path);
+	if (iter == Cf_index_cache.end() || iter->second.roottype != root->roottype) {
+		return false;
+	}
+	auto &cached = iter->second;
+
+	if (root->roottype == CF_ROOTTYPE_PACK) {
+		int64_t write_time, size;
+		if (!cf_index_cache_stat(root->path, &write_time, &size) || write_time < 0 || write_time != cached.pack_write_time
+			|| size != cached.pack_size) {
+			return false;
+		}
+	} else {
+		for (auto &dir : cached.dirs) {
+			int64_t write_time;
+			if (!cf_index_cache_stat(dir.path, &write_time) || write_time < 0 || write_time != dir.write_time) {
+				return false;
+			}
+		}
+
+		// The root itself is always searched, if it wasn't found then it might exist now
+		if (cached.dirs.empty()) {
+			return false;
+		}
+	}
+
+	if (root->roottype == CF_ROOTTYPE_PACK && Cmdline_mmap_vps) {
+		FILE *fp = fopen(root->path, "rb");
+		if (fp != nullptr) {
+			cf_map_pack(root, fp);
+			fclose(fp);
+		}
+	}
+
+	for (auto &cached_file : cached.files) {
+		cf_file *file = cf_create_file();
+
+		strcpy_s(file->name_ext, cached_file.name_ext.c_str());
+		file->root_index = root_index;
+		file->pathtype_index = cached_file.pathtype_index;
+		file->write_time = (time_t)cached_file.write_time;
+		file->size = cached_file.size;
+		file->pack_offset = cached_file.pack_offset;
+		file->real_name = cached_file.real_name.empty() ? nullptr : vm_strdup(cached_file.real_name.c_str());
+		file->data = nullptr;
+	}
+
+	cached.used = true;
+
+	mprintf(( "Using cached index for '%s' ... %i files\n", root->path, (int)cached.files.size() ));
+	return true;
+}
+
+// Stores the files that were just found in a root in the cache.  'cached' has to contain the times that were taken
+// before the root was searched.
+static void cf_index_cache_store(int root_index, uint first_file, cf_cached_root &cached)
+{
+	cf_root *root = cf_get_root(root_index);
+
+	cached.roottype = root->roottype;
+	cached.used = true;
+
+	for (uint i = first_file; i < Num_files; i++) {
+		cf_file *file = cf_get_file(i);
+		cf_cached_file cached_file;
+
+		cached_file.name_ext = file->name_ext;
+		cached_file.pathtype_index = file->pathtype_index;
+		cached_file.write_time = (int64_t)file->write_time;
+		cached_file.size = file->size;
+		cached_file.pack_offset = file->pack_offset;
+		if (file->real_name != nullptr) {
+			cached_file.real_name = file->real_name;
+		}
+
+		cached.files.push_back(std::move(cached_file));
+	}
+
+	Cf_index_cache[root->path] = std::move(cached);
+	Cf_index_cache_changed = true;
+}
+
 void cf_build_file_list()
 {
 	int i;
 
 	Num_files = 0;
 
+	cf_index_cache_load();
+
 	// For each root, find all files...
 	for (i=0; i<Num_roots; i++ )	{
 		cf_root	*root = cf_get_root(i);
+		uint first_file = Num_files;
+
 		if ( root->roottype == CF_ROOTTYPE_PATH )	{
-			cf_search_root_path(i);
+			if (!cf_index_cache_restore(i)) {
+				cf_cached_root cached;
+				cf_search_root_path(i, cached.dirs);
+				cf_index_cache_store(i, first_file, cached);
+			}
 		} else if ( root->roottype == CF_ROOTTYPE_PACK )	{
-			cf_search_root_pack(i);
+			if (!cf_index_cache_restore(i)) {
+				cf_cached_root cached;
+				bool exists = cf_index_cache_stat(root->path, &cached.pack_write_time, &cached.pack_size);
+				cf_search_root_pack(i);
+				if (exists) {
+					cf_index_cache_store(i, first_file, cached);
+				}
+			}
 		} else if (root->roottype == CF_ROOTTYPE_MEMORY) {
 			cf_search_memory_root(i);
 		}
 	}
 
+	cf_index_cache_save();
+	Cf_index_cache.clear();
 }
 
 
@@ -956,6 +1425,11 @@ void cf_free_secondary_filelist()
 {
 	int i;
 
+	// Unmap the pack files
+	for (i=0; i<Num_roots; i++ )	{
+		cf_unmap_pack(&Root_blocks[i / CF_NUM_ROOTS_PER_BLOCK]->roots[i % CF_NUM_ROOTS_PER_BLOCK]);
+	}
+
 	// Free the root blocks
 	for (i=0; i<CF_MAX_ROOT_BLOCKS; i++ )	{
 		if ( Root_blocks[i] )	{
@@ -1145,6 +1619,7 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, bool loc
 						cf_root *r = cf_get_root(f->root_index);
 
 						res.full_name = r->path;
+						res.data_ptr = cf_get_pack_file_data(r, f);
 					}
 
 					return res;
@@ -1172,6 +1647,7 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, bool loc
 				cf_root *r = cf_get_root(f->root_index);
 
 				res.full_name = r->path;
+				res.data_ptr = cf_get_pack_file_data(r, f);
 			}
 
 			return res;
@@ -1410,6 +1886,7 @@ CFileLocationExt cf_find_file_location_ext( const char *filename, const int ext_
 							cf_root *r = cf_get_root(f->root_index);
 
 							res.full_name = r->path;
+							res.data_ptr = cf_get_pack_file_data(r, f);
 						}
 
 						// found it, so cleanup and return
@@ -1441,6 +1918,7 @@ CFileLocationExt cf_find_file_location_ext( const char *filename, const int ext_
 					cf_root *r = cf_get_root(f->root_index);
 
 					res.full_name = r->path;
+					res.data_ptr = cf_get_pack_file_data(r, f);
 				}
 
 				// found it, so cleanup and return
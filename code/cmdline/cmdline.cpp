@@ -216,12 +216,17 @@ Flag exe_params[] =
 	{ "-set_cpu_affinity",	"Sets processor affinity to config value",	true,	0,					EASY_DEFAULT,		"Troubleshoot", "", },
 	{ "-nograb",			"Disables mouse grabbing",					true,	0,					EASY_DEFAULT,		"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-nograb", },
 	{ "-noshadercache",		"Disables the shader cache",				true,	0,					EASY_DEFAULT,		"Troubleshoot", "http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-noshadercache", },
+	{ "-nofileindexcache",	"Always search all directories and VPs",	true,	0,					EASY_DEFAULT,		"Troubleshoot", "", },
+	{ "-serial_physics",	"Move all objects on the main thread",		true,	0,					EASY_DEFAULT,		"Troubleshoot", "", },
 #ifdef WIN32
 	{ "-fix_registry",	"Use a different registry path",			true,		0,					EASY_DEFAULT,		"Troubleshoot", "", },
 #endif
 
 	{ "-ingame_join",		"Allow in-game joining",					true,	0,					EASY_DEFAULT,		"Experimental",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-ingame_join", },
 	{ "-voicer",			"Enable voice recognition",					true,	0,					EASY_DEFAULT,		"Experimental",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-voicer", },
+	{ "-mmap_vps",			"Memory-map VP archives",					true,	0,					EASY_DEFAULT,		"Experimental",	"", },
+	{ "-texture_cache",		"Cache decoded textures on disk",			true,	0,					EASY_DEFAULT,		"Experimental",	"", },
+	{ "-model_cache",		"Cache processed models on disk",			true,	0,					EASY_DEFAULT,		"Experimental",	"", },
 
 	{ "-fps",				"Show frames per second on HUD",			false,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-fps", },
 	{ "-bmpmanusage",		"Show how many BMPMAN slots are in use",	false,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-bmpmanusage", },
@@ -439,6 +444,12 @@ cmdline_parm no_geo_sdr_effects("-no_geo_effects", NULL, AT_NONE);
 cmdline_parm set_cpu_affinity("-set_cpu_affinity", NULL, AT_NONE);
 cmdline_parm nograb_arg("-nograb", NULL, AT_NONE);
 cmdline_parm noshadercache_arg("-noshadercache", NULL, AT_NONE);
+cmdline_parm no_file_index_cache_arg("-nofileindexcache", NULL, AT_NONE);	// Cmdline_no_file_index_cache
+cmdline_parm mmap_vps_arg("-mmap_vps", NULL, AT_NONE);	// Cmdline_mmap_vps -- read files in VPs through a memory mapping
+cmdline_parm serial_physics_arg("-serial_physics", NULL, AT_NONE);	// Cmdline_serial_physics
+cmdline_parm texture_cache_arg("-texture_cache", NULL, AT_NONE);	// Cmdline_texture_cache -- keep decoded PNG and JPG images in the cache directory
+cmdline_parm model_cache_arg("-model_cache", NULL, AT_NONE);	// Cmdline_model_cache -- keep the buffers, octants and collision trees of models in the cache directory
+cmdline_parm job_threads_arg("-job_threads", "Number of job system worker threads, 0 runs everything on the main thread", AT_INT);	// Cmdline_job_threads
 #ifdef WIN32
 cmdline_parm fix_registry("-fix_registry", NULL, AT_NONE);
 #endif
@@ -457,6 +468,12 @@ bool Cmdline_no_geo_sdr_effects = false;
 bool Cmdline_set_cpu_affinity = false;
 bool Cmdline_nograb = false;
 bool Cmdline_noshadercache = false;
+bool Cmdline_no_file_index_cache = false;
+bool Cmdline_mmap_vps = false;
+int Cmdline_job_threads = -1;
+bool Cmdline_serial_physics = false;
+bool Cmdline_texture_cache = false;
+bool Cmdline_model_cache = false;
 #ifdef WIN32
 bool Cmdline_alternate_registry_path = false;
 #endif
@@ -487,6 +504,9 @@ cmdline_parm json_profiling("-json_profiling", NULL, AT_NONE); //Cmdline_json_pr
 cmdline_parm show_video_info("-show_video_info", NULL, AT_NONE); //Cmdline_show_video_info
 cmdline_parm frame_profile_arg("-profile_frame_time", NULL, AT_NONE); //Cmdline_frame_profile
 cmdline_parm debug_window_arg("-debug_window", NULL, AT_NONE);	// Cmdline_debug_window
+cmdline_parm headless_benchmark_arg("-headless_benchmark", "Run this mission without graphics and sound and time it", AT_STRING); // Cmdline_headless_benchmark
+cmdline_parm benchmark_frames_arg("-benchmark_frames", "Number of frames -headless_benchmark simulates", AT_INT); // Cmdline_benchmark_frames
+cmdline_parm benchmark_seed_arg("-benchmark_seed", "Random seed of -headless_benchmark", AT_INT); // Cmdline_benchmark_seed
 
 
 char *Cmdline_start_mission = NULL;
@@ -516,6 +536,9 @@ bool Cmdline_json_profiling = false;
 bool Cmdline_frame_profile = false;
 bool Cmdline_show_video_info = false;
 bool Cmdline_debug_window = false;
+char *Cmdline_headless_benchmark = NULL;
+int Cmdline_benchmark_frames = 3600;
+int Cmdline_benchmark_seed = 1;
 
 // Other
 cmdline_parm get_flags_arg("-get_flags", "Output the launcher flags file", AT_STRING);
@@ -1936,6 +1959,36 @@ bool SetCmdlineParams()
 		Cmdline_noshadercache = true;
 	}
 
+	if (no_file_index_cache_arg.found())
+	{
+		Cmdline_no_file_index_cache = true;
+	}
+
+	if (mmap_vps_arg.found())
+	{
+		Cmdline_mmap_vps = true;
+	}
+
+	if (job_threads_arg.found())
+	{
+		Cmdline_job_threads = job_threads_arg.get_int();
+	}
+
+	if (serial_physics_arg.found())
+	{
+		Cmdline_serial_physics = true;
+	}
+
+	if (texture_cache_arg.found())
+	{
+		Cmdline_texture_cache = true;
+	}
+
+	if (model_cache_arg.found())
+	{
+		Cmdline_model_cache = true;
+	}
+
 	if (portable_mode.found())
 	{
 		Cmdline_portable_mode = true;
@@ -2086,6 +2139,22 @@ bool SetCmdlineParams()
 		Cmdline_debug_window = true;
 	}
 
+	if (headless_benchmark_arg.found()) {
+		Cmdline_headless_benchmark = headless_benchmark_arg.str();
+
+		// There is nobody to listen and the subsystem timings are what the benchmark reports
+		Cmdline_freespace_no_sound = Cmdline_freespace_no_music = 1;
+		Cmdline_frame_profile = true;
+	}
+
+	if (benchmark_frames_arg.found() && benchmark_frames_arg.get_int() > 0) {
+		Cmdline_benchmark_frames = benchmark_frames_arg.get_int();
+	}
+
+	if (benchmark_seed_arg.found()) {
+		Cmdline_benchmark_seed = benchmark_seed_arg.get_int();
+	}
+
 	if (show_video_info.found())
 	{
 		Cmdline_show_video_info = true;
@@ -133,6 +133,12 @@ extern bool Cmdline_no_geo_sdr_effects;
 extern bool Cmdline_set_cpu_affinity;
 extern bool Cmdline_nograb;
 extern bool Cmdline_noshadercache;
+extern bool Cmdline_no_file_index_cache;
+extern bool Cmdline_mmap_vps;
+extern int Cmdline_job_threads;
+extern bool Cmdline_serial_physics;
+extern bool Cmdline_texture_cache;
+extern bool Cmdline_model_cache;
 #ifdef WIN32
 extern bool Cmdline_alternate_registry_path;
 #endif
@@ -158,5 +164,8 @@ extern bool Cmdline_json_profiling;
 extern bool Cmdline_frame_profile;
 extern bool Cmdline_show_video_info;
 extern bool Cmdline_debug_window;
+extern char *Cmdline_headless_benchmark;
+extern int Cmdline_benchmark_frames;
+extern int Cmdline_benchmark_seed;
 
 #endif
@@ -1059,8 +1059,8 @@ bool gr_init(std::unique_ptr<os::GraphicsOperations>&& graphicsOps, int d_mode,
 		}
 	}
 
-	// if we are in standalone mode then just use special defaults
-	if (Is_standalone) {
+	// if we are in standalone mode or running the headless benchmark then just use special defaults
+	if (Is_standalone || Cmdline_headless_benchmark) {
 		mode = GR_STUB;
 		width = 640;
 		height = 480;
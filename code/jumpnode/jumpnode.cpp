@@ -12,6 +12,11 @@
 #include "jumpnode/jumpnode.h"
 #include "model/model.h"
 #include "model/modelrender.h"
+#include "utils/NameIndex.h"
+
+// Only maintained for nodes added through jumpnode_add(); the editors add nodes directly and use a linear search.
+// This needs to be defined before Jump_nodes since the node destructors remove themselves from the index.
+static util::NameIndex<CJumpNode*> Jump_node_name_index;
 
 SCP_list<CJumpNode> Jump_nodes;
 
@@ -100,6 +105,8 @@ CJumpNode& CJumpNode::operator=(CJumpNode&& other) SCP_NOEXCEPT
  */
 CJumpNode::~CJumpNode()
 {
+	Jump_node_name_index.remove(m_name, this);
+
 	if (m_modelnum >= 0)
 	{
 		model_unload(m_modelnum);
@@ -232,7 +239,15 @@ void CJumpNode::SetName(const char *new_name)
 	Assertion((check == this || !check), "Jumpnode %s is being renamed to %s, but a jump node with that name already exists in the mission!\n", m_name, new_name);
 	#endif
     
+	// only nodes which are already part of the mission are in the index
+	bool indexed = Jump_node_name_index.remove(m_name, this);
+
 	strcpy_s(m_name, new_name);
+
+	if (indexed)
+	{
+		Jump_node_name_index.add(m_name, this);
+	}
 }
 
 /**
@@ -384,6 +399,10 @@ CJumpNode *jumpnode_get_by_name(const char* name)
 	Assert(name != NULL);
 	SCP_list<CJumpNode>::iterator jnp;
 
+	if (!Fred_running) {
+		return Jump_node_name_index.find(name, [&](CJumpNode* node) { return !stricmp(node->GetName(), name); }, nullptr);
+	}
+
 	for (jnp = Jump_nodes.begin(); jnp != Jump_nodes.end(); ++jnp) {	
 		if(!stricmp(jnp->GetName(), name)) 
 			return &(*jnp);
@@ -432,10 +451,27 @@ void jumpnode_render_all()
 	}
 }
 
+/**
+ * Adds a jump node to the mission
+ *
+ * @param jnp The jump node to add
+ * @return The jump node as it is stored in Jump_nodes
+ */
+CJumpNode *jumpnode_add(CJumpNode&& jnp)
+{
+	Jump_nodes.push_back(std::move(jnp));
+
+	CJumpNode* added = &Jump_nodes.back();
+	Jump_node_name_index.add(added->GetName(), added);
+
+	return added;
+}
+
 /**
  * Level cleanup
  */
 void jumpnode_level_close()
 {
 	Jump_nodes.clear();
+	Jump_node_name_index.clear();
 }
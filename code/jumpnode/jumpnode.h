@@ -84,6 +84,7 @@ extern SCP_list<CJumpNode> Jump_nodes;
 //-----Functions-----
 CJumpNode *jumpnode_get_by_name(const char *name);
 CJumpNode *jumpnode_get_which_in(object *objp);
+CJumpNode *jumpnode_add(CJumpNode&& jnp);
 
 void jumpnode_render_all();
 void jumpnode_level_close();
@@ -371,6 +371,8 @@ void mission_init_goals()
 		Mission_goals[i].satisfied = GOAL_INCOMPLETE;
 		Mission_goals[i].flags = 0;
 		Mission_goals[i].team = 0;
+		Mission_goals[i].dependencies = SEXP_DEP_UNTRACKED;
+		Mission_goals[i].dependency_stamp = 0;
 	}
 
 	Num_mission_events = 0;
@@ -382,8 +384,13 @@ void mission_init_goals()
 		Mission_events[i].born_on_date = 0;
 		Mission_events[i].team = -1;
 		Mission_events[i].mission_log_flags = 0;
+		Mission_events[i].dependencies = SEXP_DEP_UNTRACKED;
+		Mission_events[i].dependency_stamp = 0;
+		Mission_events[i].compiled_formula = -1;
 	}
 
+	sexp_mark_dependency_changed(SEXP_DEP_EVENTS);
+
 	Mission_goal_timestamp = timestamp(GOAL_TIMESTAMP);
 	Mission_directive_sound_timestamp = 0;
 	Mission_directive_special_timestamp = timestamp(-1);		// need to make invalid right away
@@ -929,7 +936,7 @@ void mission_process_event( int event )
 			Current_event_log_variable_buffer = &Mission_events[event].event_log_variable_buffer;
 			Current_event_log_argument_buffer = &Mission_events[event].event_log_argument_buffer;
 		}
-		result = eval_sexp(sindex);
+		result = eval_compiled_sexp(Mission_events[event].compiled_formula, sindex);
 
 		// if the directive count is a special value, deal with that first.  Mark the event as a special
 		// event, and unmark it when the directive is true again.
@@ -968,6 +975,7 @@ void mission_process_event( int event )
 		// _argv[-1] - repeat_count of -1 would mean repeat indefinitely, so set to 0 instead.
 		Mission_events[event].repeat_count = 0;
 		Mission_events[event].formula = -1;
+		sexp_mark_dependency_changed(SEXP_DEP_EVENTS);
 		return;
 	}
 
@@ -1016,6 +1024,11 @@ void mission_process_event( int event )
 		}
 	}
 
+	// let the formulas that check this event know about it
+	if ((store_formula != Mission_events[event].formula) || (store_result != Mission_events[event].result)) {
+		sexp_mark_dependency_changed(SEXP_DEP_EVENTS);
+	}
+
 	// see if anything has changed	
 	if(MULTIPLAYER_MASTER && ((store_flags != Mission_events[event].flags) || (store_formula != Mission_events[event].formula) || (store_result != Mission_events[event].result) || (store_count != Mission_events[event].count)) ){
 		send_event_update_packet(event);
@@ -1033,9 +1046,43 @@ void mission_maybe_play_directive_success_sound()
 }
 
 
+// returns the dependency stamp to remember for a formula, or 0 if it must always be evaluated
+static uint32_t mission_formula_get_stamp(int dependencies)
+{
+	if ((dependencies & SEXP_DEP_UNTRACKED) || !sexp_dependency_tracking_enabled()) {
+		return 0;
+	}
+
+	return sexp_get_dependency_stamp(dependencies);
+}
+
+// returns true if a formula which was false at the given stamp would still be false
+static bool mission_formula_is_unchanged(int dependencies, uint32_t dependency_stamp)
+{
+	return (dependency_stamp != 0) && (mission_formula_get_stamp(dependencies) == dependency_stamp);
+}
+
+// returns true if evaluating the event can't change anything.  Chained events, directives and
+// logged events do more than just evaluate the formula so they are always processed.
+static bool mission_event_can_skip(int event)
+{
+	mission_event *mep = &Mission_events[event];
+
+	if (mep->result || (mep->chain_delay >= 0) || mep->objective_text || (mep->flags & MEF_DIRECTIVE_SPECIAL)) {
+		return false;
+	}
+
+	if ((mep->mission_log_flags != 0) || Snapshot_all_events) {
+		return false;
+	}
+
+	return mission_formula_is_unchanged(mep->dependencies, mep->dependency_stamp);
+}
+
 void mission_eval_goals()
 {
 	int i, result;
+	uint32_t stamp;
 
 	// before checking whether or not we should evaluate goals, we should run through the events and
 	// process any whose timestamp is valid and has expired.  This would catch repeating events only
@@ -1064,12 +1111,20 @@ void mission_eval_goals()
 		}
 
 		if (Mission_goals[i].satisfied == GOAL_INCOMPLETE) {
+			// nothing the goal depends on has changed since it was last false
+			if (mission_formula_is_unchanged(Mission_goals[i].dependencies, Mission_goals[i].dependency_stamp)) {
+				continue;
+			}
+
+			stamp = mission_formula_get_stamp(Mission_goals[i].dependencies);
 			result = eval_sexp(Mission_goals[i].formula);
 			if ( Sexp_nodes[Mission_goals[i].formula].value == SEXP_KNOWN_FALSE ) {
 				mission_goal_status_change( i, GOAL_FAILED );
 
 			} else if (result) {
 				mission_goal_status_change(i, GOAL_COMPLETE );
+			} else {
+				Mission_goals[i].dependency_stamp = stamp;
 			} // end if result
 
 		}	// end if goals[i].satsified != GOAL_COMPLETE
@@ -1082,8 +1137,14 @@ void mission_eval_goals()
 			// we will evaluate repeatable events at the top of the file so we can get
 			// the exact interval that the designer asked for.
 			if ( !timestamp_valid( Mission_events[i].timestamp) ){
+				if (mission_event_can_skip(i)) {
+					continue;
+				}
+
 				TRACE_SCOPE(tracing::NonrepeatingEvents);
+				stamp = mission_formula_get_stamp(Mission_events[i].dependencies);
 				mission_process_event( i );
+				Mission_events[i].dependency_stamp = Mission_events[i].result ? 0 : stamp;
 			}
 		}
 	}
@@ -1246,6 +1307,8 @@ void mission_goal_fail_incomplete()
 			Mission_events[i].result = 0;
 		}
 	}
+
+	sexp_mark_dependency_changed(SEXP_DEP_EVENTS);
 }
 
 // small function used to mark all objectives as true.  Used as a debug function and as a way
@@ -1268,6 +1331,8 @@ void mission_goal_mark_events_complete()
 		Mission_events[i].result = 1;
 		Mission_events[i].formula = -1;
 	}
+
+	sexp_mark_dependency_changed(SEXP_DEP_EVENTS);
 }
 
 // some debug console functions to help list and change the status of mission goals
@@ -61,6 +61,8 @@ typedef struct mission_goal {
 	int	score;							// score for this goal
 	int	flags;							// MGF_
 	int	team;								// which team is this objective for.
+	int	dependencies;					// SEXP_DEP_ flags of the formula
+	uint32_t	dependency_stamp;		// dependency stamp of the last false evaluation, 0 if it must be evaluated
 } mission_goal;
 
 extern mission_goal Mission_goals[MAX_GOALS];	// structure for the goals of this mission
@@ -124,6 +126,10 @@ typedef struct mission_event {
 	SCP_vector<SCP_string> backup_log_buffer;
 	int	previous_result;		// result of previous evaluation of event
 
+	int	dependencies;			// SEXP_DEP_ flags of the formula
+	uint32_t	dependency_stamp;	// dependency stamp of the last false evaluation, 0 if it must be evaluated
+	int	compiled_formula;		// the formula compiled by sexp_compile(), or -1
+
 } mission_event;
 
 extern int Num_mission_events;
@@ -21,6 +21,7 @@
 #include "network/multimsgs.h"
 #include "network/multiutil.h"
 #include "parse/parselo.h"
+#include "parse/sexp.h"
 #include "playerman/player.h"
 #include "ship/ship.h"
 
@@ -75,6 +76,8 @@ void mission_log_init()
 
 	// zero out all the memory so we don't get bogus information when playing across missions!
 	log_entries.fill({});
+
+	sexp_mark_dependency_changed(SEXP_DEP_MISSION_LOG);
 }
 
 // function to clean up the mission log removing obsolete entries.  Entries might get marked obsolete
@@ -122,6 +125,9 @@ void mission_log_obsolete_entries(LogType type, const char *pname)
 	int i;
 	log_entry *entry = NULL;
 
+	// this is called for every new entry, so the formulas that read the log have to check it again
+	sexp_mark_dependency_changed(SEXP_DEP_MISSION_LOG);
+
 	// before adding this entry, check to see if the entry type is a ship destroyed or destructed entry.
 	// If so, we can remove any subsystem destroyed entries from the log for this ship.  
 	if ( type == LOG_SHIP_DESTROYED || type == LOG_SELF_DESTRUCTED ) {
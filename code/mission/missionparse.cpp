@@ -4703,6 +4703,7 @@ void parse_wings(mission *pm)
 	{
 		Assert(Num_wings < MAX_WINGS);
 		parse_wing(pm);
+		wing_name_index_add(Num_wings);
 		Num_wings++;
 	}
 }
@@ -4864,6 +4865,9 @@ void parse_event(mission * /*pm*/)
 
 	required_string( "$Formula:" );
 	event->formula = get_sexp_main();
+	event->dependencies = sexp_get_dependencies(event->formula);
+	event->dependency_stamp = 0;
+	event->compiled_formula = sexp_compile(event->formula);
 
 	if (optional_string("+Name:")){
 		stuff_string(event->name, F_NAME, NAME_LENGTH);
@@ -4998,6 +5002,8 @@ void parse_goal(mission *pm)
 
 	required_string("$Formula:");
 	goalp->formula = get_sexp_main();
+	goalp->dependencies = sexp_get_dependencies(goalp->formula);
+	goalp->dependency_stamp = 0;
 
 	goalp->flags = 0;
 	if ( optional_string("+Invalid:") )
@@ -5089,7 +5095,7 @@ void parse_waypoints_and_jumpnodes(mission *pm)
 			jnp.SetVisibility(!hide);
 		}
 
-		Jump_nodes.push_back(std::move(jnp));
+		jumpnode_add(std::move(jnp));
 	}
 
 	while (required_string_either("#Messages", "$Name:"))
@@ -5609,6 +5615,7 @@ int parse_mission(mission *pm, int flags)
 	waypoint_parse_init();
 
 	Player_starts = Num_cargo = Num_goals = Num_wings = 0;
+	wing_name_index_clear();
 	Player_start_shipnum = -1;
 	*Player_start_shipname = 0;		// make the string 0 length for checking later
 	clear_texture_replacements();
@@ -1140,6 +1140,9 @@ inline void mc_info_init(mc_info *mc)
 	}
 */
 
+// model_collide() keeps all of its state in the mc_info and on the stack, so it may be called from several threads
+// at once (and from inside another query), as long as nothing modifies the models and model instances being checked
+// in the meantime.
 int model_collide(mc_info *mc_info_obj);
 void model_collide_parse_bsp(bsp_collision_tree *tree, void *model_ptr, int version);
 
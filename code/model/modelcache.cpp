@@ -0,0 +1,755 @@
+#include "model/modelcache.h"
+
+#include "bmpman/bmpman.h"
+#include "cfile/cfile.h"
+#include "cmdline/cmdline.h"
+#include "globalincs/systemvars.h"
+#include "model/model.h"
+#include "tracing/tracing.h"
+
+#include <algorithm>
+#include <ctime>
+#include <md5.h>
+
+// Must be increased whenever the layout of the file or of any of the stored structures (including the vertex format
+// of modelinterp.cpp) changes
+#define MODEL_CACHE_VERSION 1
+
+#define MODEL_CACHE_LOCATION (CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT)
+
+// Older models get the center and radius of their polygons computed while the octants are built, the collision trees
+// depend on those so these models always take the long way
+#define MODEL_CACHE_MIN_POF_VERSION 2003
+
+void model_interp_set_buffer_layout(vertex_layout *layout);
+void model_interp_process_shield_mesh(polymodel *pm);
+
+namespace {
+
+class cache_writer {
+	SCP_vector<ubyte>& _out;
+
+ public:
+	explicit cache_writer(SCP_vector<ubyte>& out) : _out(out) {}
+
+	void write_bytes(const void* data, size_t size) {
+		auto bytes = reinterpret_cast<const ubyte*>(data);
+		_out.insert(_out.end(), bytes, bytes + size);
+	}
+
+	template<typename T>
+	void write(const T& value) {
+		write_bytes(&value, sizeof(T));
+	}
+
+	template<typename T>
+	void patch(size_t pos, const T& value) {
+		memcpy(&_out[pos], &value, sizeof(T));
+	}
+
+	size_t tell() const { return _out.size(); }
+};
+
+class cache_reader {
+	const ubyte* _data;
+	size_t _size;
+	size_t _pos;
+	bool _ok = true;
+
+ public:
+	cache_reader(const SCP_vector<ubyte>& data, size_t pos) : _data(data.data()), _size(data.size()), _pos(pos) {}
+
+	// Returns nullptr if the file is too short. The data is not aligned so it has to be copied out.
+	const ubyte* read_bytes(size_t size) {
+		if (!_ok || _pos > _size || size > _size - _pos) {
+			_ok = false;
+			return nullptr;
+		}
+
+		auto data = _data + _pos;
+		_pos += size;
+		return data;
+	}
+
+	template<typename T>
+	bool read(T& value) {
+		auto data = read_bytes(sizeof(T));
+		if (data == nullptr) {
+			return false;
+		}
+
+		memcpy(&value, data, sizeof(T));
+		return true;
+	}
+
+	// Reads a count and makes sure that the file is large enough for that many elements
+	bool read_count(int& count, size_t element_size) {
+		if (!read(count) || count < 0 || (size_t)count > (_size - _pos) / MAX(element_size, (size_t)1)) {
+			_ok = false;
+			return false;
+		}
+		return true;
+	}
+
+	// Copies an array into a new allocation, empty arrays are returned as nullptr like the code that builds them does
+	template<typename T>
+	T* read_array(int count) {
+		auto data = read_bytes(sizeof(T) * count);
+		if (data == nullptr || count == 0) {
+			return nullptr;
+		}
+
+		auto array = (T*)vm_malloc(sizeof(T) * count);
+		memcpy(array, data, sizeof(T) * count);
+		return array;
+	}
+
+	bool ok() const { return _ok; }
+};
+
+bool submodel_has_collision_tree(const polymodel* pm, int submodel) {
+	return !(pm->submodel[submodel].nocollide_this_only || pm->submodel[submodel].no_collisions);
+}
+
+// The textures which are drawn from the shared vertex buffers
+SCP_vector<int> get_buffer_textures(const polymodel* pm) {
+	SCP_vector<int> textures;
+	for (int i = 0; i < pm->n_models; ++i) {
+		if (pm->submodel[i].is_thruster) {
+			continue;
+		}
+
+		for (auto& tex_buf : pm->submodel[i].buffer.tex_buf) {
+			if (std::find(textures.begin(), textures.end(), tex_buf.texture) == textures.end()) {
+				textures.push_back(tex_buf.texture);
+			}
+		}
+	}
+
+	return textures;
+}
+
+// The transparency index buffers are built by looking at the alpha channel of the base textures. Those can be replaced
+// without changing the POF so the vertex buffers of models with such textures are never taken from the cache.
+bool uses_alpha_textures(polymodel* pm, const SCP_vector<int>& textures) {
+	for (auto texture : textures) {
+		auto handle = pm->maps[texture].textures[TM_BASE_TYPE].GetTexture();
+		if (handle >= 0 && bm_has_alpha_channel(handle)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void write_vertex_buffer(cache_writer& out, const vertex_buffer& vb) {
+	out.write(vb.flags);
+	out.write((uint64_t)vb.stride);
+	out.write((uint64_t)vb.vertex_offset);
+	out.write((uint64_t)vb.vertex_num_offset);
+	out.write((ubyte)(vb.layout.get_num_vertex_components() > 0 ? 1 : 0));
+
+	out.write((int)vb.tex_buf.size());
+	for (auto& tex_buf : vb.tex_buf) {
+		out.write(tex_buf.flags);
+		out.write(tex_buf.texture);
+		out.write((uint64_t)tex_buf.n_verts);
+		out.write((uint64_t)tex_buf.index_offset);
+		out.write(tex_buf.i_first);
+		out.write(tex_buf.i_last);
+	}
+}
+
+bool read_vertex_buffer(cache_reader& in, vertex_buffer& vb, bool& has_layout) {
+	uint64_t stride, vertex_offset, vertex_num_offset;
+	ubyte layout;
+	int num_tex_bufs;
+
+	if (!in.read(vb.flags) || !in.read(stride) || !in.read(vertex_offset) || !in.read(vertex_num_offset)
+		|| !in.read(layout) || !in.read_count(num_tex_bufs, sizeof(int) * 2 + sizeof(uint64_t) * 2 + sizeof(uint) * 2)) {
+		return false;
+	}
+
+	vb.stride = (size_t)stride;
+	vb.vertex_offset = (size_t)vertex_offset;
+	vb.vertex_num_offset = (size_t)vertex_num_offset;
+	has_layout = layout != 0;
+
+	vb.tex_buf.resize(num_tex_bufs);
+	for (auto& tex_buf : vb.tex_buf) {
+		uint64_t n_verts, index_offset;
+
+		if (!in.read(tex_buf.flags) || !in.read(tex_buf.texture) || !in.read(n_verts) || !in.read(index_offset)
+			|| !in.read(tex_buf.i_first) || !in.read(tex_buf.i_last)) {
+			return false;
+		}
+
+		if (tex_buf.texture < 0 || tex_buf.texture >= MAX_MODEL_TEXTURES) {
+			return false;
+		}
+
+		tex_buf.n_verts = (size_t)n_verts;
+		tex_buf.index_offset = (size_t)index_offset;
+	}
+
+	return true;
+}
+
+void write_vertex_section(cache_writer& out, polymodel* pm, const model_cache* cache) {
+	auto textures = get_buffer_textures(pm);
+
+	if (!cache->captured_vertex_buffers || uses_alpha_textures(pm, textures)) {
+		out.write((ubyte)0);
+		return;
+	}
+	out.write((ubyte)1);
+
+	out.write((int)textures.size());
+	for (auto texture : textures) {
+		out.write(texture);
+	}
+
+	out.write((uint64_t)cache->stride);
+	out.write(pm->vert_source.Vertex_list_size);
+	out.write(pm->vert_source.Index_list_size);
+
+	out.write((int)cache->vertex_list.size());
+	out.write_bytes(cache->vertex_list.data(), cache->vertex_list.size());
+	out.write((int)cache->index_list.size());
+	out.write_bytes(cache->index_list.data(), cache->index_list.size());
+
+	for (int i = 0; i < pm->n_models; ++i) {
+		auto sm = &pm->submodel[i];
+
+		write_vertex_buffer(out, sm->buffer);
+		write_vertex_buffer(out, sm->trans_buffer);
+
+		out.write((int)sm->n_verts_outline);
+		out.write_bytes(sm->outline_buffer, sizeof(vertex) * sm->n_verts_outline);
+	}
+
+	for (int i = 0; i < pm->n_detail_levels; ++i) {
+		write_vertex_buffer(out, pm->detail_buffers[i]);
+	}
+}
+
+void write_octant_section(cache_writer& out, const polymodel* pm) {
+	auto bsp_data = pm->submodel[pm->detail[0]].bsp_data;
+
+	for (auto& oct : pm->octants) {
+		out.write(oct.min);
+		out.write(oct.max);
+
+		// The vertices point into the BSP data and the triangles into the shield
+		out.write(oct.nverts);
+		for (int i = 0; i < oct.nverts; ++i) {
+			out.write((int)(reinterpret_cast<ubyte*>(oct.verts[i]) - bsp_data));
+		}
+
+		out.write(oct.nshield_tris);
+		for (int i = 0; i < oct.nshield_tris; ++i) {
+			out.write((int)(oct.shield_tris[i] - pm->shield.tris));
+		}
+	}
+}
+
+void write_collision_section(cache_writer& out, const polymodel* pm) {
+	int count = 0;
+	for (int i = 0; i < pm->n_models; ++i) {
+		if (submodel_has_collision_tree(pm, i)) {
+			++count;
+		}
+	}
+	out.write(count);
+
+	for (int i = 0; i < pm->n_models; ++i) {
+		if (!submodel_has_collision_tree(pm, i)) {
+			continue;
+		}
+
+		auto tree = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+
+		// The length of the vertex list is not kept around but it is exactly what the leaves reference
+		int n_vert_list = 0;
+		for (int j = 0; j < tree->n_leaves; ++j) {
+			n_vert_list = MAX(n_vert_list, tree->leaf_list[j].vert_start + tree->leaf_list[j].num_verts);
+		}
+
+		out.write(i);
+
+		out.write(tree->n_verts);
+		out.write_bytes(tree->point_list, sizeof(vec3d) * tree->n_verts);
+		out.write(tree->n_nodes);
+		out.write_bytes(tree->node_list, sizeof(bsp_collision_node) * tree->n_nodes);
+		out.write(tree->n_leaves);
+		out.write_bytes(tree->leaf_list, sizeof(bsp_collision_leaf) * tree->n_leaves);
+		out.write(n_vert_list);
+		out.write_bytes(tree->vert_list, sizeof(model_tmap_vert) * n_vert_list);
+	}
+}
+
+bool read_cache_file(model_cache* cache) {
+	auto cfp = cfopen(cache->filename.c_str(), "rb", CFILE_NORMAL, CF_TYPE_CACHE, false, MODEL_CACHE_LOCATION);
+	if (cfp == nullptr) {
+		return false;
+	}
+
+	auto length = cfilelength(cfp);
+	cache->data.resize((size_t)MAX(length, 0));
+	bool read = cfread(cache->data.data(), 1, length, cfp) == length;
+	cfclose(cfp);
+
+	if (!read) {
+		return false;
+	}
+
+	cache_reader in(cache->data, 0);
+
+	char id[4] = { 0 };
+	int version = 0;
+	uint64_t size = 0, vertex_section = 0, octant_section = 0, collision_section = 0;
+
+	auto id_data = in.read_bytes(sizeof(id));
+	if (id_data != nullptr) {
+		memcpy(id, id_data, sizeof(id));
+	}
+	in.read(version);
+	in.read(size);
+	in.read(vertex_section);
+	in.read(octant_section);
+	in.read(collision_section);
+
+	// A truncated file, e.g. from a crash while it was written, is treated like a miss
+	if (!in.ok() || memcmp(id, "FSMC", sizeof(id)) != 0 || version != MODEL_CACHE_VERSION || size != cache->data.size()
+		|| vertex_section >= size || octant_section >= size || collision_section >= size) {
+		return false;
+	}
+
+	cache->vertex_section = (size_t)vertex_section;
+	cache->octant_section = (size_t)octant_section;
+	cache->collision_section = (size_t)collision_section;
+	return true;
+}
+
+}
+
+void model_cache_purge()
+{
+	SCP_vector<SCP_string> cache_files;
+	SCP_vector<file_list_info> file_info;
+	cf_get_file_list(cache_files, CF_TYPE_CACHE, "*.bin", CF_SORT_NONE, &file_info, MODEL_CACHE_LOCATION);
+
+	Assertion(cache_files.size() == file_info.size(),
+			  "cf_get_file_list returned different sizes for file names and file informations!");
+
+	const auto TIMEOUT = 2.0 * 30.0 * 24.0 * 60.0 * 60.0; // ~2 months in seconds
+	const SCP_string PREFIX = "model-";
+
+	auto now = std::time(nullptr);
+	for (size_t i = 0; i < cache_files.size(); ++i) {
+		if (cache_files[i].compare(0, PREFIX.size(), PREFIX) != 0) {
+			continue;
+		}
+
+		if (std::difftime(now, file_info[i].write_time) > TIMEOUT) {
+			cf_delete((cache_files[i] + ".bin").c_str(), CF_TYPE_CACHE, MODEL_CACHE_LOCATION);
+		}
+	}
+}
+
+void model_cache_begin(polymodel *pm, uint checksum, model_cache *cache)
+{
+	*cache = model_cache();
+
+	if (!Cmdline_model_cache || pm->version < MODEL_CACHE_MIN_POF_VERSION) {
+		return;
+	}
+
+	int params[] = { MODEL_CACHE_VERSION, (int)checksum, pm->version, Cmdline_normal, Is_standalone, pm->n_models,
+		pm->n_detail_levels, pm->shield.ntris, (int)sizeof(vertex), (int)sizeof(bsp_collision_node),
+		(int)sizeof(bsp_collision_leaf), (int)sizeof(model_tmap_vert) };
+
+	MD5 md5;
+	md5.update(pm->filename, (MD5::size_type)strlen(pm->filename));
+	md5.update(reinterpret_cast<const char*>(params), (MD5::size_type)sizeof(params));
+	for (int i = 0; i < pm->n_models; ++i) {
+		md5.update(reinterpret_cast<const char*>(&pm->submodel[i].bsp_data_size), (MD5::size_type)sizeof(int));
+	}
+	md5.finalize();
+
+	cache->enabled = true;
+	cache->filename = SCP_string("model-") + md5.hexdigest() + ".bin";
+	cache->loaded = read_cache_file(cache);
+
+	if (!cache->loaded) {
+		cache->data.clear();
+	}
+}
+
+void model_cache_capture_vertex_buffers(polymodel *pm, size_t stride, model_cache *cache)
+{
+	if (!cache->enabled || cache->loaded) {
+		return;
+	}
+
+	auto& src = pm->vert_source;
+
+	cache->stride = stride;
+	if (src.Vertex_list != nullptr) {
+		auto data = static_cast<const ubyte*>(src.Vertex_list);
+		cache->vertex_list.assign(data, data + src.Vertex_list_size);
+	}
+	if (src.Index_list != nullptr) {
+		auto data = static_cast<const ubyte*>(src.Index_list);
+		cache->index_list.assign(data, data + src.Index_list_size);
+	}
+
+	cache->captured_vertex_buffers = true;
+}
+
+bool model_cache_restore_vertex_buffers(polymodel *pm, model_cache *cache)
+{
+	Assertion(cache->loaded, "The model cache of %s has not been loaded!", pm->filename);
+
+	if (Is_standalone) {
+		return true;
+	}
+
+	TRACE_SCOPE(tracing::ModelCacheRestore);
+
+	cache_reader in(cache->data, cache->vertex_section);
+
+	ubyte present = 0;
+	if (!in.read(present) || present == 0) {
+		return false;
+	}
+
+	int num_textures;
+	if (!in.read_count(num_textures, sizeof(int))) {
+		return false;
+	}
+
+	SCP_vector<int> textures((size_t)num_textures);
+	for (auto& texture : textures) {
+		if (!in.read(texture) || texture < 0 || texture >= MAX_MODEL_TEXTURES) {
+			return false;
+		}
+	}
+
+	// The textures may have changed since the file was written
+	if (uses_alpha_textures(pm, textures)) {
+		return false;
+	}
+
+	uint64_t stride;
+	uint vertex_list_size, index_list_size;
+	int vertex_bytes, index_bytes;
+
+	in.read(stride);
+	in.read(vertex_list_size);
+	in.read(index_list_size);
+
+	if (!in.read_count(vertex_bytes, 1)) {
+		return false;
+	}
+	auto vertex_data = in.read_bytes((size_t)vertex_bytes);
+
+	if (!in.read_count(index_bytes, 1)) {
+		return false;
+	}
+	auto index_data = in.read_bytes((size_t)index_bytes);
+
+	if (!in.ok() || (vertex_bytes != 0 && (uint)vertex_bytes != vertex_list_size)
+		|| (index_bytes != 0 && (uint)index_bytes != index_list_size)) {
+		return false;
+	}
+
+	// Everything is read before the model is touched so that a broken file leaves nothing behind
+	size_t num_buffers = (size_t)(pm->n_models * 2 + pm->n_detail_levels);
+	SCP_vector<vertex_buffer> buffers(num_buffers);
+	SCP_vector<bool> has_layout(num_buffers);
+	SCP_vector<std::pair<const ubyte*, int>> outlines((size_t)pm->n_models);
+
+	size_t buffer_idx = 0;
+	for (int i = 0; i < pm->n_models; ++i) {
+		for (int j = 0; j < 2; ++j, ++buffer_idx) {
+			bool layout;
+			if (!read_vertex_buffer(in, buffers[buffer_idx], layout)) {
+				return false;
+			}
+			has_layout[buffer_idx] = layout;
+		}
+
+		if (!in.read_count(outlines[i].second, sizeof(vertex))) {
+			return false;
+		}
+		outlines[i].first = in.read_bytes(sizeof(vertex) * outlines[i].second);
+	}
+
+	for (int i = 0; i < pm->n_detail_levels; ++i, ++buffer_idx) {
+		bool layout;
+		if (!read_vertex_buffer(in, buffers[buffer_idx], layout)) {
+			return false;
+		}
+		has_layout[buffer_idx] = layout;
+	}
+
+	if (!in.ok()) {
+		return false;
+	}
+
+	auto restore_buffer = [&](vertex_buffer& dest, size_t idx) {
+		dest = buffers[idx];
+		if (has_layout[idx]) {
+			model_interp_set_buffer_layout(&dest.layout);
+		}
+	};
+
+	buffer_idx = 0;
+	for (int i = 0; i < pm->n_models; ++i) {
+		auto sm = &pm->submodel[i];
+
+		restore_buffer(sm->buffer, buffer_idx++);
+		restore_buffer(sm->trans_buffer, buffer_idx++);
+
+		if (outlines[i].second > 0) {
+			sm->n_verts_outline = (uint)outlines[i].second;
+			sm->outline_buffer = (vertex*)vm_malloc(sizeof(vertex) * sm->n_verts_outline);
+			memcpy(sm->outline_buffer, outlines[i].first, sizeof(vertex) * sm->n_verts_outline);
+		}
+	}
+
+	for (int i = 0; i < pm->n_detail_levels; ++i) {
+		restore_buffer(pm->detail_buffers[i], buffer_idx++);
+	}
+
+	auto& src = pm->vert_source;
+	src.Vertex_list_size = vertex_list_size;
+	src.Index_list_size = index_list_size;
+
+	if (vertex_bytes > 0) {
+		src.Vertex_list = vm_malloc((size_t)vertex_bytes);
+		memcpy(src.Vertex_list, vertex_data, (size_t)vertex_bytes);
+	}
+	if (index_bytes > 0) {
+		src.Index_list = vm_malloc((size_t)index_bytes);
+		memcpy(src.Index_list, index_data, (size_t)index_bytes);
+	}
+
+	pm->flags |= PM_FLAG_BATCHED;
+
+	model_interp_submit_buffers(&src, (size_t)stride);
+
+	model_interp_process_shield_mesh(pm);
+
+	return true;
+}
+
+bool model_cache_restore_octants(polymodel *pm, model_cache *cache)
+{
+	Assertion(cache->loaded, "The model cache of %s has not been loaded!", pm->filename);
+
+	TRACE_SCOPE(tracing::ModelCacheRestore);
+
+	cache_reader in(cache->data, cache->octant_section);
+
+	auto bsp_data = pm->submodel[pm->detail[0]].bsp_data;
+	auto bsp_data_size = pm->submodel[pm->detail[0]].bsp_data_size;
+
+	model_octant octants[8];
+	bool valid = true;
+
+	for (auto& oct : octants) {
+		oct.nverts = 0;
+		oct.verts = nullptr;
+		oct.nshield_tris = 0;
+		oct.shield_tris = nullptr;
+	}
+
+	for (auto& oct : octants) {
+		if (!in.read(oct.min) || !in.read(oct.max) || !in.read_count(oct.nverts, sizeof(int))) {
+			valid = false;
+			break;
+		}
+
+		if (oct.nverts > 0) {
+			oct.verts = (vec3d **)vm_malloc(sizeof(vec3d *) * oct.nverts);
+		}
+		for (int i = 0; i < oct.nverts && valid; ++i) {
+			int offset;
+			valid = in.read(offset) && offset >= 0 && offset + (int)sizeof(vec3d) <= bsp_data_size;
+			if (valid) {
+				oct.verts[i] = reinterpret_cast<vec3d*>(bsp_data + offset);
+			}
+		}
+
+		if (!valid || !in.read_count(oct.nshield_tris, sizeof(int))) {
+			valid = false;
+			break;
+		}
+
+		if (oct.nshield_tris > 0) {
+			oct.shield_tris = (shield_tri **)vm_malloc(sizeof(shield_tri *) * oct.nshield_tris);
+		}
+		for (int i = 0; i < oct.nshield_tris && valid; ++i) {
+			int index;
+			valid = in.read(index) && index >= 0 && index < pm->shield.ntris;
+			if (valid) {
+				oct.shield_tris[i] = &pm->shield.tris[index];
+			}
+		}
+
+		if (!valid) {
+			break;
+		}
+	}
+
+	if (!valid) {
+		for (auto& oct : octants) {
+			if (oct.verts != nullptr) {
+				vm_free(oct.verts);
+			}
+			if (oct.shield_tris != nullptr) {
+				vm_free(oct.shield_tris);
+			}
+		}
+		return false;
+	}
+
+	for (int i = 0; i < 8; ++i) {
+		pm->octants[i] = octants[i];
+	}
+
+	return true;
+}
+
+bool model_cache_restore_collision_trees(polymodel *pm, model_cache *cache)
+{
+	Assertion(cache->loaded, "The model cache of %s has not been loaded!", pm->filename);
+
+	TRACE_SCOPE(tracing::ModelCacheRestore);
+
+	cache_reader in(cache->data, cache->collision_section);
+
+	int count;
+	if (!in.read_count(count, sizeof(int))) {
+		return false;
+	}
+
+	bool valid = true;
+	int next = 0;
+
+	for (int i = 0; i < pm->n_models && valid; ++i) {
+		if (!submodel_has_collision_tree(pm, i)) {
+			continue;
+		}
+
+		int submodel, n_verts, n_nodes, n_leaves, n_vert_list;
+
+		valid = next++ < count && in.read(submodel) && submodel == i;
+		if (!valid) {
+			break;
+		}
+
+		pm->submodel[i].collision_tree_index = model_create_bsp_collision_tree();
+		auto tree = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+
+		tree->point_list = nullptr;
+		tree->node_list = nullptr;
+		tree->leaf_list = nullptr;
+		tree->vert_list = nullptr;
+		tree->n_verts = tree->n_nodes = tree->n_leaves = 0;
+
+		valid = in.read_count(n_verts, sizeof(vec3d));
+		if (valid) {
+			tree->n_verts = n_verts;
+			tree->point_list = in.read_array<vec3d>(n_verts);
+		}
+
+		valid = valid && in.read_count(n_nodes, sizeof(bsp_collision_node));
+		if (valid) {
+			tree->n_nodes = n_nodes;
+			tree->node_list = in.read_array<bsp_collision_node>(n_nodes);
+		}
+
+		valid = valid && in.read_count(n_leaves, sizeof(bsp_collision_leaf));
+		if (valid) {
+			tree->n_leaves = n_leaves;
+			tree->leaf_list = in.read_array<bsp_collision_leaf>(n_leaves);
+		}
+
+		valid = valid && in.read_count(n_vert_list, sizeof(model_tmap_vert));
+		if (valid) {
+			tree->vert_list = in.read_array<model_tmap_vert>(n_vert_list);
+		}
+
+		for (int j = 0; j < tree->n_leaves && valid; ++j) {
+			auto leaf = &tree->leaf_list[j];
+			valid = leaf->vert_start >= 0 && leaf->vert_start + leaf->num_verts <= n_vert_list;
+		}
+	}
+
+	if (valid && next == count) {
+		return true;
+	}
+
+	for (int i = 0; i < pm->n_models; ++i) {
+		if (pm->submodel[i].collision_tree_index >= 0) {
+			model_remove_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+			pm->submodel[i].collision_tree_index = -1;
+		}
+	}
+
+	return false;
+}
+
+void model_cache_store(polymodel *pm, model_cache *cache)
+{
+	if (!cache->enabled || cache->loaded) {
+		return;
+	}
+
+	TRACE_SCOPE(tracing::ModelCacheStore);
+
+	SCP_vector<ubyte> data;
+	cache_writer out(data);
+
+	out.write_bytes("FSMC", 4);
+	out.write((int)MODEL_CACHE_VERSION);
+
+	auto header = out.tell();
+	out.write((uint64_t)0);		// size
+	out.write((uint64_t)0);		// vertex section
+	out.write((uint64_t)0);		// octant section
+	out.write((uint64_t)0);		// collision section
+
+	out.patch(header + sizeof(uint64_t), (uint64_t)out.tell());
+	write_vertex_section(out, pm, cache);
+
+	out.patch(header + sizeof(uint64_t) * 2, (uint64_t)out.tell());
+	write_octant_section(out, pm);
+
+	out.patch(header + sizeof(uint64_t) * 3, (uint64_t)out.tell());
+	write_collision_section(out, pm);
+
+	out.patch(header, (uint64_t)out.tell());
+
+	// The captured buffers are not needed anymore
+	cache->vertex_list.clear();
+	cache->index_list.clear();
+
+	auto cfp = cfopen(cache->filename.c_str(), "wb", CFILE_NORMAL, CF_TYPE_CACHE, false, MODEL_CACHE_LOCATION);
+	if (cfp == nullptr) {
+		mprintf(("Could not open model cache file '%s'!\n", cache->filename.c_str()));
+		return;
+	}
+
+	bool written = cfwrite(data.data(), 1, (int)data.size(), cfp) == (int)data.size();
+
+	cfclose(cfp);
+
+	if (!written) {
+		mprintf(("Failed to write model cache file '%s'!\n", cache->filename.c_str()));
+		cf_delete(cache->filename.c_str(), CF_TYPE_CACHE, MODEL_CACHE_LOCATION);
+	}
+}
@@ -0,0 +1,91 @@
+#ifndef _MODELCACHE_H
+#define _MODELCACHE_H
+
+#include "globalincs/pstypes.h"
+
+class polymodel;
+
+/** @file
+ *  @brief An on-disk cache of the data which is built from a POF file after it has been parsed
+ *
+ * With -model_cache the vertex and index buffers, the octants and the collision trees of a model are written to a file
+ * in the cache directory the first time the model is loaded. The next load restores them from that file instead of
+ * walking the BSP data again. Everything is stored as offsets into the model so the loaded data only needs to be fixed
+ * up, not rebuilt.
+ *
+ * The name of a cache file is a hash of the POF and of everything else which changes the result, so a changed model
+ * never matches an old entry.
+ */
+
+/**
+ * @brief The cache state of one model while it is being loaded
+ */
+struct model_cache {
+	// Set if the model uses the cache at all
+	bool enabled = false;
+
+	// Set if a valid cache file was read, the restore functions may only be called then
+	bool loaded = false;
+
+	SCP_string filename;
+
+	// The contents of the cache file
+	SCP_vector<ubyte> data;
+	size_t vertex_section = 0;
+	size_t octant_section = 0;
+	size_t collision_section = 0;
+
+	// The vertex and index data of a model which was not in the cache. Those are handed to the GPU and freed by
+	// create_vertex_buffer() so they have to be copied before that happens.
+	bool captured_vertex_buffers = false;
+	size_t stride = 0;
+	SCP_vector<ubyte> vertex_list;
+	SCP_vector<ubyte> index_list;
+};
+
+/**
+ * @brief Deletes cache files which have not been written for a while
+ */
+void model_cache_purge();
+
+/**
+ * @brief Looks up the cache file of a model which has just been read
+ *
+ * @param pm The model, read_model_file() must have been called on it
+ * @param checksum The checksum of the POF file
+ * @param cache Receives the state of the cache
+ */
+void model_cache_begin(polymodel *pm, uint checksum, model_cache *cache);
+
+/**
+ * @brief Copies the vertex and index data of a model before it is submitted
+ */
+void model_cache_capture_vertex_buffers(polymodel *pm, size_t stride, model_cache *cache);
+
+/**
+ * @brief Restores and submits the vertex buffers of a model
+ *
+ * @return @c false if the buffers have to be built from the BSP data
+ */
+bool model_cache_restore_vertex_buffers(polymodel *pm, model_cache *cache);
+
+/**
+ * @brief Restores the octants of a model
+ *
+ * @return @c false if the octants have to be built from the BSP data
+ */
+bool model_cache_restore_octants(polymodel *pm, model_cache *cache);
+
+/**
+ * @brief Restores the collision trees of all submodels of a model
+ *
+ * @return @c false if the trees have to be built from the BSP data
+ */
+bool model_cache_restore_collision_trees(polymodel *pm, model_cache *cache);
+
+/**
+ * @brief Writes the cache file of a model which was built from the BSP data
+ */
+void model_cache_store(polymodel *pm, model_cache *cache);
+
+#endif // _MODELCACHE_H
@@ -26,59 +26,32 @@
 #define TOL		1E-4
 #define DIST_TOL	1.0
 
-// Some global variables that get set by model_collide and are used internally for
-// checking a collision rather than passing a bunch of parameters around. These are
-// not persistant between calls to model_collide
+// All the state of a single model_collide() query.  Each call to model_collide() sets one of these up on its own
+// stack and passes it down to the routines that check the individual submodels, polygons and shield triangles,
+// so any number of queries can run at the same time and a query can be started from inside another one.
+typedef struct mc_context {
+	mc_info		*mc;			// The mc_info passed into model_collide
 
-static mc_info		*Mc;				// The mc_info passed into model_collide
-	
-static polymodel	*Mc_pm;			// The polygon model we're checking
-static int			Mc_submodel;	// The current submodel we're checking
-
-static polymodel_instance *Mc_pmi;
-
-static matrix		Mc_orient;		// A matrix to rotate a world point into the current
-											// submodel's frame of reference.
-static vec3d		Mc_base;			// A point used along with Mc_orient.
-
-static vec3d		Mc_p0;			// The ray origin rotated into the current submodel's frame of reference
-static vec3d		Mc_p1;			// The ray end rotated into the current submodel's frame of reference
-static float		Mc_mag;			// The length of the ray
-static vec3d		Mc_direction;	// A vector from the ray's origin to its end, in the current submodel's frame of reference
-
-static vec3d 		**Mc_point_list = NULL;		// A pointer to the current submodel's vertex list
-
-static float		Mc_edge_time;
-
-
-void model_collide_free_point_list()
-{
-	if (Mc_point_list != NULL) {
-		vm_free(Mc_point_list);
-		Mc_point_list = NULL;
-	}
-}
+	polymodel	*pm;			// The polygon model we're checking
+	int			submodel;		// The current submodel we're checking
 
-// allocate the point list
-// NOTE: SHOULD ONLY EVER BE CALLED FROM model_allocate_interp_data()!!!
-void model_collide_allocate_point_list(int n_points)
-{
-	Assert( n_points > 0 );
+	polymodel_instance *pmi;
 
-	if (Mc_point_list != NULL) {
-		vm_free(Mc_point_list);
-		Mc_point_list = NULL;
-	}
+	matrix		orient;			// A matrix to rotate a world point into the current
+								// submodel's frame of reference.
+	vec3d		base;			// A point used along with orient.
 
-	Mc_point_list = (vec3d**) vm_malloc( sizeof(vec3d *) * n_points );
+	vec3d		p0;				// The ray origin rotated into the current submodel's frame of reference
+	vec3d		p1;				// The ray end rotated into the current submodel's frame of reference
+	float		mag;			// The length of the ray
+	vec3d		direction;		// A vector from the ray's origin to its end, in the current submodel's frame of reference
+} mc_context;
 
-	Verify( Mc_point_list != NULL );
-}
 
 // Returns non-zero if vector from p0 to pdir 
 // intersects the bounding box.
 // hitpos could be NULL, so don't fill it if it is.
-int mc_ray_boundingbox( vec3d *min, vec3d *max, vec3d * p0, vec3d *pdir, vec3d *hitpos )
+static int mc_ray_boundingbox( mc_context *ctx, vec3d *min, vec3d *max, vec3d * p0, vec3d *pdir, vec3d *hitpos )
 {
 
 	vec3d tmp_hitpos;
@@ -87,19 +60,19 @@ int mc_ray_boundingbox( vec3d *min, vec3d *max, vec3d * p0, vec3d *pdir, vec3d *
 	}
 
 
-	if ( Mc->flags & MC_CHECK_SPHERELINE )	{
+	if ( ctx->mc->flags & MC_CHECK_SPHERELINE )	{
 
 		// In the case of a sphere, just increase the size of the box by the radius 
 		// of the sphere in all directions.
 
 		vec3d sphere_mod_min, sphere_mod_max;
 
-		sphere_mod_min.xyz.x = min->xyz.x - Mc->radius;
-		sphere_mod_max.xyz.x = max->xyz.x + Mc->radius;
-		sphere_mod_min.xyz.y = min->xyz.y - Mc->radius;
-		sphere_mod_max.xyz.y = max->xyz.y + Mc->radius;
-		sphere_mod_min.xyz.z = min->xyz.z - Mc->radius;
-		sphere_mod_max.xyz.z = max->xyz.z + Mc->radius;
+		sphere_mod_min.xyz.x = min->xyz.x - ctx->mc->radius;
+		sphere_mod_max.xyz.x = max->xyz.x + ctx->mc->radius;
+		sphere_mod_min.xyz.y = min->xyz.y - ctx->mc->radius;
+		sphere_mod_max.xyz.y = max->xyz.y + ctx->mc->radius;
+		sphere_mod_min.xyz.z = min->xyz.z - ctx->mc->radius;
+		sphere_mod_max.xyz.z = max->xyz.z + ctx->mc->radius;
 
 		return fvi_ray_boundingbox( &sphere_mod_min, &sphere_mod_max, p0, pdir, hitpos );
 	} else {
@@ -119,9 +92,9 @@ int mc_ray_boundingbox( vec3d *min, vec3d *max, vec3d * p0, vec3d *pdir, vec3d *
 // ntmap -- The tmap index into the model's textures array.
 //
 // detects whether or not a vector has collided with a polygon.  vector points stored in global
-// Mc_p0 and Mc_p1.  Results stored in global mc_info * Mc.
+// ctx->p0 and ctx->p1.  Results stored in ctx->mc.
 
-static void mc_check_face(int nv, vec3d **verts, vec3d *plane_pnt, vec3d *plane_norm, uv_pair *uvl_list, int ntmap, ubyte *poly, bsp_collision_leaf* bsp_leaf)
+static void mc_check_face(mc_context *ctx, int nv, vec3d **verts, vec3d *plane_pnt, vec3d *plane_norm, uv_pair *uvl_list, int ntmap, ubyte *poly, bsp_collision_leaf* bsp_leaf)
 {
 	vec3d	hit_point;
 	float		dist;
@@ -129,55 +102,55 @@ static void mc_check_face(int nv, vec3d **verts, vec3d *plane_pnt, vec3d *plane_
 
 	// Check to see if poly is facing away from ray.  If so, don't bother
 	// checking it.
-	if (vm_vec_dot(&Mc_direction,plane_norm) > 0.0f)	{
+	if (vm_vec_dot(&ctx->direction,plane_norm) > 0.0f)	{
 		return;
 	}
 
 	// Find the intersection of this ray with the plane that the poly
-	dist = fvi_ray_plane(NULL, plane_pnt, plane_norm, &Mc_p0, &Mc_direction, 0.0f);
+	dist = fvi_ray_plane(NULL, plane_pnt, plane_norm, &ctx->p0, &ctx->direction, 0.0f);
 
 	if ( dist < 0.0f ) return; // If the ray is behind the plane there is no collision
-	if ( !(Mc->flags & MC_CHECK_RAY) && (dist > 1.0f) ) return; // The ray isn't long enough to intersect the plane
+	if ( !(ctx->mc->flags & MC_CHECK_RAY) && (dist > 1.0f) ) return; // The ray isn't long enough to intersect the plane
 
 	// If the ray hits, but a closer intersection has already been found, return
-	if ( Mc->num_hits && (dist >= Mc->hit_dist ) ) return;	
+	if ( ctx->mc->num_hits && (dist >= ctx->mc->hit_dist ) ) return;	
 
 	// Find the hit point
-	vm_vec_scale_add( &hit_point, &Mc_p0, &Mc_direction, dist );
+	vm_vec_scale_add( &hit_point, &ctx->p0, &ctx->direction, dist );
 	
 	// Check to see if the point of intersection is on the plane.  If so, this
 	// also finds the uv's where the ray hit.
 	if ( fvi_point_face(&hit_point, nv, verts, plane_norm, &u,&v, uvl_list ) )	{
-		Mc->hit_dist = dist;
+		ctx->mc->hit_dist = dist;
 
-		Mc->hit_point = hit_point;
-		Mc->hit_submodel = Mc_submodel;
+		ctx->mc->hit_point = hit_point;
+		ctx->mc->hit_submodel = ctx->submodel;
 
-		Mc->hit_normal = *plane_norm;
+		ctx->mc->hit_normal = *plane_norm;
 
 		if ( uvl_list )	{
-			Mc->hit_u = u;
-			Mc->hit_v = v;
+			ctx->mc->hit_u = u;
+			ctx->mc->hit_v = v;
 			if ( ntmap < 0 ) {
-				Mc->hit_bitmap = -1;
+				ctx->mc->hit_bitmap = -1;
 			} else {
-				Mc->hit_bitmap = Mc_pm->maps[ntmap].textures[TM_BASE_TYPE].GetTexture();			
+				ctx->mc->hit_bitmap = ctx->pm->maps[ntmap].textures[TM_BASE_TYPE].GetTexture();			
 			}
 		}
 		
 		if(ntmap >= 0){
-			Mc->t_poly = poly;
-			Mc->f_poly = NULL;
+			ctx->mc->t_poly = poly;
+			ctx->mc->f_poly = NULL;
 		} else {
-			Mc->t_poly = NULL;
-			Mc->f_poly = poly;
+			ctx->mc->t_poly = NULL;
+			ctx->mc->f_poly = poly;
 		}
 
-		Mc->bsp_leaf = bsp_leaf;
+		ctx->mc->bsp_leaf = bsp_leaf;
 
 //		mprintf(( "Bing!\n" ));
 
-		Mc->num_hits++;
+		ctx->mc->num_hits++;
 	}
 }
 
@@ -189,7 +162,7 @@ static void mc_check_face(int nv, vec3d **verts, vec3d *plane_pnt, vec3d *plane_
 //				plane_pnt	=>		center point in plane (about which radius is measured)
 //				face_rad		=>		radius of face 
 //				plane_norm	=>		normal of face
-static void mc_check_sphereline_face( int nv, vec3d ** verts, vec3d * plane_pnt, vec3d * plane_norm, uv_pair * uvl_list, int ntmap, ubyte *poly, bsp_collision_leaf *bsp_leaf)
+static void mc_check_sphereline_face( mc_context *ctx, int nv, vec3d ** verts, vec3d * plane_pnt, vec3d * plane_norm, uv_pair * uvl_list, int ntmap, ubyte *poly, bsp_collision_leaf *bsp_leaf)
 {
 	vec3d	hit_point;
 	float		u, v;
@@ -202,12 +175,12 @@ static void mc_check_sphereline_face( int nv, vec3d ** verts, vec3d * plane_pnt,
 	// Check to see if poly is facing away from ray.  If so, don't bother
 	// checking it.
 
-	if (vm_vec_dot(&Mc_direction,plane_norm) > 0.0f)	{
+	if (vm_vec_dot(&ctx->direction,plane_norm) > 0.0f)	{
 		return;
 	}
 
 	// Find the intersection of this sphere with the plane of the poly
-	if ( !fvi_sphere_plane( &hit_point, &Mc_p0, &Mc_direction, Mc->radius, plane_norm, plane_pnt, &face_t, &delta_t ) ) {
+	if ( !fvi_sphere_plane( &hit_point, &ctx->p0, &ctx->direction, ctx->mc->radius, plane_norm, plane_pnt, &face_t, &delta_t ) ) {
 		return;
 	}
 
@@ -224,7 +197,7 @@ static void mc_check_sphereline_face( int nv, vec3d ** verts, vec3d * plane_pnt,
 	}
 
 	// If the ray hits, but a closer intersection has already been found, don't check face
-	if ( Mc->num_hits && (face_t >= Mc->hit_dist ) ) {
+	if ( ctx->mc->num_hits && (face_t >= ctx->mc->hit_dist ) ) {
 		check_face = 0;		// The ray isn't long enough to intersect the plane
 	}
 
@@ -243,43 +216,43 @@ static void mc_check_sphereline_face( int nv, vec3d ** verts, vec3d * plane_pnt,
 		// If this is within the collision window, check to see if we hit a face
 		if ( fvi_point_face(&hit_point, nv, verts, plane_norm, &u, &v, uvl_list) ) {
 
-			Mc->hit_dist = face_t;		
-			Mc->hit_point = hit_point;
-			Mc->hit_normal = *plane_norm;
-			Mc->hit_submodel = Mc_submodel;			
-			Mc->edge_hit = 0;
+			ctx->mc->hit_dist = face_t;		
+			ctx->mc->hit_point = hit_point;
+			ctx->mc->hit_normal = *plane_norm;
+			ctx->mc->hit_submodel = ctx->submodel;			
+			ctx->mc->edge_hit = 0;
 
 			if ( uvl_list )	{
-				Mc->hit_u = u;
-				Mc->hit_v = v;
+				ctx->mc->hit_u = u;
+				ctx->mc->hit_v = v;
 				if ( ntmap < 0 ) {
-					Mc->hit_bitmap = -1;
+					ctx->mc->hit_bitmap = -1;
 				} else {
-					Mc->hit_bitmap = Mc_pm->maps[ntmap].textures[TM_BASE_TYPE].GetTexture();			
+					ctx->mc->hit_bitmap = ctx->pm->maps[ntmap].textures[TM_BASE_TYPE].GetTexture();			
 				}
 			}
 
 			if(ntmap >= 0){
-				Mc->t_poly = poly;
-				Mc->f_poly = NULL;
+				ctx->mc->t_poly = poly;
+				ctx->mc->f_poly = NULL;
 			} else {
-				Mc->t_poly = NULL;
-				Mc->f_poly = poly;
+				ctx->mc->t_poly = NULL;
+				ctx->mc->f_poly = poly;
 			}
 
-			Mc->bsp_leaf = bsp_leaf;
+			ctx->mc->bsp_leaf = bsp_leaf;
 
-			Mc->num_hits++;
+			ctx->mc->num_hits++;
 			check_edges = 0;
 			/*
-			vm_vec_scale_add( &temp_sphere, &Mc_p0, &Mc_direction, Mc->hit_dist );
+			vm_vec_scale_add( &temp_sphere, &ctx->p0, &ctx->direction, ctx->mc->hit_dist );
 			temp_dist = vm_vec_dist( &temp_sphere, &hit_point );
-			if ( (temp_dist - DIST_TOL > Mc->radius) || (temp_dist + DIST_TOL < Mc->radius) ) {
+			if ( (temp_dist - DIST_TOL > ctx->mc->radius) || (temp_dist + DIST_TOL < ctx->mc->radius) ) {
 				// get Andsager
-				//mprintf(("Estimated radius error: Estimate %f, actual %f Mc->radius\n", temp_dist, Mc->radius));
+				//mprintf(("Estimated radius error: Estimate %f, actual %f ctx->mc->radius\n", temp_dist, ctx->mc->radius));
 			}
 			vm_vec_sub( &temp_dir, &hit_point, &temp_sphere );
-			// Assert( vm_vec_dot( &temp_dir, &Mc_direction ) > 0 );
+			// Assert( vm_vec_dot( &temp_dir, &ctx->direction ) > 0 );
 			*/
 		}
 	}
@@ -295,49 +268,49 @@ static void mc_check_sphereline_face( int nv, vec3d ** verts, vec3d * plane_pnt,
 		// PUT TEST HERE
 
 		// check each edge to see if we hit, find the closest edge
-		// Mc->hit_dist stores the best edge time of *all* faces
+		// ctx->mc->hit_dist stores the best edge time of *all* faces
 		float sphere_time;
-		if ( fvi_polyedge_sphereline(&hit_point, &Mc_p0, &Mc_direction, Mc->radius, nv, verts, &sphere_time)) {
+		if ( fvi_polyedge_sphereline(&hit_point, &ctx->p0, &ctx->direction, ctx->mc->radius, nv, verts, &sphere_time)) {
 			Assert( sphere_time >= 0.0f );
 			/*
-			vm_vec_scale_add( &temp_sphere, &Mc_p0, &Mc_direction, sphere_time );
+			vm_vec_scale_add( &temp_sphere, &ctx->p0, &ctx->direction, sphere_time );
 			temp_dist = vm_vec_dist( &temp_sphere, &hit_point );
-			if ( (temp_dist - DIST_TOL > Mc->radius) || (temp_dist + DIST_TOL < Mc->radius) ) {
+			if ( (temp_dist - DIST_TOL > ctx->mc->radius) || (temp_dist + DIST_TOL < ctx->mc->radius) ) {
 				// get Andsager
-				//mprintf(("Estimated radius error: Estimate %f, actual %f Mc->radius\n", temp_dist, Mc->radius));
+				//mprintf(("Estimated radius error: Estimate %f, actual %f ctx->mc->radius\n", temp_dist, ctx->mc->radius));
 			}
 			vm_vec_sub( &temp_dir, &hit_point, &temp_sphere );
-//			Assert( vm_vec_dot( &temp_dir, &Mc_direction ) > 0 );
+//			Assert( vm_vec_dot( &temp_dir, &ctx->direction ) > 0 );
 			*/
 
-			if ( (Mc->num_hits==0) || (sphere_time < Mc->hit_dist) ) {
+			if ( (ctx->mc->num_hits==0) || (sphere_time < ctx->mc->hit_dist) ) {
 				// This is closer than best so far
-				Mc->hit_dist = sphere_time;
-				Mc->hit_point = hit_point;
-				Mc->hit_submodel = Mc_submodel;
-				Mc->edge_hit = 1;
+				ctx->mc->hit_dist = sphere_time;
+				ctx->mc->hit_point = hit_point;
+				ctx->mc->hit_submodel = ctx->submodel;
+				ctx->mc->edge_hit = 1;
 				if ( ntmap < 0 ) {
-					Mc->hit_bitmap = -1;
+					ctx->mc->hit_bitmap = -1;
 				} else {
-					Mc->hit_bitmap = Mc_pm->maps[ntmap].textures[TM_BASE_TYPE].GetTexture();			
+					ctx->mc->hit_bitmap = ctx->pm->maps[ntmap].textures[TM_BASE_TYPE].GetTexture();			
 				}
 
 				if(ntmap >= 0){
-					Mc->t_poly = poly;
-					Mc->f_poly = NULL;
+					ctx->mc->t_poly = poly;
+					ctx->mc->f_poly = NULL;
 				} else {
-					Mc->t_poly = NULL;
-					Mc->f_poly = poly;
+					ctx->mc->t_poly = NULL;
+					ctx->mc->f_poly = poly;
 				}
 
-				Mc->num_hits++;
+				ctx->mc->num_hits++;
 
 			//	nprintf(("Physics", "edge sphere time: %f, normal: (%f, %f, %f) hit_point: (%f, %f, %f)\n", sphere_time,
-			//		Mc->hit_normal.xyz.x, Mc->hit_normal.xyz.y, Mc->hit_normal.xyz.z,
+			//		ctx->mc->hit_normal.xyz.x, ctx->mc->hit_normal.xyz.y, ctx->mc->hit_normal.xyz.z,
 			//		hit_point.xyz.x, hit_point.xyz.y, hit_point.xyz.z));
 			} else  {	// Not best so far
-				Assert(Mc->num_hits>0);
-				Mc->num_hits++;
+				Assert(ctx->mc->num_hits>0);
+				ctx->mc->num_hits++;
 			}
 		}
 	}
@@ -352,7 +325,7 @@ static void mc_check_sphereline_face( int nv, vec3d ** verts, vec3d * plane_pnt,
 // +16     int         offset from start of chunk to vertex data
 // +20     n_verts*char    norm_counts
 // +offset             vertex data. Each vertex n is a point followed by norm_counts[n] normals.     
-void model_collide_defpoints(ubyte * p)
+static int model_collide_parse_bsp_defpoints(ubyte * p, SCP_vector<vec3d*> *point_list)
 {
 	int n;
 	int nverts = w(p+8);	
@@ -360,31 +333,11 @@ void model_collide_defpoints(ubyte * p)
 
 	ubyte * normcount = p+20;
 	vec3d *src = vp(p+offset);
-	
-	Assert( Mc_point_list != NULL );
 
-	for (n=0; n<nverts; n++ ) {
-		Mc_point_list[n] = src;
-
-		src += normcount[n]+1;
-	} 
-}
-
-int model_collide_parse_bsp_defpoints(ubyte * p)
-{
-	int n;
-	int nverts = w(p+8);	
-	int offset = w(p+16);	
-
-	ubyte * normcount = p+20;
-	vec3d *src = vp(p+offset);
-
-	model_collide_allocate_point_list(nverts);
-
-	Assert( Mc_point_list != NULL );
+	point_list->clear();
 
 	for (n=0; n<nverts; n++ ) {
-		Mc_point_list[n] = src;
+		point_list->push_back(src);
 
 		src += normcount[n]+1;
 	} 
@@ -392,185 +345,7 @@ int model_collide_parse_bsp_defpoints(ubyte * p)
 	return nverts;
 }
 
-// Flat Poly
-// +0      int         id
-// +4      int         size 
-// +8      vec3d      normal
-// +20     vec3d      center
-// +32     float       radius
-// +36     int         nverts
-// +40     byte        red
-// +41     byte        green
-// +42     byte        blue
-// +43     byte        pad
-// +44     nverts*int  vertlist
-void model_collide_flatpoly(ubyte * p)
-{
-	int i;
-	int nv;
-	vec3d *points[TMAP_MAX_VERTS];
-	short *verts;
-
-	nv = w(p+36);
-
-	if ( nv <= 0 )
-		return;
-
-	if ( nv > TMAP_MAX_VERTS ) {
-		Int3();
-		return;
-	}
-
-	verts = (short *)(p+44);
-
-	for (i=0;i<nv;i++)	{
-		points[i] = Mc_point_list[verts[i*2]];
-	}
-
-	if ( Mc->flags & MC_CHECK_SPHERELINE )	{
-		mc_check_sphereline_face(nv, points, vp(p+20), vp(p+8), NULL, -1, p, NULL);
-	} else {
-		mc_check_face(nv, points, vp(p+20), vp(p+8), NULL, -1, p, NULL);
-	}
-}
-
-
-// Textured Poly
-// +0      int         id
-// +4      int         size 
-// +8      vec3d      normal
-// +20     vec3d      normal_point
-// +32     int         tmp = 0
-// +36     int         nverts
-// +40     int         tmap_num
-// +44     nverts*(model_tmap_vert) vertlist (n,u,v)
-void model_collide_tmappoly(ubyte * p)
-{
-	int i;
-	int nv;
-	uv_pair uvlist[TMAP_MAX_VERTS];
-	vec3d *points[TMAP_MAX_VERTS];
-	model_tmap_vert *verts;
-
-	nv = w(p+36);
-
-	if ( nv <= 0 )
-		return;
-
-	if ( nv > TMAP_MAX_VERTS ) {
-		Int3();
-		return;
-	}
-
-	int tmap_num = w(p+40);
-	Assert(tmap_num >= 0 && tmap_num < MAX_MODEL_TEXTURES);	// Goober5000
-
-	if ( (!(Mc->flags & MC_CHECK_INVISIBLE_FACES)) && (Mc_pm->maps[tmap_num].textures[TM_BASE_TYPE].GetTexture() < 0) )	{
-		// Don't check invisible polygons.
-		//SUSHI: Unless $collide_invisible is set.
-		if (!(Mc_pm->submodel[Mc_submodel].collide_invisible))
-			return;
-	}
-
-	verts = (model_tmap_vert *)(p+44);
-
-	for (i=0;i<nv;i++)	{
-		points[i] = Mc_point_list[verts[i].vertnum];
-		uvlist[i].u = verts[i].u;
-		uvlist[i].v = verts[i].v;
-	}
-
-	if ( Mc->flags & MC_CHECK_SPHERELINE )	{
-		mc_check_sphereline_face(nv, points, vp(p+20), vp(p+8), uvlist, tmap_num, p, NULL);
-	} else {
-		mc_check_face(nv, points, vp(p+20), vp(p+8), uvlist, tmap_num, p, NULL);
-	}
-}
-
-
-// Sortnorms
-// +0      int         id
-// +4      int         size 
-// +8      vec3d      normal
-// +20     vec3d      center
-// +32     float       radius
-// 36     int     front offset
-// 40     int     back offset
-// 44     int     prelist offset
-// 48     int     postlist offset
-// 52     int     online offset
-
-int model_collide_sub( void *model_ptr );
-
-void model_collide_sortnorm(ubyte * p)
-{
-	int frontlist = w(p+36);
-	int backlist = w(p+40);
-	int prelist = w(p+44);
-	int postlist = w(p+48);
-	int onlist = w(p+52);
-	vec3d hitpos;
-
-	if ( Mc_pm->version >= 2000 )	{
-		if ( mc_ray_boundingbox( vp(p+56), vp(p+68), &Mc_p0, &Mc_direction, &hitpos) )	{
-			if ( !(Mc->flags & MC_CHECK_RAY) && (vm_vec_dist(&hitpos, &Mc_p0) > Mc_mag) ) {
-				return;
-			}
-		} else {
-			return;
-		}
-	}
-
-	if (prelist) model_collide_sub(p+prelist);
-	if (backlist) model_collide_sub(p+backlist);
-	if (onlist) model_collide_sub(p+onlist);
-	if (frontlist) model_collide_sub(p+frontlist);
-	if (postlist) model_collide_sub(p+postlist);
-}
-
-//calls the object interpreter to render an object.  The object renderer
-//is really a seperate pipeline. returns true if drew
-int model_collide_sub(void *model_ptr )
-{
-	ubyte *p = (ubyte *)model_ptr;
-	int chunk_type, chunk_size;
-	vec3d hitpos;
-
-	chunk_type = w(p);
-	chunk_size = w(p+4);
-
-	while (chunk_type != OP_EOF)	{
-
-//		mprintf(( "Processing chunk type %d, len=%d\n", chunk_type, chunk_size ));
-
-		switch (chunk_type) {
-		case OP_DEFPOINTS:	model_collide_defpoints(p); break;
-		case OP_FLATPOLY:		model_collide_flatpoly(p); break;
-		case OP_TMAPPOLY:		model_collide_tmappoly(p); break;
-		case OP_SORTNORM:		model_collide_sortnorm(p); break;
-		case OP_BOUNDBOX:	
-			if ( mc_ray_boundingbox( vp(p+8), vp(p+20), &Mc_p0, &Mc_direction, &hitpos ) )	{
-				if ( !(Mc->flags & MC_CHECK_RAY) && (vm_vec_dist(&hitpos, &Mc_p0) > Mc_mag) ) {
-					// The ray isn't long enough to intersect the bounding box
-					return 1;
-				}
-			} else {
-				return 1;
-			}
-			break;
-		default:
-			mprintf(( "Bad chunk type %d, len=%d in model_collide_sub\n", chunk_type, chunk_size ));
-			Int3();		// Bad chunk type!
-			return 0;
-		}
-		p += chunk_size;
-		chunk_type = w(p);
-		chunk_size = w(p+4);
-	}
-	return 1;
-}
-
-void model_collide_bsp_poly(bsp_collision_tree *tree, int leaf_index)
+static void model_collide_bsp_poly(mc_context *ctx, bsp_collision_tree *tree, int leaf_index)
 {
 	int i;
 	int tested_leaf = leaf_index;
@@ -585,10 +360,10 @@ void model_collide_bsp_poly(bsp_collision_tree *tree, int leaf_index)
 		int nv = leaf->num_verts;
 
 		if ( leaf->tmap_num < MAX_MODEL_TEXTURES ) {
-			if ( (!(Mc->flags & MC_CHECK_INVISIBLE_FACES)) && (Mc_pm->maps[leaf->tmap_num].textures[TM_BASE_TYPE].GetTexture() < 0) )	{
+			if ( (!(ctx->mc->flags & MC_CHECK_INVISIBLE_FACES)) && (ctx->pm->maps[leaf->tmap_num].textures[TM_BASE_TYPE].GetTexture() < 0) )	{
 				// Don't check invisible polygons.
 				//SUSHI: Unless $collide_invisible is set.
-				if (!(Mc_pm->submodel[Mc_submodel].collide_invisible))
+				if (!(ctx->pm->submodel[ctx->submodel].collide_invisible))
 					return;
 			}
 		} else {
@@ -605,16 +380,16 @@ void model_collide_bsp_poly(bsp_collision_tree *tree, int leaf_index)
 		}
 
 		if ( flat_poly ) {
-			if ( Mc->flags & MC_CHECK_SPHERELINE ) {
-				mc_check_sphereline_face(nv, points, &leaf->plane_pnt, &leaf->plane_norm, NULL, -1, NULL, leaf);
+			if ( ctx->mc->flags & MC_CHECK_SPHERELINE ) {
+				mc_check_sphereline_face(ctx, nv, points, &leaf->plane_pnt, &leaf->plane_norm, NULL, -1, NULL, leaf);
 			} else {
-				mc_check_face(nv, points, &leaf->plane_pnt, &leaf->plane_norm, NULL, -1, NULL, leaf);
+				mc_check_face(ctx, nv, points, &leaf->plane_pnt, &leaf->plane_norm, NULL, -1, NULL, leaf);
 			}
 		} else {
-			if ( Mc->flags & MC_CHECK_SPHERELINE ) {
-				mc_check_sphereline_face(nv, points, &leaf->plane_pnt, &leaf->plane_norm, uvlist, leaf->tmap_num, NULL, leaf);
+			if ( ctx->mc->flags & MC_CHECK_SPHERELINE ) {
+				mc_check_sphereline_face(ctx, nv, points, &leaf->plane_pnt, &leaf->plane_norm, uvlist, leaf->tmap_num, NULL, leaf);
 			} else {
-				mc_check_face(nv, points, &leaf->plane_pnt, &leaf->plane_norm, uvlist, leaf->tmap_num, NULL, leaf);
+				mc_check_face(ctx, nv, points, &leaf->plane_pnt, &leaf->plane_norm, uvlist, leaf->tmap_num, NULL, leaf);
 			}
 		}
 
@@ -622,7 +397,7 @@ void model_collide_bsp_poly(bsp_collision_tree *tree, int leaf_index)
 	}
 }
 
-void model_collide_bsp(bsp_collision_tree *tree, int node_index)
+static void model_collide_bsp(mc_context *ctx, bsp_collision_tree *tree, int node_index)
 {
 	if ( tree->node_list == NULL || tree->n_verts <= 0) {
 		return;
@@ -632,17 +407,17 @@ void model_collide_bsp(bsp_collision_tree *tree, int node_index)
 	vec3d hitpos;
 
 	// check the bounding box of this node. if it passes, check left and right children
-	if ( mc_ray_boundingbox( &node->min, &node->max, &Mc_p0, &Mc_direction, &hitpos ) ) {
-		if ( !(Mc->flags & MC_CHECK_RAY) && (vm_vec_dist(&hitpos, &Mc_p0) > Mc_mag) ) {
+	if ( mc_ray_boundingbox(ctx,  &node->min, &node->max, &ctx->p0, &ctx->direction, &hitpos ) ) {
+		if ( !(ctx->mc->flags & MC_CHECK_RAY) && (vm_vec_dist(&hitpos, &ctx->p0) > ctx->mag) ) {
 			// The ray isn't long enough to intersect the bounding box
 			return;
 		}
 
 		if ( node->leaf >= 0 ) {
-			model_collide_bsp_poly(tree, node->leaf);
+			model_collide_bsp_poly(ctx, tree, node->leaf);
 		} else {
-			if ( node->back >= 0 ) model_collide_bsp(tree, node->back);
-			if ( node->front >= 0 ) model_collide_bsp(tree, node->front);
+			if ( node->back >= 0 ) model_collide_bsp(ctx, tree, node->back);
+			if ( node->front >= 0 ) model_collide_bsp(ctx, tree, node->front);
 		}
 	}
 }
@@ -745,7 +520,8 @@ void model_collide_parse_bsp(bsp_collision_tree *tree, void *model_ptr, int vers
 
 	Assert(chunk_type == OP_DEFPOINTS);
 
-	int n_verts = model_collide_parse_bsp_defpoints(p);
+	SCP_vector<vec3d*> point_list;
+	int n_verts = model_collide_parse_bsp_defpoints(p, &point_list);
 
 	if ( n_verts <= 0) {
 		tree->point_list = NULL;
@@ -888,7 +664,7 @@ void model_collide_parse_bsp(bsp_collision_tree *tree, void *model_ptr, int vers
 	tree->point_list = (vec3d*)vm_malloc(sizeof(vec3d) * n_verts);
 
 	for ( i = 0; i < (size_t)n_verts; ++i ) {
-		tree->point_list[i] = *Mc_point_list[i];
+		tree->point_list[i] = *point_list[i];
 	}
 
 	tree->n_verts = n_verts;
@@ -911,7 +687,7 @@ void model_collide_parse_bsp(bsp_collision_tree *tree, void *model_ptr, int vers
 	vert_buffer.clear();
 }
 
-bool mc_shield_check_common(shield_tri	*tri)
+static bool mc_shield_check_common(mc_context *ctx, shield_tri	*tri)
 {
 	vec3d * points[3];
 	vec3d hitpoint;
@@ -919,35 +695,35 @@ bool mc_shield_check_common(shield_tri	*tri)
 	float dist;
 	float sphere_check_closest_shield_dist = FLT_MAX;
 
-	// Check to see if Mc_pmly is facing away from ray.  If so, don't bother
+	// Check to see if poly is facing away from ray.  If so, don't bother
 	// checking it.
-	if (vm_vec_dot(&Mc_direction,&tri->norm) > 0.0f)	{
+	if (vm_vec_dot(&ctx->direction,&tri->norm) > 0.0f)	{
 		return false;
 	}
 	// get the vertices in the form the next function wants them
 	for (int j = 0; j < 3; j++ )
-		points[j] = &Mc_pm->shield.verts[tri->verts[j]].pos;
+		points[j] = &ctx->pm->shield.verts[tri->verts[j]].pos;
 
-	if (!(Mc->flags & MC_CHECK_SPHERELINE) ) {	// Don't do this test for sphere colliding against shields
-		// Find the intersection of this ray with the plane that the Mc_pmly
+	if (!(ctx->mc->flags & MC_CHECK_SPHERELINE) ) {	// Don't do this test for sphere colliding against shields
+		// Find the intersection of this ray with the plane that the poly
 		// lies in
-		dist = fvi_ray_plane(NULL, points[0],&tri->norm,&Mc_p0,&Mc_direction,0.0f);
+		dist = fvi_ray_plane(NULL, points[0],&tri->norm,&ctx->p0,&ctx->direction,0.0f);
 
 		if ( dist < 0.0f ) return false; // If the ray is behind the plane there is no collision
-		if ( !(Mc->flags & MC_CHECK_RAY) && (dist > 1.0f) ) return false; // The ray isn't long enough to intersect the plane
+		if ( !(ctx->mc->flags & MC_CHECK_RAY) && (dist > 1.0f) ) return false; // The ray isn't long enough to intersect the plane
 
-		// Find the hit Mc_pmint
-		vm_vec_scale_add( &hitpoint, &Mc_p0, &Mc_direction, dist );
+		// Find the hit point
+		vm_vec_scale_add( &hitpoint, &ctx->p0, &ctx->direction, dist );
 	
-		// Check to see if the Mc_pmint of intersection is on the plane.  If so, this
+		// Check to see if the point of intersection is on the plane.  If so, this
 		// also finds the uv's where the ray hit.
 		if ( fvi_point_face(&hitpoint, 3, points, &tri->norm, NULL,NULL,NULL ) )	{
-			Mc->hit_dist = dist;
-			Mc->shield_hit_tri = (int)(tri - Mc_pm->shield.tris);
-			Mc->hit_point = hitpoint;
-			Mc->hit_normal = tri->norm;
-			Mc->hit_submodel = -1;
-			Mc->num_hits++;
+			ctx->mc->hit_dist = dist;
+			ctx->mc->shield_hit_tri = (int)(tri - ctx->pm->shield.tris);
+			ctx->mc->hit_point = hitpoint;
+			ctx->mc->hit_normal = tri->norm;
+			ctx->mc->hit_submodel = -1;
+			ctx->mc->num_hits++;
 			return true;		// We hit, so we're done
 		}
 	} else {		// Sphere check against shield
@@ -955,53 +731,53 @@ bool mc_shield_check_common(shield_tri	*tri)
 
 		// HACK HACK!! The 10000.0 is the face radius, I didn't know this,
 		// so I'm assume 10000 would be as big as ever.
-		mc_check_sphereline_face(3, points, points[0], &tri->norm, NULL, 0, NULL, NULL);
-		if (Mc->num_hits && Mc->hit_dist < sphere_check_closest_shield_dist) {
+		mc_check_sphereline_face(ctx, 3, points, points[0], &tri->norm, NULL, 0, NULL, NULL);
+		if (ctx->mc->num_hits && ctx->mc->hit_dist < sphere_check_closest_shield_dist) {
 
 			// same behavior whether face or edge
 			// normal, edge_hit, hit_point all updated thru sphereline_face
-			sphere_check_closest_shield_dist = Mc->hit_dist;
-			Mc->shield_hit_tri = (int)(tri - Mc_pm->shield.tris);
-			Mc->hit_submodel = -1;
-			Mc->num_hits++;
+			sphere_check_closest_shield_dist = ctx->mc->hit_dist;
+			ctx->mc->shield_hit_tri = (int)(tri - ctx->pm->shield.tris);
+			ctx->mc->hit_submodel = -1;
+			ctx->mc->num_hits++;
 			return true;		// We hit, so we're done
 		}
-	} // Mc->flags & MC_CHECK_SPHERELINE else
+	} // ctx->mc->flags & MC_CHECK_SPHERELINE else
 
 	return false;
 }
 
-bool mc_check_sldc(int offset)
+static bool mc_check_sldc(mc_context *ctx, int offset)
 {
-	if (offset > Mc_pm->sldc_size-5) //no way is this big enough
+	if (offset > ctx->pm->sldc_size-5) //no way is this big enough
 		return false;
-	char *type_p = (char *)(Mc_pm->shield_collision_tree+offset);
+	char *type_p = (char *)(ctx->pm->shield_collision_tree+offset);
 	
 	// not used
-	//int *size_p = (int *)(Mc_pm->shield_collision_tree+offset+1);
+	//int *size_p = (int *)(ctx->pm->shield_collision_tree+offset+1);
 	// split and polygons
-	vec3d *minbox_p = (vec3d*)(Mc_pm->shield_collision_tree+offset+5);
-	vec3d *maxbox_p = (vec3d*)(Mc_pm->shield_collision_tree+offset+17);
+	vec3d *minbox_p = (vec3d*)(ctx->pm->shield_collision_tree+offset+5);
+	vec3d *maxbox_p = (vec3d*)(ctx->pm->shield_collision_tree+offset+17);
 
 	// split
-	unsigned int *front_offset_p = (unsigned int*)(Mc_pm->shield_collision_tree+offset+29);
-	unsigned int *back_offset_p = (unsigned int*)(Mc_pm->shield_collision_tree+offset+33);
+	unsigned int *front_offset_p = (unsigned int*)(ctx->pm->shield_collision_tree+offset+29);
+	unsigned int *back_offset_p = (unsigned int*)(ctx->pm->shield_collision_tree+offset+33);
 
 	// polygons
-	unsigned int *num_polygons_p = (unsigned int*)(Mc_pm->shield_collision_tree+offset+29);
+	unsigned int *num_polygons_p = (unsigned int*)(ctx->pm->shield_collision_tree+offset+29);
 
-	unsigned int *shld_polys = (unsigned int*)(Mc_pm->shield_collision_tree+offset+33);
+	unsigned int *shld_polys = (unsigned int*)(ctx->pm->shield_collision_tree+offset+33);
 
 
 
 	// see if it fits inside our bbox
-	if (!mc_ray_boundingbox( minbox_p, maxbox_p, &Mc_p0, &Mc_direction, NULL ))	{
+	if (!mc_ray_boundingbox(ctx,  minbox_p, maxbox_p, &ctx->p0, &ctx->direction, NULL ))	{
 		return false;
 	}
 
 	if (*type_p == 0) // SPLIT
 	{
-			return mc_check_sldc(offset+*front_offset_p) || mc_check_sldc(offset+*back_offset_p);
+			return mc_check_sldc(ctx, offset+*front_offset_p) || mc_check_sldc(ctx, offset+*back_offset_p);
 	}
 	else
 	{
@@ -1009,9 +785,9 @@ bool mc_check_sldc(int offset)
 		shield_tri	* tri;
 		for (unsigned int i = 0; i < *num_polygons_p; i++)
 		{
-			tri = &Mc_pm->shield.tris[shld_polys[i]];
+			tri = &ctx->pm->shield.tris[shld_polys[i]];
 						
-			mc_shield_check_common(tri);
+			mc_shield_check_common(ctx, tri);
 
 		} // for (unsigned int i = 0; i < leaf->num_polygons; i++)
 	}
@@ -1021,30 +797,30 @@ bool mc_check_sldc(int offset)
 }
 
 // checks a vector collision against a ships shield (if it has shield points defined).
-void mc_check_shield()
+static void mc_check_shield(mc_context *ctx)
 {
 	int i;
 
 
-	if ( Mc_pm->shield.ntris < 1 )
+	if ( ctx->pm->shield.ntris < 1 )
 		return;
-	if (Mc_pm->shield_collision_tree)
+	if (ctx->pm->shield_collision_tree)
 	{
-		mc_check_sldc(0); // see if we hit the SLDC
+		mc_check_sldc(ctx, 0); // see if we hit the SLDC
 	}
 	else
 	{
 		int o;
 		for (o=0; o<8; o++ )	{
-			model_octant * poct1 = &Mc_pm->octants[o];
+			model_octant * poct1 = &ctx->pm->octants[o];
 
-			if (!mc_ray_boundingbox( &poct1->min, &poct1->max, &Mc_p0, &Mc_direction, NULL ))	{
+			if (!mc_ray_boundingbox(ctx,  &poct1->min, &poct1->max, &ctx->p0, &ctx->direction, NULL ))	{
 				continue;
 			}
 			
 			for (i = 0; i < poct1->nshield_tris; i++) {
 				shield_tri	* tri = poct1->shield_tris[i];
-				mc_shield_check_common(tri);
+				mc_shield_check_common(ctx, tri);
 			}
 		}
 	}//model has shield_collsion_tree
@@ -1053,7 +829,7 @@ void mc_check_shield()
 
 // This function recursively checks a submodel and its children
 // for a collision with a vector.
-void mc_check_subobj( int mn )
+static void mc_check_subobj( mc_context *ctx, int mn )
 {
 	vec3d tempv;
 	vec3d hitpt;		// used in bounding box check
@@ -1061,53 +837,53 @@ void mc_check_subobj( int mn )
 	int i;
 
 	Assert( mn >= 0 );
-	Assert( mn < Mc_pm->n_models );
-	if ( (mn < 0) || (mn>=Mc_pm->n_models) ) return;
+	Assert( mn < ctx->pm->n_models );
+	if ( (mn < 0) || (mn>=ctx->pm->n_models) ) return;
 	
-	sm = &Mc_pm->submodel[mn];
+	sm = &ctx->pm->submodel[mn];
 	if (sm->no_collisions) return; // don't do collisions
 	if (sm->nocollide_this_only) goto NoHit; // Don't collide for this model, but keep checking others
 
 	// Rotate the world check points into the current subobject's 
 	// frame of reference.
-	// After this block, Mc_p0, Mc_p1, Mc_direction, and Mc_mag are correct
+	// After this block, ctx->p0, ctx->p1, ctx->direction, and ctx->mag are correct
 	// and relative to this subobjects' frame of reference.
-	vm_vec_sub(&tempv, Mc->p0, &Mc_base);
-	vm_vec_rotate(&Mc_p0, &tempv, &Mc_orient);
+	vm_vec_sub(&tempv, ctx->mc->p0, &ctx->base);
+	vm_vec_rotate(&ctx->p0, &tempv, &ctx->orient);
 
-	vm_vec_sub(&tempv, Mc->p1, &Mc_base);
-	vm_vec_rotate(&Mc_p1, &tempv, &Mc_orient);
-	vm_vec_sub(&Mc_direction, &Mc_p1, &Mc_p0);
+	vm_vec_sub(&tempv, ctx->mc->p1, &ctx->base);
+	vm_vec_rotate(&ctx->p1, &tempv, &ctx->orient);
+	vm_vec_sub(&ctx->direction, &ctx->p1, &ctx->p0);
 
 	// bail early if no ray exists
-	if ( IS_VEC_NULL(&Mc_direction) ) {
+	if ( IS_VEC_NULL(&ctx->direction) ) {
 		return;
 	}
 
-	if (Mc_pm->detail[0] == mn)	{
+	if (ctx->pm->detail[0] == mn)	{
 		// Quickly bail if we aren't inside the full model bbox
-		if (!mc_ray_boundingbox( &Mc_pm->mins, &Mc_pm->maxs, &Mc_p0, &Mc_direction, NULL))	{
+		if (!mc_ray_boundingbox(ctx,  &ctx->pm->mins, &ctx->pm->maxs, &ctx->p0, &ctx->direction, NULL))	{
 			return;
 		}
 
 		// If we are checking the root submodel, then we might want to check	
 		// the shield at this point
-		if ((Mc->flags & MC_CHECK_SHIELD) && (Mc_pm->shield.ntris > 0 )) {
-			mc_check_shield();
+		if ((ctx->mc->flags & MC_CHECK_SHIELD) && (ctx->pm->shield.ntris > 0 )) {
+			mc_check_shield(ctx);
 			return;
 		}
 	}
 
-	if (!(Mc->flags & MC_CHECK_MODEL)) {
+	if (!(ctx->mc->flags & MC_CHECK_MODEL)) {
 		return;
 	}
 	
-	Mc_submodel = mn;
+	ctx->submodel = mn;
 
 	// Check if the ray intersects this subobject's bounding box
-	if ( mc_ray_boundingbox(&sm->min, &sm->max, &Mc_p0, &Mc_direction, &hitpt) ) {
-		if (Mc->flags & MC_ONLY_BOUND_BOX) {
-			float dist = vm_vec_dist( &Mc_p0, &hitpt );
+	if ( mc_ray_boundingbox(ctx, &sm->min, &sm->max, &ctx->p0, &ctx->direction, &hitpt) ) {
+		if (ctx->mc->flags & MC_ONLY_BOUND_BOX) {
+			float dist = vm_vec_dist( &ctx->p0, &hitpt );
 
 			// If the ray is behind the plane there is no collision
 			if (dist < 0.0f) {
@@ -1115,39 +891,39 @@ void mc_check_subobj( int mn )
 			}
 
 			// The ray isn't long enough to intersect the plane
-			if ( !(Mc->flags & MC_CHECK_RAY) && (dist > Mc_mag) ) {
+			if ( !(ctx->mc->flags & MC_CHECK_RAY) && (dist > ctx->mag) ) {
 				goto NoHit;
 			}
 
 			// If the ray hits, but a closer intersection has already been found, return
-			if ( Mc->num_hits && (dist >= Mc->hit_dist) ) {
+			if ( ctx->mc->num_hits && (dist >= ctx->mc->hit_dist) ) {
 				goto NoHit;
 			}
 
-			Mc->hit_dist = dist;
-			Mc->hit_point = hitpt;
-			Mc->hit_submodel = Mc_submodel;
-			Mc->hit_bitmap = -1;
-			Mc->num_hits++;
+			ctx->mc->hit_dist = dist;
+			ctx->mc->hit_point = hitpt;
+			ctx->mc->hit_submodel = ctx->submodel;
+			ctx->mc->hit_bitmap = -1;
+			ctx->mc->num_hits++;
 		} else {
 			// The ray intersects this bounding box, so we have to check all the
 			// polygons in this submodel.
-			if (Mc->lod > 0 && sm->num_details > 0) {
+			if (ctx->mc->lod > 0 && sm->num_details > 0) {
 				bsp_info* lod_sm = sm;
 
-				for (i = Mc->lod - 1; i >= 0; i--) {
+				for (i = ctx->mc->lod - 1; i >= 0; i--) {
 					if (sm->details[i] != -1) {
-						lod_sm = &Mc_pm->submodel[sm->details[i]];
+						lod_sm = &ctx->pm->submodel[sm->details[i]];
 
-						// mprintf(("Checking %s collision for %s using %s instead\n", Mc_pm->filename, sm->name,
+						// mprintf(("Checking %s collision for %s using %s instead\n", ctx->pm->filename, sm->name,
 						// lod_sm->name));
 						break;
 					}
 				}
 
-				model_collide_bsp(model_get_bsp_collision_tree(lod_sm->collision_tree_index), 0);
+				model_collide_bsp(ctx, model_get_bsp_collision_tree(lod_sm->collision_tree_index), 0);
 			} else {
-				model_collide_bsp(model_get_bsp_collision_tree(sm->collision_tree_index), 0);
+				model_collide_bsp(ctx, model_get_bsp_collision_tree(sm->collision_tree_index), 0);
 			}
 		}
 	}
@@ -1155,7 +931,7 @@ void mc_check_subobj( int mn )
 NoHit:
 
 	// If we're only checking one submodel, return
-	if (Mc->flags & MC_SUBMODEL)	{
+	if (ctx->mc->flags & MC_SUBMODEL)	{
 		return;
 	}
 
@@ -1163,9 +939,9 @@ NoHit:
 	// If this subobject doesn't have any children, we're done checking it.
 	if ( sm->num_children < 1 ) return;
 	
-	// Save instance (Mc_orient, Mc_base, Mc_point_base)
-	matrix saved_orient = Mc_orient;
-	vec3d saved_base = Mc_base;
+	// Save instance (ctx->orient, ctx->base)
+	matrix saved_orient = ctx->orient;
+	vec3d saved_base = ctx->base;
 	
 	// Check all of this subobject's children
 	i = sm->first_child;
@@ -1173,12 +949,12 @@ NoHit:
 		angles angs;
 		bool blown_off;
 		bool collision_checked;
-		bsp_info * csm = &Mc_pm->submodel[i];
+		bsp_info * csm = &ctx->pm->submodel[i];
 		
-		if ( Mc_pmi ) {
-			angs = Mc_pmi->submodel[i].angs;
-			blown_off = Mc_pmi->submodel[i].blown_off;
-			collision_checked = Mc_pmi->submodel[i].collision_checked;
+		if ( ctx->pmi ) {
+			angs = ctx->pmi->submodel[i].angs;
+			blown_off = ctx->pmi->submodel[i].blown_off;
+			collision_checked = ctx->pmi->submodel[i].collision_checked;
 		} else {
 			angs = csm->angs;
 			blown_off = csm->blown_off ? true : false;
@@ -1188,16 +964,16 @@ NoHit:
 		// Don't check it or its children if it is destroyed
 		// or if it's set to no collision
 		if ( !blown_off && !collision_checked && !csm->no_collisions )	{
-			if ( Mc_pmi ) {
-				Mc_orient = Mc_pmi->submodel[i].mc_orient;
-				Mc_base = Mc_pmi->submodel[i].mc_base;
-				vm_vec_add2(&Mc_base, Mc->pos);
+			if ( ctx->pmi ) {
+				ctx->orient = ctx->pmi->submodel[i].mc_orient;
+				ctx->base = ctx->pmi->submodel[i].mc_base;
+				vm_vec_add2(&ctx->base, ctx->mc->pos);
 			} else {
 				//instance for this subobject
 				matrix tm = IDENTITY_MATRIX;
 
-				vm_vec_unrotate(&Mc_base, &csm->offset, &saved_orient );
-				vm_vec_add2(&Mc_base, &saved_base );
+				vm_vec_unrotate(&ctx->base, &csm->offset, &saved_orient );
+				vm_vec_add2(&ctx->base, &saved_base );
 
 				if( vm_matrix_same(&tm, &csm->orientation)) {
 					// if submodel orientation matrix is identity matrix then don't bother with matrix ops
@@ -1212,10 +988,10 @@ NoHit:
 					vm_matrix_x_matrix(&tm, &rotation_matrix, &inv_orientation);
 				}
 
-				vm_matrix_x_matrix(&Mc_orient, &saved_orient, &tm);
+				vm_matrix_x_matrix(&ctx->orient, &saved_orient, &tm);
 			}
 
-			mc_check_subobj( i );
+			mc_check_subobj( ctx, i );
 		}
 
 		i = csm->next_sibling;
@@ -1223,70 +999,61 @@ NoHit:
 
 }
 
-MONITOR(NumFVI)
-
-// See model.h for usage.   I don't want to put the
-// usage here because you need to see the #defines and structures
-// this uses while reading the help.   
-int model_collide(mc_info *mc_info_obj)
+// Runs the query described by ctx->mc
+static int mc_collide(mc_context *ctx)
 {
-	Mc = mc_info_obj;
-
-	MONITOR_INC(NumFVI,1);
-
-	Mc->num_hits = 0;				// How many collisions were found
-	Mc->shield_hit_tri = -1;	// Assume we won't hit any shield polygons
-	Mc->hit_bitmap = -1;
-	Mc->edge_hit = 0;
+	ctx->mc->num_hits = 0;				// How many collisions were found
+	ctx->mc->shield_hit_tri = -1;	// Assume we won't hit any shield polygons
+	ctx->mc->hit_bitmap = -1;
+	ctx->mc->edge_hit = 0;
 
-	if ( (Mc->flags & MC_CHECK_SHIELD) && (Mc->flags & MC_CHECK_MODEL) )	{
+	if ( (ctx->mc->flags & MC_CHECK_SHIELD) && (ctx->mc->flags & MC_CHECK_MODEL) )	{
 		Error( LOCATION, "Checking both shield and model!\n" );
 		return 0;
 	}
 
-	//Fill in some global variables that all the model collide routines need internally.
-	Mc_pm = model_get(Mc->model_num);
-	Mc_orient = *Mc->orient;
-	Mc_base = *Mc->pos;
-	Mc_mag = vm_vec_dist( Mc->p0, Mc->p1 );
-	Mc_edge_time = FLT_MAX;
+	//Fill in the query state that all the model collide routines need internally.
+	ctx->pm = model_get(ctx->mc->model_num);
+	ctx->orient = *ctx->mc->orient;
+	ctx->base = *ctx->mc->pos;
+	ctx->mag = vm_vec_dist( ctx->mc->p0, ctx->mc->p1 );
 
-	if ( Mc->model_instance_num >= 0 ) {
-		Mc_pmi = model_get_instance(Mc->model_instance_num);
+	if ( ctx->mc->model_instance_num >= 0 ) {
+		ctx->pmi = model_get_instance(ctx->mc->model_instance_num);
 	} else {
-		Mc_pmi = NULL;
+		ctx->pmi = NULL;
 	}
 
 	// DA 11/19/98 - disable this check for rotating submodels
 	// Don't do check if for very small movement
-//	if (Mc_mag < 0.01f) {
+//	if (ctx->mag < 0.01f) {
 //		return 0;
 //	}
 
 	float model_radius;		// How big is the model we're checking against
 	int first_submodel;		// Which submodel gets returned as hit if MC_ONLY_SPHERE specified
 
-	if ( (Mc->flags & MC_SUBMODEL) || (Mc->flags & MC_SUBMODEL_INSTANCE) )	{
-		first_submodel = Mc->submodel_num;
-		model_radius = Mc_pm->submodel[first_submodel].rad;
+	if ( (ctx->mc->flags & MC_SUBMODEL) || (ctx->mc->flags & MC_SUBMODEL_INSTANCE) )	{
+		first_submodel = ctx->mc->submodel_num;
+		model_radius = ctx->pm->submodel[first_submodel].rad;
 	} else {
-		first_submodel = Mc_pm->detail[0];
-		model_radius = Mc_pm->rad;
+		first_submodel = ctx->pm->detail[0];
+		model_radius = ctx->pm->rad;
 	}
 
-	if ( Mc->flags & MC_CHECK_SPHERELINE ) {
-		if ( Mc->radius <= 0.0f ) {
-			Warning(LOCATION, "Attempting to collide with a sphere, but the sphere's radius is <= 0.0f!\n\n(model file is %s; submodel is %d, mc_flags are %d)", Mc_pm->filename, first_submodel, Mc->flags);
+	if ( ctx->mc->flags & MC_CHECK_SPHERELINE ) {
+		if ( ctx->mc->radius <= 0.0f ) {
+			Warning(LOCATION, "Attempting to collide with a sphere, but the sphere's radius is <= 0.0f!\n\n(model file is %s; submodel is %d, mc_flags are %d)", ctx->pm->filename, first_submodel, ctx->mc->flags);
 			return 0;
 		}
 
 		// Do a quick check on the Bounding Sphere
-		if (fvi_segment_sphere(&Mc->hit_point_world, Mc->p0, Mc->p1, Mc->pos, model_radius+Mc->radius) )	{
-			if ( Mc->flags & MC_ONLY_SPHERE )	{
-				Mc->hit_point = Mc->hit_point_world;
-				Mc->hit_submodel = first_submodel;
-				Mc->num_hits++;
-				return (Mc->num_hits > 0);
+		if (fvi_segment_sphere(&ctx->mc->hit_point_world, ctx->mc->p0, ctx->mc->p1, ctx->mc->pos, model_radius+ctx->mc->radius) )	{
+			if ( ctx->mc->flags & MC_ONLY_SPHERE )	{
+				ctx->mc->hit_point = ctx->mc->hit_point_world;
+				ctx->mc->hit_submodel = first_submodel;
+				ctx->mc->num_hits++;
+				return (ctx->mc->num_hits > 0);
 			}
 			// continue checking polygons.
 		} else {
@@ -1296,17 +1063,17 @@ int model_collide(mc_info *mc_info_obj)
 		int r;
 
 		// Do a quick check on the Bounding Sphere
-		if ( Mc->flags & MC_CHECK_RAY ) {
-			r = fvi_ray_sphere(&Mc->hit_point_world, Mc->p0, Mc->p1, Mc->pos, model_radius);
+		if ( ctx->mc->flags & MC_CHECK_RAY ) {
+			r = fvi_ray_sphere(&ctx->mc->hit_point_world, ctx->mc->p0, ctx->mc->p1, ctx->mc->pos, model_radius);
 		} else {
-			r = fvi_segment_sphere(&Mc->hit_point_world, Mc->p0, Mc->p1, Mc->pos, model_radius);
+			r = fvi_segment_sphere(&ctx->mc->hit_point_world, ctx->mc->p0, ctx->mc->p1, ctx->mc->pos, model_radius);
 		}
 		if (r) {
-			if ( Mc->flags & MC_ONLY_SPHERE ) {
-				Mc->hit_point = Mc->hit_point_world;
-				Mc->hit_submodel = first_submodel;
-				Mc->num_hits++;
-				return (Mc->num_hits > 0);
+			if ( ctx->mc->flags & MC_ONLY_SPHERE ) {
+				ctx->mc->hit_point = ctx->mc->hit_point_world;
+				ctx->mc->hit_submodel = first_submodel;
+				ctx->mc->num_hits++;
+				return (ctx->mc->num_hits > 0);
 			}
 			// continue checking polygons.
 		} else {
@@ -1315,40 +1082,55 @@ int model_collide(mc_info *mc_info_obj)
 
 	}
 
-	if ( Mc->flags & MC_SUBMODEL )	{
+	if ( ctx->mc->flags & MC_SUBMODEL )	{
 		// Check only one subobject
-		mc_check_subobj( Mc->submodel_num );
+		mc_check_subobj( ctx, ctx->mc->submodel_num );
 		// Check submodel and any children
-	} else if (Mc->flags & MC_SUBMODEL_INSTANCE) {
-		mc_check_subobj(Mc->submodel_num);
+	} else if (ctx->mc->flags & MC_SUBMODEL_INSTANCE) {
+		mc_check_subobj(ctx, ctx->mc->submodel_num);
 	} else {
 		// Check all the the highest detail model polygons and subobjects for intersections
 
 		// Don't check it or its children if it is destroyed
-		if (!Mc_pm->submodel[Mc_pm->detail[0]].blown_off)	{	
-			mc_check_subobj( Mc_pm->detail[0] );
+		if (!ctx->pm->submodel[ctx->pm->detail[0]].blown_off)	{	
+			mc_check_subobj( ctx, ctx->pm->detail[0] );
 		}
 	}
 
 
 	//If we found a hit, then rotate it into world coordinates	
-	if ( Mc->num_hits )	{
-		if ( Mc->flags & MC_SUBMODEL )	{
+	if ( ctx->mc->num_hits )	{
+		if ( ctx->mc->flags & MC_SUBMODEL )	{
 			// If we're just checking one submodel, don't use normal instancing to find world points
-			vm_vec_unrotate(&Mc->hit_point_world, &Mc->hit_point, Mc->orient);
-			vm_vec_add2(&Mc->hit_point_world, Mc->pos);
+			vm_vec_unrotate(&ctx->mc->hit_point_world, &ctx->mc->hit_point, ctx->mc->orient);
+			vm_vec_add2(&ctx->mc->hit_point_world, ctx->mc->pos);
 		} else {
-			if ( Mc_pmi ) {
-				model_instance_find_world_point(&Mc->hit_point_world, &Mc->hit_point, Mc->model_instance_num, Mc->hit_submodel, Mc->orient, Mc->pos);
+			if ( ctx->pmi ) {
+				model_instance_find_world_point(&ctx->mc->hit_point_world, &ctx->mc->hit_point, ctx->mc->model_instance_num, ctx->mc->hit_submodel, ctx->mc->orient, ctx->mc->pos);
 			} else {
-				model_find_world_point(&Mc->hit_point_world, &Mc->hit_point, Mc->model_num, Mc->hit_submodel, Mc->orient, Mc->pos);
+				model_find_world_point(&ctx->mc->hit_point_world, &ctx->mc->hit_point, ctx->mc->model_num, ctx->mc->hit_submodel, ctx->mc->orient, ctx->mc->pos);
 			}
 		}
 	}
 
 
-	return Mc->num_hits;
+	return ctx->mc->num_hits;
+
+}
+
+MONITOR(NumFVI)
+
+// See model.h for usage.   I don't want to put the
+// usage here because you need to see the #defines and structures
+// this uses while reading the help.   
+int model_collide(mc_info *mc_info_obj)
+{
+	MONITOR_INC(NumFVI,1);
+
+	mc_context ctx;
+	ctx.mc = mc_info_obj;
 
+	return mc_collide(&ctx);
 }
 
 void model_collide_preprocess_subobj(vec3d *pos, matrix *orient, polymodel *pm,  polymodel_instance *pmi, int subobj_num)
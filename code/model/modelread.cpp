@@ -31,6 +31,7 @@
 #include "math/fvi.h"
 #include "math/vecmat.h"
 #include "model/model.h"
+#include "model/modelcache.h"
 #include "model/modelsinc.h"
 #include "parse/parselo.h"
 #include "render/3dinternal.h"
@@ -450,6 +451,10 @@ void model_init()
 		Polygon_models[i] = NULL;
 	}
 
+	if (Cmdline_model_cache) {
+		model_cache_purge();
+	}
+
 	model_initted = 1;
 }
 
@@ -878,7 +883,7 @@ void create_family_tree(polymodel *obj)
 	}
 }
 
-void create_vertex_buffer(polymodel *pm)
+void create_vertex_buffer(polymodel *pm, model_cache *cache)
 {
 	if (Is_standalone) {
 		return;
@@ -940,6 +945,8 @@ void create_vertex_buffer(polymodel *pm)
 
 	pm->flags |= PM_FLAG_BATCHED;
 
+	model_cache_capture_vertex_buffers(pm, stride, cache);
+
 	// ... and then finalize buffer
 	model_interp_submit_buffers(&pm->vert_source, stride);
 
@@ -2744,8 +2751,14 @@ int model_load(const  char *filename, int n_subsystems, model_subsystem *subsyst
 
 	create_family_tree(pm);
 
+	// the vertex buffers, octants and collision trees only depend on the POF so they may come from the cache
+	model_cache cache;
+	model_cache_begin(pm, Global_checksum, &cache);
+
 	// maybe generate vertex buffers
-	create_vertex_buffer(pm);
+	if (!cache.loaded || !model_cache_restore_vertex_buffers(pm, &cache)) {
+		create_vertex_buffer(pm, &cache);
+	}
 
 	//==============================
 	// Find all the lower detail versions of the hires model
@@ -2849,18 +2862,24 @@ int model_load(const  char *filename, int n_subsystems, model_subsystem *subsyst
 	}
 
 
-	model_octant_create( pm );
+	if (!cache.loaded || !model_cache_restore_octants(pm, &cache)) {
+		model_octant_create( pm );
+	}
 
-	TRACE_SCOPE(tracing::ModelParseAllBSPTrees);
+	if (!cache.loaded || !model_cache_restore_collision_trees(pm, &cache)) {
+		TRACE_SCOPE(tracing::ModelParseAllBSPTrees);
 
-	for (i = 0; i < pm->n_models; ++i) {
-		if (!(pm->submodel[i].nocollide_this_only || pm->submodel[i].no_collisions)) {
-			pm->submodel[i].collision_tree_index = model_create_bsp_collision_tree();
-			bsp_collision_tree* tree             = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
-			model_collide_parse_bsp(tree, pm->submodel[i].bsp_data, pm->version);
+		for (i = 0; i < pm->n_models; ++i) {
+			if (!(pm->submodel[i].nocollide_this_only || pm->submodel[i].no_collisions)) {
+				pm->submodel[i].collision_tree_index = model_create_bsp_collision_tree();
+				bsp_collision_tree* tree             = model_get_bsp_collision_tree(pm->submodel[i].collision_tree_index);
+				model_collide_parse_bsp(tree, pm->submodel[i].bsp_data, pm->version);
+			}
 		}
 	}
 
+	model_cache_store(pm, &cache);
+
 	// Find the core_radius... the minimum of 
 	float rx, ry, rz;
 	rx = fl_abs( pm->submodel[pm->detail[0]].max.xyz.x - pm->submodel[pm->detail[0]].min.xyz.x );
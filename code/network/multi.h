@@ -61,9 +61,11 @@ class player;
 // version 47 - 11/11/2003 (FS2OpenPXO, FS2 Open Changes - FS2Open 3.6)
 // revert  46 - 9/7/2006 (the 47 bump wasn't needed, reverting to retail version for compatibility reasons)
 // version 48 - 8/15/2016 Multiple changes to the packet format for multi sexps
+// version 49 - 10/17/2026 Acknowledged deltas of position, orientation, hull, shield and subsystem data in object updates
+// version 50 - 10/17/2026 Unreliable packets are collected into datagrams of up to MAX_DATAGRAM_SIZE bytes
 // STANDALONE_ONLY
 
-#define MULTI_FS_SERVER_VERSION							148
+#define MULTI_FS_SERVER_VERSION							150
 
 #define MULTI_FS_SERVER_COMPATIBLE_VERSION			MULTI_FS_SERVER_VERSION
 
@@ -431,7 +433,7 @@ typedef struct net_player_server_info {
 	ubyte				accum_buttons;				
 	
 	// buffered packet info
-	ubyte					unreliable_buffer[MAX_PACKET_SIZE];	// buffer used to buffer unreliable packets before sending as a single UDP packet
+	ubyte					unreliable_buffer[MAX_DATAGRAM_SIZE];	// buffer used to buffer unreliable packets before sending as a single UDP packet
 	int					unreliable_buffer_size;					// length (in bytes) of data in unreliable send_buffer
 	ubyte					reliable_buffer[MAX_PACKET_SIZE];	// buffer used to buffer reliable packets before sending as a single UDP packet
 	int					reliable_buffer_size;					// length (in bytes) of data in reliable send_buffer
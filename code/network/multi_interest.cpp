@@ -0,0 +1,53 @@
+#include "network/multi_interest.h"
+
+const interest_params Default_interest_params = {
+	1400.0f,			// near_dist, the far range of object updates
+	4000.0f,			// view_dist
+	0.1f,				// view_dot, the view cone of object updates
+	1.25f,			// hysteresis
+	0.1f,				// view_dot_margin
+	8,					// max_far
+};
+
+interest_set::interest_set() : _far_cursor(0) {
+}
+
+void interest_set::clear() {
+	_members.clear();
+	_in_set.clear();
+	_far_cursor = 0;
+}
+
+void interest_set::set_flag(int objnum, bool value) {
+	Assertion(objnum >= 0, "Invalid object number %d!", objnum);
+
+	if ((size_t)objnum >= _in_set.size()) {
+		if (!value) {
+			return;
+		}
+		_in_set.resize(objnum + 1, false);
+	}
+
+	_in_set[objnum] = value;
+}
+
+bool interest_set::in_range(const vec3d* pos, const vec3d* fvec, const vec3d* obj_pos, const interest_params& params, bool member, float* dist_out) {
+	float scale = member ? params.hysteresis : 1.0f;
+	vec3d to_obj;
+
+	vm_vec_sub(&to_obj, obj_pos, pos);
+	float dist = vm_vec_mag(&to_obj);
+	*dist_out = dist;
+
+	if (dist < params.near_dist * scale) {
+		return true;
+	}
+
+	if (dist >= params.view_dist * scale) {
+		return false;
+	}
+
+	// dist is at least near_dist here so there is no division by zero
+	float min_dot = member ? (params.view_dot - params.view_dot_margin) : params.view_dot;
+	return vm_vec_dot(&to_obj, fvec) >= min_dot * dist;
+}
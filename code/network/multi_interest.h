@@ -0,0 +1,140 @@
+#ifndef _MULTI_INTEREST_H
+#define _MULTI_INTEREST_H
+
+#include "globalincs/pstypes.h"
+#include "math/vecmat.h"
+
+// Decides which objects the server updates a player about.  An object joins the set of a player once it comes close
+// to the player or into the player's view and only leaves it again once it is clearly out of both, so that objects at
+// the border don't flicker in and out from one update to the next.  Objects outside of the set are not dropped but
+// handed out a few at a time so that the player still hears about everything in the mission now and then.
+//
+// This only deals in object numbers and positions so it can be used (and tested) without the object system.
+
+typedef struct interest_params {
+	float	near_dist;				// everything closer than this is of interest
+	float	view_dist;				// objects in view are of interest up to this distance
+	float	view_dot;				// the cosine of the half angle of the view cone
+	float	hysteresis;				// an object in the set stays there until it is this much further out
+	float	view_dot_margin;		// and this much out of the view cone
+	int		max_far;					// how many objects outside the set are handed out per update
+} interest_params;
+
+extern const interest_params Default_interest_params;
+
+class interest_set {
+ public:
+	struct member {
+		int		objnum;
+		int		signature;
+		float	dist;				// from the viewer at the last update
+	};
+
+	interest_set();
+
+	/**
+	 * @brief Updates which objects are in the set
+	 *
+	 * The members are checked against the leave distances first, then the candidates against the enter distances.
+	 *
+	 * @param pos The position of the viewer
+	 * @param fvec The (normalized) direction the viewer looks in
+	 * @param params The distances to use
+	 * @param candidates Every object which may be within the near distance or within the view cone, a superset and
+	 * duplicates are fine
+	 * @param locate Called as <tt>bool locate(int objnum, int* signature, vec3d* pos)</tt>, fills in where the object is
+	 * and returns false if it may not be in the set at all. If @c signature is not -1 the object must have that
+	 * signature.
+	 */
+	template<typename Locate>
+	void update(const vec3d* pos, const vec3d* fvec, const interest_params& params, const SCP_vector<int>& candidates, Locate locate) {
+		// members first, with the generous distances
+		size_t kept = 0;
+		for (auto& m : _members) {
+			vec3d obj_pos;
+			int signature = m.signature;
+
+			if (locate(m.objnum, &signature, &obj_pos) && in_range(pos, fvec, &obj_pos, params, true, &m.dist)) {
+				_members[kept++] = m;
+			} else {
+				set_flag(m.objnum, false);
+			}
+		}
+		_members.resize(kept);
+
+		// then everything that may have come close enough
+		for (auto objnum : candidates) {
+			if (has_flag(objnum)) {
+				continue;
+			}
+
+			vec3d obj_pos;
+			int signature = -1;
+			float dist;
+			if (locate(objnum, &signature, &obj_pos) && in_range(pos, fvec, &obj_pos, params, false, &dist)) {
+				member m;
+				m.objnum = objnum;
+				m.signature = signature;
+				m.dist = dist;
+				_members.push_back(m);
+
+				set_flag(objnum, true);
+			}
+		}
+	}
+
+	/**
+	 * @brief Hands out objects which are not in the set, continuing where the last call stopped
+	 *
+	 * @param num_slots The number of slots to go through, like MAX_SHIPS
+	 * @param max How many objects to hand out at most
+	 * @param slot_objnum Called with a slot number, returns the object in it which is due for an update or -1
+	 * @param fn Called with every object handed out
+	 * @return The number of objects handed out
+	 */
+	template<typename SlotObjnum, typename Function>
+	int for_each_far(int num_slots, int max, SlotObjnum slot_objnum, Function fn) {
+		int count = 0;
+
+		if (num_slots <= 0) {
+			return 0;
+		}
+		if (_far_cursor >= num_slots) {
+			_far_cursor = 0;
+		}
+
+		for (int i = 0; (i < num_slots) && (count < max); ++i) {
+			int slot = _far_cursor;
+			_far_cursor = (_far_cursor + 1) % num_slots;
+
+			int objnum = slot_objnum(slot);
+			if ((objnum >= 0) && !has_flag(objnum)) {
+				fn(objnum);
+				++count;
+			}
+		}
+
+		return count;
+	}
+
+	const SCP_vector<member>& members() const { return _members; }
+
+	bool contains(int objnum) const { return has_flag(objnum); }
+
+	void clear();
+
+ private:
+	SCP_vector<member> _members;
+	SCP_vector<bool> _in_set;			// indexed by object number
+	int _far_cursor;
+
+	bool has_flag(int objnum) const {
+		return (objnum >= 0) && ((size_t)objnum < _in_set.size()) && _in_set[objnum];
+	}
+
+	void set_flag(int objnum, bool value);
+
+	static bool in_range(const vec3d* pos, const vec3d* fvec, const vec3d* obj_pos, const interest_params& params, bool member, float* dist_out);
+};
+
+#endif
@@ -20,9 +20,11 @@
 #include "network/multiutil.h"
 #include "network/multi_options.h"
 #include "network/multi_rate.h"
+#include "network/multi_interest.h"
 #include "network/multi.h"
 #include "object/object.h"
 #include "object/objectshield.h"
+#include "object/objectgrid.h"
 #include "ship/ship.h"
 #include "playerman/player.h"
 #include "math/spline.h"
@@ -85,6 +87,74 @@ bool Multi_oo_afterburn_hack = false;
 #define OO_HULL_SHIELD_TIME		600
 #define OO_SUBSYS_TIME				1000
 
+// Position, orientation, hull, shield and subsystem values are sent as a delta against the last values a client is
+// known to have. Clients acknowledge the object update packets they received in their control info and the server
+// keeps the values it sent until the packet which carried them is acknowledged.
+
+// the status sections of a ship update
+#define OO_STATUS_HULL				0		// hull and shield quadrants
+#define OO_STATUS_SUBSYS			1		// subsystem hits
+#define OO_STATUS_POS				2		// quantized position, server to client only
+#define OO_STATUS_ORIENT			3		// quantized orientation, server to client only
+#define OO_NUM_STATUS_SECTIONS	4
+
+// how a status section is encoded. position and orientation sections start with either OO_STATUS_FULL or the
+// number of bits of every difference to the baseline
+#define OO_STATUS_FULL				0
+#define OO_STATUS_DELTA				1
+
+// a status section holds at most this many values
+#define OO_MAX_STATUS_VALUES		255
+
+// how many received sections a client keeps per ship to apply deltas against, and how many unacknowledged ones the
+// server keeps. a ship is updated every 66 ms at most and acknowledgements come with the control info every 85 ms, so
+// this covers about a second of round trip. a baseline older than this many updates isn't used for deltas
+#define OO_STATUS_HISTORY			16
+
+// send every status section in full this often so that a client which lost its baseline recovers
+#define OO_STATUS_FULL_TIME		5000
+
+// how many packets before the latest one an acknowledgement covers
+#define OO_ACK_BITS					32
+
+// the widths position and orientation differences may be sent with
+const int OO_pos_delta_bits[] = { 8, 12, 16 };
+const int OO_orient_delta_bits[] = { 4, 6, 8 };
+
+// the quantized values of one status section of a ship
+typedef struct oo_status_values {
+	bool		valid = false;
+	ushort	net_signature = 0;
+	ubyte		update_seq = 0;			// sequence # of the ship update which carried them
+	ushort	packet_seq = 0;			// server only, the packet which carried them
+	SCP_vector<int> values;
+} oo_status_values;
+
+// what the server knows a player has of one status section of a ship
+typedef struct oo_status_baseline {
+	oo_status_values acked;										// the player has these
+	oo_status_values pending[OO_STATUS_HISTORY];		// sent but not acknowledged yet
+	int		pending_next = 0;								// where the next pending values go
+	int		full_stamp = -1;								// when this section has to be sent in full again
+} oo_status_baseline;
+
+// which object update packets arrived
+typedef struct oo_packet_ack {
+	bool		valid = false;
+	ushort	seq = 0;						// the latest packet
+	uint		bits = 0;					// bit n is set if packet seq - n - 1 arrived as well
+} oo_packet_ack;
+
+// server side
+oo_status_baseline OO_status_baselines[MAX_SHIPS][MAX_PLAYERS][OO_NUM_STATUS_SECTIONS];
+ushort OO_packet_seq[MAX_PLAYERS];						// sequence # of the next object update packet to each player
+oo_packet_ack OO_packet_acks[MAX_PLAYERS];			// what each player acknowledged
+
+// client side
+oo_status_values OO_status_history[MAX_SHIPS][OO_NUM_STATUS_SECTIONS][OO_STATUS_HISTORY];
+int OO_status_history_next[MAX_SHIPS][OO_NUM_STATUS_SECTIONS];
+oo_packet_ack OO_received_packets;						// the object update packets received from the server
+
 // timestamp values for object update times based on client's update level.
 int Multi_oo_target_update_times[MAX_OBJ_UPDATE_LEVELS] = 
 {
@@ -157,43 +227,181 @@ int OO_update_index = -1;							// index into OO_update_records for displaying u
 // OBJECT UPDATE FUNCTIONS
 //
 
-object *OO_player_obj;
 int OO_sort = 1;
 
-bool multi_oo_sort_func(const short &index1, const short &index2)
+// which ships each player gets updates about, see multi_interest.h
+interest_set OO_interest[MAX_PLAYERS];
+bool Multi_oo_interest_enabled = true;
+DCF_BOOL(oo_interest, Multi_oo_interest_enabled)
+
+// how much an update of each ship is worth to the player whose list is being built
+float OO_ship_priority[MAX_SHIPS];
+
+// an overdue ship gains this much priority per ms it waited, up to OO_MAX_OVERDUE
+#define OO_OVERDUE_PRIORITY		(0.01f)
+#define OO_MAX_OVERDUE				1000
+
+// how much an update of this ship is worth to the player. ships close by, in view, after the player or waiting long
+// for their update go first
+float multi_oo_ship_priority(net_player *pl, object *player_obj, object *objp)
 {
-	object *obj1, *obj2;
-	float dist1, dist2;
-	float dot1, dot2;
-	vec3d v1, v2;
-	vec3d vn1, vn2;
+	ship *shipp = &Ships[objp->instance];
+	vec3d dir;
+
+	float dist = vm_vec_normalized_dir(&dir, &objp->pos, &player_obj->pos);
+	float priority = OO_NEAR_DIST / MAX(dist, OO_NEAR_DIST);
 
+	// in view
+	if(vm_vec_dot(&player_obj->orient.vec.fvec, &dir) >= OO_VIEW_CONE_DOT){
+		priority *= 2.0f;
+	}
+
+	// after the player
+	if((shipp->ai_index >= 0) && (Ai_info[shipp->ai_index].target_objnum == OBJ_INDEX(player_obj))){
+		priority *= 2.0f;
+	}
+
+	// ships the budget skipped before catch up
+	int stamp = shipp->np_updates[NET_PLAYER_NUM(pl)].update_stamp;
+	if(stamp != -1){
+		int overdue = -timestamp_until(stamp);
+		if(overdue > 0){
+			priority *= 1.0f + OO_OVERDUE_PRIORITY * (float)MIN(overdue, OO_MAX_OVERDUE);
+		}
+	}
+
+	return priority;
+}
+
+bool multi_oo_sort_func(const short &index1, const short &index2)
+{
 	// if the indices are bogus, or the objnums are bogus, return ">"
 	if((index1 < 0) || (index2 < 0) || (Ships[index1].objnum < 0) || (Ships[index2].objnum < 0)){
 		return false;
 	}
 
-	// get the 2 objects
-	obj1 = &Objects[Ships[index1].objnum];
-	obj2 = &Objects[Ships[index2].objnum];
+	// the more valuable update first
+	return OO_ship_priority[index1] > OO_ship_priority[index2];
+}
+
+// sort the first count ships in OO_ship_index by how much an update is worth to the player
+void multi_oo_sort_ship_list(net_player *pl, object *player_obj, int count)
+{
+	int idx;
+
+	if(!OO_sort){
+		return;
+	}
+
+	for(idx=0; idx<count; idx++){
+		int shipnum = OO_ship_index[idx];
+		OO_ship_priority[shipnum] = multi_oo_ship_priority(pl, player_obj, &Objects[Ships[shipnum].objnum]);
+	}
+
+	std::sort(OO_ship_index, OO_ship_index + count, multi_oo_sort_func);
+}
+
+// if this ship may be sent to the player at all
+bool multi_oo_ship_sendable(net_player *pl, object *player_obj, int objnum)
+{
+	// if it is an invalid ship object, skip it
+	if((objnum < 0) || (Objects[objnum].instance < 0) || (Objects[objnum].type != OBJ_SHIP)){
+		return false;
+	}
+
+	// if we're a standalone server, don't send any data regarding its pseudo-ship
+	if((Game_mode & GM_STANDALONE_SERVER) && ((&Objects[objnum] == Player_obj) || (Objects[objnum].net_signature == STANDALONE_SHIP_SIG)) ){
+		return false;
+	}		
+		
+	// must be a ship, a weapon, and _not_ an observer
+	if (Objects[objnum].flags[Object::Object_Flags::Should_be_dead]){
+		return false;
+	}
+
+	// don't send info for dying ships
+	if (Ships[Objects[objnum].instance].flags[Ship::Ship_Flags::Dying]){
+		return false;
+	}		
 
-	// get the distance and dot product to the player obj for both
-	vm_vec_sub(&v1, &OO_player_obj->pos, &obj1->pos);
-	dist1 = vm_vec_copy_normalize(&vn1, &v1);
-	vm_vec_sub(&v2, &OO_player_obj->pos, &obj2->pos);
-	dist2 = vm_vec_copy_normalize(&vn2, &v2);
-	dot1 = vm_vec_dot(&OO_player_obj->orient.vec.fvec, &vn1);
-	dot2 = vm_vec_dot(&OO_player_obj->orient.vec.fvec, &vn2);
+	// never update the knossos device
+	if ((Ships[Objects[objnum].instance].ship_info_index >= 0) && (Ships[Objects[objnum].instance].ship_info_index < static_cast<int>(Ship_info.size())) && (Ship_info[Ships[Objects[objnum].instance].ship_info_index].flags[Ship::Info_Flags::Knossos_device])){
+		return false;
+	}
+			
+	// don't send him info for himself
+	if ( &Objects[objnum] == player_obj ){
+		return false;
+	}
 
-	// objects in front take precedence
-	if((dot1 < 0.0f) && (dot2 >= 0.0f)){
+	// don't send info for his targeted ship here, since its always done first
+	if((pl->s_info.target_objnum != -1) && (objnum == pl->s_info.target_objnum)){
 		return false;
-	} else if((dot2 < 0.0f) && (dot1 >= 0.0f)){
+	}
+
+	return true;
+}
+
+// pick the ships near the player or in view, and a few of the others. return the number of ships added to OO_ship_index
+int multi_oo_build_interest_list(net_player *pl, object *player_obj)
+{
+	static SCP_vector<int> candidates;
+	interest_set *interest = &OO_interest[NET_PLAYER_NUM(pl)];
+	const interest_params &params = Default_interest_params;
+	int ship_index = 0;
+
+	// everything that may have come close or into view
+	candidates.clear();
+	obj_grid_query_sphere(&player_obj->pos, params.near_dist, OBJ_GRID_TYPE_MASK(OBJ_SHIP), [&](int objnum) {
+		candidates.push_back(objnum);
+	});
+	obj_grid_query_cone(&player_obj->pos, &player_obj->orient.vec.fvec, params.view_dot, params.view_dist, OBJ_GRID_TYPE_MASK(OBJ_SHIP), [&](int objnum) {
+		candidates.push_back(objnum);
+	});
+
+	interest->update(&player_obj->pos, &player_obj->orient.vec.fvec, params, candidates, [&](int objnum, int *signature, vec3d *pos) {
+		if(!multi_oo_ship_sendable(pl, player_obj, objnum)){
+			return false;
+		}
+		if((*signature != -1) && (*signature != Objects[objnum].signature)){
+			return false;
+		}
+
+		*signature = Objects[objnum].signature;
+		*pos = Objects[objnum].pos;
 		return true;
+	});
+
+	for(auto &m : interest->members()){
+		if(ship_index < MAX_SHIPS){
+			OO_ship_index[ship_index++] = (short)Objects[m.objnum].instance;
+		}
 	}
 
-	// otherwise go by distance
-	return (dist1 < dist2);
+	// the ships the player is interested in go first
+	multi_oo_sort_ship_list(pl, player_obj, ship_index);
+
+	// and then a few of the others which are due for an update
+	interest->for_each_far(MAX_SHIPS, params.max_far, [&](int shipnum) {
+		int objnum = Ships[shipnum].objnum;
+
+		if((objnum < 0) || !multi_oo_ship_sendable(pl, player_obj, objnum)){
+			return -1;
+		}
+
+		int stamp = Ships[shipnum].np_updates[NET_PLAYER_NUM(pl)].update_stamp;
+		if((stamp != -1) && !timestamp_elapsed_safe(stamp, OO_MAX_TIMESTAMP)){
+			return -1;
+		}
+
+		return objnum;
+	}, [&](int objnum) {
+		if(ship_index < MAX_SHIPS){
+			OO_ship_index[ship_index++] = (short)Objects[objnum].instance;
+		}
+	});
+
+	return ship_index;
 }
 
 // build the list of ship indices to use when updating for this player
@@ -214,56 +422,465 @@ void multi_oo_build_ship_list(net_player *pl)
 		return;
 	}
 	player_obj = &Objects[pl->m_player->objnum];
+
+	// only look at the ships around the player if we can find them quickly
+	if(Multi_oo_interest_enabled && obj_grid_available()){
+		multi_oo_build_interest_list(pl, player_obj);
+		return;
+	}
 	
 	// go through all other relevant objects
 	ship_index = 0;
 	for ( moveup = GET_FIRST(&Ship_obj_list); moveup != END_OF_LIST(&Ship_obj_list); moveup = GET_NEXT(moveup) ) {
-		// if it is an invalid ship object, skip it
-		if((moveup->objnum < 0) || (Objects[moveup->objnum].instance < 0) || (Objects[moveup->objnum].type != OBJ_SHIP)){
+		if(!multi_oo_ship_sendable(pl, player_obj, moveup->objnum)){
 			continue;
 		}
 
-		// if we're a standalone server, don't send any data regarding its pseudo-ship
-		if((Game_mode & GM_STANDALONE_SERVER) && ((&Objects[moveup->objnum] == Player_obj) || (Objects[moveup->objnum].net_signature == STANDALONE_SHIP_SIG)) ){
-			continue;
-		}		
-			
-		// must be a ship, a weapon, and _not_ an observer
-		if (Objects[moveup->objnum].flags[Object::Object_Flags::Should_be_dead]){
-			continue;
+		// add the ship 
+		if(ship_index < MAX_SHIPS){
+			OO_ship_index[ship_index++] = (short)Objects[moveup->objnum].instance;
 		}
+	}
 
-		// don't send info for dying ships
-		if (Ships[Objects[moveup->objnum].instance].flags[Ship::Ship_Flags::Dying]){
-			continue;
-		}		
+	// maybe sort the thing here
+	multi_oo_sort_ship_list(pl, player_obj, ship_index);
+}
 
-		// never update the knossos device
-		if ((Ships[Objects[moveup->objnum].instance].ship_info_index >= 0) && (Ships[Objects[moveup->objnum].instance].ship_info_index < static_cast<int>(Ship_info.size())) && (Ship_info[Ships[Objects[moveup->objnum].instance].ship_info_index].flags[Ship::Info_Flags::Knossos_device])){
-			continue;
+DCF(oo_interest_bench, "Measures what building the update lists of all players costs the server (Multiplayer)")
+{
+	int iterations = 100;
+
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: oo_interest_bench [iterations]\n");
+		dc_printf("\tBuilds the ship lists of all connected players with the interest sets and with the full scan\n");
+		dc_printf("\t(default %d times) and prints the time per pass for each. Only works on the server.\n", iterations);
+		return;
+	}
+
+	dc_maybe_stuff_int(&iterations);
+	if (iterations <= 0) {
+		dc_printf("Iteration count must be positive\n");
+		return;
+	}
+
+	if ((Net_player == NULL) || !MULTIPLAYER_MASTER || !(Game_mode & GM_IN_MISSION)) {
+		dc_printf("Must be the server of a running mission\n");
+		return;
+	}
+
+	SCP_vector<net_player*> players;
+	for (int idx = 0; idx < MAX_PLAYERS; idx++) {
+		if (MULTI_CONNECTED(Net_players[idx]) && !MULTI_STANDALONE(Net_players[idx]) && (Net_player != &Net_players[idx]) && (Net_players[idx].m_player->objnum >= 0)) {
+			players.push_back(&Net_players[idx]);
 		}
-				
-		// don't send him info for himself
-		if ( &Objects[moveup->objnum] == player_obj ){
-			continue;
+	}
+	if (players.empty()) {
+		dc_printf("No connected players with a ship\n");
+		return;
+	}
+
+	int num_ships = 0;
+	for (ship_obj *so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so)) {
+		num_ships++;
+	}
+
+	bool interest_enabled = Multi_oo_interest_enabled;
+	std::uint64_t times[2];
+	int listed[2];
+
+	for (int pass = 0; pass < 2; pass++) {
+		Multi_oo_interest_enabled = (pass == 0);
+		listed[pass] = 0;
+
+		std::uint64_t start = timer_get_microseconds();
+		for (int i = 0; i < iterations; ++i) {
+			for (auto pl : players) {
+				multi_oo_build_ship_list(pl);
+			}
+		}
+		times[pass] = timer_get_microseconds() - start;
+
+		// how long the lists are, from the last pass
+		for (auto pl : players) {
+			multi_oo_build_ship_list(pl);
+			for (int idx = 0; (idx < MAX_SHIPS) && (OO_ship_index[idx] >= 0); idx++) {
+				listed[pass]++;
+			}
+		}
+	}
+
+	Multi_oo_interest_enabled = interest_enabled;
+
+	dc_printf("%d ships, %d players%s\n", num_ships, (int)players.size(), obj_grid_available() ? "" : " (no object grid, both passes scan everything)");
+	dc_printf("Interest sets: %.1f us per pass, %.1f ships listed per player\n", (double)times[0] / iterations, (double)listed[0] / players.size());
+	dc_printf("Full scan: %.1f us per pass, %.1f ships listed per player\n", (double)times[1] / iterations, (double)listed[1] / players.size());
+}
+
+// quantize a percentage the same way PACK_PERCENT does
+ubyte multi_oo_percent_byte(float v)
+{
+	if(v < 0.0f){
+		v = 0.0f;
+	}
+
+	return (v * 255.0f) <= 255.0f ? (ubyte)(v * 255.0f) : (ubyte)255;
+}
+
+// record that the object update packet with the given sequence # arrived
+void multi_oo_ack_packet(oo_packet_ack *ack, ushort seq)
+{
+	if(!ack->valid){
+		ack->valid = true;
+		ack->seq = seq;
+		ack->bits = 0;
+		return;
+	}
+
+	int diff = (short)(seq - ack->seq);
+	if(diff > 0){
+		// a newer packet, the previous latest one moves into the bits
+		if(diff < OO_ACK_BITS){
+			ack->bits = (ack->bits << diff) | (1u << (diff - 1));
+		} else if(diff == OO_ACK_BITS){
+			ack->bits = 1u << (OO_ACK_BITS - 1);
+		} else {
+			ack->bits = 0;
 		}
+		ack->seq = seq;
+	} else if((diff < 0) && (-diff <= OO_ACK_BITS)){
+		ack->bits |= 1u << (-diff - 1);
+	}
+}
 
-		// don't send info for his targeted ship here, since its always done first
-		if((pl->s_info.target_objnum != -1) && (moveup->objnum == pl->s_info.target_objnum)){
+// if the object update packet with the given sequence # is known to have arrived
+bool multi_oo_packet_acked(const oo_packet_ack *ack, ushort seq)
+{
+	if(!ack->valid){
+		return false;
+	}
+
+	int diff = (short)(ack->seq - seq);
+	if(diff == 0){
+		return true;
+	}
+	if((diff < 0) || (diff > OO_ACK_BITS)){
+		return false;
+	}
+
+	return (ack->bits & (1u << (diff - 1))) != 0;
+}
+
+// is update sequence # a newer than b
+bool multi_oo_update_seq_newer(ubyte a, ubyte b)
+{
+	return (a != b) && ((ubyte)(a - b) < 128);
+}
+
+// the values of a section of a ship a delta for the player can be made against, or NULL if there are none or the
+// section has to be sent in full
+oo_status_values *multi_oo_status_base(net_player *pl, object *objp, int section, int count)
+{
+	oo_status_baseline *base = &OO_status_baselines[objp->instance][NET_PLAYER_NUM(pl)][section];
+	int idx;
+
+	// the newest values the player acknowledged are the baseline now
+	for(idx=0; idx<OO_STATUS_HISTORY; idx++){
+		oo_status_values *pending = &base->pending[idx];
+
+		if(!pending->valid || !multi_oo_packet_acked(&OO_packet_acks[NET_PLAYER_NUM(pl)], pending->packet_seq)){
 			continue;
 		}
 
-		// add the ship 
-		if(ship_index < MAX_SHIPS){
-			OO_ship_index[ship_index++] = (short)Objects[moveup->objnum].instance;
+		if(!base->acked.valid || (base->acked.net_signature != pending->net_signature) || multi_oo_update_seq_newer(pending->update_seq, base->acked.update_seq)){
+			std::swap(base->acked, *pending);
 		}
+		pending->valid = false;
 	}
 
-	// maybe sort the thing here
-	OO_player_obj = player_obj;
-	if (OO_sort) {
-		std::sort(OO_ship_index, OO_ship_index + ship_index, multi_oo_sort_func);
+	// every so often everything is sent anyway
+	if((base->full_stamp == -1) || timestamp_elapsed(base->full_stamp)){
+		base->full_stamp = timestamp(OO_STATUS_FULL_TIME);
+		return NULL;
+	}
+
+	// a delta is only possible against values of this very ship
+	if(!base->acked.valid || (base->acked.net_signature != objp->net_signature) || (base->acked.values.size() != (size_t)count)){
+		return NULL;
+	}
+
+	// and which the player still has, he only keeps the last few
+	ubyte update_seq = Ships[objp->instance].np_updates[NET_PLAYER_NUM(pl)].seq;
+	if((ubyte)(update_seq - base->acked.update_seq) >= OO_STATUS_HISTORY){
+		return NULL;
+	}
+
+	return &base->acked;
+}
+
+// keep the values of a section which were just packed until the player acknowledges them
+void multi_oo_status_sent(net_player *pl, object *objp, int section, const int *values, int count)
+{
+	int player_index = NET_PLAYER_NUM(pl);
+	oo_status_baseline *base = &OO_status_baselines[objp->instance][player_index][section];
+	oo_status_values *pending = &base->pending[base->pending_next];
+
+	base->pending_next = (base->pending_next + 1) % OO_STATUS_HISTORY;
+
+	pending->valid = true;
+	pending->net_signature = objp->net_signature;
+	pending->update_seq = Ships[objp->instance].np_updates[player_index].seq;
+	pending->packet_seq = OO_packet_seq[player_index];
+	pending->values.assign(values, values + count);
+}
+
+// pack a status section of a ship, as a delta against what the player has if that is smaller. return bytes added
+int multi_oo_pack_status(net_player *pl, object *objp, int section, const ubyte *values, int count, ubyte *data)
+{
+	int packet_size = 0;
+	ubyte mask[(OO_MAX_STATUS_VALUES + 7) / 8];
+	int mask_size = (count + 7) / 8;
+	int sent[OO_MAX_STATUS_VALUES];
+	int changed = 0;
+	int idx;
+
+	Assert((count >= 0) && (count <= OO_MAX_STATUS_VALUES));
+
+	oo_status_values *base = multi_oo_status_base(pl, objp, section, count);
+
+	if(base != NULL){
+		memset(mask, 0, mask_size);
+		for(idx=0; idx<count; idx++){
+			if(values[idx] != base->values[idx]){
+				mask[idx / 8] |= (ubyte)(1 << (idx % 8));
+				changed++;
+			}
+		}
+	}
+
+	// mode and count, then either all values or the baseline sequence #, the mask and the changed values
+	int full_size = 2 + count;
+	int delta_size = 3 + mask_size + changed;
+	ubyte mode = ((base != NULL) && (delta_size < full_size)) ? OO_STATUS_DELTA : OO_STATUS_FULL;
+	ubyte n = (ubyte)count;
+
+	ADD_DATA(mode);
+	ADD_DATA(n);
+	if(mode == OO_STATUS_DELTA){
+		ADD_DATA(base->update_seq);
+		memcpy(data + packet_size, mask, mask_size);
+		packet_size += mask_size;
+
+		for(idx=0; idx<count; idx++){
+			if(mask[idx / 8] & (1 << (idx % 8))){
+				ADD_DATA(values[idx]);
+			}
+		}
+	} else {
+		memcpy(data + packet_size, values, count);
+		packet_size += count;
+	}
+
+	// what the deltas saved
+	multi_rate_add(NET_PLAYER_NUM(pl), "dsv", full_size - packet_size);
+
+	for(idx=0; idx<count; idx++){
+		sent[idx] = values[idx];
+	}
+	multi_oo_status_sent(pl, objp, section, sent, count);
+
+	return packet_size;
+}
+
+// pack the quantized position or orientation of a ship, as a delta against what the player has if it fits into one
+// of the widths. fields is NULL for values which can't be sent as a delta. return bytes added, which is only the mode
+// if the caller has to add the full values
+int multi_oo_pack_fields(net_player *pl, object *objp, int section, int *fields, int count, const int *widths, int num_widths, ubyte *data)
+{
+	int packet_size = 0;
+	ubyte bits = OO_STATUS_FULL;
+
+	oo_status_values *base = multi_oo_status_base(pl, objp, section, count);
+
+	if((base != NULL) && (fields != NULL)){
+		bits = (ubyte)multi_field_delta_bits(base->values.data(), fields, count, widths, num_widths);
+	}
+
+	ADD_DATA(bits);
+	if(bits != OO_STATUS_FULL){
+		ADD_DATA(base->update_seq);
+		packet_size += multi_pack_unpack_field_deltas(1, data + packet_size, base->values.data(), fields, count, bits);
+	}
+
+	if(fields != NULL){
+		multi_oo_status_sent(pl, objp, section, fields, count);
+	}
+
+	return packet_size;
+}
+
+// the update which was just packed for this ship goes into a later packet than the one it was packed for
+void multi_oo_status_moved_to_packet(net_player *pl, object *objp, ushort packet_seq)
+{
+	int section, idx;
+
+	// multi_oo_maybe_update() already incremented the sequence # of the ship
+	ubyte update_seq = (ubyte)(Ships[objp->instance].np_updates[NET_PLAYER_NUM(pl)].seq - 1);
+
+	for(section=0; section<OO_NUM_STATUS_SECTIONS; section++){
+		for(idx=0; idx<OO_STATUS_HISTORY; idx++){
+			oo_status_values *pending = &OO_status_baselines[objp->instance][NET_PLAYER_NUM(pl)][section].pending[idx];
+
+			if(pending->valid && (pending->update_seq == update_seq)){
+				pending->packet_seq = packet_seq;
+			}
+		}
+	}
+}
+
+// the values of a section of a ship a delta we received refers to, or NULL if we don't have them
+oo_status_values *multi_oo_status_find(object *objp, int section, ubyte base_seq, int count)
+{
+	int idx;
+
+	for(idx=0; idx<OO_STATUS_HISTORY; idx++){
+		oo_status_values *hist = &OO_status_history[objp->instance][section][idx];
+		if(hist->valid && (hist->net_signature == objp->net_signature) && (hist->update_seq == base_seq) && (hist->values.size() == (size_t)count)){
+			return hist;
+		}
+	}
+
+	return NULL;
+}
+
+// keep the values of a section we received so that later deltas can refer to them
+void multi_oo_status_record(object *objp, int section, ubyte update_seq, const int *values, int count)
+{
+	int *next = &OO_status_history_next[objp->instance][section];
+	oo_status_values *hist = &OO_status_history[objp->instance][section][*next];
+	*next = (*next + 1) % OO_STATUS_HISTORY;
+
+	hist->valid = true;
+	hist->net_signature = objp->net_signature;
+	hist->update_seq = update_seq;
+	hist->values.assign(values, values + count);
+}
+
+// unpack a status section of a ship, return bytes processed. count is set to the number of values, or to -1 if this
+// is a delta against values we don't have
+int multi_oo_unpack_status(object *objp, int section, ubyte update_seq, ubyte *data, ubyte *values, int *count)
+{
+	int offset = 0;
+	ubyte mode, n;
+	int received[OO_MAX_STATUS_VALUES];
+	int idx;
+
+	GET_DATA(mode);
+	GET_DATA(n);
+	*count = n;
+
+	if(mode == OO_STATUS_FULL){
+		memcpy(values, data + offset, n);
+		offset += n;
+	} else {
+		ubyte base_seq;
+		GET_DATA(base_seq);
+
+		ubyte *mask = data + offset;
+		offset += (n + 7) / 8;
+
+		oo_status_values *base = multi_oo_status_find(objp, section, base_seq, n);
+
+		for(idx=0; idx<n; idx++){
+			if(mask[idx / 8] & (1 << (idx % 8))){
+				GET_DATA(values[idx]);
+			} else if(base != NULL){
+				values[idx] = (ubyte)base->values[idx];
+			}
+		}
+
+		if(base == NULL){
+			*count = -1;
+			return offset;
+		}
+	}
+
+	for(idx=0; idx<n; idx++){
+		received[idx] = values[idx];
+	}
+	multi_oo_status_record(objp, section, update_seq, received, n);
+
+	return offset;
+}
+
+// unpack the quantized position or orientation of a ship, return bytes processed. if it was a delta fields is filled
+// in and *found tells if we had the values it refers to, otherwise *full is set and the caller unpacks the full values
+int multi_oo_unpack_fields(object *objp, int section, ubyte *data, int *fields, int count, bool *full, bool *found)
+{
+	int offset = 0;
+	ubyte bits;
+
+	GET_DATA(bits);
+	*full = (bits == OO_STATUS_FULL);
+	*found = false;
+
+	if(!*full){
+		ubyte base_seq;
+		GET_DATA(base_seq);
+
+		oo_status_values *base = multi_oo_status_find(objp, section, base_seq, count);
+
+		offset += multi_pack_unpack_field_deltas(0, data + offset, (base != NULL) ? base->values.data() : NULL, fields, count, bits);
+		*found = (base != NULL);
+	}
+
+	return offset;
+}
+
+// unpack the position of a ship from the server, return bytes processed. *has_pos is set if pos was filled in
+int multi_oo_unpack_position(object *objp, ubyte update_seq, ubyte *data, vec3d *pos, bool *has_pos)
+{
+	int fields[OO_POS_FIELDS];
+	bool full;
+	int offset = multi_oo_unpack_fields(objp, OO_STATUS_POS, data, fields, OO_POS_FIELDS, &full, has_pos);
+
+	if(full){
+		offset += multi_pack_unpack_position(0, data + offset, pos, fields);
+		*has_pos = true;
+	} else if(*has_pos){
+		multi_fields_to_position(fields, pos);
+	} else {
+		return offset;
 	}
+
+	multi_oo_status_record(objp, OO_STATUS_POS, update_seq, fields, OO_POS_FIELDS);
+
+	return offset;
+}
+
+// unpack the orientation of a ship from the server, return bytes processed. *has_orient is set if orient was filled in
+int multi_oo_unpack_orientation(object *objp, ubyte update_seq, ubyte *data, matrix *orient, bool *has_orient)
+{
+	int fields[OO_ORIENT_FIELDS];
+	bool full;
+	int offset = multi_oo_unpack_fields(objp, OO_STATUS_ORIENT, data, fields, OO_ORIENT_FIELDS, &full, has_orient);
+
+	if(full){
+		offset += multi_pack_unpack_orient(0, data + offset, orient, fields);
+		*has_orient = true;
+
+		// the whole matrix can't be a baseline
+		if(fields[0] == OO_ORIENT_NO_FIELDS){
+			return offset;
+		}
+	} else if(*has_orient){
+		multi_fields_to_orient(fields, orient);
+	} else {
+		return offset;
+	}
+
+	multi_oo_status_record(objp, OO_STATUS_ORIENT, update_seq, fields, OO_ORIENT_FIELDS);
+
+	return offset;
 }
 
 // pack information for a client (myself), return bytes added
@@ -342,6 +959,12 @@ int multi_oo_pack_client_data(ubyte *data)
 	ADD_DATA( t_subsys );
 	ADD_DATA( l_subsys );
 
+	// the object update packets we got from the server
+	ubyte ack_valid = OO_received_packets.valid ? 1 : 0;
+	ADD_DATA( ack_valid );
+	ADD_USHORT( OO_received_packets.seq );
+	ADD_UINT( OO_received_packets.bits );
+
 	return packet_size;
 }
 
@@ -407,7 +1030,20 @@ int multi_oo_pack_data(net_player *pl, object *objp, ubyte oo_flags, ubyte *data
 		
 	// position, velocity
 	if ( oo_flags & OO_POS_NEW ) {		
-		ret = (ubyte)multi_pack_unpack_position( 1, data + packet_size + header_bytes, &objp->pos );
+		// the server sends the position as a delta if it can
+		if(MULTIPLAYER_MASTER){
+			int fields[OO_POS_FIELDS];
+
+			multi_position_to_fields(&objp->pos, fields);
+			ret = (ubyte)multi_oo_pack_fields(pl, objp, OO_STATUS_POS, fields, OO_POS_FIELDS, OO_pos_delta_bits, sizeof(OO_pos_delta_bits) / sizeof(int), data + packet_size + header_bytes);
+			if(data[packet_size + header_bytes] == OO_STATUS_FULL){
+				ret += (ubyte)multi_pack_unpack_position( 1, data + packet_size + header_bytes + ret, &objp->pos );
+			} else {
+				multi_rate_add(NET_PLAYER_NUM(pl), "dsv", 1 + OO_POS_RET_SIZE - ret);
+			}
+		} else {
+			ret = (ubyte)multi_pack_unpack_position( 1, data + packet_size + header_bytes, &objp->pos );
+		}
 		packet_size += ret;
 		
 		// global records
@@ -422,7 +1058,20 @@ int multi_oo_pack_data(net_player *pl, object *objp, ubyte oo_flags, ubyte *data
 
 	// orientation	
 	if(oo_flags & OO_ORIENT_NEW){
-		ret = (ubyte)multi_pack_unpack_orient( 1, data + packet_size + header_bytes, &objp->orient );
+		// the server sends the orientation as a delta if it can
+		if(MULTIPLAYER_MASTER){
+			int fields[OO_ORIENT_FIELDS];
+			bool has_fields = multi_orient_to_fields(&objp->orient, fields);
+
+			ret = (ubyte)multi_oo_pack_fields(pl, objp, OO_STATUS_ORIENT, has_fields ? fields : NULL, OO_ORIENT_FIELDS, OO_orient_delta_bits, sizeof(OO_orient_delta_bits) / sizeof(int), data + packet_size + header_bytes);
+			if(data[packet_size + header_bytes] == OO_STATUS_FULL){
+				ret += (ubyte)multi_pack_unpack_orient( 1, data + packet_size + header_bytes + ret, &objp->orient );
+			} else {
+				multi_rate_add(NET_PLAYER_NUM(pl), "dsv", 1 + OO_ORIENT_RET_SIZE + 1 - ret);
+			}
+		} else {
+			ret = (ubyte)multi_pack_unpack_orient( 1, data + packet_size + header_bytes, &objp->orient );
+		}
 		// Assert(ret == OO_ORIENT_RET_SIZE);
 		packet_size += ret;
 		multi_rate_add(NET_PLAYER_NUM(pl), "ori", ret);				
@@ -445,22 +1094,25 @@ int multi_oo_pack_data(net_player *pl, object *objp, ubyte oo_flags, ubyte *data
 
 	// hull info
 	if ( oo_flags & OO_HULL_NEW ){
+		ubyte values[OO_MAX_STATUS_VALUES];
+		int count = 0;
+
 		// add the hull value for this guy		
 		temp = get_hull_pct(objp);
 		if ( (temp < 0.004f) && (temp > 0.0f) ) {
 			temp = 0.004f;		// 0.004 is the lowest positive value we can have before we zero out when packing
 		}
-		PACK_PERCENT(temp);				
-		multi_rate_add(NET_PLAYER_NUM(pl), "hul", 1);	
+		values[count++] = multi_oo_percent_byte(temp);
 
 		float quad = shield_get_max_quad(objp);
 
-		for (int i = 0; i < objp->n_quadrants; i++) {
-			temp = (objp->shield_quadrant[i] / quad);
-			PACK_PERCENT(temp);
+		for (int i = 0; (i < objp->n_quadrants) && (count < OO_MAX_STATUS_VALUES); i++) {
+			values[count++] = multi_oo_percent_byte(objp->shield_quadrant[i] / quad);
 		}
-				
-		multi_rate_add(NET_PLAYER_NUM(pl), "shl", objp->n_quadrants);	
+
+		int status_size = multi_oo_pack_status(pl, objp, OO_STATUS_HULL, values, count, data + packet_size + header_bytes);
+		packet_size += status_size;
+		multi_rate_add(NET_PLAYER_NUM(pl), "hul", status_size);	
 	}	
 
 	// subsystem info
@@ -470,25 +1122,25 @@ int multi_oo_pack_data(net_player *pl, object *objp, ubyte oo_flags, ubyte *data
 				
 		// just in case we have some kind of invalid data (should've been taken care of earlier in this function)
 		if(shipp->ship_info_index < 0){
+			ubyte mode = OO_STATUS_FULL;
 			ns = 0;
+			PACK_BYTE( mode );
 			PACK_BYTE( ns );
 
-			multi_rate_add(NET_PLAYER_NUM(pl), "sub", 1);	
+			multi_rate_add(NET_PLAYER_NUM(pl), "sub", 2);	
 		}
 		// add the # of subsystems, and their data
 		else {
-			ns = (ubyte)Ship_info[shipp->ship_info_index].n_subsystems;
-			PACK_BYTE( ns );
+			ubyte values[OO_MAX_STATUS_VALUES];
+			int count = 0;
 
-			multi_rate_add(NET_PLAYER_NUM(pl), "sub", 1);	
-
-			// now the subsystems.
-			for ( subsysp = GET_FIRST(&shipp->subsys_list); subsysp != END_OF_LIST(&shipp->subsys_list); subsysp = GET_NEXT(subsysp) ) {
-				temp = (float)subsysp->current_hits / (float)subsysp->max_hits;
-				PACK_PERCENT(temp);
-				
-				multi_rate_add(NET_PLAYER_NUM(pl), "sub", 1);
+			for ( subsysp = GET_FIRST(&shipp->subsys_list); (subsysp != END_OF_LIST(&shipp->subsys_list)) && (count < OO_MAX_STATUS_VALUES); subsysp = GET_NEXT(subsysp) ) {
+				values[count++] = multi_oo_percent_byte((float)subsysp->current_hits / (float)subsysp->max_hits);
 			}
+
+			int status_size = multi_oo_pack_status(pl, objp, OO_STATUS_SUBSYS, values, count, data + packet_size + header_bytes);
+			packet_size += status_size;
+			multi_rate_add(NET_PLAYER_NUM(pl), "sub", status_size);
 		}
 
 		// ai mode info
@@ -659,6 +1311,22 @@ int multi_oo_unpack_client_data(net_player *pl, ubyte *data)
 	GET_DATA(t_subsys);
 	GET_DATA(l_subsys);
 
+	// which object update packets arrived
+	ubyte ack_valid;
+	ushort ack_seq;
+	uint ack_bits;
+	GET_DATA(ack_valid);
+	GET_USHORT(ack_seq);
+	GET_UINT(ack_bits);
+
+	// newer acknowledgements include everything the older ones did
+	oo_packet_ack *ack = &OO_packet_acks[NET_PLAYER_NUM(pl)];
+	if(ack_valid && (!ack->valid || ((short)(ack_seq - ack->seq) >= 0))){
+		ack->valid = true;
+		ack->seq = ack_seq;
+		ack->bits = ack_bits;
+	}
+
 	// try and find the targeted object
 	tobj = NULL;
 	if(tnet_sig != 0){
@@ -691,6 +1359,37 @@ int multi_oo_unpack_client_data(net_player *pl, ubyte *data)
 	return offset;
 }
 
+// keep the sections of an update from the server which came in after a newer one, without applying anything
+void multi_oo_record_stale_update(object *objp, ubyte oo_flags, ubyte seq_num, ubyte *data)
+{
+	int offset = 0;
+	vec3d pos = objp->pos;
+	matrix orient = objp->orient;
+	physics_info pi = objp->phys_info;
+	ubyte values[OO_MAX_STATUS_VALUES];
+	int count;
+	bool has_values;
+
+	if(oo_flags & OO_POS_NEW){
+		offset += multi_oo_unpack_position(objp, seq_num, data + offset, &pos, &has_values);
+		offset += multi_pack_unpack_vel(0, data + offset, &objp->orient, &pos, &pi);
+	}
+	if(oo_flags & OO_ORIENT_NEW){
+		offset += multi_oo_unpack_orientation(objp, seq_num, data + offset, &orient, &has_values);
+		offset += multi_pack_unpack_rotvel(0, data + offset, &orient, &pos, &pi);
+	}
+
+	// forward thrust
+	offset++;
+
+	if(oo_flags & OO_HULL_NEW){
+		offset += multi_oo_unpack_status(objp, OO_STATUS_HULL, seq_num, data + offset, values, &count);
+	}
+	if(oo_flags & OO_SUBSYSTEMS_AND_AI_NEW){
+		multi_oo_unpack_status(objp, OO_STATUS_SUBSYS, seq_num, data + offset, values, &count);
+	}
+}
+
 // unpack the object data, return bytes processed
 #define UNPACK_PERCENT(v)					{ ubyte temp_byte; memcpy(&temp_byte, data + offset, sizeof(ubyte)); v = (float)temp_byte / 255.0f; offset++;}
 int multi_oo_unpack_data(net_player *pl, ubyte *data)
@@ -747,6 +1446,11 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	if(seq_num < shipp->np_updates[NET_PLAYER_NUM(pl)].seq){
 		// non-wraparound case
 		if((shipp->np_updates[NET_PLAYER_NUM(pl)].seq - seq_num) <= 100){
+			// the server only knows that the packet arrived, so it may send deltas against what is in here
+			if(!MULTIPLAYER_MASTER){
+				multi_oo_record_stale_update(pobjp, oo_flags, seq_num, data + offset);
+			}
+
 			offset += data_size;
 			return offset;
 		}
@@ -764,6 +1468,10 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	vec3d new_pos = pobjp->pos;
 	physics_info new_phys_info = pobjp->phys_info;
 	matrix new_orient = pobjp->orient;
+
+	// a delta against values we don't have leaves the position or orientation as it is
+	bool has_pos = true;
+	bool has_orient = true;
 	
 	// position
 	if ( oo_flags & OO_POS_NEW ) {						
@@ -788,7 +1496,12 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 		oo_arrive_time_next[shipp - Ships] = 0.0f;
 
 		// int r1 = multi_pack_unpack_position( 0, data + offset, &pobjp->pos );
-		int r1 = multi_pack_unpack_position( 0, data + offset, &new_pos );
+		int r1;
+		if(MULTIPLAYER_MASTER){
+			r1 = multi_pack_unpack_position( 0, data + offset, &new_pos );
+		} else {
+			r1 = multi_oo_unpack_position( pobjp, seq_num, data + offset, &new_pos, &has_pos );
+		}
 		offset += r1;				
 
 		// int r3 = multi_pack_unpack_vel( 0, data + offset, &pobjp->orient, &pobjp->pos, &pobjp->phys_info );
@@ -802,7 +1515,12 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	// orientation	
 	if ( oo_flags & OO_ORIENT_NEW ) {		
 		// int r2 = multi_pack_unpack_orient( 0, data + offset, &pobjp->orient );
-		int r2 = multi_pack_unpack_orient( 0, data + offset, &new_orient );
+		int r2;
+		if(MULTIPLAYER_MASTER){
+			r2 = multi_pack_unpack_orient( 0, data + offset, &new_orient );
+		} else {
+			r2 = multi_oo_unpack_orientation( pobjp, seq_num, data + offset, &new_orient, &has_orient );
+		}
 		offset += r2;		
 
 		// int r5 = multi_pack_unpack_rotvel( 0, data + offset, &pobjp->orient, &pobjp->pos, &pobjp->phys_info );
@@ -819,7 +1537,7 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	GET_DATA(percent);		
 
 	// now stuff all this new info
-	if(oo_flags & OO_POS_NEW){
+	if((oo_flags & OO_POS_NEW) && has_pos){
 		// if we're past the position update tolerance, bash.
 		// this should cause our 2 interpolation splines to be exactly the same. so we'll see a jump,
 		// but it should be nice and smooth immediately afterwards
@@ -836,14 +1554,17 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 
 			multi_oo_calc_interp_splines(SHIP_INDEX(shipp), &pobjp->pos, &pobjp->orient, &pobjp->phys_info, &new_pos, &new_orient, &new_phys_info);
 		}
-		
+	}
+	if(oo_flags & OO_POS_NEW){
 		pobjp->phys_info.vel = new_phys_info.vel;		
 		pobjp->phys_info.desired_vel = new_phys_info.vel;
 	} 
 
 	// we'll just sim rotation straight. it works fine.
 	if(oo_flags & OO_ORIENT_NEW){
-		pobjp->orient = new_orient;
+		if(has_orient){
+			pobjp->orient = new_orient;
+		}
 		pobjp->phys_info.rotvel = new_phys_info.rotvel;
 		// pobjp->phys_info.desired_rotvel = vmd_zero_vector;
 		pobjp->phys_info.desired_rotvel = new_phys_info.rotvel;
@@ -856,36 +1577,40 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 	
 	// hull info
 	if ( oo_flags & OO_HULL_NEW ){
-		UNPACK_PERCENT(fpct);
-		pobjp->hull_strength = fpct * Ships[pobjp->instance].ship_max_hull_strength;		
+		ubyte values[OO_MAX_STATUS_VALUES];
+		int count;
 
-		float quad = shield_get_max_quad(pobjp);
+		offset += multi_oo_unpack_status(pobjp, OO_STATUS_HULL, seq_num, data + offset, values, &count);
 
-		for (int i = 0; i < pobjp->n_quadrants; i++) {
-			UNPACK_PERCENT(fpct);
-			pobjp->shield_quadrant[i] = fpct * quad;
+		// a delta against values we don't have is skipped, the next full update fixes that
+		if(count == 1 + pobjp->n_quadrants){
+			fpct = (float)values[0] / 255.0f;
+			pobjp->hull_strength = fpct * Ships[pobjp->instance].ship_max_hull_strength;		
+
+			float quad = shield_get_max_quad(pobjp);
+
+			for (int i = 0; i < pobjp->n_quadrants; i++) {
+				fpct = (float)values[1 + i] / 255.0f;
+				pobjp->shield_quadrant[i] = fpct * quad;
+			}
 		}
 	}	
 
 	if ( oo_flags & OO_SUBSYSTEMS_AND_AI_NEW ) {
-		ubyte n_subsystems, subsys_count;
-		float subsystem_percent[MAX_MODEL_SUBSYSTEMS];		
+		ubyte values[OO_MAX_STATUS_VALUES];
+		int n_subsystems, subsys_count;
 		ship_subsys *subsysp;		
 		float val;		
-		int i;		
 
 		// get the data for the subsystems
-		GET_DATA( n_subsystems );
-		for ( i = 0; i < n_subsystems; i++ ){
-			UNPACK_PERCENT( subsystem_percent[i] );
-		}		
+		offset += multi_oo_unpack_status(pobjp, OO_STATUS_SUBSYS, seq_num, data + offset, values, &n_subsystems);
 		
-		// fill in the subsystem data
+		// fill in the subsystem data, unless this was a delta against values we don't have
 		subsys_count = 0;
-		for ( subsysp = GET_FIRST(&shipp->subsys_list); subsysp != END_OF_LIST(&shipp->subsys_list); subsysp = GET_NEXT(subsysp) ) {
+		for ( subsysp = GET_FIRST(&shipp->subsys_list); (n_subsystems > 0) && (subsysp != END_OF_LIST(&shipp->subsys_list)); subsysp = GET_NEXT(subsysp) ) {
 			int subsys_type;
 
-			val = subsystem_percent[subsys_count] * subsysp->max_hits;
+			val = ((float)values[subsys_count] / 255.0f) * subsysp->max_hits;
 			subsysp->current_hits = val;
 
 			// add the value just generated (it was zero'ed above) into the array of generic system types
@@ -903,7 +1628,9 @@ int multi_oo_unpack_data(net_player *pl, ubyte *data)
 		}
 		
 		// recalculate all ship subsystems
-		ship_recalc_subsys_strength( shipp );			
+		if(n_subsystems > 0){
+			ship_recalc_subsys_strength( shipp );
+		}
 
 		// ai mode info
 		ubyte umode;
@@ -1247,6 +1974,11 @@ void multi_oo_process_all(net_player *pl)
 	}
 
 	object *targ_obj;	
+	int player_index = NET_PLAYER_NUM(pl);
+
+	// what the player may be sent now, and what went out in earlier packets of this frame
+	int budget = multi_oo_rate_budget(pl);
+	int spent = 0;
 
 	// build the list of ships to check against
 	multi_oo_build_ship_list(pl);
@@ -1255,6 +1987,7 @@ void multi_oo_process_all(net_player *pl)
 	if((pl->s_info.target_objnum != -1) && (Objects[pl->s_info.target_objnum].type == OBJ_SHIP)){
 		// build the header
 		BUILD_HEADER(OBJECT_UPDATE);		
+		ADD_USHORT(OO_packet_seq[player_index]);
 	
 		// get a pointer to the object
 		targ_obj = &Objects[pl->s_info.target_objnum];
@@ -1274,17 +2007,17 @@ void multi_oo_process_all(net_player *pl)
 	} else {
 		// just build the header for the rest of the function
 		BUILD_HEADER(OBJECT_UPDATE);		
+		ADD_USHORT(OO_packet_seq[player_index]);
 	}
 		
 	idx = 0;
 	// rely on logical-AND shortcut evaluation to prevent array out-of-bounds read of OO_ship_index[idx]
 	while((idx < MAX_SHIPS) && (OO_ship_index[idx] >= 0)){
-		// if this guy is over his datarate limit, do nothing
-		if(multi_oo_rate_exceeded(pl)){
+		// if this guy is over his datarate budget, the rest of the ships wait. they're sorted so that those matter least
+		// and gain priority while they wait
+		if((budget >= 0) && (spent + packet_size + UDP_HEADER_SIZE >= budget)){
 			nprintf(("Network","Capping client\n"));
-			idx++;
-
-			continue;
+			break;
 		}			
 
 		// get the object
@@ -1301,9 +2034,17 @@ void multi_oo_process_all(net_player *pl)
 									
 			multi_io_send(pl, data, packet_size);
 			pl->s_info.rate_bytes += packet_size + UDP_HEADER_SIZE;
+			spent += packet_size + UDP_HEADER_SIZE;
+			OO_packet_seq[player_index]++;
 
 			packet_size = 0;
 			BUILD_HEADER(OBJECT_UPDATE);			
+			ADD_USHORT(OO_packet_seq[player_index]);
+
+			// the ship's status values go out with the next packet
+			if(add_size){
+				multi_oo_status_moved_to_packet(pl, moveup, OO_packet_seq[player_index]);
+			}
 		}
 
 		if(add_size){
@@ -1320,15 +2061,19 @@ void multi_oo_process_all(net_player *pl)
 		idx++;
 	}
 
-	// if we have anything more than 3 byte in the packet, send the last one off
-	if(packet_size > 3){
+	// if we have anything more than the header and sequence # in the packet, send the last one off
+	if(packet_size > HEADER_LENGTH + 2){
 		stop = 0x00;		
 		multi_rate_add(NET_PLAYER_NUM(pl), "stp", 1);
 		ADD_DATA(stop);
 								
 		multi_io_send(pl, data, packet_size);
 		pl->s_info.rate_bytes += packet_size + UDP_HEADER_SIZE;
+		spent += packet_size + UDP_HEADER_SIZE;
+		OO_packet_seq[player_index]++;
 	}
+
+	multi_oo_rate_spend(pl, spent);
 }
 
 // process all object update details for this frame
@@ -1370,6 +2115,13 @@ void multi_oo_process_update(ubyte *data, header *hinfo)
 		pl = Net_player;
 	}
 
+	// packets from the server are numbered so that we can acknowledge them
+	if(!MULTIPLAYER_MASTER){
+		ushort packet_seq;
+		GET_USHORT(packet_seq);
+		multi_oo_ack_packet(&OO_received_packets, packet_seq);
+	}
+
 	GET_DATA(stop);
 	
 	while(stop == 0xff){
@@ -1419,6 +2171,19 @@ void multi_oo_gameplay_init()
 			oo_arrive_time_count[shipp - Ships] = 0;			
 			oo_interp_count[shipp - Ships] = 0;
 
+			// forget all status baselines
+			for(idx=0; idx<OO_NUM_STATUS_SECTIONS; idx++){
+				int p_idx, h_idx;
+
+				for(p_idx=0; p_idx<MAX_PLAYERS; p_idx++){
+					OO_status_baselines[s_idx][p_idx][idx] = oo_status_baseline();
+				}
+				for(h_idx=0; h_idx<OO_STATUS_HISTORY; h_idx++){
+					OO_status_history[s_idx][idx][h_idx] = oo_status_values();
+				}
+				OO_status_history_next[s_idx][idx] = 0;
+			}
+
 			// increment the time
 //			cur += split;			
 		}
@@ -1428,7 +2193,12 @@ void multi_oo_gameplay_init()
 	extern int OO_gran;
 	for(idx=0; idx<MAX_PLAYERS; idx++){
 		Net_players[idx].s_info.rate_stamp = timestamp( (int)(1000.0f / (float)OO_gran) );
+
+		OO_packet_seq[idx] = 0;
+		OO_packet_acks[idx] = oo_packet_ack();
+		OO_interest[idx].clear();
 	}
+	OO_received_packets = oo_packet_ack();
 }
 
 // send control info for a client (which is basically a "reverse" object update)
@@ -1506,6 +2276,7 @@ void multi_oo_send_changed_object(object *changedobj)
 	}
 	// build the header
 	BUILD_HEADER(OBJECT_UPDATE);		
+	ADD_USHORT(OO_packet_seq[idx]);
 
 	// pos and orient always
 	oo_flags = (OO_POS_NEW | OO_ORIENT_NEW);
@@ -1529,10 +2300,11 @@ void multi_oo_send_changed_object(object *changedobj)
 	multi_rate_add(idx, "stp", 1);
 	ADD_DATA(stop);
 
-	// increment sequence #
-//	Player_ship->np_updates[idx].seq++;
+	// increment sequence #, the sections just packed are kept as baselines under it
+	Ships[changedobj->instance].np_updates[idx].seq++;
 
 	multi_io_send(&Net_players[idx], data, packet_size);
+	OO_packet_seq[idx]++;
 }
 
 
@@ -1566,6 +2338,13 @@ int OO_client_rate = -1;							// max bandwidth to go to an individual client
 #define RATE_UPDATE_TIME		1250				// in ms
 int OO_server_rate_stamp = -1;
 
+// object update bytes each player may still be sent this frame, refilled at his datarate limit
+float OO_rate_budget[MAX_PLAYERS];
+int OO_rate_budget_time[MAX_PLAYERS];					// when it was last refilled, -1 for a fresh start
+
+// how many ms of a player's datarate the budget holds at most, so that a quiet moment doesn't turn into a burst
+#define OO_RATE_BUDGET_BURST	250
+
 // bandwidth granularity
 int OO_gran = 1;
 DCF(oog, "Sets bandwidth granularity (Multiplayer)")
@@ -1697,10 +2476,13 @@ void multi_oo_rate_init(net_player *pl)
 	// reinitialize his datarate timestamp
 	pl->s_info.rate_stamp = -1;
 	pl->s_info.rate_bytes = 0;
+
+	OO_rate_budget[NET_PLAYER_NUM(pl)] = 0.0f;
+	OO_rate_budget_time[NET_PLAYER_NUM(pl)] = -1;
 }
 
-// if the given net-player has exceeded his datarate limit
-int multi_oo_rate_exceeded(net_player *pl)
+// the bytes the given net-player may be sent per datarate period (1000 / OO_gran ms), or -1 if there is no limit
+int multi_oo_rate_limit(net_player *pl)
 {
 	int rate_compare;
 		
@@ -1725,7 +2507,7 @@ int multi_oo_rate_exceeded(net_player *pl)
 
 	// LAN - no rate max
 	case OBJ_UPDATE_LAN:
-		return 0;
+		return -1;
 
 	// default level
 	default:
@@ -1736,7 +2518,20 @@ int multi_oo_rate_exceeded(net_player *pl)
 
 	// if the server global rate PER CLIENT (OO_client_rate) is actually lower
 	if(OO_client_rate < rate_compare){
-		rate_compare = OO_client_rate;
+		rate_compare = MAX(OO_client_rate, 0);
+	}
+
+	return rate_compare;
+}
+
+// if the given net-player has exceeded his datarate limit
+int multi_oo_rate_exceeded(net_player *pl)
+{
+	int rate_compare = multi_oo_rate_limit(pl);
+
+	// LAN - no rate max
+	if(rate_compare < 0){
+		return 0;
 	}
 
 	// compare his bytes sent against the allowable amount
@@ -1748,6 +2543,44 @@ int multi_oo_rate_exceeded(net_player *pl)
 	return 0;
 }
 
+// refill the object update budget of the given net-player at his datarate limit. returns the bytes he may be sent
+// now, or -1 if there is no limit
+int multi_oo_rate_budget(net_player *pl)
+{
+	int player_index = NET_PLAYER_NUM(pl);
+	int limit = multi_oo_rate_limit(pl);
+	int now = timer_get_milliseconds();
+
+	if(limit < 0){
+		OO_rate_budget_time[player_index] = -1;
+		return -1;
+	}
+
+	// bytes per ms, and the budget never holds more than a short burst
+	float rate = (float)limit * (float)OO_gran / 1000.0f;
+	float burst = rate * (float)OO_RATE_BUDGET_BURST;
+
+	if(OO_rate_budget_time[player_index] == -1){
+		OO_rate_budget[player_index] = burst;
+	} else {
+		OO_rate_budget[player_index] += rate * (float)(now - OO_rate_budget_time[player_index]);
+	}
+	OO_rate_budget_time[player_index] = now;
+
+	if(OO_rate_budget[player_index] > burst){
+		OO_rate_budget[player_index] = burst;
+	}
+
+	return MAX((int)OO_rate_budget[player_index], 0);
+}
+
+// take bytes sent to the given net-player from his object update budget. it may go below zero, which the next
+// refills pay back
+void multi_oo_rate_spend(net_player *pl, int bytes)
+{
+	OO_rate_budget[NET_PLAYER_NUM(pl)] -= (float)bytes;
+}
+
 // if it is ok for me to send a control info (will be ~N times a second)
 int multi_oo_cirate_can_send()
 {
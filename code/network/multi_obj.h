@@ -94,6 +94,13 @@ void multi_oo_rate_init(net_player *pl);
 // if the given net-player has exceeded his datarate limit, or if the overall datarate limit has been reached
 int multi_oo_rate_exceeded(net_player *pl);
 
+// refill the object update budget of the given net-player at his datarate limit. returns the bytes he may be sent
+// now, or -1 if there is no limit
+int multi_oo_rate_budget(net_player *pl);
+
+// take bytes sent to the given net-player from his object update budget
+void multi_oo_rate_spend(net_player *pl, int bytes);
+
 // if it is ok for me to send a control info (will be ~N times a second)
 int multi_oo_cirate_can_send();
 
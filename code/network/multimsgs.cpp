@@ -394,13 +394,13 @@ void multi_io_send(net_player *pl, ubyte *data, int len)
 		}
 	}
 
-	// If this packet will push the buffer over MAX_PACKET_SIZE, send the current send_buffer
-	if ((pl->s_info.unreliable_buffer_size + len) > MAX_PACKET_SIZE) {		
+	// If this packet will push the buffer over MAX_DATAGRAM_SIZE, send the current send_buffer
+	if ((pl->s_info.unreliable_buffer_size + len) > MAX_DATAGRAM_SIZE) {		
 		multi_io_send_force(pl);
 		pl->s_info.unreliable_buffer_size = 0;
 	}
 
-	Assert((pl->s_info.unreliable_buffer_size + len) <= MAX_PACKET_SIZE);
+	Assert((pl->s_info.unreliable_buffer_size + len) <= MAX_DATAGRAM_SIZE);
 
 	memcpy(pl->s_info.unreliable_buffer + pl->s_info.unreliable_buffer_size, data, len);
 	pl->s_info.unreliable_buffer_size += len;
@@ -551,6 +551,9 @@ void multi_io_send_buffered_packets()
 		return;
 	}
 
+	// hand the datagrams for all players to the OS at once
+	psnet_send_batch_begin();
+
 	// server
 	if(MULTIPLAYER_MASTER){
 		for(idx=0; idx<MAX_PLAYERS; idx++){
@@ -583,6 +586,8 @@ void multi_io_send_buffered_packets()
 			Net_player->s_info.reliable_buffer_size = 0;
 		}
 	}
+
+	psnet_send_batch_end();
 }
 
 //*********************************************************************************************************
@@ -7925,6 +7930,8 @@ void process_event_update_packet(ubyte *data, header *hinfo)
 	GET_INT(Mission_events[u_event].count);
 	PACKET_SET_SIZE();
 
+	sexp_mark_dependency_changed(SEXP_DEP_EVENTS);
+
 	// went from non directive special to directive special
 	if(!(store_flags & MEF_DIRECTIVE_SPECIAL) && (Mission_events[u_event].flags & MEF_DIRECTIVE_SPECIAL)){
 		mission_event_set_directive_special(u_event);
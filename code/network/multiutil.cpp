@@ -1596,7 +1596,7 @@ void multi_create_standalone_object()
 	// make ship hidden from sensors so that this observer cannot target it.  Observers really have two ships
 	// one observer, and one "Player_ship".  Observer needs to ignore the Player_ship.
     Player_ship->flags.set(Ship::Ship_Flags::Hidden_from_sensors);
-	strcpy_s(Player_ship->ship_name, XSTR("Standalone Ship",904));
+	ship_set_name(Player_ship, XSTR("Standalone Ship",904));
 	Player_ai = &Ai_info[Ships[Objects[pobj_num].instance].ai_index];		
 
 }
@@ -3578,30 +3578,47 @@ int bitbuffer_get_signed( bitbuffer *bitbuf, int bit_count )
 	
 
 
+// Quantizes a position the way multi_pack_unpack_position() sends it.
+void multi_position_to_fields(const vec3d *pos, int *fields)
+{
+	fields[0] = (int)std::lround(pos->xyz.x*105.0f);
+	fields[1] = (int)std::lround(pos->xyz.y*105.0f);
+	fields[2] = (int)std::lround(pos->xyz.z*105.0f);
+	CAP(fields[0],-8388608,8388607);
+	CAP(fields[1],-8388608,8388607);
+	CAP(fields[2],-8388608,8388607);
+}
+
+// Turns quantized values back into a position.
+void multi_fields_to_position(const int *fields, vec3d *pos)
+{
+	pos->xyz.x = i2fl(fields[0])/105.0f;
+	pos->xyz.y = i2fl(fields[1])/105.0f;
+	pos->xyz.z = i2fl(fields[2])/105.0f;
+}
+
 // Packs/unpacks an object position.
 // Returns number of bytes read or written.
 // #define OO_POS_RET_SIZE							9
-int multi_pack_unpack_position( int write, ubyte *data, vec3d *pos)
+int multi_pack_unpack_position( int write, ubyte *data, vec3d *pos, int *fields)
 {
 	bitbuffer buf;
 
 	bitbuffer_init(&buf,data);
 
-	int a, b, c;
+	int values[OO_POS_FIELDS];
+
+	if(fields == NULL){
+		fields = values;
+	}
 
 	if ( write )	{
 		// Output pos
-
-		a = (int)std::lround(pos->xyz.x*105.0f);
-		b = (int)std::lround(pos->xyz.y*105.0f);
-		c = (int)std::lround(pos->xyz.z*105.0f);
-		CAP(a,-8388608,8388607);
-		CAP(b,-8388608,8388607);
-		CAP(c,-8388608,8388607);
+		multi_position_to_fields(pos, fields);
 		
-		bitbuffer_put( &buf, (uint)a, 24 );
-		bitbuffer_put( &buf, (uint)b, 24 );
-		bitbuffer_put( &buf, (uint)c, 24 );
+		bitbuffer_put( &buf, (uint)fields[0], 24 );
+		bitbuffer_put( &buf, (uint)fields[1], 24 );
+		bitbuffer_put( &buf, (uint)fields[2], 24 );
 
 
 		return bitbuffer_write_flush(&buf);
@@ -3609,13 +3626,11 @@ int multi_pack_unpack_position( int write, ubyte *data, vec3d *pos)
 	} else {
 
 		// unpack pos
-		a = bitbuffer_get_signed(&buf,24);
-		b = bitbuffer_get_signed(&buf,24);
-		c = bitbuffer_get_signed(&buf,24);
+		fields[0] = bitbuffer_get_signed(&buf,24);
+		fields[1] = bitbuffer_get_signed(&buf,24);
+		fields[2] = bitbuffer_get_signed(&buf,24);
 
-		pos->xyz.x = i2fl(a)/105.0f;
-		pos->xyz.y = i2fl(b)/105.0f;
-		pos->xyz.z = i2fl(c)/105.0f;
+		multi_fields_to_position(fields, pos);
 
 		return bitbuffer_read_flush(&buf);
 	}
@@ -3669,36 +3684,91 @@ hack = bitbuffer_get_unsigned(&buf, 32);
 			hack = bitbuffer_get_unsigned(&buf, 32);
 			memcpy(&orient->vec.rvec.z, &hack, 4);*/
 
+#define N_SCALE 2048.0f
+#define N_MAX_RANGE 2047
+#define N_MIN_RANGE -2048
+
+// Quantizes an orientation the way multi_pack_unpack_orient() sends it.
+// Returns false if it is sent as the whole matrix instead.
+bool multi_orient_to_fields(const matrix *orient, int *fields)
+{
+	vec3d rot_axis;
+	float theta;
+	angles ang;
+
+	// degenerate case
+	vm_extract_angles_matrix(&ang, orient);
+	if((ang.h > 3.130) && (ang.h < 3.150)){
+		return false;
+	}
+
+	vm_matrix_to_rot_axis_and_angle(orient, &theta, &rot_axis);
+	// Have theta, which is an angle between 0 and PI.
+	// Convert it to be between -1.0f and 1.0f
+	theta = theta*2.0f/PI-1.0f;
+
+	// -1 to 1
+	fields[0] = fl2i(rot_axis.xyz.x*N_SCALE);
+	fields[1] = fl2i(rot_axis.xyz.y*N_SCALE);
+	fields[2] = fl2i(rot_axis.xyz.z*N_SCALE);
+	fields[3] = fl2i(theta*N_SCALE);
+
+	CAP(fields[0], N_MIN_RANGE, N_MAX_RANGE);
+	CAP(fields[1], N_MIN_RANGE, N_MAX_RANGE);
+	CAP(fields[2], N_MIN_RANGE, N_MAX_RANGE);
+	CAP(fields[3], N_MIN_RANGE, N_MAX_RANGE);
+
+	return true;
+}
+
+// Turns quantized values back into an orientation.
+void multi_fields_to_orient(const int *fields, matrix *orient)
+{
+	vec3d rot_axis;
+	float theta;
+
+	// special case
+	rot_axis.xyz.x = i2fl(fields[0])/N_SCALE;
+	rot_axis.xyz.y = i2fl(fields[1])/N_SCALE;
+	rot_axis.xyz.z = i2fl(fields[2])/N_SCALE;
+	theta = i2fl(fields[3])/N_SCALE;
+
+	// Convert theta back to range 0-PI
+	theta = (theta+1.0f)*PI_2;
+
+	vm_quaternion_rotate(orient, theta, &rot_axis);
+
+	vm_orthogonalize_matrix(orient);
+}
+
 // Packs/unpacks an orientation matrix.
 // Returns number of bytes read or written.
 // #define OO_ORIENT_RET_SIZE						6
-int multi_pack_unpack_orient( int write, ubyte *data, matrix *orient)
+int multi_pack_unpack_orient( int write, ubyte *data, matrix *orient, int *fields)
 {
 	bitbuffer buf;
 
 	bitbuffer_init(&buf, data + 1);
 
-	vec3d rot_axis;	
-	float theta;
-	int a, b, c, d;
-	angles ang;	
+	int a;
+	int values[OO_ORIENT_FIELDS];
 	ubyte flag = 0x00;	
 
 	#define D_SCALE 32768.0f
 	#define D_MAX_RANGE 32767
 	#define D_MIN_RANGE -32768
 
-	#define N_SCALE 2048.0f
-	#define N_MAX_RANGE 2047
-	#define N_MIN_RANGE -2048
+	if(fields == NULL){
+		fields = values;
+	}
 
 	if ( write )	{			
 		// degenerate case - send the whole orient matrix
-		vm_extract_angles_matrix(&ang, orient);	
-		if((ang.h > 3.130) && (ang.h < 3.150)){
+		if(!multi_orient_to_fields(orient, fields)){
 			degenerate_count++;
 
 			flag = 0xff;
+			fields[0] = OO_ORIENT_NO_FIELDS;
 			
 			// stuff it	
 			a = fl2i(orient->vec.fvec.xyz.x * D_SCALE);
@@ -3732,27 +3802,11 @@ int multi_pack_unpack_orient( int write, ubyte *data, matrix *orient)
 			bitbuffer_put( &buf, a, 16  );
 		} else {
 			non_degenerate_count++;
-				
-			vm_matrix_to_rot_axis_and_angle(orient, &theta, &rot_axis);		
-			// Have theta, which is an angle between 0 and PI.
-			// Convert it to be between -1.0f and 1.0f
-			theta = theta*2.0f/PI-1.0f;			
-
-			// -1 to 1
-			a = fl2i(rot_axis.xyz.x*N_SCALE); 
-			b = fl2i(rot_axis.xyz.y*N_SCALE);
-			c = fl2i(rot_axis.xyz.z*N_SCALE);
-			d = fl2i(theta*N_SCALE);
-
-			CAP(a, N_MIN_RANGE, N_MAX_RANGE);
-			CAP(b, N_MIN_RANGE, N_MAX_RANGE);
-			CAP(c, N_MIN_RANGE, N_MAX_RANGE);
-			CAP(d, N_MIN_RANGE, N_MAX_RANGE);
 					
-			bitbuffer_put( &buf, (uint)a, 12 );
-			bitbuffer_put( &buf, (uint)b, 12 );
-			bitbuffer_put( &buf, (uint)c, 12 );
-			bitbuffer_put( &buf, (uint)d, 12 );
+			bitbuffer_put( &buf, (uint)fields[0], 12 );
+			bitbuffer_put( &buf, (uint)fields[1], 12 );
+			bitbuffer_put( &buf, (uint)fields[2], 12 );
+			bitbuffer_put( &buf, (uint)fields[3], 12 );
 		}
 
 		// flag for degenerate case
@@ -3764,6 +3818,8 @@ int multi_pack_unpack_orient( int write, ubyte *data, matrix *orient)
 
 		// degenerate
 		if(flag){
+			fields[0] = OO_ORIENT_NO_FIELDS;
+
 			a = bitbuffer_get_signed(&buf, 16);
 			orient->vec.fvec.xyz.x = i2fl(a) / D_SCALE;			
 			a = bitbuffer_get_signed(&buf, 16);
@@ -3785,29 +3841,64 @@ int multi_pack_unpack_orient( int write, ubyte *data, matrix *orient)
 			a = bitbuffer_get_signed(&buf, 16);
 			orient->vec.rvec.xyz.z = i2fl(a) / D_SCALE;			
 		} else {
-			a = bitbuffer_get_signed(&buf,12);
-			b = bitbuffer_get_signed(&buf,12);
-			c = bitbuffer_get_signed(&buf,12);
-			d = bitbuffer_get_signed(&buf,12);
-
-			// special case		
-			rot_axis.xyz.x = i2fl(a)/N_SCALE;
-			rot_axis.xyz.y = i2fl(b)/N_SCALE;
-			rot_axis.xyz.z = i2fl(c)/N_SCALE;
-			theta = i2fl(d)/N_SCALE;
-				
-			// Convert theta back to range 0-PI
-			theta = (theta+1.0f)*PI_2;
-				
-			vm_quaternion_rotate(orient, theta, &rot_axis);		
+			fields[0] = bitbuffer_get_signed(&buf,12);
+			fields[1] = bitbuffer_get_signed(&buf,12);
+			fields[2] = bitbuffer_get_signed(&buf,12);
+			fields[3] = bitbuffer_get_signed(&buf,12);
 
-			vm_orthogonalize_matrix(orient);		
+			multi_fields_to_orient(fields, orient);
 		}
 
 		return bitbuffer_read_flush(&buf) + 1;
 	}
 }
 
+// The smallest of the given widths (in bits, ascending) which holds every difference between the quantized values
+// and the base, or 0 if none does.
+int multi_field_delta_bits(const int *base, const int *fields, int count, const int *widths, int num_widths)
+{
+	int largest = 0;
+	int idx;
+
+	for(idx=0; idx<count; idx++){
+		int diff = fields[idx] - base[idx];
+		largest = MAX(largest, (diff < 0) ? -diff - 1 : diff);
+	}
+
+	for(idx=0; idx<num_widths; idx++){
+		if(largest < (1 << (widths[idx] - 1))){
+			return widths[idx];
+		}
+	}
+
+	return 0;
+}
+
+// Packs/unpacks quantized values as differences to the base of the given width each. When unpacking the base may
+// be NULL to just skip the data.
+// Returns number of bytes read or written.
+int multi_pack_unpack_field_deltas(int write, ubyte *data, const int *base, int *fields, int count, int bits)
+{
+	bitbuffer buf;
+	int idx;
+
+	bitbuffer_init(&buf, data);
+
+	if ( write ) {
+		for(idx=0; idx<count; idx++){
+			bitbuffer_put( &buf, (uint)(fields[idx] - base[idx]), bits );
+		}
+
+		return bitbuffer_write_flush(&buf);
+	} else {
+		for(idx=0; idx<count; idx++){
+			int diff = bitbuffer_get_signed(&buf, bits);
+			fields[idx] = (base != NULL) ? base[idx] + diff : diff;
+		}
+
+		return bitbuffer_read_flush(&buf);
+	}
+}
 
 // Packs/unpacks an orientation matrix.
 // Returns number of bytes read or written.
@@ -14,6 +14,8 @@
 
 #include "network/psnet2.h"
 
+#include <climits>
+
 // prototypes instead of headers :)
 struct net_player;
 struct net_addr;
@@ -185,15 +187,34 @@ void multi_display_chat_msg(const char *msg, int player_index, int add_id);
 // fill in Current_file_checksum and Current_file_length
 void multi_get_mission_checksum(const char *filename);
 
-// Packs/unpacks an object position.
+// Packs/unpacks an object position. If given, fields gets the quantized values which were sent.
 // Returns number of bytes read or written.
 #define OO_POS_RET_SIZE							9
-int multi_pack_unpack_position(int write, ubyte *data, vec3d *pos);
+#define OO_POS_FIELDS							3
+int multi_pack_unpack_position(int write, ubyte *data, vec3d *pos, int *fields = NULL);
 
-// Packs/unpacks an orientation matrix.
+// Packs/unpacks an orientation matrix. If given, fields gets the quantized values which were sent, or
+// OO_ORIENT_NO_FIELDS in the first one if the whole matrix was sent.
 // Returns number of bytes read or written.
 #define OO_ORIENT_RET_SIZE						6
-int multi_pack_unpack_orient(int write, ubyte *data, matrix *orient);
+#define OO_ORIENT_FIELDS						4
+#define OO_ORIENT_NO_FIELDS					INT_MIN
+int multi_pack_unpack_orient(int write, ubyte *data, matrix *orient, int *fields = NULL);
+
+// Quantizes positions and orientations the way they are packed above, and back.
+void multi_position_to_fields(const vec3d *pos, int *fields);
+void multi_fields_to_position(const int *fields, vec3d *pos);
+bool multi_orient_to_fields(const matrix *orient, int *fields);
+void multi_fields_to_orient(const int *fields, matrix *orient);
+
+// The smallest of the given widths (in bits, ascending) which holds every difference between the quantized values
+// and the base, or 0 if none does.
+int multi_field_delta_bits(const int *base, const int *fields, int count, const int *widths, int num_widths);
+
+// Packs/unpacks quantized values as differences to the base of the given width each. When unpacking the base may
+// be NULL to just skip the data.
+// Returns number of bytes read or written.
+int multi_pack_unpack_field_deltas(int write, ubyte *data, const int *base, int *fields, int count, int bits);
 
 // Packs/unpacks velocity
 // Returns number of bytes read or written.
@@ -83,7 +83,7 @@ ushort	Psnet_default_port;
 // number, possibly a checksum).  We must include a 2 byte flags variable into both structure
 // since the receiving end of this packet must know whether or not to checksum the packet.
 
-#define MAX_TOP_LAYER_PACKET_SIZE			680
+#define MAX_TOP_LAYER_PACKET_SIZE			(MAX_DATAGRAM_SIZE + 1)		// a datagram and the psnet type in front of it
 
 // use the pack pragma to pack these structures to 2 byte aligment.  Really only needed for
 // the naked packet.
@@ -220,6 +220,27 @@ unsigned int Serverconn = 0xffffffff;
 // top layer buffers
 network_packet_buffer_list Psnet_top_buffers[PSNET_NUM_TYPES];
 
+// unreliable sends held back between psnet_send_batch_begin() and psnet_send_batch_end()
+#define PSNET_SEND_BATCH_SIZE				32
+
+typedef struct psnet_batched_send {
+	SOCKADDR_IN	addr;
+	int			len;
+	char			data[MAX_TOP_LAYER_PACKET_SIZE];
+} psnet_batched_send;
+
+psnet_batched_send Psnet_send_batch[PSNET_SEND_BATCH_SIZE];
+int Psnet_send_batch_count = 0;
+int Psnet_send_batching = 0;
+
+#ifdef __LINUX__
+// how many datagrams are read off the socket with one call
+#define PSNET_RECV_BATCH_SIZE				16
+
+ubyte Psnet_recv_data[PSNET_RECV_BATCH_SIZE][MAX_TOP_LAYER_PACKET_SIZE];
+SOCKADDR_IN Psnet_recv_addr[PSNET_RECV_BATCH_SIZE];
+#endif
+
 // -------------------------------------------------------------------------------------------------------
 // PSNET 2 FORWARD DECLARATIONS
 //
@@ -227,6 +248,9 @@ network_packet_buffer_list Psnet_top_buffers[PSNET_NUM_TYPES];
 // if the string is a legally formatted ip string
 int psnet_is_valid_numeric_ip(char *ip);
 
+// hold back a datagram until the batch is sent
+int psnet_send_batch_add(SOCKADDR_IN *addr, char *data, int len);
+
 #ifdef _WIN32
 // functions to get the status of a RAS connection
 unsigned int psnet_ras_status();
@@ -354,28 +378,92 @@ int SENDTO(SOCKET s, char * buf, int len, int flags, sockaddr *to, int tolen, in
 	return sendto(s, outbuf, len + 1, flags, (SOCKADDR*)to, tolen);
 }
 
+/**
+ * Buffer a datagram read off of our socket by its packet type
+ */
+void psnet_top_layer_store(ubyte *data, int read_len, SOCKADDR_IN *ip_addr)
+{
+	net_addr	from_addr;
+
+	// set the from_addr for storage into the packet buffer structure
+	from_addr.type = Socket_type;
+	from_addr.port = ntohs( ip_addr->sin_port );			
+	memset(from_addr.addr, 0x00, 6);
+#ifdef _WIN32
+	memcpy(from_addr.addr, &ip_addr->sin_addr.S_un.S_addr, 4); //-V512
+#else
+	memcpy(from_addr.addr, &ip_addr->sin_addr.s_addr, 4); //-V512
+#endif
+
+	if ( read_len < 1 ) {
+		return;
+	}
+
+	// determine the packet type
+	int packet_type = data[0];	
+	Assertion(((packet_type >= 0) && (packet_type < PSNET_NUM_TYPES)), "Invalid packet_type found. Packet type %d does not exist", packet_type);
+	if((packet_type >= 0) && (packet_type < PSNET_NUM_TYPES)){
+		// buffer the packet
+		psnet_buffer_packet(&Psnet_top_buffers[packet_type], data + 1, read_len - 1, &from_addr);
+	}
+}
+
 /**
  * Call this once per frame to read everything off of our socket
  */
 void PSNET_TOP_LAYER_PROCESS()
 {
+	if ( Network_status != NETWORK_STATUS_RUNNING ) {
+		ml_string("Network ==> socket not inited in PSNET_TOP_LAYER_PROCESS");
+		return;
+	}
+
+	if ( Socket_type != NET_TCP ) {
+		Assert(0);
+		return;
+	}
+
+#ifdef __LINUX__
+	// read as many datagrams per call as there are waiting, instead of a select() and a recvfrom() for each of them
+	mmsghdr	msgs[PSNET_RECV_BATCH_SIZE];
+	iovec		iovs[PSNET_RECV_BATCH_SIZE];
+	int		idx, count;
+
+	do {
+		memset(msgs, 0, sizeof(msgs));
+		for ( idx = 0; idx < PSNET_RECV_BATCH_SIZE; idx++ ) {
+			iovs[idx].iov_base = Psnet_recv_data[idx];
+			iovs[idx].iov_len = MAX_TOP_LAYER_PACKET_SIZE;
+			msgs[idx].msg_hdr.msg_name = &Psnet_recv_addr[idx];
+			msgs[idx].msg_hdr.msg_namelen = sizeof(SOCKADDR_IN);
+			msgs[idx].msg_hdr.msg_iov = &iovs[idx];
+			msgs[idx].msg_hdr.msg_iovlen = 1;
+		}
+
+		count = recvmmsg( Unreliable_socket, msgs, PSNET_RECV_BATCH_SIZE, MSG_DONTWAIT, NULL );
+		if ( count == SOCKET_ERROR ) {
+			if ( (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR) ) {
+				ml_string("Socket error on socket_get_data()");
+			}
+			return;
+		}
+
+		for ( idx = 0; idx < count; idx++ ) {
+			psnet_top_layer_store(Psnet_recv_data[idx], (int)msgs[idx].msg_len, &Psnet_recv_addr[idx]);
+		}
+	} while ( count == PSNET_RECV_BATCH_SIZE );
+#else
 	// read socket stuff
 	SOCKADDR_IN ip_addr;				// UDP/TCP socket structure
 	fd_set	rfds;
 	timeval	timeout;
 	int		read_len;
    socklen_t from_len;
-	net_addr	from_addr;	
 	network_naked_packet packet_read;		
 
 	// clear the addresses to remove compiler warnings
 	memset(&ip_addr, 0, sizeof(SOCKADDR_IN));
 
-	if ( Network_status != NETWORK_STATUS_RUNNING ) {
-		ml_string("Network ==> socket not inited in PSNET_TOP_LAYER_PROCESS");
-		return;
-	}
-
 	while ( 1 ) {		
 		// check if there is any data on the socket to be read.  The amount of data that can be 
 		// atomically read is stored in len.
@@ -400,51 +488,17 @@ void PSNET_TOP_LAYER_PROCESS()
 		}
 
 		// get data off the socket and process
-		read_len = SOCKET_ERROR;
-		switch ( Socket_type ) {
-		case NET_TCP:
-			from_len = sizeof(SOCKADDR_IN);			
-			read_len = recvfrom( Unreliable_socket, (char*)packet_read.data, MAX_TOP_LAYER_PACKET_SIZE, 0,  (SOCKADDR*)&ip_addr, &from_len);
-			break;
-		
-		default:
-			Assert(0);
-			return;
-		}
-
-		// set the from_addr for storage into the packet buffer structure
-		from_addr.type = Socket_type;
-
-		switch ( Socket_type ) {
-		case NET_TCP:			
-			from_addr.port = ntohs( ip_addr.sin_port );			
-			memset(from_addr.addr, 0x00, 6);
-#ifdef _WIN32
-			memcpy(from_addr.addr, &ip_addr.sin_addr.S_un.S_addr, 4); //-V512
-#else
-			memcpy(from_addr.addr, &ip_addr.sin_addr.s_addr, 4); //-V512
-#endif
-			break;
-
-		default:
-			Assert(0);
-			return;
-			// break;
-		}
+		from_len = sizeof(SOCKADDR_IN);			
+		read_len = recvfrom( Unreliable_socket, (char*)packet_read.data, MAX_TOP_LAYER_PACKET_SIZE, 0,  (SOCKADDR*)&ip_addr, &from_len);
 
 		if ( read_len == SOCKET_ERROR ) {
 			ml_string("Socket error on socket_get_data()");
 			break;
 		}		
 
-		// determine the packet type
-		int packet_type = packet_read.data[0];	
-		Assertion(((packet_type >= 0) && (packet_type < PSNET_NUM_TYPES)), "Invalid packet_type found. Packet type %d does not exist", packet_type);
-		if((packet_type >= 0) && (packet_type < PSNET_NUM_TYPES)){
-			// buffer the packet
-			psnet_buffer_packet(&Psnet_top_buffers[packet_type], packet_read.data + 1, read_len - 1, &from_addr);
-		}
+		psnet_top_layer_store(packet_read.data, read_len, &ip_addr);
 	}
+#endif
 }
 
 
@@ -860,7 +914,11 @@ int psnet_send( net_addr * who_to, void * data, int len, int np_index )
 
 			multi_rate_add(np_index, "udp(h)", send_len + UDP_HEADER_SIZE);
 			multi_rate_add(np_index, "udp", send_len);
-			ret = SENDTO( send_sock, (char *)send_data, send_len, 0, (SOCKADDR*)&sockaddr, sizeof(sockaddr), PSNET_TYPE_UNRELIABLE );
+			if ( Psnet_send_batching ) {
+				ret = psnet_send_batch_add( &sockaddr, (char *)send_data, send_len );
+			} else {
+				ret = SENDTO( send_sock, (char *)send_data, send_len, 0, (SOCKADDR*)&sockaddr, sizeof(sockaddr), PSNET_TYPE_UNRELIABLE );
+			}
 			break;
 
 		default:
@@ -875,6 +933,104 @@ int psnet_send( net_addr * who_to, void * data, int len, int np_index )
 	return 0;
 }
 
+/**
+ * Send all held back datagrams
+ */
+void psnet_send_batch_flush()
+{
+	int idx;
+
+	if ( Psnet_send_batch_count <= 0 ) {
+		return;
+	}
+
+#ifdef __LINUX__
+	mmsghdr	msgs[PSNET_SEND_BATCH_SIZE];
+	iovec		iovs[PSNET_SEND_BATCH_SIZE];
+	int		sent, ret;
+
+	memset(msgs, 0, sizeof(msgs));
+	for ( idx = 0; idx < Psnet_send_batch_count; idx++ ) {
+		iovs[idx].iov_base = Psnet_send_batch[idx].data;
+		iovs[idx].iov_len = Psnet_send_batch[idx].len;
+		msgs[idx].msg_hdr.msg_name = &Psnet_send_batch[idx].addr;
+		msgs[idx].msg_hdr.msg_namelen = sizeof(SOCKADDR_IN);
+		msgs[idx].msg_hdr.msg_iov = &iovs[idx];
+		msgs[idx].msg_hdr.msg_iovlen = 1;
+	}
+
+	sent = 0;
+	while ( sent < Psnet_send_batch_count ) {
+		ret = sendmmsg( Unreliable_socket, msgs + sent, Psnet_send_batch_count - sent, 0 );
+
+		if ( ret == SOCKET_ERROR ) {
+			if ( errno == EINTR ) {
+				continue;
+			}
+
+			// only the first datagram failed, skip it so that one bad destination doesn't hold up the others
+			ml_printf("Error %d sending a batch of datagrams", errno);
+			ret = 1;
+		}
+
+		sent += ret;
+	}
+#else
+	for ( idx = 0; idx < Psnet_send_batch_count; idx++ ) {
+		sendto( Unreliable_socket, Psnet_send_batch[idx].data, Psnet_send_batch[idx].len, 0, (SOCKADDR*)&Psnet_send_batch[idx].addr, sizeof(SOCKADDR_IN) );
+	}
+#endif
+
+	Psnet_send_batch_count = 0;
+}
+
+/**
+ * Hold back a datagram until the batch is sent, returns SOCKET_ERROR if it is too large
+ */
+int psnet_send_batch_add( SOCKADDR_IN *addr, char *data, int len )
+{
+	if ( (len < 0) || (len + 1 > MAX_TOP_LAYER_PACKET_SIZE) ) {
+		return SOCKET_ERROR;
+	}
+
+	if ( Psnet_send_batch_count >= PSNET_SEND_BATCH_SIZE ) {
+		psnet_send_batch_flush();
+	}
+
+	psnet_batched_send *batched = &Psnet_send_batch[Psnet_send_batch_count++];
+
+	// stuff type, the same as SENDTO()
+	batched->addr = *addr;
+	batched->data[0] = (char)PSNET_TYPE_UNRELIABLE;
+	memcpy(&batched->data[1], data, len);
+	batched->len = len + 1;
+
+	return len + 1;
+}
+
+/**
+ * Hold back unreliable sends until psnet_send_batch_end()
+ */
+void psnet_send_batch_begin()
+{
+	Psnet_send_batching = 1;
+}
+
+/**
+ * Send everything held back since psnet_send_batch_begin()
+ */
+void psnet_send_batch_end()
+{
+	Psnet_send_batching = 0;
+
+	if ( Network_status != NETWORK_STATUS_RUNNING ) {
+		Psnet_send_batch_count = 0;
+		return;
+	}
+
+	psnet_send_batch_flush();
+}
+
 /**
  * Get data from the unreliable socket
  */
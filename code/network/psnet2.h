@@ -33,6 +33,10 @@
 //#define MAX_PACKET_SIZE 4096
 #define MAX_PACKET_SIZE		512
 
+// unreliable packets to a player are collected into datagrams of up to this size, which keeps them below the smallest
+// MTU of most internet paths (1280 for IPv6) together with the IP and UDP headers
+#define MAX_DATAGRAM_SIZE		1200
+
 #define DEFAULT_GAME_PORT 7808
 
 typedef struct net_addr	{
@@ -153,6 +157,12 @@ int psnet_same( net_addr * a1, net_addr * a2 );
 // send data unreliably
 int psnet_send( net_addr * who_to, void * data, int len, int np_index = -1 );
 
+// hold back unreliable sends until psnet_send_batch_end() so that they go to the OS in as few calls as possible
+void psnet_send_batch_begin();
+
+// send everything held back since psnet_send_batch_begin()
+void psnet_send_batch_end();
+
 // get data from the unreliable socket
 int psnet_get( void * data, net_addr * from_addr );
 
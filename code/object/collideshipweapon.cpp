@@ -129,64 +129,40 @@ static void ship_weapon_do_hit_stuff(object *pship_obj, object *weapon_obj, vec3
 
 extern int Framecount;
 
-static int ship_weapon_check_collision(object *ship_objp, object *weapon_objp, float time_limit = 0.0f, int *next_hit = NULL)
+/**
+ * Runs the model_collide() queries for a ship-weapon pair and stores the results in geometry.
+ *
+ * This does not touch any game state, so for a batch of pairs it can run before any of the hit handling in
+ * ship_weapon_check_collision().
+ */
+static void ship_weapon_check_geometry(object *ship_objp, object *weapon_objp, float time_limit, collision_geometry *geometry)
 {
-	mc_info mc, mc_shield, mc_hull;
-	ship	*shipp;
-	ship_info *sip;
-	weapon	*wp;
-	weapon_info	*wip;
-
-	Assert( ship_objp != NULL );
-	Assert( ship_objp->type == OBJ_SHIP );
-	Assert( ship_objp->instance >= 0 );
-
-	shipp = &Ships[ship_objp->instance];
-	sip = &Ship_info[shipp->ship_info_index];
-
-	Assert( weapon_objp != NULL );
-	Assert( weapon_objp->type == OBJ_WEAPON );
-	Assert( weapon_objp->instance >= 0 );
-
-	wp = &Weapons[weapon_objp->instance];
-	wip = &Weapon_info[wp->weapon_info_index];
-
-
-	Assert( shipp->objnum == OBJ_INDEX(ship_objp));
-
-	// Make ships that are warping in not get collision detection done
-	if ( shipp->is_arriving() ) return 0;
-	
-	//	Return information for AI to detect incoming fire.
-	//	Could perhaps be done elsewhere at lower cost --MK, 11/7/97
-	float	dist = vm_vec_dist_quick(&ship_objp->pos, &weapon_objp->pos);
-	if (dist < weapon_objp->phys_info.speed) {
-		update_danger_weapon(ship_objp, weapon_objp);
-	}
-
-	int	valid_hit_occurred = 0;				// If this is set, then hitpos is set
-	int	quadrant_num = -1;
+	ship *shipp = &Ships[ship_objp->instance];
+	ship_info *sip = &Ship_info[shipp->ship_info_index];
+	weapon *wp = &Weapons[weapon_objp->instance];
 	polymodel *pm = model_get(sip->model_num);
 
+	mc_info &mc_shield = geometry->mc_shield;
+	mc_info &mc_hull = geometry->mc_hull;
+
 	//	total time is flFrametime + time_limit (time_limit used to predict collisions into the future)
-	vec3d weapon_end_pos;
+	vec3d &weapon_end_pos = geometry->end_pos;
 	vm_vec_scale_add( &weapon_end_pos, &weapon_objp->pos, &weapon_objp->phys_info.vel, time_limit );
 
 
 	// Goober5000 - I tried to make collision code here much saner... here begin the (major) changes
-	mc_info_init(&mc);
+	mc_info_init(&mc_hull);
 
 	// set up collision structs
-	mc.model_instance_num = shipp->model_instance_num;
-	mc.model_num = sip->model_num;
-	mc.submodel_num = -1;
-	mc.orient = &ship_objp->orient;
-	mc.pos = &ship_objp->pos;
-	mc.p0 = &weapon_objp->last_pos;
-	mc.p1 = &weapon_end_pos;
-	mc.lod = sip->collision_lod;
-	memcpy(&mc_shield, &mc, sizeof(mc_info));
-	memcpy(&mc_hull, &mc, sizeof(mc_info));
+	mc_hull.model_instance_num = shipp->model_instance_num;
+	mc_hull.model_num = sip->model_num;
+	mc_hull.submodel_num = -1;
+	mc_hull.orient = &ship_objp->orient;
+	mc_hull.pos = &ship_objp->pos;
+	mc_hull.p0 = &weapon_objp->last_pos;
+	mc_hull.p1 = &weapon_end_pos;
+	mc_hull.lod = sip->collision_lod;
+	memcpy(&mc_shield, &mc_hull, sizeof(mc_info));
 
 	// (btw, these are leftover comments from below...)
 	//
@@ -208,8 +184,11 @@ static int ship_weapon_check_collision(object *ship_objp, object *weapon_objp, f
 	// Someone should make one.
 
 	// check both kinds of collisions
-	int shield_collision = 0;
-	int hull_collision = 0;
+	int &shield_collision = geometry->shield_collision;
+	int &hull_collision = geometry->hull_collision;
+
+	shield_collision = 0;
+	hull_collision = 0;
 
 	// check shields for impact
 	if (!(ship_objp->flags[Object::Object_Flags::No_shields])) {
@@ -353,6 +332,110 @@ static int ship_weapon_check_collision(object *ship_objp, object *weapon_objp, f
 		hull_collision = model_collide(&mc_hull);
 	}
 
+	geometry->ship_pos = ship_objp->pos;
+	geometry->ship_orient = ship_objp->orient;
+	geometry->weapon_last_pos = weapon_objp->last_pos;
+	geometry->no_shields = ship_objp->flags[Object::Object_Flags::No_shields];
+
+	geometry->valid = true;
+}
+
+/**
+ * Checks if a geometry test from the collision batch still holds.
+ *
+ * The hit handling of an earlier pair in the batch can move the ship, take down its shields or blow off the submodel
+ * the weapon hit.  In that case the test has to be run again so that the result is the same as colliding the pairs
+ * one after the other.
+ */
+static bool ship_weapon_geometry_current(object *ship_objp, object *weapon_objp, const collision_geometry *geometry)
+{
+	if (!vm_vec_same(&geometry->ship_pos, &ship_objp->pos) || !vm_vec_same(&geometry->weapon_last_pos, &weapon_objp->last_pos) || !vm_vec_same(&geometry->end_pos, &weapon_objp->pos)) {
+		return false;
+	}
+
+	matrix orient = ship_objp->orient;
+	matrix old_orient = geometry->ship_orient;
+	if (!vm_matrix_same(&old_orient, &orient)) {
+		return false;
+	}
+
+	if (geometry->no_shields != ship_objp->flags[Object::Object_Flags::No_shields]) {
+		return false;
+	}
+
+	// a submodel which was hit, or one of its parents, may have been blown off since
+	ship *shipp = &Ships[ship_objp->instance];
+	polymodel *pm = model_get(Ship_info[shipp->ship_info_index].model_num);
+	polymodel_instance *pmi = model_get_instance(shipp->model_instance_num);
+
+	const mc_info *hits[2] = { &geometry->mc_hull, &geometry->mc_shield };
+	for (auto mc : hits) {
+		if (!(mc->flags & MC_CHECK_MODEL)) {
+			continue;
+		}
+
+		for (int submodel = mc->hit_submodel; (submodel >= 0) && (submodel < pm->n_models); submodel = pm->submodel[submodel].parent) {
+			if (pmi->submodel[submodel].blown_off) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static int ship_weapon_check_collision(object *ship_objp, object *weapon_objp, float time_limit = 0.0f, int *next_hit = NULL, const collision_geometry *geometry = NULL)
+{
+	mc_info mc;
+	ship	*shipp;
+	ship_info *sip;
+	weapon	*wp;
+	weapon_info	*wip;
+
+	Assert( ship_objp != NULL );
+	Assert( ship_objp->type == OBJ_SHIP );
+	Assert( ship_objp->instance >= 0 );
+
+	shipp = &Ships[ship_objp->instance];
+	sip = &Ship_info[shipp->ship_info_index];
+
+	Assert( weapon_objp != NULL );
+	Assert( weapon_objp->type == OBJ_WEAPON );
+	Assert( weapon_objp->instance >= 0 );
+
+	wp = &Weapons[weapon_objp->instance];
+	wip = &Weapon_info[wp->weapon_info_index];
+
+
+	Assert( shipp->objnum == OBJ_INDEX(ship_objp));
+
+	// Make ships that are warping in not get collision detection done
+	if ( shipp->is_arriving() ) return 0;
+	
+	//	Return information for AI to detect incoming fire.
+	//	Could perhaps be done elsewhere at lower cost --MK, 11/7/97
+	float	dist = vm_vec_dist_quick(&ship_objp->pos, &weapon_objp->pos);
+	if (dist < weapon_objp->phys_info.speed) {
+		update_danger_weapon(ship_objp, weapon_objp);
+	}
+
+	int	valid_hit_occurred = 0;				// If this is set, then hitpos is set
+	int	quadrant_num = -1;
+
+	// use the geometry test from the collision batch if it was run for this check, otherwise run it now
+	collision_geometry local_geometry;
+	if (geometry == NULL || !geometry->valid || time_limit != 0.0f || !ship_weapon_geometry_current(ship_objp, weapon_objp, geometry)) {
+		ship_weapon_check_geometry(ship_objp, weapon_objp, time_limit, &local_geometry);
+		geometry = &local_geometry;
+	}
+
+	mc_info mc_shield = geometry->mc_shield;
+	mc_info mc_hull = geometry->mc_hull;
+	int shield_collision = geometry->shield_collision;
+	int hull_collision = geometry->hull_collision;
+
+	memcpy(&mc, &mc_hull, sizeof(mc_info));
+
 	if (shield_collision) {
 		// pick out the shield quadrant
 		quadrant_num = get_quadrant(&mc_shield.hit_point, ship_objp);
@@ -472,30 +555,25 @@ static int ship_weapon_check_collision(object *ship_objp, object *weapon_objp, f
 }
 
 
-/**
- * Checks ship-weapon collisions.  
- * @param pair obj_pair pointer to the two objects. pair->a is ship and pair->b is weapon.
- * @return 1 if all future collisions between these can be ignored
- */
-int collide_ship_weapon( obj_pair * pair )
-{
-	int		did_hit;
-	object *ship = pair->a;
-	object *weapon_obj = pair->b;
-	
-	Assert( ship->type == OBJ_SHIP );
-	Assert( weapon_obj->type == OBJ_WEAPON );
+// how collide_ship_weapon() checks a pair
+enum class ship_weapon_check_type {
+	None,				// pair can't collide this frame
+	Inside_big_ship,	// laser inside the sphere of a big ship, predicted with check_inside_radius_for_big_ships()
+	Normal				// plain ship_weapon_check_collision() for this frame
+};
 
+static ship_weapon_check_type ship_weapon_get_check_type(object *ship, object *weapon_obj)
+{
 	ship_info *sip = &Ship_info[Ships[ship->instance].ship_info_index];
 
 	// Don't check collisions for player if past first warpout stage.
 	if ( Player->control_mode > PCM_WARPOUT_STAGE1)	{
 		if ( ship == Player_obj )
-			return 0;
+			return ship_weapon_check_type::None;
 	}
 
 	if (reject_due_collision_groups(ship, weapon_obj))
-		return 0;
+		return ship_weapon_check_type::None;
 
 	// Cull lasers within big ship spheres by casting a vector forward for (1) exit sphere or (2) lifetime of laser
 	// If it does hit, don't check the pair until about 200 ms before collision.  
@@ -508,11 +586,40 @@ int collide_ship_weapon( obj_pair * pair )
 		// Note: culling ships with auto spread shields seems to waste more performance than it saves,
 		// so we're not doing that here
 		if ( !(sip->flags[Ship::Info_Flags::Auto_spread_shields]) && vm_vec_dist_squared(&ship->pos, &weapon_obj->pos) < (1.2f*ship->radius*ship->radius) ) {
-			return check_inside_radius_for_big_ships( ship, weapon_obj, pair );
+			return ship_weapon_check_type::Inside_big_ship;
 		}
 	}
 
-	did_hit = ship_weapon_check_collision( ship, weapon_obj );
+	return ship_weapon_check_type::Normal;
+}
+
+/**
+ * Checks ship-weapon collisions.  
+ * @param pair obj_pair pointer to the two objects. pair->a is ship and pair->b is weapon.
+ * @return 1 if all future collisions between these can be ignored
+ */
+int collide_ship_weapon( obj_pair * pair )
+{
+	int		did_hit;
+	object *ship = pair->a;
+	object *weapon_obj = pair->b;
+	
+	Assert( ship->type == OBJ_SHIP );
+	Assert( weapon_obj->type == OBJ_WEAPON );
+
+	switch (ship_weapon_get_check_type(ship, weapon_obj)) {
+	case ship_weapon_check_type::None:
+		return 0;
+
+	case ship_weapon_check_type::Inside_big_ship:
+		return check_inside_radius_for_big_ships( ship, weapon_obj, pair );
+
+	case ship_weapon_check_type::Normal:
+	default:
+		break;
+	}
+
+	did_hit = ship_weapon_check_collision( ship, weapon_obj, 0.0f, NULL, pair->geometry );
 
 	if ( !did_hit )	{
 		// Since we didn't hit, check to see if we can disable all future collisions
@@ -523,6 +630,29 @@ int collide_ship_weapon( obj_pair * pair )
 	return 0;
 }
 
+/**
+ * Runs the geometry test collide_ship_weapon() will need for this pair, if it needs one.
+ * @param pair obj_pair pointer to the two objects. pair->a is ship and pair->b is weapon. pair->geometry receives the result.
+ */
+void collide_ship_weapon_geometry( obj_pair * pair )
+{
+	object *ship = pair->a;
+	object *weapon_obj = pair->b;
+
+	Assert( ship->type == OBJ_SHIP );
+	Assert( weapon_obj->type == OBJ_WEAPON );
+	Assert( pair->geometry != NULL );
+
+	// these mirror the early outs of collide_ship_weapon() and ship_weapon_check_collision()
+	if ( ship_weapon_get_check_type(ship, weapon_obj) != ship_weapon_check_type::Normal )
+		return;
+
+	if ( Ships[ship->instance].is_arriving() )
+		return;
+
+	ship_weapon_check_geometry( ship, weapon_obj, 0.0f, pair->geometry );
+}
+
 /**
  * Upper limit estimate ship speed at end of time
  */
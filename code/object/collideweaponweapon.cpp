@@ -20,19 +20,13 @@
 
 
 /**
- * Checks weapon-weapon collisions.  
- * @param pair obj_pair pointer to the two objects. pair->a and pair->b are weapons.
- * @return 1 if all future collisions between these can be ignored
+ * Runs the checks that decide whether a weapon-weapon pair has to be tested at all, and finds the radii to test with.
+ * @return -1 if the pair has to be tested, otherwise the value collide_weapon_weapon() returns for it
  */
-int collide_weapon_weapon( obj_pair * pair )
+static int weapon_weapon_check_pair(object *A, object *B, float *A_radius_out, float *B_radius_out)
 {
 	float A_radius, B_radius;
-	object *A = pair->a;
-	object *B = pair->b;
 
-	Assert( A->type == OBJ_WEAPON );
-	Assert( B->type == OBJ_WEAPON );
-	
 	//	Don't allow ship to shoot down its own missile.
 	if (A->parent_sig == B->parent_sig)
 		return 1;
@@ -79,8 +73,59 @@ int collide_weapon_weapon( obj_pair * pair )
 			return 0;
 	}
 
+	*A_radius_out = A_radius;
+	*B_radius_out = B_radius;
+
+	return -1;
+}
+
+/**
+ * Checks if a geometry test from the collision batch was run on the same paths and radii.
+ */
+static bool weapon_weapon_geometry_current(object *A, object *B, float A_radius, float B_radius, const collision_geometry *geometry)
+{
+	return vm_vec_same(&geometry->a_last_pos, &A->last_pos) && vm_vec_same(&geometry->a_pos, &A->pos)
+		&& vm_vec_same(&geometry->b_last_pos, &B->last_pos) && vm_vec_same(&geometry->b_pos, &B->pos)
+		&& (geometry->a_radius == A_radius) && (geometry->b_radius == B_radius);
+}
+
+/**
+ * Checks weapon-weapon collisions.  
+ * @param pair obj_pair pointer to the two objects. pair->a and pair->b are weapons.
+ * @return 1 if all future collisions between these can be ignored
+ */
+int collide_weapon_weapon( obj_pair * pair )
+{
+	float A_radius, B_radius;
+	object *A = pair->a;
+	object *B = pair->b;
+
+	Assert( A->type == OBJ_WEAPON );
+	Assert( B->type == OBJ_WEAPON );
+
+	int early_out = weapon_weapon_check_pair(A, B, &A_radius, &B_radius);
+	if (early_out >= 0)
+		return early_out;
+
+	weapon	*wpA, *wpB;
+	weapon_info	*wipA, *wipB;
+
+	wpA = &Weapons[A->instance];
+	wpB = &Weapons[B->instance];
+	wipA = &Weapon_info[wpA->weapon_info_index];
+	wipB = &Weapon_info[wpB->weapon_info_index];
+
 	//	Rats, do collision detection.
-	if (collide_subdivide(&A->last_pos, &A->pos, A_radius, &B->last_pos, &B->pos, B_radius))
+	// use the test from the collision batch if it is still current, otherwise run it now
+	int hit;
+	const collision_geometry *geometry = pair->geometry;
+	if (geometry != NULL && geometry->valid && weapon_weapon_geometry_current(A, B, A_radius, B_radius, geometry)) {
+		hit = geometry->hull_collision;
+	} else {
+		hit = collide_subdivide(&A->last_pos, &A->pos, A_radius, &B->last_pos, &B->pos, B_radius);
+	}
+
+	if (hit)
 	{
 		Script_system.SetHookObjects(4, "Self", A, "Object", B, "Weapon", A, "WeaponB", B);
 		bool a_override = Script_system.IsConditionOverride(CHA_COLLIDEWEAPON, A);
@@ -189,3 +234,33 @@ int collide_weapon_weapon( obj_pair * pair )
 
 	return 0;
 }
+
+/**
+ * Runs the collide_subdivide() test collide_weapon_weapon() will need for this pair, if it needs one.
+ * @param pair obj_pair pointer to the two objects. pair->a and pair->b are weapons. pair->geometry receives the result.
+ */
+void collide_weapon_weapon_geometry( obj_pair * pair )
+{
+	float A_radius, B_radius;
+	object *A = pair->a;
+	object *B = pair->b;
+	collision_geometry *geometry = pair->geometry;
+
+	Assert( A->type == OBJ_WEAPON );
+	Assert( B->type == OBJ_WEAPON );
+	Assert( geometry != NULL );
+
+	if (weapon_weapon_check_pair(A, B, &A_radius, &B_radius) >= 0)
+		return;
+
+	geometry->hull_collision = collide_subdivide(&A->last_pos, &A->pos, A_radius, &B->last_pos, &B->pos, B_radius);
+
+	geometry->a_last_pos = A->last_pos;
+	geometry->a_pos = A->pos;
+	geometry->b_last_pos = B->last_pos;
+	geometry->b_pos = B->pos;
+	geometry->a_radius = A_radius;
+	geometry->b_radius = B_radius;
+
+	geometry->valid = true;
+}
@@ -9,6 +9,7 @@
 
 
 
+#include "debugconsole/console.h"
 #include "globalincs/linklist.h"
 #include "io/timer.h"
 #include "object/objcollide.h"
@@ -16,6 +17,7 @@
 #include "object/objectdock.h"
 #include "ship/ship.h"
 #include "tracing/tracing.h"
+#include "utils/JobSystem.h"
 #include "weapon/beam.h"
 #include "weapon/weapon.h"
 #include "tracing/Monitor.h"
@@ -36,7 +38,28 @@ obj_pair *Obj_pairs = NULL;
 obj_pair pair_used_list;
 obj_pair pair_free_list;
 
-SCP_vector<int> Collision_sort_list;
+// Persistent sweep-and-prune broadphase. The colliders are kept sorted along a single sweep axis between frames
+// and their bounds for the current frame are cached in a structure of arrays indexed by object number, so that
+// neither the re-sort nor the sweep needs to call obj_get_collider_endpoint().
+typedef struct collider_sweep_entry {
+	float min;		// bounds on the sweep axis, copied from Collider_bounds
+	float max;
+	int objnum;
+} collider_sweep_entry;
+
+// switch the sweep axis only when another axis has this much more spread than the current one
+#define COLLIDER_SWEEP_AXIS_HYSTERESIS	1.5f
+
+static SCP_vector<collider_sweep_entry> Collider_sweep_list;		// sorted by min on Collider_sweep_axis
+static SCP_vector<collider_sweep_entry> Collider_sweep_pending;		// added since the last update, not yet sorted in
+static bool Collider_sweep_removed[MAX_OBJECTS];
+static int Collider_sweep_num_removed = 0;
+static int Collider_sweep_axis = 0;
+
+static struct {
+	float min[3][MAX_OBJECTS];
+	float max[3][MAX_OBJECTS];
+} Collider_bounds;
 
 class collider_pair
 {
@@ -57,6 +80,22 @@ public:
 
 SCP_unordered_map<uint, collider_pair> Collision_cached_pairs;
 
+// A pair reported by the broadphase that passed all the cheap rejection tests.  The entries of a frame are
+// evaluated and then applied in the order the broadphase reported them.
+typedef struct collision_batch_entry {
+	obj_pair pair;
+	collider_pair *cache;						// entry in Collision_cached_pairs, stable until obj_reset_colliders()
+	int signature_a;
+	int signature_b;
+	void (*evaluate)( obj_pair *pair );			// fills in pair.geometry, or NULL if check_collision does everything
+	collision_geometry geometry;
+} collision_batch_entry;
+
+static SCP_vector<collision_batch_entry> Collision_batch;
+
+static collider_pair *obj_collide_pair_prepare(object *A, object *B, obj_pair *pair_out);
+static void obj_collide_pair_apply(obj_pair *pair, collider_pair *collision_info);
+
 class checkobject;
 extern checkobject CheckObjects[MAX_OBJECTS];
 
@@ -440,6 +479,7 @@ void obj_add_pair( object *A, object *B, int check_time, int add_to_end )
 	new_pair->a = A;
 	new_pair->b = B;
 	new_pair->check_collision = check_collision;
+	new_pair->geometry = NULL;
 
 	if ( check_time == -1 ){
 		new_pair->next_check_time = timestamp(0);	// 0 means instantly time out
@@ -989,7 +1029,12 @@ void obj_add_collider(int obj_index)
 		return;
 	}
 
-	Collision_sort_list.push_back(obj_index);
+	// new colliders are merged into the sorted sweep list on the next broadphase update
+	collider_sweep_entry entry;
+	entry.min = 0.0f;
+	entry.max = 0.0f;
+	entry.objnum = obj_index;
+	Collider_sweep_pending.push_back(entry);
 
 	objp->flags.remove(Object::Object_Flags::Not_in_coll);
 }
@@ -1001,21 +1046,35 @@ void obj_remove_collider(int obj_index)
 #endif	
 
 	size_t i;
+	bool was_pending = false;
 
-	for ( i = 0; i < Collision_sort_list.size(); ++i ) {
-		if ( Collision_sort_list[i] == obj_index ) {
-			Collision_sort_list[i] = Collision_sort_list.back();
-			Collision_sort_list.pop_back();
+	for ( i = 0; i < Collider_sweep_pending.size(); ++i ) {
+		if ( Collider_sweep_pending[i].objnum == obj_index ) {
+			Collider_sweep_pending[i] = Collider_sweep_pending.back();
+			Collider_sweep_pending.pop_back();
+			was_pending = true;
 			break;
 		}
 	}
 
+	// entries in the sweep list itself are only flagged here; they are compacted out on the next update so that
+	// removing a collider from inside a collision response never invalidates a running sweep
+	if ( !was_pending && !(Objects[obj_index].flags[Object::Object_Flags::Not_in_coll]) ) {
+		Collider_sweep_removed[obj_index] = true;
+		Collider_sweep_num_removed++;
+	}
+
 	Objects[obj_index].flags.set(Object::Object_Flags::Not_in_coll);
 }
 
 void obj_reset_colliders()
 {
-	Collision_sort_list.clear();
+	Collider_sweep_list.clear();
+	Collider_sweep_pending.clear();
+	memset(Collider_sweep_removed, 0, sizeof(Collider_sweep_removed));
+	Collider_sweep_num_removed = 0;
+	Collider_sweep_axis = 0;
+
 	Collision_cached_pairs.clear();
 }
 
@@ -1028,9 +1087,284 @@ void obj_collide_retime_cached_pairs(int checkdly)
 	}
 }
 
-// used only in obj_sort_and_collide()
-static SCP_vector<int> sort_list_y;
-static SCP_vector<int> sort_list_z;
+/**
+ * Computes the bounds of a collider on all three axes at once and stores them in the per-frame endpoint cache.
+ *
+ * Uses the same extents as obj_get_collider_endpoint().
+ */
+static void obj_cache_collider_bounds(int objnum)
+{
+	object *objp = &Objects[objnum];
+	const vec3d *start;
+	const vec3d *end;
+	float radius;
+
+	if ( objp->type == OBJ_BEAM ) {
+		beam *b = &Beams[objp->instance];
+
+		// use the last start and last shot as endpoints
+		start = &b->last_start;
+		end = &b->last_shot;
+		radius = 0.0f;
+	} else if ( objp->type == OBJ_WEAPON ) {
+		start = &objp->last_pos;
+		end = &objp->pos;
+		radius = objp->radius;
+	} else {
+		start = &objp->pos;
+		end = &objp->pos;
+		radius = objp->radius;
+	}
+
+	for ( int axis = 0; axis < 3; ++axis ) {
+		if ( start->a1d[axis] > end->a1d[axis] ) {
+			Collider_bounds.min[axis][objnum] = end->a1d[axis] - radius;
+			Collider_bounds.max[axis][objnum] = start->a1d[axis] + radius;
+		} else {
+			Collider_bounds.min[axis][objnum] = start->a1d[axis] - radius;
+			Collider_bounds.max[axis][objnum] = end->a1d[axis] + radius;
+		}
+	}
+}
+
+static bool collider_sweep_entry_compare(const collider_sweep_entry &a, const collider_sweep_entry &b)
+{
+	return a.min < b.min;
+}
+
+/**
+ * Brings the persistent sweep list up to date for this frame.
+ *
+ * Drops removed colliders, refreshes the endpoint cache, picks the sweep axis and then restores the sort order.
+ * Since objects barely move between frames the list is almost sorted already and a plain insertion sort is
+ * close to linear. Colliders added since the last update are sorted on their own and merged in, so a burst of
+ * newly fired weapons does not have to be walked down the whole list one by one.
+ */
+static void obj_broadphase_update()
+{
+	TRACE_SCOPE(tracing::SortColliders);
+
+	size_t i;
+
+	if ( Collider_sweep_num_removed > 0 ) {
+		size_t num_kept = 0;
+
+		for ( i = 0; i < Collider_sweep_list.size(); ++i ) {
+			if ( !Collider_sweep_removed[Collider_sweep_list[i].objnum] ) {
+				Collider_sweep_list[num_kept++] = Collider_sweep_list[i];
+			}
+		}
+
+		Collider_sweep_list.resize(num_kept);
+		memset(Collider_sweep_removed, 0, sizeof(Collider_sweep_removed));
+		Collider_sweep_num_removed = 0;
+	}
+
+	// refresh the endpoint cache and find the axis along which the colliders are spread out the most
+	vec3d sum = vmd_zero_vector;
+	vec3d sum_sq = vmd_zero_vector;
+
+	for ( i = 0; i < Collider_sweep_list.size(); ++i ) {
+		int objnum = Collider_sweep_list[i].objnum;
+
+		obj_cache_collider_bounds(objnum);
+
+		for ( int axis = 0; axis < 3; ++axis ) {
+			float center = (Collider_bounds.min[axis][objnum] + Collider_bounds.max[axis][objnum]) * 0.5f;
+			sum.a1d[axis] += center;
+			sum_sq.a1d[axis] += center * center;
+		}
+	}
+
+	for ( i = 0; i < Collider_sweep_pending.size(); ++i ) {
+		obj_cache_collider_bounds(Collider_sweep_pending[i].objnum);
+	}
+
+	bool resort = false;
+
+	if ( !Collider_sweep_list.empty() ) {
+		float count = i2fl((int)Collider_sweep_list.size());
+		float variance[3];
+		int best_axis = Collider_sweep_axis;
+
+		for ( int axis = 0; axis < 3; ++axis ) {
+			float mean = sum.a1d[axis] / count;
+			variance[axis] = sum_sq.a1d[axis] / count - mean * mean;
+
+			if ( variance[axis] > variance[best_axis] ) {
+				best_axis = axis;
+			}
+		}
+
+		// only switch axes when it is clearly worth it, since switching costs a full sort
+		if ( best_axis != Collider_sweep_axis && variance[best_axis] > variance[Collider_sweep_axis] * COLLIDER_SWEEP_AXIS_HYSTERESIS ) {
+			Collider_sweep_axis = best_axis;
+			resort = true;
+		}
+	}
+
+	const float *axis_min = Collider_bounds.min[Collider_sweep_axis];
+	const float *axis_max = Collider_bounds.max[Collider_sweep_axis];
+
+	for ( i = 0; i < Collider_sweep_list.size(); ++i ) {
+		collider_sweep_entry *entry = &Collider_sweep_list[i];
+		entry->min = axis_min[entry->objnum];
+		entry->max = axis_max[entry->objnum];
+	}
+
+	if ( resort ) {
+		std::sort(Collider_sweep_list.begin(), Collider_sweep_list.end(), collider_sweep_entry_compare);
+	} else {
+		for ( i = 1; i < Collider_sweep_list.size(); ++i ) {
+			collider_sweep_entry entry = Collider_sweep_list[i];
+			size_t j = i;
+
+			while ( j > 0 && Collider_sweep_list[j - 1].min > entry.min ) {
+				Collider_sweep_list[j] = Collider_sweep_list[j - 1];
+				--j;
+			}
+
+			Collider_sweep_list[j] = entry;
+		}
+	}
+
+	if ( !Collider_sweep_pending.empty() ) {
+		for ( i = 0; i < Collider_sweep_pending.size(); ++i ) {
+			collider_sweep_entry *entry = &Collider_sweep_pending[i];
+			entry->min = axis_min[entry->objnum];
+			entry->max = axis_max[entry->objnum];
+		}
+
+		std::sort(Collider_sweep_pending.begin(), Collider_sweep_pending.end(), collider_sweep_entry_compare);
+
+		size_t old_size = Collider_sweep_list.size();
+		Collider_sweep_list.insert(Collider_sweep_list.end(), Collider_sweep_pending.begin(), Collider_sweep_pending.end());
+		std::inplace_merge(Collider_sweep_list.begin(), Collider_sweep_list.begin() + old_size, Collider_sweep_list.end(), collider_sweep_entry_compare);
+
+		Collider_sweep_pending.clear();
+	}
+}
+
+/**
+ * Sweeps the sorted collider list and reports every pair whose cached bounds overlap on all three axes.
+ *
+ * Pairs are handed to report(objnum_a, objnum_b) as soon as they are found, with the lower object number first so
+ * that a pair always maps to the same entry in Collision_cached_pairs no matter how the sort order changes.
+ */
+template <typename REPORT>
+static void obj_broadphase_sweep(REPORT report)
+{
+	TRACE_SCOPE(tracing::FindOverlapColliders);
+
+	const int axis_b = (Collider_sweep_axis + 1) % 3;
+	const int axis_c = (Collider_sweep_axis + 2) % 3;
+	const float *min_b = Collider_bounds.min[axis_b];
+	const float *max_b = Collider_bounds.max[axis_b];
+	const float *min_c = Collider_bounds.min[axis_c];
+	const float *max_c = Collider_bounds.max[axis_c];
+
+	const size_t count = Collider_sweep_list.size();
+
+	for ( size_t i = 0; i < count; ++i ) {
+		const int objnum_a = Collider_sweep_list[i].objnum;
+		const float sweep_max = Collider_sweep_list[i].max;
+
+		if ( Collider_sweep_removed[objnum_a] ) {
+			continue;
+		}
+
+		for ( size_t j = i + 1; j < count && Collider_sweep_list[j].min <= sweep_max; ++j ) {
+			const int objnum_b = Collider_sweep_list[j].objnum;
+
+			if ( min_b[objnum_b] > max_b[objnum_a] || max_b[objnum_b] < min_b[objnum_a] ) {
+				continue;
+			}
+
+			if ( min_c[objnum_b] > max_c[objnum_a] || max_c[objnum_b] < min_c[objnum_a] ) {
+				continue;
+			}
+
+			// a collision response earlier in this sweep may have taken either object out of the broadphase
+			if ( Collider_sweep_removed[objnum_b] || Collider_sweep_removed[objnum_a] ) {
+				continue;
+			}
+
+			if ( objnum_a < objnum_b ) {
+				report(objnum_a, objnum_b);
+			} else {
+				report(objnum_b, objnum_a);
+			}
+		}
+	}
+}
+
+static void obj_broadphase_gather_pair(int objnum_a, int objnum_b)
+{
+	obj_pair pair;
+	collider_pair *collision_info = obj_collide_pair_prepare(&Objects[objnum_a], &Objects[objnum_b], &pair);
+
+	if ( collision_info == NULL ) {
+		return;
+	}
+
+	Collision_batch.emplace_back();
+	collision_batch_entry *entry = &Collision_batch.back();
+
+	entry->pair = pair;
+	entry->cache = collision_info;
+	entry->signature_a = pair.a->signature;
+	entry->signature_b = pair.b->signature;
+	entry->geometry.valid = false;
+
+	if ( pair.check_collision == collide_ship_weapon ) {
+		entry->evaluate = collide_ship_weapon_geometry;
+	} else if ( pair.check_collision == collide_weapon_weapon ) {
+		entry->evaluate = collide_weapon_weapon_geometry;
+	} else {
+		entry->evaluate = NULL;
+	}
+}
+
+/**
+ * Runs the geometry tests of every pair in the batch.
+ *
+ * The evaluate functions only read game state and each writes to its own entry, so the pairs are independent of
+ * each other and the results do not depend on the order they are evaluated in.
+ */
+static void obj_collide_batch_evaluate()
+{
+	TRACE_SCOPE(tracing::CollideGeometry);
+
+	util::jobs::parallel_for(0, Collision_batch.size(), 4, &tracing::CollideGeometryJob, [](size_t i) {
+		auto &entry = Collision_batch[i];
+
+		// the batch does not grow anymore, so pointers into it stay valid from here on
+		entry.pair.geometry = &entry.geometry;
+
+		if ( entry.evaluate != NULL ) {
+			entry.evaluate(&entry.pair);
+		}
+	});
+}
+
+/**
+ * Applies the collision responses of the batch on the main thread, in the order the broadphase reported the pairs.
+ * A pair whose geometry test was invalidated by an earlier response runs the test again here.
+ */
+static void obj_collide_batch_apply()
+{
+	for ( auto &entry : Collision_batch ) {
+		// a response earlier in the batch may have deleted one of the objects and reused its slot
+		if ( entry.pair.a->signature != entry.signature_a || entry.pair.b->signature != entry.signature_b ) {
+			continue;
+		}
+
+		TRACE_SCOPE(tracing::CollidePair);
+		obj_collide_pair_apply(&entry.pair, entry.cache);
+	}
+
+	Collision_batch.clear();
+}
 
 void obj_sort_and_collide()
 {
@@ -1040,29 +1374,89 @@ void obj_sort_and_collide()
 	if ( !(Game_detail_flags & DETAIL_FLAG_COLLISION) )
 		return;
 
-	sort_list_y.clear();
-	{
-		TRACE_SCOPE(tracing::SortColliders);
-		obj_quicksort_colliders(&Collision_sort_list, 0, (int)(Collision_sort_list.size() - 1), 0);
+	obj_broadphase_update();
+
+	Collision_batch.clear();
+	obj_broadphase_sweep(obj_broadphase_gather_pair);
+
+	obj_collide_batch_evaluate();
+	obj_collide_batch_apply();
+}
+
+// used only by the collide_bench debug command
+static SCP_vector<int> sort_list_x;
+static SCP_vector<int> sort_list_y;
+static SCP_vector<int> sort_list_z;
+
+static int Collide_bench_pairs = 0;
+
+static void obj_broadphase_count_pair(int /*objnum_a*/, int /*objnum_b*/)
+{
+	Collide_bench_pairs++;
+}
+
+DCF(collide_bench, "Compares the sweep-and-prune broadphase against the per-axis quicksort on the current colliders")
+{
+	int iterations = 100;
+
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: collide_bench [iterations]\n");
+		dc_printf("\tReplays the current set of colliders through both broadphase implementations (default %d times)\n", iterations);
+		dc_printf("\tand prints the number of candidate pairs and the time per pass for each.\n");
+		dc_printf("\tCollision responses are not run.\n");
+		return;
+	}
+
+	dc_maybe_stuff_int(&iterations);
+	if (iterations <= 0) {
+		dc_printf("Iteration count must be positive\n");
+		return;
 	}
-	obj_find_overlap_colliders(&sort_list_y, &Collision_sort_list, 0, false);
 
-	sort_list_z.clear();
-	{
-		TRACE_SCOPE(tracing::SortColliders);
-		obj_quicksort_colliders(&sort_list_y, 0, (int)(sort_list_y.size() - 1), 1);
+	// make sure pending additions and removals are applied before snapshotting the collider set
+	obj_broadphase_update();
+
+	SCP_vector<int> colliders;
+	colliders.reserve(Collider_sweep_list.size());
+	for (auto &entry : Collider_sweep_list) {
+		colliders.push_back(entry.objnum);
 	}
-	obj_find_overlap_colliders(&sort_list_z, &sort_list_y, 1, false);
 
-	sort_list_y.clear();
-	{
-		TRACE_SCOPE(tracing::SortColliders);
+	int legacy_pairs = 0;
+	std::uint64_t start = timer_get_microseconds();
+	for (int i = 0; i < iterations; ++i) {
+		legacy_pairs = 0;
+
+		sort_list_x = colliders;
+		sort_list_y.clear();
+		obj_quicksort_colliders(&sort_list_x, 0, (int)(sort_list_x.size() - 1), 0);
+		obj_find_overlap_colliders(&sort_list_y, &sort_list_x, 0, false);
+
+		sort_list_z.clear();
+		obj_quicksort_colliders(&sort_list_y, 0, (int)(sort_list_y.size() - 1), 1);
+		obj_find_overlap_colliders(&sort_list_z, &sort_list_y, 1, false);
+
+		sort_list_y.clear();
 		obj_quicksort_colliders(&sort_list_z, 0, (int)(sort_list_z.size() - 1), 2);
+		obj_find_overlap_colliders(&sort_list_y, &sort_list_z, 2, false, &legacy_pairs);
 	}
-	obj_find_overlap_colliders(&sort_list_y, &sort_list_z, 2, true);
+	std::uint64_t legacy_time = timer_get_microseconds() - start;
+
+	start = timer_get_microseconds();
+	for (int i = 0; i < iterations; ++i) {
+		Collide_bench_pairs = 0;
+
+		obj_broadphase_update();
+		obj_broadphase_sweep(obj_broadphase_count_pair);
+	}
+	std::uint64_t sweep_time = timer_get_microseconds() - start;
+
+	dc_printf("%d colliders, %d iterations\n", (int)colliders.size(), iterations);
+	dc_printf("  per-axis quicksort: %d candidate pairs, %.1f us per pass\n", legacy_pairs, (double)legacy_time / iterations);
+	dc_printf("  sweep and prune:    %d candidate pairs, %.1f us per pass (sweep axis %d)\n", Collide_bench_pairs, (double)sweep_time / iterations, Collider_sweep_axis);
 }
 
-void obj_find_overlap_colliders(SCP_vector<int> *overlap_list_out, SCP_vector<int> *list, int axis, bool collide)
+void obj_find_overlap_colliders(SCP_vector<int> *overlap_list_out, SCP_vector<int> *list, int axis, bool collide, int *num_pairs_out)
 {
 	TRACE_SCOPE(tracing::FindOverlapColliders);
 
@@ -1094,6 +1488,10 @@ void obj_find_overlap_colliders(SCP_vector<int> *overlap_list_out, SCP_vector<in
 				if ( collide ) {
 					obj_collide_pair(&Objects[(*list)[i]], &Objects[overlappers[j]]);
 				}
+
+				if ( num_pairs_out != NULL ) {
+					(*num_pairs_out)++;
+				}
 			} else {
 				overlappers[j] = overlappers.back();
 				overlappers.pop_back();
@@ -1204,24 +1602,40 @@ void obj_collide_pair(object *A, object *B)
 {
 	TRACE_SCOPE(tracing::CollidePair);
 
+	obj_pair new_pair;
+	collider_pair *collision_info = obj_collide_pair_prepare(A, B, &new_pair);
+
+	if ( collision_info != NULL ) {
+		obj_collide_pair_apply(&new_pair, collision_info);
+	}
+}
+
+/**
+ * Runs the cheap rejection tests for a pair and looks up its entry in Collision_cached_pairs.
+ *
+ * @return the cached pair info if the pair needs to be checked this frame, in which case pair_out is filled in,
+ *         or NULL if it can be skipped.
+ */
+static collider_pair *obj_collide_pair_prepare(object *A, object *B, obj_pair *pair_out)
+{
 	uint ctype;
 	int (*check_collision)( obj_pair *pair );
 	int swapped = 0;	
 	
 	check_collision = NULL;
 
-	if ( A==B ) return;		// Don't check collisions with yourself
+	if ( A==B ) return NULL;		// Don't check collisions with yourself
 
-	if ( !(A->flags[Object::Object_Flags::Collides]) ) return;		// This object doesn't collide with anything
-	if ( !(B->flags[Object::Object_Flags::Collides]) ) return;		// This object doesn't collide with anything
+	if ( !(A->flags[Object::Object_Flags::Collides]) ) return NULL;		// This object doesn't collide with anything
+	if ( !(B->flags[Object::Object_Flags::Collides]) ) return NULL;		// This object doesn't collide with anything
 	
-	if ((A->flags[Object::Object_Flags::Immobile]) && (B->flags[Object::Object_Flags::Immobile])) return;	// Two immobile objects will never collide with each other
+	if ((A->flags[Object::Object_Flags::Immobile]) && (B->flags[Object::Object_Flags::Immobile])) return NULL;	// Two immobile objects will never collide with each other
 
 	// Make sure you're not checking a parent with it's kid or vicy-versy
 //	if ( A->parent_sig == B->signature && !(A->type == OBJ_SHIP && B->type == OBJ_DEBRIS) ) return;
 //	if ( B->parent_sig == A->signature && !(A->type == OBJ_DEBRIS && B->type == OBJ_SHIP) ) return;
 	if ( reject_obj_pair_on_parent(A,B) ) {
-		return;
+		return NULL;
 	}
 
 	Assert( A->type < 127 );
@@ -1282,7 +1696,7 @@ void obj_collide_pair(object *A, object *B)
 	
 	case COLLISION_OF(OBJ_SHIP, OBJ_BEAM):
 		if(beam_collide_early_out(B, A)){
-			return;
+			return NULL;
 		}
 		swapped = 1;
 		check_collision = beam_collide_ship;
@@ -1290,14 +1704,14 @@ void obj_collide_pair(object *A, object *B)
 
 	case COLLISION_OF(OBJ_BEAM, OBJ_SHIP):
 		if(beam_collide_early_out(A, B)){
-			return;
+			return NULL;
 		}
 		check_collision = beam_collide_ship;
 		break;
 
 	case COLLISION_OF(OBJ_ASTEROID, OBJ_BEAM):
 		if(beam_collide_early_out(B, A)) {
-			return;
+			return NULL;
 		}
 		swapped = 1;
 		check_collision = beam_collide_asteroid;
@@ -1305,26 +1719,26 @@ void obj_collide_pair(object *A, object *B)
 
 	case COLLISION_OF(OBJ_BEAM, OBJ_ASTEROID):
 		if(beam_collide_early_out(A, B)){
-			return;
+			return NULL;
 		}
 		check_collision = beam_collide_asteroid;
 		break;
 	case COLLISION_OF(OBJ_DEBRIS, OBJ_BEAM):
 		if(beam_collide_early_out(B, A)) {
-			return;
+			return NULL;
 		}
 		swapped = 1;
 		check_collision = beam_collide_debris;
 		break;
 	case COLLISION_OF(OBJ_BEAM, OBJ_DEBRIS):
 		if(beam_collide_early_out(A, B)){
-			return;
+			return NULL;
 		}
 		check_collision = beam_collide_debris;
 		break;
 	case COLLISION_OF(OBJ_WEAPON, OBJ_BEAM):
 		if(beam_collide_early_out(B, A)) {
-			return;
+			return NULL;
 		}
 		swapped = 1;
 		check_collision = beam_collide_missile;
@@ -1332,7 +1746,7 @@ void obj_collide_pair(object *A, object *B)
 
 	case COLLISION_OF(OBJ_BEAM, OBJ_WEAPON):
 		if(beam_collide_early_out(A, B)){
-			return;
+			return NULL;
 		}		
 		check_collision = beam_collide_missile;
 		break;
@@ -1355,10 +1769,10 @@ void obj_collide_pair(object *A, object *B)
 	}
 
 	default:
-		return;
+		return NULL;
 	}
 
-	if ( !check_collision ) return;
+	if ( !check_collision ) return NULL;
 
 	// Swap them if needed
 	if ( swapped )	{
@@ -1397,10 +1811,10 @@ void obj_collide_pair(object *A, object *B)
 	if ( valid &&  A->type != OBJ_BEAM ) {
 		// if this signature is valid, make the necessary checks to see if we need to collide check
 		if ( collision_info->next_check_time == -1 ) {
-			return;
+			return NULL;
 		} else {
 			if ( !timestamp_elapsed(collision_info->next_check_time) ) {
-				return;
+				return NULL;
 			}
 		}
 	} else {
@@ -1435,7 +1849,7 @@ void obj_collide_pair(object *A, object *B)
 						// The other object is behind the weapon by more than
 						// its radius, so it will never hit...
 						collision_info->next_check_time = -1;
-						return;
+						return NULL;
 					}
 				}
 
@@ -1444,13 +1858,13 @@ void obj_collide_pair(object *A, object *B)
 				vm_vec_sub(&delta_v, &B->phys_info.vel, &A->phys_info.vel);
 				if (vm_vec_dist_squared(&A->pos, &B->pos) > (vm_vec_mag_squared(&delta_v)*Weapons[B->instance].lifeleft*Weapons[B->instance].lifeleft)) {
 					collision_info->next_check_time = -1;
-					return;
+					return NULL;
 				}
 
 				// for nonplayer ships, only create collision pair if close enough
 				if ( (B->parent >= 0) && !((Objects[B->parent].signature == B->parent_sig) && (Objects[B->parent].flags[Object::Object_Flags::Player_ship])) && (vm_vec_dist(&B->pos, &A->pos) < (4.0f*A->radius + 200.0f)) ) {
 					collision_info->next_check_time = -1;
-					return;
+					return NULL;
 				}
 			}
 		}
@@ -1465,22 +1879,30 @@ void obj_collide_pair(object *A, object *B)
 				&& (Ship_info[Ships[A->instance].ship_info_index].is_small_ship()) 
 				&& (Weapon_info[Weapons[B->instance].weapon_info_index].subtype == WP_LASER) ) {
 				collision_info->next_check_time = -1;
-				return;
+				return NULL;
 			}
 		}
 	}
 
-	obj_pair new_pair;	
+	pair_out->a = A;
+	pair_out->b = B;
+	pair_out->check_collision = check_collision;
+	pair_out->next_check_time = collision_info->next_check_time;
+	pair_out->geometry = NULL;
+	pair_out->next = NULL;
 
-	new_pair.a = A;
-	new_pair.b = B;
-	new_pair.check_collision = check_collision;
-	new_pair.next_check_time = collision_info->next_check_time;
+	return collision_info;
+}
 
-	if ( check_collision(&new_pair) ) {
+/**
+ * Runs the narrow phase check and the collision response for a prepared pair and stores when to check it next.
+ */
+static void obj_collide_pair_apply(obj_pair *pair, collider_pair *collision_info)
+{
+	if ( pair->check_collision(pair) ) {
 		// don't have to check ever again
 		collision_info->next_check_time = -1;
 	} else {
-		collision_info->next_check_time = new_pair.next_check_time;
+		collision_info->next_check_time = pair->next_check_time;
 	}
 }
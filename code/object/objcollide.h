@@ -13,10 +13,10 @@
 #define _COLLIDESTUFF_H
 
 #include "globalincs/pstypes.h"
+#include "model/model.h"
 
 class object;
 struct CFILE;
-struct mc_info;
 
 // used for ship:ship and ship:debris
 typedef struct collision_info_struct {
@@ -50,12 +50,39 @@ typedef struct collision_info_struct {
 // type specific collision modules.
 //===============================================================================
 
+// Result of the read-only geometry part of a narrow phase check.  For the pairs collided by obj_sort_and_collide()
+// this is filled in for the whole frame's batch before any collision response is applied, so the model_collide()
+// queries do not depend on the (order dependent) hit handling.
+typedef struct collision_geometry {
+	bool	valid;					// set once the geometry test has been run for the pair
+	int		shield_collision;
+	int		hull_collision;
+	vec3d	end_pos;				// end of the tested path, the p1 of both mc_infos points here
+	mc_info	mc_shield;
+	mc_info	mc_hull;
+
+	// what the test depended on, a response applied earlier in the batch may have changed it
+	vec3d	ship_pos;
+	matrix	ship_orient;
+	vec3d	weapon_last_pos;
+	bool	no_shields;
+
+	// weapon-weapon pairs only use hull_collision for the collide_subdivide() result, tested on these paths
+	vec3d	a_last_pos;
+	vec3d	a_pos;
+	vec3d	b_last_pos;
+	vec3d	b_pos;
+	float	a_radius;
+	float	b_radius;
+} collision_geometry;
+
 // Keeps track of pairs of objects for collision detection
 typedef struct obj_pair	{
 	object *a;
 	object *b;
 	int (*check_collision)( obj_pair * pair );
 	int	next_check_time;	// a timestamp that when elapsed means to check for a collision
+	collision_geometry *geometry;	// precomputed geometry test, or NULL if check_collision has to do it itself
 	struct obj_pair *next;
 } obj_pair;
 
@@ -72,9 +99,15 @@ void obj_add_collider(int obj_index);
 void obj_remove_collider(int obj_index);
 void obj_reset_colliders();
 
+// runs the broadphase over all colliders and collides every overlapping pair
+// the pairs are gathered into a batch first; their geometry tests are evaluated for the whole batch before the
+// collision responses are applied one pair at a time, in broadphase order
 void obj_sort_and_collide();
+
+// per-axis quicksort broadphase that obj_sort_and_collide() used to run every frame, kept as a reference for the
+// collide_bench debug command
 void obj_quicksort_colliders(SCP_vector<int> *list, int left, int right, int axis);
-void obj_find_overlap_colliders(SCP_vector<int> *overlap_list_out, SCP_vector<int> *list, int axis, bool collide);
+void obj_find_overlap_colliders(SCP_vector<int> *overlap_list_out, SCP_vector<int> *list, int axis, bool collide, int *num_pairs_out = NULL);
 float obj_get_collider_endpoint(int obj_num, int axis, bool min);
 void obj_collide_pair(object *A, object *B);
 
@@ -103,11 +136,21 @@ int collide_subdivide(vec3d *p0, vec3d *p1, float prad, vec3d *q0, vec3d *q1, fl
 // CODE is locatated in CollideWeaponWeapon.cpp
 int collide_weapon_weapon( obj_pair * pair );
 
+// Runs the collide_subdivide() part of collide_weapon_weapon() for the pair and stores the result in pair->geometry.
+// Does not modify any game state.
+// CODE is locatated in CollideWeaponWeapon.cpp
+void collide_weapon_weapon_geometry( obj_pair * pair );
+
 // Checks ship-weapon collisions.  pair->a is ship and pair->b is weapon.
 // Returns 1 if all future collisions between these can be ignored
 // CODE is locatated in CollideShipWeapon.cpp
 int collide_ship_weapon( obj_pair * pair );
 
+// Runs the model_collide() part of collide_ship_weapon() for the pair and stores the result in pair->geometry.
+// Does not modify any game state.
+// CODE is locatated in CollideShipWeapon.cpp
+void collide_ship_weapon_geometry( obj_pair * pair );
+
 // Checks debris-weapon collisions.  pair->a is debris and pair->b is weapon.
 // Returns 1 if all future collisions between these can be ignored
 // CODE is locatated in CollideDebrisWeapon.cpp
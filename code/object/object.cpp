@@ -10,7 +10,9 @@
 
 
 
+#include "ai/ai.h"
 #include "asteroid/asteroid.h"
+#include "cmdline/cmdline.h"
 #include "cmeasure/cmeasure.h"
 #include "debris/debris.h"
 #include "debugconsole/console.h"
@@ -28,6 +30,7 @@
 #include "object/objcollide.h"
 #include "object/object.h"
 #include "object/objectdock.h"
+#include "object/objectgrid.h"
 #include "object/objectshield.h"
 #include "object/objectsnd.h"
 #include "observer/observer.h"
@@ -39,6 +42,7 @@
 #include "ship/afterburner.h"
 #include "ship/ship.h"
 #include "tracing/tracing.h"
+#include "utils/JobSystem.h"
 #include "weapon/beam.h"
 #include "weapon/shockwave.h"
 #include "weapon/swarm.h"
@@ -339,6 +343,8 @@ void obj_init()
 	list_init( &obj_used_list );
 	list_init( &obj_create_list );
 
+	obj_grid_init();
+
 	// Link all object slots into the free list
 	objp = Objects;
 	for (i=0; i<MAX_OBJECTS; i++)	{
@@ -518,6 +524,8 @@ int obj_create(ubyte type,int parent_obj,int instance, matrix * orient,
 	obj->n_quadrants = DEFAULT_SHIELD_SECTIONS; // Might be changed by the ship creation code
 	obj->shield_quadrant.resize(obj->n_quadrants);
 
+	obj_grid_add_new(objnum);
+
 	return objnum;
 }
 
@@ -791,11 +799,18 @@ void obj_player_fire_stuff( object *objp, control_info ci )
 	
 }
 
-void obj_move_call_physics(object *objp, float frametime)
-{
-	TRACE_SCOPE(tracing::Physics);
+// what obj_move_physics_prepare() found needs to be done for an object
+#define OBJ_MOVE_SIMULATE		(1<<0)		// physics_sim() has to be called
+#define OBJ_MOVE_FIRE			(1<<1)		// the object may fire after it has been moved
 
-	int has_fired = -1;	//stop fireing stuff-Bobboau
+/**
+ * Everything obj_move_call_physics() does before the object is simulated
+ *
+ * @return A combination of the OBJ_MOVE_* flags
+ */
+static int obj_move_physics_prepare(object *objp, float frametime)
+{
+	int stage = 0;
 
 	//	Do physics for objects with OF_PHYSICS flag set and with some engine strength remaining.
 	if ( objp->flags[Object::Object_Flags::Physics] ) {
@@ -868,9 +883,11 @@ void obj_move_call_physics(object *objp, float frametime)
 
 		if (physics_paused)	{
 			if (objp==Player_obj){
-				physics_sim(&objp->pos, &objp->orient, &objp->phys_info, frametime );		// simulate the physics
+				stage |= OBJ_MOVE_SIMULATE;		// simulate the physics
 			}
 		} else {
+			stage |= OBJ_MOVE_FIRE;
+
 			//	Hack for dock mode.
 			//	If docking with a ship, we don't obey the normal ship physics, we can slew about.
 			if (objp->type == OBJ_SHIP) {
@@ -900,30 +917,42 @@ void obj_move_call_physics(object *objp, float frametime)
 			// then reset the flag and don't move the object.
             if (MULTIPLAYER_MASTER && (objp->flags[Object::Object_Flags::Just_updated])) {
 				objp->flags.remove(Object::Object_Flags::Just_updated);
-				goto obj_maybe_fire;
+			} else {
+				stage |= OBJ_MOVE_SIMULATE;		// simulate the physics
 			}
+		}
+	}
 
-				physics_sim(&objp->pos, &objp->orient, &objp->phys_info, frametime );		// simulate the physics
-
-			// if the object is the player object, do things that need to be done after the ship
-			// is moved (like firing weapons, etc).  This routine will get called either single
-			// or multiplayer.  We must find the player object to get to the control info field
-obj_maybe_fire:
-			if ( (objp->flags[Object::Object_Flags::Player_ship]) && (objp->type != OBJ_OBSERVER) && (objp == Player_obj)) {
-				player *pp;
-				if(Player != NULL){
-					pp = Player;
-					obj_player_fire_stuff( objp, pp->ci );				
-				}
-			}
+	return stage;
+}
+
+/**
+ * Everything obj_move_call_physics() does after the object has been simulated
+ *
+ * @param stage What obj_move_physics_prepare() returned for the object
+ */
+static void obj_move_physics_finish(object *objp, int stage)
+{
+	int has_fired = -1;	//stop fireing stuff-Bobboau
 
-			// fire streaming weapons for ships in here - ALL PLAYERS, regardless of client, single player, server, whatever.
-			// do stream weapon firing for all ships themselves. 
-			if(objp->type == OBJ_SHIP){
-				ship_fire_primary(objp, 1, 0);
-					has_fired = 1;
+	if (stage & OBJ_MOVE_FIRE) {
+		// if the object is the player object, do things that need to be done after the ship
+		// is moved (like firing weapons, etc).  This routine will get called either single
+		// or multiplayer.  We must find the player object to get to the control info field
+		if ( (objp->flags[Object::Object_Flags::Player_ship]) && (objp->type != OBJ_OBSERVER) && (objp == Player_obj)) {
+			player *pp;
+			if(Player != NULL){
+				pp = Player;
+				obj_player_fire_stuff( objp, pp->ci );				
 			}
 		}
+
+		// fire streaming weapons for ships in here - ALL PLAYERS, regardless of client, single player, server, whatever.
+		// do stream weapon firing for all ships themselves. 
+		if(objp->type == OBJ_SHIP){
+			ship_fire_primary(objp, 1, 0);
+				has_fired = 1;
+		}
 	}
 	
 	if(has_fired == -1){
@@ -953,6 +982,19 @@ obj_maybe_fire:
 	}
 }
 
+void obj_move_call_physics(object *objp, float frametime)
+{
+	TRACE_SCOPE(tracing::Physics);
+
+	int stage = obj_move_physics_prepare(objp, frametime);
+
+	if (stage & OBJ_MOVE_SIMULATE) {
+		physics_sim(&objp->pos, &objp->orient, &objp->phys_info, frametime);
+	}
+
+	obj_move_physics_finish(objp, stage);
+}
+
 
 #ifdef OBJECT_CHECK 
 
@@ -1396,6 +1438,67 @@ int Collisions_enabled = 1;
 
 DCF_BOOL( collisions, Collisions_enabled )
 
+// An object that is being moved by obj_move_all()
+typedef struct obj_move_entry {
+	object	*objp;
+	int		stage;		// what obj_move_physics_prepare() returned, -1 if the object is not simulated
+} obj_move_entry;
+
+static SCP_vector<obj_move_entry> Obj_move_list;
+
+// the objects which are simulated by obj_move_all_simulate(), in parallel and on the main thread
+static SCP_vector<object*> Obj_move_simulate;
+static SCP_vector<object*> Obj_move_simulate_serial;
+
+// -serial_physics keeps this off so that runs can be compared for determinism
+bool Obj_move_parallel = true;
+DCF_BOOL(parallel_physics, Obj_move_parallel)
+
+/**
+ * Runs physics_sim() for every object in Obj_move_list which needs it
+ *
+ * physics_sim() only touches the position, orientation and physics info of the object it is given so the objects are
+ * simulated in parallel.  The exception is the shockwave shake which draws from the global random number generator;
+ * those objects are simulated afterwards on this thread, in object order, so that the results do not depend on how the
+ * jobs were scheduled.  Docked objects are simulated like everything else and pulled back together by
+ * dock_move_docked_objects() once all objects have moved.
+ */
+static void obj_move_all_simulate(float frametime)
+{
+	TRACE_SCOPE(tracing::Physics);
+
+	Obj_move_simulate.clear();
+	Obj_move_simulate_serial.clear();
+	for (auto& entry : Obj_move_list) {
+		if ((entry.stage < 0) || !(entry.stage & OBJ_MOVE_SIMULATE)) {
+			continue;
+		}
+
+		if (entry.objp->phys_info.flags & PF_IN_SHOCKWAVE) {
+			Obj_move_simulate_serial.push_back(entry.objp);
+		} else {
+			Obj_move_simulate.push_back(entry.objp);
+		}
+	}
+
+	auto simulate = [frametime](size_t i) {
+		object *objp = Obj_move_simulate[i];
+		physics_sim(&objp->pos, &objp->orient, &objp->phys_info, frametime);
+	};
+
+	if (Obj_move_parallel && !Cmdline_serial_physics) {
+		util::jobs::parallel_for(0, Obj_move_simulate.size(), 32, &tracing::PhysicsJob, simulate);
+	} else {
+		for (size_t i = 0; i < Obj_move_simulate.size(); ++i) {
+			simulate(i);
+		}
+	}
+
+	for (auto objp : Obj_move_simulate_serial) {
+		physics_sim(&objp->pos, &objp->orient, &objp->phys_info, frametime);
+	}
+}
+
 MONITOR( NumObjects )
 
 /**
@@ -1428,6 +1531,9 @@ void obj_move_all(float frametime)
 
 	MONITOR_INC( NumObjects, Num_objects );	
 
+	Obj_move_list.clear();
+
+	// Phase 1: everything before the physics, in object order
 	for (objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
 		// skip objects which should be dead
 		if (objp->flags[Object::Object_Flags::Should_be_dead]) {
@@ -1470,6 +1576,10 @@ void obj_move_all(float frametime)
 		objp->last_pos = cur_pos;
 		objp->last_orient = objp->orient;
 
+		obj_move_entry entry;
+		entry.objp = objp;
+		entry.stage = -1;
+
 		// Goober5000 - skip objects which don't move, but only until they're destroyed
 		if (!(objp->flags[Object::Object_Flags::Immobile] && objp->hull_strength > 0.0f)) {
 			// if this is an object which should be interpolated in multiplayer, do so
@@ -1477,10 +1587,31 @@ void obj_move_all(float frametime)
 				multi_oo_interp(objp);
 			} else {
 				// physics
-				obj_move_call_physics(objp, frametime);
+				entry.stage = obj_move_physics_prepare(objp, frametime);
 			}
 		}
 
+		Obj_move_list.push_back(entry);
+	}
+
+	// Phase 2: the physics integration, which only touches the object itself
+	obj_move_all_simulate(frametime);
+
+	// pick the new turret targets for the frame now that everything is where it will be for the AI
+	ai_turret_evaluate_targets();
+
+	// Phase 3: everything after the physics, in object order
+	for (auto& entry : Obj_move_list) {
+		objp = entry.objp;
+
+		// an earlier object may have killed this one during its post-move
+		if (objp->flags[Object::Object_Flags::Should_be_dead])
+			continue;
+
+		if (entry.stage >= 0) {
+			obj_move_physics_finish(objp, entry.stage);
+		}
+
 		// move post
 		obj_move_all_post(objp, frametime);
 
@@ -1568,6 +1699,9 @@ void obj_move_all(float frametime)
 	// update artillery locking info now
 	ship_update_artillery_lock();
 
+	// everything is where it will be for the rest of the frame, so index the new positions
+	obj_grid_rebuild(frametime);
+
 //	mprintf(("moved all objects\n"));
 }
 
@@ -0,0 +1,231 @@
+#include "object/objectgrid.h"
+
+#include "debugconsole/console.h"
+#include "globalincs/linklist.h"
+#include "iff_defs/iff_defs.h"
+#include "object/object.h"
+#include "tracing/tracing.h"
+
+#include <algorithm>
+
+extern float flFrametime;
+
+// Objects are only put into the grid if there is a query which looks for them
+#define OBJ_GRID_TYPES	(OBJ_GRID_TYPE_MASK(OBJ_SHIP) | OBJ_GRID_TYPE_MASK(OBJ_WEAPON) | OBJ_GRID_TYPE_MASK(OBJ_DEBRIS) | OBJ_GRID_TYPE_MASK(OBJ_ASTEROID))
+
+// Safety factor for the distance an object may travel between two rebuilds; physics can push an object past its
+// maximum velocity for a short while (collisions, shockwaves)
+#define OBJ_GRID_SPEED_MARGIN	1.5f
+
+// Cell coordinates are clamped to this so they fit into 21 bits of the key
+#define OBJ_GRID_MAX_CELL		((1 << 20) - 1)
+
+bool Object_grid_enabled = true;
+DCF_BOOL(object_grid, Object_grid_enabled)
+
+static object_grid Object_grid;
+
+static bool Object_grid_built = false;
+
+// Objects created since the last rebuild
+static SCP_vector<int> Object_grid_new_objects;
+
+// The highest speed of any object of a type at the time of the last rebuild
+static float Object_grid_max_speed[MAX_OBJECT_TYPES];
+
+// Where every object was at the last rebuild.  Used to account for movement which the object's velocity does not
+// show, like docked objects being dragged along by their parent.
+static SCP_vector<object_grid_entry> Object_grid_last_pos;
+
+// Reused between rebuilds so that the rebuild does not have to allocate
+static SCP_vector<object_grid_entry> Object_grid_scratch;
+
+object_grid::object_grid(float cell_size) : _cell_size(cell_size) {
+	Assertion(cell_size > 0.0f, "The cell size of an object grid must be positive!");
+}
+
+int object_grid::cell_coord(float value) const {
+	float cell = floorf(value / _cell_size);
+
+	CLAMP(cell, (float)-OBJ_GRID_MAX_CELL, (float)OBJ_GRID_MAX_CELL);
+
+	return (int)cell;
+}
+
+object_grid::cell_key object_grid::make_key(int x, int y, int z) {
+	return ((cell_key)(x + OBJ_GRID_MAX_CELL) << 42) | ((cell_key)(y + OBJ_GRID_MAX_CELL) << 21) | (cell_key)(z + OBJ_GRID_MAX_CELL);
+}
+
+void object_grid::build(const SCP_vector<object_grid_entry>& entries) {
+	clear();
+
+	SCP_vector<std::pair<cell_key, size_t>> keys;
+	keys.reserve(entries.size());
+
+	for (size_t i = 0; i < entries.size(); ++i) {
+		auto& entry = entries[i];
+
+		if (entry.radius > _cell_size * 0.5f) {
+			_large.push_back(entry);
+			continue;
+		}
+
+		_max_small_radius = MAX(_max_small_radius, entry.radius);
+		keys.emplace_back(make_key(cell_coord(entry.pos.xyz.x), cell_coord(entry.pos.xyz.y), cell_coord(entry.pos.xyz.z)), i);
+	}
+
+	// Sort by cell so that every cell is a contiguous range of the entries. The index is part of the sort key so that
+	// the entries of a cell keep the order they were passed in.
+	std::sort(keys.begin(), keys.end());
+
+	_entries.reserve(keys.size());
+	for (size_t i = 0; i < keys.size(); ++i) {
+		if (i == 0 || keys[i].first != keys[i - 1].first) {
+			_cells[keys[i].first] = { i, i };
+		}
+		_cells[keys[i].first].end = i + 1;
+
+		_entries.push_back(entries[keys[i].second]);
+	}
+}
+
+void object_grid::clear() {
+	_entries.clear();
+	_cells.clear();
+	_large.clear();
+	_max_small_radius = 0.0f;
+}
+
+void obj_grid_init()
+{
+	Object_grid.clear();
+	Object_grid_built = false;
+	Object_grid_new_objects.clear();
+	Object_grid_last_pos.clear();
+
+	for (auto& speed : Object_grid_max_speed) {
+		speed = 0.0f;
+	}
+}
+
+void obj_grid_rebuild(float frametime)
+{
+	TRACE_SCOPE(tracing::ObjectGridRebuild);
+
+	if (Object_grid_last_pos.size() != MAX_OBJECTS) {
+		Object_grid_last_pos.resize(MAX_OBJECTS);
+		for (auto& last : Object_grid_last_pos) {
+			last.signature = -1;
+		}
+	}
+
+	for (auto& speed : Object_grid_max_speed) {
+		speed = 0.0f;
+	}
+
+	Object_grid_scratch.clear();
+
+	auto add_object = [frametime](object *objp) {
+		if (!(OBJ_GRID_TYPE_MASK(objp->type) & OBJ_GRID_TYPES)) {
+			return;
+		}
+
+		int objnum = OBJ_INDEX(objp);
+
+		object_grid_entry entry;
+		entry.objnum = objnum;
+		entry.signature = objp->signature;
+		entry.type = objp->type;
+		entry.pos = objp->pos;
+		entry.radius = objp->radius * OBJ_GRID_DIST_QUICK_SCALE;
+		Object_grid_scratch.push_back(entry);
+
+		float speed = vm_vec_mag(&objp->phys_info.vel);
+		speed = MAX(speed, vm_vec_mag(&objp->phys_info.max_vel));
+		speed = MAX(speed, vm_vec_mag(&objp->phys_info.afterburner_max_vel));
+
+		auto& last = Object_grid_last_pos[objnum];
+		if (last.signature == objp->signature && frametime > 0.0f) {
+			speed = MAX(speed, vm_vec_dist(&last.pos, &objp->pos) / frametime);
+		}
+		last = entry;
+
+		Object_grid_max_speed[objp->type] = MAX(Object_grid_max_speed[objp->type], speed);
+	};
+
+	for (auto objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+		add_object(objp);
+	}
+
+	// Objects created during the frame are only merged into the used list by the next obj_move_all()
+	for (auto objp = GET_FIRST(&obj_create_list); objp != END_OF_LIST(&obj_create_list); objp = GET_NEXT(objp)) {
+		add_object(objp);
+	}
+
+	Object_grid.build(Object_grid_scratch);
+	Object_grid_new_objects.clear();
+	Object_grid_built = true;
+}
+
+void obj_grid_add_new(int objnum)
+{
+	if (!Object_grid_built) {
+		return;
+	}
+
+	if (!(OBJ_GRID_TYPE_MASK(Objects[objnum].type) & OBJ_GRID_TYPES)) {
+		return;
+	}
+
+	// The slot may already be in the list if an object was created and deleted again since the last rebuild
+	if (std::find(Object_grid_new_objects.begin(), Object_grid_new_objects.end(), objnum) == Object_grid_new_objects.end()) {
+		Object_grid_new_objects.push_back(objnum);
+	}
+}
+
+bool obj_grid_available()
+{
+	return Object_grid_enabled && Object_grid_built;
+}
+
+float obj_grid_get_slack(uint type_mask)
+{
+	float max_speed = 0.0f;
+	for (int type = 0; type < MAX_OBJECT_TYPES; ++type) {
+		if (type_mask & OBJ_GRID_TYPE_MASK(type)) {
+			max_speed = MAX(max_speed, Object_grid_max_speed[type]);
+		}
+	}
+
+	return max_speed * flFrametime * OBJ_GRID_SPEED_MARGIN;
+}
+
+const object_grid& obj_grid_get()
+{
+	return Object_grid;
+}
+
+const SCP_vector<int>& obj_grid_get_new_objects()
+{
+	return Object_grid_new_objects;
+}
+
+bool obj_grid_entry_is_live(const object_grid_entry& entry)
+{
+	auto objp = &Objects[entry.objnum];
+
+	return objp->signature == entry.signature && objp->type == entry.type;
+}
+
+bool obj_grid_new_object_matches(int objnum, uint type_mask)
+{
+	auto objp = &Objects[objnum];
+
+	// Whatever is in the slot now was created after the last rebuild so it is fine to pass it on
+	return objp->type != OBJ_NONE && (type_mask & OBJ_GRID_TYPE_MASK(objp->type));
+}
+
+bool obj_grid_team_matches(int objnum, int team_mask)
+{
+	return iff_matches_mask(obj_team(&Objects[objnum]), team_mask) != 0;
+}
@@ -0,0 +1,265 @@
+#ifndef _OBJECTGRID_H
+#define _OBJECTGRID_H
+
+#include "globalincs/pstypes.h"
+#include "math/vecmat.h"
+
+#include <cmath>
+
+// A uniform grid over the objects in the mission which answers "which objects are near this point" without walking
+// obj_used_list.  It is rebuilt once per frame at the end of obj_move_all() so the stored positions lag behind the
+// objects while they are being moved.  To make up for that every query is widened by how far an object of the queried
+// types can have travelled since the rebuild.  Distances and radii are also widened enough to cover the error of
+// vm_vec_dist_quick(), which is what most of the game code tests against.  The result is a superset of the objects
+// that really satisfy the query so callers still have to do their own tests; they just get to skip most of the objects
+// in the mission.
+
+// Object types which are put into the grid, as a mask of (1 << OBJ_xxx)
+#define OBJ_GRID_TYPE_MASK(type)		(1u << (type))
+
+typedef struct object_grid_entry {
+	int		objnum;
+	int		signature;
+	int		type;
+	vec3d	pos;				// position at the time of the rebuild
+	float	radius;
+} object_grid_entry;
+
+/**
+ * @brief The spatial part of the object grid
+ *
+ * This only knows about the entries it was built with so it can be used (and tested) without the object system.
+ * Queries visit every entry whose sphere, grown by @c slack, might intersect the query volume.
+ */
+class object_grid {
+ public:
+	explicit object_grid(float cell_size = 500.0f);
+
+	/**
+	 * @brief Replaces the contents of the grid
+	 *
+	 * Entries which are larger than half a cell are kept in a separate list which is checked by every query.
+	 */
+	void build(const SCP_vector<object_grid_entry>& entries);
+
+	void clear();
+
+	size_t size() const { return _entries.size() + _large.size(); }
+
+	float cell_size() const { return _cell_size; }
+
+	/**
+	 * @brief Visits the entries which may be within @c radius of @c center
+	 *
+	 * @param center The center of the query sphere
+	 * @param radius The radius of the query sphere, the entry radius is added to this
+	 * @param type_mask Only entries with a type in this mask are visited
+	 * @param slack Additional distance to allow for entries that have moved since the grid was built
+	 * @param fn Called with every candidate entry
+	 */
+	template<typename Function>
+	void for_each_in_sphere(const vec3d* center, float radius, uint type_mask, float slack, Function fn) const {
+		float reach = radius + slack;
+
+		for_each_candidate(center, reach + _max_small_radius, type_mask, [&](const object_grid_entry& entry) {
+			float max_dist = reach + entry.radius;
+			if (vm_vec_dist_squared(center, &entry.pos) <= max_dist * max_dist) {
+				fn(entry);
+			}
+		});
+	}
+
+	/**
+	 * @brief Visits the entries which may be inside a cone
+	 *
+	 * @param apex The apex of the cone
+	 * @param dir The (normalized) axis of the cone
+	 * @param min_dot The cosine of the half angle of the cone, everything with a dot product above this is inside
+	 * @param radius The length of the cone
+	 * @param type_mask Only entries with a type in this mask are visited
+	 * @param slack Additional distance to allow for entries that have moved since the grid was built
+	 * @param fn Called with every candidate entry
+	 */
+	template<typename Function>
+	void for_each_in_cone(const vec3d* apex, const vec3d* dir, float min_dot, float radius, uint type_mask, float slack, Function fn) const {
+		if (min_dot <= -1.0f) {
+			for_each_in_sphere(apex, radius, type_mask, slack, fn);
+			return;
+		}
+
+		float half_angle = acosf(MIN(min_dot, 1.0f));
+
+		for_each_in_sphere(apex, radius, type_mask, slack, [&](const object_grid_entry& entry) {
+			vec3d to_entry;
+			vm_vec_sub(&to_entry, &entry.pos, apex);
+			float dist = vm_vec_mag(&to_entry);
+			float entry_radius = entry.radius + slack;
+
+			if (dist <= entry_radius) {
+				// The apex is inside the entry
+				fn(entry);
+				return;
+			}
+
+			// Widen the cone by the angle the entry sphere covers as seen from the apex
+			float angle = half_angle + asinf(entry_radius / dist);
+			if (angle >= PI || vm_vec_dot(&to_entry, dir) >= cosf(angle) * dist) {
+				fn(entry);
+			}
+		});
+	}
+
+ private:
+	typedef uint64_t cell_key;
+
+	struct cell_range {
+		size_t begin;
+		size_t end;
+	};
+
+	float _cell_size;
+	float _max_small_radius = 0.0f;
+
+	// Entries which fit into a cell, sorted by their cell
+	SCP_vector<object_grid_entry> _entries;
+	SCP_unordered_map<cell_key, cell_range> _cells;
+
+	// Entries which are too large for a cell
+	SCP_vector<object_grid_entry> _large;
+
+	int cell_coord(float value) const;
+
+	static cell_key make_key(int x, int y, int z);
+
+	template<typename Function>
+	void for_each_candidate(const vec3d* center, float reach, uint type_mask, Function fn) const {
+		int min_cell[3], max_cell[3];
+		size_t num_cells = 1;
+		for (int i = 0; i < 3; ++i) {
+			min_cell[i] = cell_coord(center->a1d[i] - reach);
+			max_cell[i] = cell_coord(center->a1d[i] + reach);
+			num_cells *= (size_t)(max_cell[i] - min_cell[i] + 1);
+		}
+
+		if (num_cells >= _cells.size()) {
+			// The query covers more cells than there are occupied ones so just look at everything
+			for (auto& entry : _entries) {
+				if (type_mask & OBJ_GRID_TYPE_MASK(entry.type)) {
+					fn(entry);
+				}
+			}
+		} else {
+			for (int x = min_cell[0]; x <= max_cell[0]; ++x) {
+				for (int y = min_cell[1]; y <= max_cell[1]; ++y) {
+					for (int z = min_cell[2]; z <= max_cell[2]; ++z) {
+						auto iter = _cells.find(make_key(x, y, z));
+						if (iter == _cells.end()) {
+							continue;
+						}
+
+						for (auto i = iter->second.begin; i < iter->second.end; ++i) {
+							if (type_mask & OBJ_GRID_TYPE_MASK(_entries[i].type)) {
+								fn(_entries[i]);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		for (auto& entry : _large) {
+			if (type_mask & OBJ_GRID_TYPE_MASK(entry.type)) {
+				fn(entry);
+			}
+		}
+	}
+};
+
+extern bool Object_grid_enabled;
+
+// clears the grid, called from obj_init()
+void obj_grid_init();
+
+// rebuilds the grid from the current object positions, called at the end of obj_move_all()
+void obj_grid_rebuild(float frametime);
+
+// tells the grid about an object created since the last rebuild
+void obj_grid_add_new(int objnum);
+
+// whether the grid can be used for queries, if not the callers should scan the object lists instead
+bool obj_grid_available();
+
+// how far an object of the given types may have moved since the last rebuild
+float obj_grid_get_slack(uint type_mask);
+
+// the grid, only valid while obj_grid_available() is true
+const object_grid& obj_grid_get();
+
+// objects which were created after the last rebuild
+const SCP_vector<int>& obj_grid_get_new_objects();
+
+// vm_vec_dist_quick() can be up to 10% short of the real distance
+#define OBJ_GRID_DIST_QUICK_SCALE		1.125f
+
+// helpers for the query templates below
+bool obj_grid_entry_is_live(const object_grid_entry& entry);
+bool obj_grid_new_object_matches(int objnum, uint type_mask);
+bool obj_grid_team_matches(int objnum, int team_mask);
+
+/**
+ * @brief Calls @c fn with the object number of every live object of the given types which may be within @c radius of
+ * @c center (plus the radius of the object)
+ *
+ * Must only be used when obj_grid_available() returns true.
+ */
+template<typename Function>
+void obj_grid_query_sphere(const vec3d* center, float radius, uint type_mask, Function fn) {
+	obj_grid_get().for_each_in_sphere(center, radius * OBJ_GRID_DIST_QUICK_SCALE, type_mask, obj_grid_get_slack(type_mask), [&](const object_grid_entry& entry) {
+		if (obj_grid_entry_is_live(entry)) {
+			fn(entry.objnum);
+		}
+	});
+
+	// Objects created since the rebuild have no position in the grid yet so they are always candidates
+	for (auto objnum : obj_grid_get_new_objects()) {
+		if (obj_grid_new_object_matches(objnum, type_mask)) {
+			fn(objnum);
+		}
+	}
+}
+
+/**
+ * @brief Calls @c fn with the object number of every live object of the given types which may be inside the cone
+ *
+ * Must only be used when obj_grid_available() returns true.
+ */
+template<typename Function>
+void obj_grid_query_cone(const vec3d* apex, const vec3d* dir, float min_dot, float radius, uint type_mask, Function fn) {
+	obj_grid_get().for_each_in_cone(apex, dir, min_dot, radius * OBJ_GRID_DIST_QUICK_SCALE, type_mask, obj_grid_get_slack(type_mask), [&](const object_grid_entry& entry) {
+		if (obj_grid_entry_is_live(entry)) {
+			fn(entry.objnum);
+		}
+	});
+
+	for (auto objnum : obj_grid_get_new_objects()) {
+		if (obj_grid_new_object_matches(objnum, type_mask)) {
+			fn(objnum);
+		}
+	}
+}
+
+/**
+ * @brief Like obj_grid_query_sphere() but also filters on the team of the object
+ *
+ * @param team_mask An iff mask, only objects whose team matches it are passed on
+ */
+template<typename Function>
+void obj_grid_query_team(const vec3d* center, float radius, uint type_mask, int team_mask, Function fn) {
+	obj_grid_query_sphere(center, radius, type_mask, [&](int objnum) {
+		if (obj_grid_team_matches(objnum, team_mask)) {
+			fn(objnum);
+		}
+	});
+}
+
+#endif
@@ -4,8 +4,14 @@
 #include "globalincs/linklist.h"
 #include "object/object.h"
 #include "object/waypoint.h"
+#include "utils/NameIndex.h"
 
 //********************GLOBALS********************
+// Only maintained for lists added through waypoint_add_list() and waypoint_add(); the editors rename lists directly
+// and use a linear search.  This needs to be defined before Waypoint_lists since the list destructors remove
+// themselves from the index.
+static util::NameIndex<waypoint_list*> Waypoint_list_name_index;
+
 SCP_list<waypoint_list> Waypoint_lists;
 
 // In order to restore ai_info to a plain-old-data struct, ai_info->wp_index
@@ -78,7 +84,7 @@ waypoint_list::waypoint_list(const char *name)
 
 waypoint_list::~waypoint_list()
 {
-	// nothing to do
+	Waypoint_list_name_index.remove(m_name, this);
 }
 
 char *waypoint_list::get_name()
@@ -94,18 +100,27 @@ SCP_vector<waypoint> &waypoint_list::get_waypoints()
 void waypoint_list::set_name(const char *name)
 {
 	Assert(name != NULL);
+
+	// only lists which are already part of the mission are in the index
+	bool indexed = Waypoint_list_name_index.remove(m_name, this);
+
 	strcpy_s(this->m_name, name);
+
+	if (indexed)
+		Waypoint_list_name_index.add(m_name, this);
 }
 
 //********************FUNCTIONS********************
 void waypoint_parse_init()
 {
 	Waypoint_lists.clear();
+	Waypoint_list_name_index.clear();
 }
 
 void waypoint_level_close()
 {
 	Waypoint_lists.clear();
+	Waypoint_list_name_index.clear();
 }
 
 int calc_waypoint_instance(int waypoint_list_index, int waypoint_index)
@@ -168,6 +183,9 @@ waypoint_list *find_matching_waypoint_list(const char *name)
 	Assert(name != NULL);
 	SCP_list<waypoint_list>::iterator ii;
 
+	if (!Fred_running)
+		return Waypoint_list_name_index.find(name, [&](waypoint_list *wp_list) { return !stricmp(wp_list->get_name(), name); }, nullptr);
+
 	for (ii = Waypoint_lists.begin(); ii != Waypoint_lists.end(); ++ii)
 	{
 		if (!stricmp(ii->get_name(), name))
@@ -177,12 +195,64 @@ waypoint_list *find_matching_waypoint_list(const char *name)
 	return NULL;
 }
 
+// returns the waypoint referred to by the part of a waypoint name after the colon, or NULL if it isn't valid
+static waypoint *find_waypoint_from_index_string(waypoint_list *wp_list, const char *name, const char *index_str)
+{
+	if (*index_str == '\0')
+	{
+		nprintf(("waypoints", "possible error with waypoint name '%s': no waypoint number after the colon\n", name));
+		return NULL;
+	}
+
+	// make sure it's actually a number
+	for (const char *ch = index_str; *ch != '\0'; ch++)
+	{
+		if (!isdigit(*ch))
+		{
+			nprintf(("waypoints", "possible error with waypoint name '%s': string after the colon is not a number\n", name));
+			return NULL;
+		}
+	}
+
+	// get the number and make sure it's in range
+	uint index = atoi(index_str);
+	if (index < 1 || index > wp_list->get_waypoints().size())
+	{
+		nprintf(("waypoints", "possible error with waypoint name '%s': waypoint number is out of range\n", name));
+		return NULL;
+	}
+
+	return find_waypoint_at_index(wp_list, index - 1);
+}
+
 // NOTE: waypoint names are always in the format Name:index
 waypoint *find_matching_waypoint(const char *name)
 {
 	Assert(name != NULL);
 	SCP_list<waypoint_list>::iterator ii;
 
+	if (!Fred_running)
+	{
+		// the index is all digits, so the list name is everything in front of the last colon
+		auto colon = strrchr(name, ':');
+		if (colon == NULL)
+			return NULL;
+
+		auto len = (size_t) (colon - name);
+		if (len >= NAME_LENGTH)
+			return NULL;
+
+		char list_name[NAME_LENGTH];
+		strncpy(list_name, name, len);
+		list_name[len] = '\0';
+
+		auto wp_list = find_matching_waypoint_list(list_name);
+		if (wp_list == NULL)
+			return NULL;
+
+		return find_waypoint_from_index_string(wp_list, name, colon + 1);
+	}
+
 	for (ii = Waypoint_lists.begin(); ii != Waypoint_lists.end(); ++ii)
 	{
 		auto len = strlen(ii->get_name());
@@ -195,38 +265,11 @@ waypoint *find_matching_waypoint(const char *name)
 				continue;
 
 			// skip over the : to inspect a new string holding only the index
-			const char *index_str = name + len + 1;
-			if (*index_str == '\0')
-			{
-				nprintf(("waypoints", "possible error with waypoint name '%s': no waypoint number after the colon\n", name));
+			auto wpt = find_waypoint_from_index_string(&(*ii), name, name + len + 1);
+			if (wpt == NULL)
 				continue;
-			}
-
-			// make sure it's actually a number
-			bool valid = true;
-			for (const char *ch = index_str; *ch != '\0'; ch++)
-			{
-				if (!isdigit(*ch))
-				{
-					valid = false;
-					break;
-				}
-			}
-			if (!valid)
-			{
-				nprintf(("waypoints", "possible error with waypoint name '%s': string after the colon is not a number\n", name));
-				continue;
-			}
-
-			// get the number and make sure it's in range
-			uint index = atoi(index_str);
-			if (index < 1 || index > ii->get_waypoints().size())
-			{
-				nprintf(("waypoints", "possible error with waypoint name '%s': waypoint number is out of range\n", name));
-				continue;
-			}
 
-			return find_waypoint_at_index(&(*ii), index - 1);
+			return wpt;
 		}
 	}
 
@@ -386,6 +429,7 @@ void waypoint_add_list(const char *name, SCP_vector<vec3d> &vec_list)
 	waypoint_list new_list(name);
 	Waypoint_lists.push_back(new_list);
 	waypoint_list *wp_list = &Waypoint_lists.back();
+	Waypoint_list_name_index.add(wp_list->get_name(), wp_list);
 
 	wp_list->get_waypoints().reserve(vec_list.size());
 	SCP_vector<vec3d>::iterator ii;
@@ -418,6 +462,7 @@ int waypoint_add(vec3d *pos, int waypoint_instance)
 		waypoint_list new_list(buf);
 		Waypoint_lists.push_back(new_list);
 		wp_list = &Waypoint_lists.back();
+		Waypoint_list_name_index.add(wp_list->get_name(), wp_list);
 
 		// set up references
 		wp_list_index = (int)(Waypoint_lists.size() - 1);
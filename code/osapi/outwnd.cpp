@@ -15,6 +15,7 @@
 #include <cstdarg>
 #include <cstring>
 #include <algorithm>
+#include <mutex>
 
 #ifdef WIN32
 #include <direct.h>
@@ -188,6 +189,10 @@ void outwnd_print(const char *id, const char *tmp)
   	if ( !outwnd_inited )
   		return;
 
+	// Jobs may print from their worker threads. Recursive since the filter warning below prints from in here.
+	static std::recursive_mutex print_lock;
+	std::lock_guard<std::recursive_mutex> guard(print_lock);
+
 	if (Outwnd_no_filter_file == 1) {
 		Outwnd_no_filter_file = 2;
 
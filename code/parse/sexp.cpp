@@ -899,12 +899,16 @@ int sexp_explosion_option_lookup(char *text);
 const char *Explosion_option[] = { "damage", "blast", "inner radius", "outer radius", "shockwave speed", "death roll time" };
 int Num_explosion_options = 6;
 
+// whether eval_num() and sexp_ship_name_lookup() may use the values cached in the sexp nodes
+static bool Sexp_cache_arguments = true;
+
 int get_sexp();
 void build_extended_sexp_string(SCP_string &accumulator, int cur_node, int level, int mode);
 void update_sexp_references(const char *old_name, const char *new_name, int format, int node);
 int sexp_determine_team(char *subj);
 int extract_sexp_variable_index(int node);
 void init_sexp_vars();
+static void build_operator_index();
 int eval_num(int node);
 
 // for handling variables
@@ -1109,7 +1113,9 @@ void init_sexp()
 	Current_sexp_network_packet.initialize();
 
 	sexp_nodes_init();
+	sexp_clear_compiled();
 	init_sexp_vars();
+	build_operator_index();
 	Locked_sexp_false = Locked_sexp_true = -1;
 
 	Locked_sexp_false = alloc_sexp("false", SEXP_LIST, SEXP_ATOM_OPERATOR, -1, -1);
@@ -1180,6 +1186,18 @@ int alloc_sexp(const char *text, int type, int subtype, int first, int rest)
 	Sexp_nodes[node].flags = SNF_DEFAULT_VALUE;	// Goober5000
 	Sexp_nodes[node].op_index = NO_OPERATOR_INDEX_DEFINED;
 
+	// resolve the tokens that CTEXT would otherwise have to compare on every evaluation
+	Sexp_nodes[node].is_argument = !strcmp(text, SEXP_ARGUMENT_STRING);
+	if (!Fred_running && (type & SEXP_FLAG_VARIABLE))
+		Sexp_nodes[node].variable_index = atoi(text);
+	else
+		Sexp_nodes[node].variable_index = -1;
+	Sexp_nodes[node].number_value = atoi(text);
+
+	Sexp_nodes[node].cached_ship = -1;
+	Sexp_nodes[node].cached_ship_inc_players = 0;
+	Sexp_nodes[node].cached_ship_generation = 0;
+
 	return node;
 }
 
@@ -1571,6 +1589,44 @@ int find_argnum(int parent_node, int arg_node)
 	return -1;
 }
 
+struct operator_name_hash {
+	size_t operator()(const char *name) const
+	{
+		// FNV-1a, operator names are case sensitive
+		uint32_t hash = 2166136261u;
+		for (const char *c = name; *c != '\0'; ++c) {
+			hash ^= (uint32_t) (unsigned char) *c;
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+};
+
+struct operator_name_equal {
+	bool operator()(const char *left, const char *right) const
+	{
+		return !strcmp(left, right);
+	}
+};
+
+// Maps operator names to their index in Operators.  The keys point into the strings of Operators so this has to be
+// rebuilt whenever that vector changes, which only happens when dynamic SEXPs are added.
+static SCP_unordered_map<const char*, int, operator_name_hash, operator_name_equal> Operator_index;
+static size_t Operator_index_count = 0;
+
+static void build_operator_index()
+{
+	Operator_index.clear();
+	Operator_index.reserve(Operators.size());
+
+	for (size_t i = 0; i < Operators.size(); i++) {
+		// if there are duplicates, the first one wins, same as with a linear search
+		Operator_index.insert(std::make_pair(Operators[i].text.c_str(), (int) i));
+	}
+
+	Operator_index_count = Operators.size();
+}
+
 /**
  * From an operator name, return its index in the array Operators
  */
@@ -1578,13 +1634,16 @@ int get_operator_index(const char *token)
 {
 	Assertion(token != NULL, "get_operator_index(char*) called with a null token; get a coder!\n");
 
-	for (size_t i=0; i < Operators.size(); i++){
-		if (Operators[i].text == token){
-			return (int)i;
-		}
+	if (Operator_index_count != Operators.size()) {
+		build_operator_index();
+	}
+
+	auto iter = Operator_index.find(token);
+	if (iter == Operator_index.end()) {
+		return NOT_A_SEXP_OPERATOR;
 	}
 
-	return NOT_A_SEXP_OPERATOR;
+	return iter->second;
 }
 
 /**
@@ -1907,7 +1966,7 @@ int check_sexp_syntax(int node, int return_type, int recursive, int *bad_node, i
 					return SEXP_CHECK_TYPE_MISMATCH;
 				}
 
-				if (ship_name_lookup(CTEXT(node), 0) < 0)
+				if (sexp_ship_name_lookup(node) < 0)
 				{
 					if (Fred_running || !mission_parse_get_arrival_ship(CTEXT(node)))
 					{
@@ -1925,7 +1984,7 @@ int check_sexp_syntax(int node, int return_type, int recursive, int *bad_node, i
 
 				if (stricmp(CTEXT(node), SEXP_NONE_STRING) != 0)		// none is okay
 				{
-					if (ship_name_lookup(CTEXT(node), 1) < 0)
+					if (sexp_ship_name_lookup(node, 1) < 0)
 					{
 						if (Fred_running || !mission_parse_get_arrival_ship(CTEXT(node)))
 						{
@@ -1942,7 +2001,7 @@ int check_sexp_syntax(int node, int return_type, int recursive, int *bad_node, i
 					return SEXP_CHECK_TYPE_MISMATCH;
 				}
 
-				if (ship_name_lookup(CTEXT(node), 1) < 0) {
+				if (sexp_ship_name_lookup(node, 1) < 0) {
 					if (Fred_running || !mission_parse_get_arrival_ship(CTEXT(node)))
 					{
 						if (type == OPF_SHIP)
@@ -1990,7 +2049,7 @@ int check_sexp_syntax(int node, int return_type, int recursive, int *bad_node, i
 				}
 
 				// all of these have ships and wings in common
-				if (ship_name_lookup(CTEXT(node), 1) >= 0 || wing_name_lookup(CTEXT(node), 1) >= 0) {
+				if (sexp_ship_name_lookup(node, 1) >= 0 || wing_name_lookup(CTEXT(node), 1) >= 0) {
 					break;
 				}
 				// also check arrival list if we're running the game
@@ -2278,7 +2337,7 @@ int check_sexp_syntax(int node, int return_type, int recursive, int *bad_node, i
 						valid = 1;
 					}
 
-					if (ship_name_lookup(CTEXT(node), 1) >= 0)
+					if (sexp_ship_name_lookup(node, 1) >= 0)
 					{
 						valid = 1;
 					}
@@ -3271,7 +3330,7 @@ void get_sexp_text_for_variable(char *text, char *token)
 void do_preload_for_arguments(void (*preloader)(char *), int arg_node, int arg_handler_node)
 {
 	// we have a special argument
-	if (!strcmp(Sexp_nodes[arg_node].text, SEXP_ARGUMENT_STRING))
+	if (Sexp_nodes[arg_node].is_argument)
 	{
 		int n;
 
@@ -3557,7 +3616,7 @@ int get_sexp()
 				n = CDR(n);
 
 				// set flag for taylor
-				if (CAR(n) != -1 || !strcmp(Sexp_nodes[n].text, SEXP_ARGUMENT_STRING))	// if it's evaluating a sexp or a special argument
+				if (CAR(n) != -1 || Sexp_nodes[n].is_argument)	// if it's evaluating a sexp or a special argument
 					Knossos_warp_ani_used = 1;												// set flag just in case
 				else if (atoi(CTEXT(n)) != 0)											// if it's not the default 0
 					Knossos_warp_ani_used = 1;												// set flag just in case
@@ -3984,7 +4043,7 @@ player * get_player_from_ship_node(int node, bool test_respawns)
 	
 	Assert (node != -1);
 
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 
 	// singleplayer
 	if (!(Game_mode & GM_MULTIPLAYER)){	
@@ -4027,7 +4086,7 @@ ship * sexp_get_ship_from_node(int node)
 	int sindex;
 	ship *shipp = NULL;
 
-	sindex = ship_name_lookup( CTEXT(node) );
+	sindex = sexp_ship_name_lookup(node);
 
 	if (sindex < 0) {
 		return shipp;
@@ -4370,6 +4429,15 @@ int sexp_bitwise_xor(int node)
 	return eval_num(node) ^ eval_num(CDR(node));
 }
 
+/**
+ * Rewrites the text of a number atom, keeping the number parsed by alloc_sexp() in step with it
+ */
+static void sexp_set_number_text(int node, int value)
+{
+	sprintf(Sexp_nodes[node].text, "%d", value);
+	Sexp_nodes[node].number_value = value;
+}
+
 // seeding added by Karajorma and Goober5000
 int rand_sexp(int n, bool multiple)
 {
@@ -4403,14 +4471,14 @@ int rand_sexp(int n, bool multiple)
 	{
 		// set .value and .text so random number is generated only once.
 		Sexp_nodes[n].value = SEXP_NUM_EVAL;
-		sprintf(Sexp_nodes[n].text, "%d", rand_num);
+		sexp_set_number_text(n, rand_num);
 	}
 	// if this is multiple with a nonzero seed provided
 	else if (seed > 0)
 	{
 		// Set the seed to a new seeded random value. This will ensure that the next time the method
 		// is called it will return a predictable but different number from the previous time. 
-		sprintf(Sexp_nodes[CDDR(n)].text, "%d", rand_internal(1, INT_MAX, seed));
+		sexp_set_number_text(CDDR(n), rand_internal(1, INT_MAX, seed));
 	}
 
 	return rand_num;
@@ -8274,7 +8342,7 @@ int special_argument_appears_in_sexp_tree(int node)
 		return 0;
 
 	// special argument?
-	if (!strcmp(Sexp_nodes[node].text, SEXP_ARGUMENT_STRING))
+	if (Sexp_nodes[node].is_argument)
 		return 1;
 
 	// we don't want to include special arguments if they are nested in a new argument SEXP
@@ -8295,7 +8363,7 @@ int special_argument_appears_in_sexp_list(int node)
 	while (node != -1)
 	{
 		// special argument?
-		if (!strcmp(Sexp_nodes[node].text, SEXP_ARGUMENT_STRING))
+		if (Sexp_nodes[node].is_argument)
 			return 1;
 
 		node = CDR(node);
@@ -8436,6 +8504,41 @@ void eval_when_do_all_exp(int all_actions, int when_op_num)
 	}
 }
 
+/**
+ * Performs the actions of a when (or the 'then' action of an if-then-else) whose condition is true
+ */
+static void eval_when_do_then_actions(int actions, int when_op_num)
+{
+	// get the operator
+	int exp = CAR(actions);
+
+	// if the mod.tbl setting is in effect we want to each evaluate all the SEXPs for 
+	// each argument	
+	if (True_loop_argument_sexps && special_argument_appears_in_sexp_tree(exp)) {	
+		if (exp != -1) {
+			eval_when_do_all_exp(actions, when_op_num);
+		}
+	}
+	// without the mod.tbl setting (or if there are no arguments in this SEXP) we loop 
+	// through every action performing them for all arguments
+	else {
+		while (actions != -1)
+		{
+			// get the operator
+			exp = CAR(actions);
+			if (exp != -1)
+				eval_when_do_one_exp(exp);
+
+			// iterate
+			actions = CDR(actions);
+
+			// if-then-else only has one "if" action
+			if (when_op_num == OP_IF_THEN_ELSE)
+				break;
+		}
+	}
+}
+
 /**
  * This is like using when, but it takes a lot of shortcuts.  It's clearer just to separate it out into its own function, especially since it's not supposed to start
  * a new level of special argument handling, like eval_when would do.  It's a lot like the original retail version of eval_when!
@@ -8507,34 +8610,7 @@ int eval_when(int n, int when_op_num)
 	// if value is true, perform the actions in the 'then' part
 	if (val == SEXP_TRUE) // note: SEXP_KNOWN_TRUE is never returned from eval_sexp
 	{
-		// get the operator
-		int exp = CAR(actions);
-
-		// if the mod.tbl setting is in effect we want to each evaluate all the SEXPs for 
-		// each argument	
-		if (True_loop_argument_sexps && special_argument_appears_in_sexp_tree(exp)) {	
-			if (exp != -1) {
-				eval_when_do_all_exp(actions, when_op_num);
-			}
-		}
-		// without the mod.tbl setting (or if there are no arguments in this SEXP) we loop 
-		// through every action performing them for all arguments
-		else {
-			while (actions != -1)
-			{
-				// get the operator
-				exp = CAR(actions);
-				if (exp != -1)
-					eval_when_do_one_exp(exp);
-
-				// iterate
-				actions = CDR(actions);
-
-				// if-then-else only has one "if" action
-				if (when_op_num == OP_IF_THEN_ELSE)
-					break;
-			}
-		}
+		eval_when_do_then_actions(actions, when_op_num);
 	}
 	// if-then-else has actions to perform under "else"
 	else if (val == SEXP_FALSE && when_op_num == OP_IF_THEN_ELSE) // note: SEXP_KNOWN_FALSE is never returned from eval_sexp
@@ -9596,7 +9672,7 @@ int sexp_is_ship_class(int n)
 	while (n != -1)
 	{
 		// get ship
-		ship_num = ship_name_lookup(CTEXT(n));
+		ship_num = sexp_ship_name_lookup(n);
 
 		// we can't do anything with ships that aren't present
 		if (ship_num < 0)
@@ -9629,7 +9705,7 @@ int sexp_is_ship_type(int n)
 	while (n != -1)
 	{
 		// get ship
-		ship_num = ship_name_lookup(CTEXT(n));
+		ship_num = sexp_ship_name_lookup(n);
 
 		// we can't do anything with ships that aren't present
 		if (ship_num < 0)
@@ -9738,7 +9814,7 @@ void sexp_change_ai_class(int n)
 
 	// find ship
 	n = CDR(n);
-	ship_num = ship_name_lookup(CTEXT(n));
+	ship_num = sexp_ship_name_lookup(n);
 	n = CDR(n);
 
 	// we can't do anything with ships that aren't present
@@ -10737,7 +10813,7 @@ void sexp_set_explosion_option(int node)
 	shockwave_create_info *sci;
 
 	// get ship
-	ship_num = ship_name_lookup(CTEXT(n));
+	ship_num = sexp_ship_name_lookup(n);
 	if (ship_num < 0)
 		return;
 
@@ -11348,7 +11424,7 @@ void sexp_self_destruct(int node)
 
 	for (n = node; n != -1; n = CDR(n))	{
 		// get the ship
-		ship_num = ship_name_lookup(CTEXT(n));
+		ship_num = sexp_ship_name_lookup(n);
 
 		// if it still exists, destroy it
 		if (ship_num >= 0) {
@@ -11778,7 +11854,7 @@ void sexp_destroy_subsys_instantly(int n)
 	ship *shipp;
 	ship_subsys *ss;
 
-	shipnum = ship_name_lookup(CTEXT(n));
+	shipnum = sexp_ship_name_lookup(n);
 	// if no ship, then return immediately.
 	if (shipnum < 0)
 		return;
@@ -12208,7 +12284,7 @@ void sexp_jettison_cargo(int n, bool jettison_new)
 		for (; n != -1; n = CDR(n))
 		{
 			// make sure ship exists
-			ship_index = ship_name_lookup(CTEXT(n));
+			ship_index = sexp_ship_name_lookup(n);
 			if (ship_index < 0)
 				continue;
 
@@ -12705,7 +12781,7 @@ void sexp_change_player_score(int node)
 	node = CDR(node);
 
 	if(!(Game_mode & GM_MULTIPLAYER)){
-		if ( (sindex = ship_name_lookup(CTEXT(node))) == -1) {
+		if ( (sindex = sexp_ship_name_lookup(node)) == -1) {
 			Warning(LOCATION, "Invalid shipname '%s' passed to sexp_change_player_score!", CTEXT(node));
 			return;
 		}
@@ -13652,7 +13728,7 @@ void sexp_set_persona (int node)
 
 	// now loop through the list of ships
 	for ( ; node >= 0; node = CDR(node) ) {
-		sindex = ship_name_lookup( CTEXT(node) );
+		sindex = sexp_ship_name_lookup(node);
 
 		if (sindex < 0) {
 			continue;
@@ -14250,7 +14326,7 @@ void sexp_ships_visible(int n, bool visible)
 	// we also have to add any escort ships that were made visible
 	for (; n >= 0; n = CDR(n))
 	{
-		int shipnum = ship_name_lookup(CTEXT(n));
+		int shipnum = sexp_ship_name_lookup(n);
 		if (shipnum < 0)
 			continue;
 
@@ -14273,7 +14349,7 @@ void sexp_ships_stealthy(int n, bool stealthy)
 	{
 		for (; n >= 0; n = CDR(n))
 		{
-			int shipnum = ship_name_lookup(CTEXT(n));
+			int shipnum = sexp_ship_name_lookup(n);
 			if (shipnum < 0)
 				continue;
 
@@ -14293,7 +14369,7 @@ void sexp_friendly_stealth_invisible(int n, bool invisible)
 	{
 		for (; n >= 0; n = CDR(n))
 		{
-			int shipnum = ship_name_lookup(CTEXT(n));
+			int shipnum = sexp_ship_name_lookup(n);
 			if (shipnum < 0)
 				continue;
 
@@ -14419,7 +14495,7 @@ void sexp_ship_tag( int n, int tag )
 		return;
 
 	// get the ship num
-	ship_num = ship_name_lookup(CTEXT(n));
+	ship_num = sexp_ship_name_lookup(n);
 	if ( ship_num < 0 )
 		return;
 
@@ -14706,7 +14782,7 @@ void sexp_weapon_create(int n)
 	parent_objnum = -1;
 	if (stricmp(CTEXT(n), SEXP_NONE_STRING) != 0)
 	{
-		int parent_ship = ship_name_lookup(CTEXT(n));
+		int parent_ship = sexp_ship_name_lookup(n);
 
 		if (parent_ship >= 0)
 			parent_objnum = Ships[parent_ship].objnum;
@@ -14758,7 +14834,7 @@ void sexp_weapon_create(int n)
 	target_objnum = -1;
 	if (n >= 0)
 	{
-		int target_ship = ship_name_lookup(CTEXT(n));
+		int target_ship = sexp_ship_name_lookup(n);
 
 		if (target_ship >= 0)
 			target_objnum = Ships[target_ship].objnum;
@@ -15091,7 +15167,7 @@ void sexp_ship_change_callsign(int node)
 
 	while ( node >= 0 )
 	{
-		sindex = ship_name_lookup(CTEXT(node));
+		sindex = sexp_ship_name_lookup(node);
 		if (sindex >= 0) 
 		{
 			shipp = &Ships[sindex];
@@ -15242,7 +15318,7 @@ int sexp_targeted(int node)
 		return SEXP_CANT_EVAL;
 	}
 
-	z = ship_name_lookup(CTEXT(node), 1);
+	z = sexp_ship_name_lookup(node, 1);
 	if ((z < 0) || !Player_ai || (Ships[z].objnum != Players_target)){
 		return SEXP_FALSE;
 	}
@@ -15337,7 +15413,7 @@ int sexp_primaries_depleted(int node)
 	ship *shipp;
 
 	// get ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if (sindex < 0) {
 		return SEXP_FALSE;
 	}
@@ -15374,7 +15450,7 @@ int sexp_secondaries_depleted(int node)
 	ship *shipp;
 
 	// get ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if (sindex < 0) {
 		return SEXP_FALSE;
 	}
@@ -15670,7 +15746,7 @@ int sexp_shield_recharge_pct(int node)
 	int sindex;
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return 0;
 	}
@@ -15687,7 +15763,7 @@ int sexp_engine_recharge_pct(int node)
 	int sindex;
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return 0;
 	}
@@ -15704,7 +15780,7 @@ int sexp_weapon_recharge_pct(int node)
 	int sindex;
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return 0;
 	}
@@ -15727,7 +15803,7 @@ int sexp_get_ets_value(int node)
 	ets_type = CTEXT(node);
 	node = CDR(node);
 
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if (sindex < 0) {
 		return SEXP_FALSE;
 	}
@@ -15768,7 +15844,7 @@ void sexp_set_ets_values(int node)
 
 	// apply ETS settings to specified ships
 	for ( ; node != -1; node = CDR(node)) {
-		sindex = ship_name_lookup(CTEXT(node));
+		sindex = sexp_ship_name_lookup(node);
 
 		if (sindex >= 0 && validate_ship_ets_indxes(sindex, ets_idx)) {
 			Ships[sindex].engine_recharge_index = ets_idx[ENGINES];
@@ -15808,7 +15884,7 @@ int sexp_shield_quad_low(int node)
 	object *objp;
 
 	// get the ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return SEXP_FALSE;
 	}
@@ -15849,7 +15925,7 @@ int sexp_primary_ammo_pct(int node)
 	int ret = 0;
 
 	// get the ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0)
 	{
 		return 0;
@@ -15920,7 +15996,7 @@ int sexp_secondary_ammo_pct(int node)
 	int ret = 0;
 
 	// get the ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return 0;
 	}
@@ -15968,7 +16044,7 @@ int sexp_get_primary_ammo(int node)
 	int check;
 
 	// get the ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0)
 	{
 		return 0;
@@ -16022,7 +16098,7 @@ void sexp_set_primary_ammo (int node)
 	int rearm_limit = -1;
 
 	// Check that a ship has been supplied
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if (sindex < 0) 
 	{
 		return ;
@@ -16143,7 +16219,7 @@ int sexp_get_secondary_ammo (int node)
 	int check ;
 
 	// Get the ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if (sindex < 0) 
 	{
 		return 0;
@@ -16187,7 +16263,7 @@ void sexp_set_secondary_ammo (int node)
 	int rearm_limit = -1;
 
 	// Check that a ship has been supplied
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if (sindex < 0) 
 	{
 		return ;
@@ -16298,7 +16374,7 @@ void sexp_set_weapon(int node, bool primary)
 	Assert(node != -1);
 
 	// Check that a ship has been supplied
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if (sindex < 0)
 	{
 		return;
@@ -16502,7 +16578,7 @@ void sexp_change_subsystem_name(int node)
 	Assert (node != -1);
 
 	// Check that a ship has been supplied
-	ship_index = ship_name_lookup(CTEXT(node));
+	ship_index = sexp_ship_name_lookup(node);
 	if (ship_index < 0) {
 		return;
 	}
@@ -16577,7 +16653,7 @@ void sexp_change_ship_class(int n)
 	// all ships in the sexp
 	for ( ; n != -1; n = CDR(n))
 	{
-		ship_num = ship_name_lookup(CTEXT(n), 1);
+		ship_num = sexp_ship_name_lookup(n, 1);
 
 		// If the ship hasn't arrived we still want the ability to change its class.
 		if (ship_num == -1)
@@ -16762,7 +16838,7 @@ void sexp_ship_copy_damage(int node)
 	p_object *target_pobjp;
 
 	// source ship must be present
-	source_shipnum = ship_name_lookup(CTEXT(node));
+	source_shipnum = sexp_ship_name_lookup(node);
 	if (source_shipnum < 0)
 		return;
 
@@ -16770,7 +16846,7 @@ void sexp_ship_copy_damage(int node)
 	for (n = CDR(node); n != -1; n = CDR(n))
 	{
 		// maybe it's present in-mission
-		target_shipnum = ship_name_lookup(CTEXT(n));
+		target_shipnum = sexp_ship_name_lookup(n);
 		if (target_shipnum >= 0)
 		{
 			ship_copy_damage(&Ships[target_shipnum], &Ships[source_shipnum]);
@@ -16798,7 +16874,7 @@ void sexp_activate_deactivate_glow_points(int n, bool activate)
 
 	for ( ; n != -1; n = CDR(n))
 	{
-		sindex = ship_name_lookup(CTEXT(n), 1);
+		sindex = sexp_ship_name_lookup(n, 1);
 		if (sindex >= 0)
 		{
 			for (i = 0; i < Ships[sindex].glow_point_bank_active.size(); i++)
@@ -16812,7 +16888,7 @@ void sexp_activate_deactivate_glow_point_bank(int n, bool activate)
 {
 	int sindex, num;
 
-	sindex = ship_name_lookup(CTEXT(n), 1);
+	sindex = sexp_ship_name_lookup(n, 1);
 	if (sindex >= 0)
 	{
 		for ( n = CDR(n); n != -1; n = CDR(n))
@@ -16834,7 +16910,7 @@ void sexp_activate_deactivate_glow_maps(int n, int activate)
 
 	for ( ; n != -1; n = CDR(n))
 	{
-		sindex = ship_name_lookup(CTEXT(n), 1);
+		sindex = sexp_ship_name_lookup(n, 1);
 		if (sindex >= 0)
 		{
 			shipp = &Ships[sindex];
@@ -17033,7 +17109,7 @@ void sexp_beam_fire(int node, bool at_coords)
 	fire_info.accuracy = 0.000001f;							// this will guarantee a hit
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(n));
+	sindex = sexp_ship_name_lookup(n);
 	n = CDR(n);
 	if (sindex < 0) {
 		return;
@@ -17063,7 +17139,7 @@ void sexp_beam_fire(int node, bool at_coords)
 		fire_info.target_subsys = NULL;
 	} else {
 		// get the target
-		sindex = ship_name_lookup(CTEXT(n));
+		sindex = sexp_ship_name_lookup(n);
 		n = CDR(n);
 		if (sindex < 0) {
 			return;
@@ -17160,7 +17236,7 @@ void sexp_beam_floating_fire(int n)
 	fire_info.shooter = NULL;
 	if (stricmp(CTEXT(n), SEXP_NONE_STRING) != 0)
 	{
-		sindex = ship_name_lookup(CTEXT(n));
+		sindex = sexp_ship_name_lookup(n);
 
 		if (sindex >= 0)
 			fire_info.shooter = &Objects[Ships[sindex].objnum];
@@ -17183,7 +17259,7 @@ void sexp_beam_floating_fire(int n)
 	sindex = -1;
 	if (stricmp(CTEXT(n), SEXP_NONE_STRING) != 0)
 	{
-		sindex = ship_name_lookup(CTEXT(n));
+		sindex = sexp_ship_name_lookup(n);
 
 		if (sindex >= 0)
 			fire_info.target = &Objects[Ships[sindex].objnum];
@@ -17237,7 +17313,7 @@ void sexp_beam_free(int node)
 	ship_subsys *turret = NULL;	
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -17268,7 +17344,7 @@ void sexp_set_thrusters(int node)
 	node = CDR(node);
 
 	for(; node >= 0; node = CDR(node)) {
-		int sindex = ship_name_lookup(CTEXT(node));
+		int sindex = sexp_ship_name_lookup(node);
 		
 		if (sindex < 0) {
 			continue;
@@ -17289,7 +17365,7 @@ void sexp_beam_free_all(int node)
 
 	for (int n = node; n >= 0; n = CDR(n)) {
 		// get the firing ship
-		sindex = ship_name_lookup( CTEXT(n) );
+		sindex = sexp_ship_name_lookup(n);
 
 		if (sindex < 0) {
 			continue;
@@ -17322,7 +17398,7 @@ void sexp_beam_lock(int node)
 	ship_subsys *turret = NULL;	
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -17350,7 +17426,7 @@ void sexp_beam_lock_all(int node)
 
 	for (int n = node; n >= 0; n = CDR(n)) {
 		// get the firing ship
-		sindex = ship_name_lookup( CTEXT(n) );
+		sindex = sexp_ship_name_lookup(n);
 
 		if (sindex < 0) {
 			continue;
@@ -17381,7 +17457,7 @@ void sexp_turret_free(int node)
 	ship_subsys *turret = NULL;	
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -17413,7 +17489,7 @@ void sexp_turret_free_all(int node)
 
 	for (int n = node; n >= 0; n = CDR(n)) {
 		// get the firing ship
-		sindex = ship_name_lookup( CTEXT(n) );
+		sindex = sexp_ship_name_lookup(n);
 
 		if (sindex < 0) {
 			continue;
@@ -17445,7 +17521,7 @@ void sexp_turret_lock(int node)
 	ship_subsys *turret = NULL;	
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -17473,7 +17549,7 @@ void sexp_turret_lock_all(int node)
 
 	for (int n = node; n >= 0; n = CDR(n)) {
 		// get the firing ship
-		sindex = ship_name_lookup( CTEXT(n) );
+		sindex = sexp_ship_name_lookup(n);
 
 		if (sindex < 0) {
 			continue;
@@ -17504,7 +17580,7 @@ void sexp_turret_tagged_only_all(int node)
 	int sindex;
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -17531,7 +17607,7 @@ void sexp_turret_tagged_clear_all(int node)
 	int sindex;
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -17560,7 +17636,7 @@ void sexp_turret_change_weapon(int node)
 	ship_weapon *swp = NULL;
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0 || Ships[sindex].objnum < 0){
 		return;
 	}
@@ -17651,7 +17727,7 @@ void sexp_set_armor_type(int node)
 	ship_info *sip = NULL;
 
 	// get ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0) {
 		return;
 	}
@@ -17801,7 +17877,7 @@ void sexp_ship_set_damage_type(int node)
 	while(node != -1)
 	{
 		// get the ship
-		sindex = ship_name_lookup(CTEXT(node));
+		sindex = sexp_ship_name_lookup(node);
 		if(sindex >= 0) 
 		{
 			shipp = &Ships[sindex];
@@ -17908,7 +17984,7 @@ void sexp_turret_set_target_order(int node)
 	int i;
 
 	// get ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -17952,7 +18028,7 @@ void sexp_turret_set_direction_preference(int node)
 	ship_subsys *turret = NULL;	
 	
 	// get ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -17996,7 +18072,7 @@ void sexp_turret_set_rate_of_fire(int node)
 	ship_subsys *turret = NULL;	
 	
 	// get ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -18035,7 +18111,7 @@ void sexp_turret_set_optimum_range(int node)
 	ship_subsys *turret = NULL;	
 	
 	// get ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -18076,7 +18152,7 @@ void sexp_turret_set_target_priorities(int node)
 	int j;
 
 	// get ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -18132,7 +18208,7 @@ void sexp_ship_turret_target_order(int node)
 	int new_target_order[NUM_TURRET_ORDER_TYPES];
 
 	// get ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -18181,7 +18257,7 @@ int sexp_get_turret_primary_ammo(int node)
 	ship_weapon *swp;
 	int bank, check, ammo_left = 0;
 
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if (sindex < 0) {
 		return 0;
 	}
@@ -18238,7 +18314,7 @@ void sexp_set_turret_primary_ammo(int node)
 	int requested_weapons;
 
 	// Check that a ship has been supplied
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if (sindex < 0)
 	{
 		return;
@@ -18336,7 +18412,7 @@ int sexp_get_turret_secondary_ammo(int node)
 	ship_weapon *swp;
 	int bank, check, ammo_left = 0;
 
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if (sindex < 0) {
 		return 0;
 	}
@@ -18385,7 +18461,7 @@ void sexp_set_turret_secondary_ammo(int node)
 	int requested_weapons;
 
 	// Check that a ship has been supplied
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if (sindex < 0)
 	{
 		return;
@@ -18536,7 +18612,7 @@ void sexp_set_subsys_rotation_lock_free(int node, bool locked)
 	ship_subsys *rotate;
 
 	// get the ship
-	ship_num = ship_name_lookup(CTEXT(node));
+	ship_num = sexp_ship_name_lookup(node);
 	if (ship_num < 0)
 		return;
 	
@@ -18581,7 +18657,7 @@ void sexp_reverse_rotating_subsystem(int node)
 	ship_subsys *rotate;
 
 	// get the ship
-	ship_num = ship_name_lookup(CTEXT(node));
+	ship_num = sexp_ship_name_lookup(node);
 	if (ship_num < 0)
 		return;
 	
@@ -18613,7 +18689,7 @@ void sexp_rotating_subsys_set_turn_time(int node)
 	ship_subsys *rotate;
 
 	// get the ship
-	ship_num = ship_name_lookup(CTEXT(n));
+	ship_num = sexp_ship_name_lookup(n);
 	if (ship_num < 0)
 		return;
 	if (Ships[ship_num].objnum < 0)
@@ -18647,7 +18723,7 @@ void sexp_trigger_submodel_animation(int node)
 	bool instant;
 
 	// get the ship
-	ship_num = ship_name_lookup(CTEXT(n));
+	ship_num = sexp_ship_name_lookup(n);
 	if (ship_num < 0)
 		return;
 	if (Ships[ship_num].objnum < 0)
@@ -18708,7 +18784,7 @@ void sexp_turret_tagged_specific(int node)
 	int sindex;
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -18735,7 +18811,7 @@ void sexp_turret_tagged_clear_specific(int node)
 	int sindex;
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -18762,7 +18838,7 @@ void sexp_add_remove_escort(int node)
 	int flag;
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -18833,7 +18909,7 @@ void sexp_damage_escort_list(int node)
 		if ( mission_log_get_time(LOG_SHIP_DEPARTED, CTEXT(n), NULL, NULL) || mission_log_get_time(LOG_SHIP_DESTROYED, CTEXT(n), NULL, NULL) || mission_log_get_time(LOG_SELF_DESTRUCTED, CTEXT(n), NULL, NULL) )
 			continue;
 
-		shipnum=ship_name_lookup(CTEXT(n));
+		shipnum=sexp_ship_name_lookup(n);
 		
 		//it may be dead
 		if (shipnum < 0)
@@ -19271,7 +19347,7 @@ void sexp_awacs_set_radius(int node)
 	ship_subsys *awacs;
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -19731,7 +19807,7 @@ int sexp_is_tagged(int node)
 	int sindex;
 
 	// get the firing ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return SEXP_FALSE;
 	}
@@ -19830,7 +19906,7 @@ int sexp_is_player (int node)
 			// reset the netplayer index
 			np_index = -1; 
 
-			sindex = ship_name_lookup(CTEXT(node));
+			sindex = sexp_ship_name_lookup(node);
 			if(sindex >= 0){
 				if(Ships[sindex].objnum >= 0) {
 					// try and find the player
@@ -19962,7 +20038,7 @@ int sexp_return_player_data(int node, int type)
 	player *p = NULL;
 	p_object *p_objp;
 
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 
 	if(Game_mode & GM_MULTIPLAYER){			
 		if(sindex >= 0){
@@ -20064,7 +20140,7 @@ int sexp_num_type_kills(int node)
 	player *p = NULL;
 
 	// get the ship we're interested in
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return 0;
 	}
@@ -20119,7 +20195,7 @@ int sexp_num_class_kills(int node)
 	player *p = NULL;
 
 	// get the ship we're interested in
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return 0;
 	}
@@ -20167,7 +20243,7 @@ void sexp_subsys_set_random(int node)
 	ship *shipp;
 
 	// get ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return;
 	}
@@ -20242,7 +20318,7 @@ int sexp_is_secondary_selected(int node)
 	ship *shipp;
 
 	// lookup ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return SEXP_FALSE;
 	}
@@ -20273,7 +20349,7 @@ int sexp_is_primary_selected(int node)
 	ship *shipp;
 
 	// lookup ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 	if(sindex < 0){
 		return SEXP_FALSE;
 	}
@@ -22501,7 +22577,7 @@ void sexp_script_eval_multi(int node)
 				}
 				// otherwise notify the clients
 				else {
-					sindex = ship_name_lookup(CTEXT(node));
+					sindex = sexp_ship_name_lookup(node);
 					Current_sexp_network_packet.send_ship(sindex);
 				}
 			}
@@ -22556,7 +22632,7 @@ void sexp_force_glide(int node)
 	int sindex;
 
 	// get ship
-	sindex = ship_name_lookup(CTEXT(node));
+	sindex = sexp_ship_name_lookup(node);
 
 	if (sindex < 0) {
 		return;
@@ -22632,7 +22708,7 @@ int sexp_is_in_box(int n)
 	object* reference_ship_obj = NULL;
 	if (n != -1)
 	{
-		int sindex = ship_name_lookup(CTEXT(n));
+		int sindex = sexp_ship_name_lookup(n);
 
 		if (sindex < 0 || Ships[sindex].objnum < 0)
 			return SEXP_FALSE;
@@ -22664,7 +22740,7 @@ int sexp_is_in_box(int n)
 int sexp_is_in_mission(int node)
 {
 	for (int n = node; n != -1; n = CDR(n))
-		if (ship_name_lookup(CTEXT(n)) < 0)
+		if (sexp_ship_name_lookup(n) < 0)
 			return SEXP_FALSE;
 
 	return SEXP_TRUE;
@@ -22907,7 +22983,7 @@ void sexp_call_ssm_strike(int node) {
 		return;
 
 	for (int n = node; n != -1; n = CDR(n)) {
-		int ship_num = ship_name_lookup(CTEXT(n));
+		int ship_num = sexp_ship_name_lookup(n);
 		// don't do anything if the ship isn't there
 		if (ship_num >= 0) {
 			int obj_num = Ships[ship_num].objnum;
@@ -23193,6 +23269,84 @@ void add_to_event_log_buffer(int op_num, int result)
 	Current_event_log_buffer->push_back(tmp);
 }
 
+/**
+ * Determines whether the parent operator of an operator node wants its result as a positive number
+ */
+static bool sexp_operator_result_must_be_positive(int cur_node)
+{
+	int parent_node = find_parent_operator(cur_node);
+
+	// if the SEXP has no parent, the point is moot
+	if (parent_node < 0)
+		return false;
+
+	int arg_num = find_argnum(parent_node, cur_node);
+	Assertion(arg_num >= 0, "Error finding sexp argument.  The SEXP is not listed among its parent's children.");
+
+	return query_operator_argument_type(get_operator_index(parent_node), arg_num) == OPF_POSITIVE;
+}
+
+/**
+ * Records the value an operator returned in its node and converts it to the value eval_sexp() returns
+ *
+ * @param positive Whether a negative value has to be made positive, or -1 to look it up from the parent operator
+ */
+static int sexp_set_operator_result(int cur_node, int sexp_val, int positive)
+{
+	// check the sexp value of the sexpression evaluation.  A special
+	// value of known true or known false means that we should set the sexp.value field for
+	// short circuit eval.
+	if (sexp_val == SEXP_KNOWN_TRUE) {
+		Sexp_nodes[cur_node].value = SEXP_KNOWN_TRUE;
+		return SEXP_TRUE;
+	}
+
+	if (sexp_val == SEXP_KNOWN_FALSE) {
+		Sexp_nodes[cur_node].value = SEXP_KNOWN_FALSE;
+		return SEXP_FALSE;
+	}
+
+	if ( sexp_val == SEXP_NAN ) {
+		Sexp_nodes[cur_node].value = SEXP_NAN;			// not a number values are false I would suspect
+		return SEXP_FALSE;
+	}
+
+	if ( sexp_val == SEXP_NAN_FOREVER ) {
+		Sexp_nodes[cur_node].value = SEXP_NAN_FOREVER;
+		return SEXP_FALSE;	// Goober5000 changed from sexp_val to SEXP_FALSE on 2/21/2006 in accordance with above comment
+	}
+
+	if ( sexp_val == SEXP_CANT_EVAL ) {
+		Sexp_nodes[cur_node].value = SEXP_CANT_EVAL;
+		Sexp_useful_number = 0;  // indicate sexp isn't current yet
+		return SEXP_FALSE;
+	}
+
+	if ( Sexp_nodes[cur_node].value == SEXP_NAN ) {	// if we had a nan, but now don't, reset the value
+		Sexp_nodes[cur_node].value = SEXP_UNKNOWN;
+		return sexp_val;
+	}
+
+	// now, reconcile positive and negative - Goober5000
+	if (sexp_val < 0)
+	{
+		if (positive < 0)
+			positive = sexp_operator_result_must_be_positive(cur_node) ? 1 : 0;
+
+		// if we need a positive value, make it positive
+		if (positive)
+			sexp_val *= -1;
+	}
+
+	if ( sexp_val ){
+		Sexp_nodes[cur_node].value = SEXP_TRUE;
+	} else {
+		Sexp_nodes[cur_node].value = SEXP_FALSE;
+	}
+
+	return sexp_val;
+}
+
 /**
  * High-level sexpression evaluator
  */
@@ -25462,66 +25616,7 @@ int eval_sexp(int cur_node, int referenced_node)
 
 		Assertion(sexp_val != UNINITIALIZED, "SEXP %s didn't return a value!", CTEXT(cur_node));
 
-		// if we haven't returned, check the sexp value of the sexpression evaluation.  A special
-		// value of known true or known false means that we should set the sexp.value field for
-		// short circuit eval.
-		if (sexp_val == SEXP_KNOWN_TRUE) {
-			Sexp_nodes[cur_node].value = SEXP_KNOWN_TRUE;
-			return SEXP_TRUE;
-		}
-
-		if (sexp_val == SEXP_KNOWN_FALSE) {
-			Sexp_nodes[cur_node].value = SEXP_KNOWN_FALSE;
-			return SEXP_FALSE;
-		}
-
-		if ( sexp_val == SEXP_NAN ) {
-			Sexp_nodes[cur_node].value = SEXP_NAN;			// not a number values are false I would suspect
-			return SEXP_FALSE;
-		}
-
-		if ( sexp_val == SEXP_NAN_FOREVER ) {
-			Sexp_nodes[cur_node].value = SEXP_NAN_FOREVER;
-			return SEXP_FALSE;	// Goober5000 changed from sexp_val to SEXP_FALSE on 2/21/2006 in accordance with above comment
-		}
-
-		if ( sexp_val == SEXP_CANT_EVAL ) {
-			Sexp_nodes[cur_node].value = SEXP_CANT_EVAL;
-			Sexp_useful_number = 0;  // indicate sexp isn't current yet
-			return SEXP_FALSE;
-		}
-
-		if ( Sexp_nodes[cur_node].value == SEXP_NAN ) {	// if we had a nan, but now don't, reset the value
-			Sexp_nodes[cur_node].value = SEXP_UNKNOWN;
-			return sexp_val;
-		}
-
-		// now, reconcile positive and negative - Goober5000
-		if (sexp_val < 0)
-		{
-			int parent_node = find_parent_operator(cur_node);
-
-			// if the SEXP has no parent, the point is moot
-			if (parent_node >= 0)
-			{
-				int arg_num = find_argnum(parent_node, cur_node);
-				Assertion(arg_num >= 0, "Error finding sexp argument.  The SEXP is not listed among its parent's children.");
-
-				// if we need a positive value, make it positive
-				if (query_operator_argument_type(get_operator_index(parent_node), arg_num) == OPF_POSITIVE)
-				{
-					sexp_val *= -1;
-				}
-			}
-		}
-
-		if ( sexp_val ){
-			Sexp_nodes[cur_node].value = SEXP_TRUE;
-		} else {
-			Sexp_nodes[cur_node].value = SEXP_FALSE;
-		}
-
-		return sexp_val;
+		return sexp_set_operator_result(cur_node, sexp_val, -1);
 	}
 }
 
@@ -29303,7 +29398,7 @@ char *CTEXT(int n)
 
 	// Goober5000 - MWAHAHAHAHAHAHAHA!  Thank you, Volition programmers!  Without
 	// the CTEXT wrapper, when-argument would probably be infeasibly difficult to code.
-	if (!strcmp(Sexp_nodes[n].text, SEXP_ARGUMENT_STRING))
+	if (Sexp_nodes[n].is_argument)
 	{
 		if (Fred_running)
 		{
@@ -29346,7 +29441,8 @@ char *CTEXT(int n)
 		}
 		else
 		{
-			sexp_variable_index = atoi(Sexp_nodes[n].text);
+			// resolved when the node was allocated
+			sexp_variable_index = Sexp_nodes[n].variable_index;
 		}
 		// Reference a Sexp_variable
 		// string format -- "Sexp_variables[xx]=number" or "Sexp_variables[xx]=string", where xx is the index
@@ -29784,7 +29880,7 @@ int get_index_sexp_variable_from_node (int node)
 		var_index = get_index_sexp_variable_name(Sexp_nodes[node].text);
 	}
 	else {
-		var_index = atoi(Sexp_nodes[node].text);
+		var_index = Sexp_nodes[node].variable_index;
 	}
 
 	return var_index; 
@@ -30051,6 +30147,17 @@ void sexp_variable_sort()
 	insertion_sort( (void *)Sexp_variables, (size_t)(MAX_SEXP_VARIABLES), sizeof(sexp_variable), sexp_var_compare );
 }
 
+/**
+ * Returns true if the node is a number atom whose text can't change between evaluations
+ */
+static bool is_constant_number_node(int n)
+{
+	const sexp_node *node = &Sexp_nodes[n];
+
+	return Sexp_cache_arguments && !Fred_running && (node->first == -1) && (node->subtype == SEXP_ATOM_NUMBER)
+		&& !(node->type & SEXP_FLAG_VARIABLE) && !node->is_argument;
+}
+
 /**
  * Evaluate number which may result from an operator or may be text
  */
@@ -30060,10 +30167,848 @@ int eval_num(int n)
 
 	if (CAR(n) != -1)				// if argument is a sexp
 		return eval_sexp(CAR(n));
+	else if (is_constant_number_node(n))
+		return Sexp_nodes[n].number_value;	// parsed when the node was allocated
 	else
 		return atoi(CTEXT(n));		// otherwise, just get the number
 }
 
+/**
+ * Looks up the ship named by a sexp node and caches the result in the node
+ *
+ * A plain atom always names the same ship so its result stays valid until a ship is created, deleted or renamed.
+ * Special arguments and variables can change between evaluations so they are looked up every time.
+ */
+int sexp_ship_name_lookup(int node, int inc_players)
+{
+	Assertion(node >= 0 && node < Num_sexp_nodes, "Passed an out-of-range node index (%d) to sexp_ship_name_lookup!", node);
+	sexp_node *sn = &Sexp_nodes[node];
+
+	if (!Sexp_cache_arguments || Fred_running || sn->is_argument || (sn->type & SEXP_FLAG_VARIABLE))
+		return ship_name_lookup(CTEXT(node), inc_players);
+
+	auto generation = ship_name_lookup_generation();
+	if (sn->cached_ship_generation != generation || sn->cached_ship_inc_players != inc_players)
+	{
+		sn->cached_ship = ship_name_lookup(sn->text, inc_players);
+		sn->cached_ship_inc_players = inc_players;
+		sn->cached_ship_generation = generation;
+	}
+
+	return sn->cached_ship;
+}
+
+DCF_BOOL(sexp_cache_arguments, Sexp_cache_arguments);
+
+DCF(sexp_cache_check, "Checks the cached sexp argument values against the uncached ones and times both")
+{
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: sexp_cache_check\n. Resolves every ship name and number atom of the loaded mission with and without the sexp argument caches, reports mismatches and the time each took.\n");
+		return;
+	}
+
+	if (Fred_running || Sexp_nodes == NULL) {
+		dc_printf("No sexps to check\n");
+		return;
+	}
+
+	bool saved = Sexp_cache_arguments;
+	int mismatches = 0, checked = 0;
+	SCP_vector<int> uncached;
+
+	uncached.reserve(2 * Num_sexp_nodes);
+
+	// The argument and variable nodes are never cached and CTEXT() would need an argument context for them
+	auto is_checked_node = [](int n) {
+		return (Sexp_nodes[n].type == SEXP_ATOM) && !Sexp_nodes[n].is_argument;
+	};
+
+	Sexp_cache_arguments = false;
+	auto start = timer_get_microseconds();
+	for (int n = 0; n < Num_sexp_nodes; n++) {
+		if (!is_checked_node(n))
+			continue;
+
+		uncached.push_back(sexp_ship_name_lookup(n));
+		uncached.push_back(eval_num(n));
+	}
+	auto uncached_time = timer_get_microseconds() - start;
+
+	Sexp_cache_arguments = true;
+	start = timer_get_microseconds();
+	size_t i = 0;
+	for (int n = 0; n < Num_sexp_nodes; n++) {
+		if (!is_checked_node(n))
+			continue;
+
+		if (sexp_ship_name_lookup(n) != uncached[i] || eval_num(n) != uncached[i + 1]) {
+			dc_printf("Mismatch at node %d ('%s')\n", n, Sexp_nodes[n].text);
+			mismatches++;
+		}
+		i += 2;
+		checked++;
+	}
+	auto cached_time = timer_get_microseconds() - start;
+
+	Sexp_cache_arguments = saved;
+
+	dc_printf("Checked %d atoms, %d mismatches. Uncached: %d us, cached: %d us (including the checks)\n",
+		checked, mismatches, (int) uncached_time, (int) cached_time);
+}
+
+// change counters for the inputs in sexp_get_dependencies()
+static uint32_t Sexp_mission_log_generation = 1;
+static uint32_t Sexp_events_generation = 1;
+
+// whether mission_eval_goals() may skip formulas whose dependencies haven't changed
+static bool Sexp_dependency_tracking = true;
+
+static int sexp_get_operator_dependencies(int op_node);
+
+/**
+ * Returns the dependencies of a single argument of an operator
+ */
+static int sexp_get_argument_dependencies(int node)
+{
+	if (CAR(node) != -1)
+		return sexp_get_operator_dependencies(CAR(node));
+
+	// special arguments and variables can change without anything we can track
+	if (Sexp_nodes[node].is_argument || (Sexp_nodes[node].type & SEXP_FLAG_VARIABLE))
+		return SEXP_DEP_UNTRACKED;
+
+	return 0;
+}
+
+static int sexp_get_operator_dependencies(int op_node)
+{
+	int deps;
+
+	switch (get_operator_const(op_node))
+	{
+		case OP_TRUE:
+		case OP_FALSE:
+		case OP_AND:
+		case OP_OR:
+		case OP_NOT:
+			deps = 0;
+			break;
+
+		case OP_WHEN:
+		{
+			// the actions only run when the condition is true, and a true formula is never skipped
+			int cond = CDR(op_node);
+			return (cond == -1) ? 0 : sexp_get_argument_dependencies(cond);
+		}
+
+		// these only look at the mission log and at whether the ships are present yet
+		case OP_IS_DESTROYED:
+		case OP_IS_SUBSYSTEM_DESTROYED:
+		case OP_HAS_ARRIVED:
+		case OP_HAS_DEPARTED:
+		case OP_IS_DISABLED:
+		case OP_IS_DISARMED:
+		case OP_HAS_DOCKED:
+		case OP_HAS_UNDOCKED:
+		case OP_WAYPOINTS_DONE:
+		case OP_GOAL_INCOMPLETE:
+			deps = SEXP_DEP_MISSION_LOG;
+			break;
+
+		case OP_EVENT_TRUE:
+		case OP_EVENT_FALSE:
+		case OP_EVENT_INCOMPLETE:
+			deps = SEXP_DEP_EVENTS;
+			break;
+
+		// anything else may depend on time, positions, variables, ...
+		default:
+			return SEXP_DEP_UNTRACKED;
+	}
+
+	for (int arg = CDR(op_node); arg != -1; arg = CDR(arg))
+		deps |= sexp_get_argument_dependencies(arg);
+
+	return deps;
+}
+
+/**
+ * Determines which inputs a formula depends on
+ *
+ * Only a handful of common operators are known, any other operator makes the whole formula ::SEXP_DEP_UNTRACKED.
+ *
+ * @param node The formula, as returned by get_sexp_main()
+ * @return A combination of the SEXP_DEP_ flags
+ */
+int sexp_get_dependencies(int node)
+{
+	if (node < 0)
+		return 0;
+
+	if (Sexp_nodes[node].first != -1)
+		return sexp_get_operator_dependencies(CAR(node));
+
+	return sexp_get_operator_dependencies(node);
+}
+
+/**
+ * Must be called whenever one of the tracked inputs changes
+ */
+void sexp_mark_dependency_changed(int dependencies)
+{
+	if (dependencies & SEXP_DEP_MISSION_LOG)
+		Sexp_mission_log_generation++;
+	if (dependencies & SEXP_DEP_EVENTS)
+		Sexp_events_generation++;
+}
+
+/**
+ * Gets a value which changes whenever one of the specified inputs changes
+ *
+ * A formula which was evaluated with the same stamp will evaluate to the same result again.
+ */
+uint32_t sexp_get_dependency_stamp(int dependencies)
+{
+	Assertion(!(dependencies & SEXP_DEP_UNTRACKED), "Untracked formulas don't have a dependency stamp!");
+
+	// all the counters only ever go up so the sum changes whenever one of them does
+	uint32_t stamp = 1;
+	if (dependencies & SEXP_DEP_MISSION_LOG)
+		stamp += Sexp_mission_log_generation + ship_name_lookup_generation();
+	if (dependencies & SEXP_DEP_EVENTS)
+		stamp += Sexp_events_generation;
+
+	return stamp;
+}
+
+bool sexp_dependency_tracking_enabled()
+{
+	return Sexp_dependency_tracking && !Fred_running;
+}
+
+DCF_BOOL(sexp_dependency_tracking, Sexp_dependency_tracking);
+
+// Compiled formulas
+//
+// sexp_compile() lowers a formula into a flat array of instructions, stored in pre-order: an operator is followed by
+// its arguments and knows where its subtree ends.  Constant number atoms are folded into the instructions and the
+// sign reconciliation of each operator is resolved up front, so the common operators run without walking the node
+// tree or looking at the text of their arguments.  Operators that have not been ported are kept as a single
+// instruction that hands the subtree to eval_sexp().  Ship references in those subtrees are resolved through
+// sexp_ship_name_lookup(), whose cache is dropped whenever a ship is created, deleted or renamed.
+//
+// Every instruction stands for one eval_sexp() call and has to leave the nodes exactly as that call would.
+
+#define SEXP_INSN_CELL		0	// a list cell; evaluates the operator it holds and copies the operator's value into the cell
+#define SEXP_INSN_NUMBER	1	// a constant number atom
+#define SEXP_INSN_OPERATOR	2	// a ported operator, followed by its arguments
+#define SEXP_INSN_FALLBACK	3	// anything else, evaluated by eval_sexp()
+
+typedef struct sexp_instruction {
+	int		type;			// one of the SEXP_INSN_ defines
+	int		node;			// the node eval_sexp() would be called on
+	int		op_num;			// OP_ define of a SEXP_INSN_OPERATOR
+	int		value;			// the number of a SEXP_INSN_NUMBER
+	int		end;			// index of the first instruction past this one and its arguments
+	bool	positive;		// a negative result of this operator is made positive, see sexp_set_operator_result()
+} sexp_instruction;
+
+// the instructions of all compiled formulas, each formula is the range starting at the index sexp_compile() returned
+static SCP_vector<sexp_instruction> Sexp_program;
+
+static bool Sexp_compiled_formulas = true;
+
+static void sexp_compile_node(int node, int parent_op, int arg_num);
+
+/**
+ * Checks whether the arguments of an operator have the shape its compiled form expects
+ */
+static bool sexp_can_compile_operator(int op_node, int op_num)
+{
+	int first_arg = CDR(op_node);
+
+	switch (op_num)
+	{
+		case OP_TRUE:
+		case OP_FALSE:
+		case OP_MISSION_TIME:
+			return true;
+
+		// the first argument has to be an operator; the tree walker reads a plain number there without evaluating it
+		case OP_AND:
+		case OP_OR:
+		case OP_NOT:
+		case OP_WHEN:
+		case OP_EVERY_TIME:
+			return (first_arg != -1) && (CAR(first_arg) != -1);
+
+		// the first argument is either evaluated or read as a number
+		case OP_PLUS:
+		case OP_MINUS:
+		case OP_MUL:
+		case OP_HAS_TIME_ELAPSED:
+			return (first_arg != -1) && ((CAR(first_arg) != -1) || is_constant_number_node(first_arg));
+
+		case OP_EQUALS:
+		case OP_GREATER_THAN:
+		case OP_LESS_THAN:
+		case OP_NOT_EQUAL:
+		case OP_GREATER_OR_EQUAL:
+		case OP_LESS_OR_EQUAL:
+			return first_arg != -1;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Compiles the arguments of an operator, each as the node its tree walking implementation evaluates
+ */
+static void sexp_compile_operator_args(int op_node, int op_num)
+{
+	int first_arg = CDR(op_node);
+	int arg_num = 0;
+
+	switch (op_num)
+	{
+		case OP_TRUE:
+		case OP_FALSE:
+		case OP_MISSION_TIME:
+			break;
+
+		// only the condition, the actions are run through eval_when_do_then_actions()
+		case OP_NOT:
+		case OP_WHEN:
+		case OP_EVERY_TIME:
+			sexp_compile_node(CAR(first_arg), op_node, 0);
+			break;
+
+		case OP_HAS_TIME_ELAPSED:
+			if (CAR(first_arg) != -1)
+				sexp_compile_node(CAR(first_arg), op_node, 0);
+			else
+				sexp_compile_node(first_arg, op_node, 0);
+			break;
+
+		// the first argument is evaluated through its operator, the others through their cells
+		case OP_AND:
+		case OP_OR:
+		case OP_PLUS:
+		case OP_MINUS:
+		case OP_MUL:
+			if (CAR(first_arg) != -1)
+				sexp_compile_node(CAR(first_arg), op_node, arg_num);
+			else
+				sexp_compile_node(first_arg, op_node, arg_num);
+
+			for (int arg = CDR(first_arg); arg != -1; arg = CDR(arg))
+				sexp_compile_node(arg, op_node, ++arg_num);
+			break;
+
+		case OP_EQUALS:
+		case OP_GREATER_THAN:
+		case OP_LESS_THAN:
+		case OP_NOT_EQUAL:
+		case OP_GREATER_OR_EQUAL:
+		case OP_LESS_OR_EQUAL:
+			for (int arg = first_arg; arg != -1; arg = CDR(arg))
+				sexp_compile_node(arg, op_node, arg_num++);
+			break;
+
+		default:
+			UNREACHABLE("Operator %d is not compiled!", op_num);
+	}
+}
+
+/**
+ * Appends the instructions that do what eval_sexp(node) does
+ *
+ * @param parent_op The operator node node is an argument of, or -1 if it is the root of the formula
+ * @param arg_num Which argument of parent_op node is
+ */
+static void sexp_compile_node(int node, int parent_op, int arg_num)
+{
+	int index = (int) Sexp_program.size();
+	Sexp_program.emplace_back();
+
+	sexp_instruction insn;
+	insn.type = SEXP_INSN_FALLBACK;
+	insn.node = node;
+	insn.op_num = 0;
+	insn.value = 0;
+	insn.positive = false;
+
+	if (Sexp_nodes[node].first != -1) {
+		insn.type = SEXP_INSN_CELL;
+		Sexp_program[index] = insn;
+		sexp_compile_node(CAR(node), parent_op, arg_num);
+	} else {
+		int op_num = get_operator_const(node);
+
+		if (op_num == 0) {
+			if (is_constant_number_node(node)) {
+				insn.type = SEXP_INSN_NUMBER;
+				insn.value = Sexp_nodes[node].number_value;
+			}
+			Sexp_program[index] = insn;
+		} else if (sexp_can_compile_operator(node, op_num)) {
+			insn.type = SEXP_INSN_OPERATOR;
+			insn.op_num = op_num;
+			if (parent_op >= 0)
+				insn.positive = query_operator_argument_type(get_operator_index(parent_op), arg_num) == OPF_POSITIVE;
+			else
+				insn.positive = sexp_operator_result_must_be_positive(node);
+			Sexp_program[index] = insn;
+			sexp_compile_operator_args(node, op_num);
+		} else {
+			Sexp_program[index] = insn;
+		}
+	}
+
+	Sexp_program[index].end = (int) Sexp_program.size();
+}
+
+/**
+ * Compiles a formula for eval_compiled_sexp()
+ *
+ * @param node The formula, as returned by get_sexp_main()
+ * @return The compiled formula, or -1 if the formula is not compiled
+ */
+int sexp_compile(int node)
+{
+	if (node < 0 || Fred_running)
+		return -1;
+
+	int program = (int) Sexp_program.size();
+	sexp_compile_node(node, -1, -1);
+
+	// nothing gained if the whole formula falls back to the tree walker
+	if (Sexp_program[program].type == SEXP_INSN_FALLBACK) {
+		Sexp_program.resize(program);
+		return -1;
+	}
+
+	return program;
+}
+
+/**
+ * Forgets all compiled formulas, the node indices they refer to are about to be reused
+ */
+void sexp_clear_compiled()
+{
+	Sexp_program.clear();
+}
+
+/**
+ * Does the quick return at the top of eval_sexp() for a node whose value is already known
+ */
+static bool sexp_known_result(int node, int *result)
+{
+	int value = Sexp_nodes[node].value;
+
+	if (value == SEXP_KNOWN_TRUE) {
+		*result = SEXP_TRUE;
+		return true;
+	}
+
+	if (value == SEXP_KNOWN_FALSE || value == SEXP_NAN_FOREVER) {
+		*result = SEXP_FALSE;
+		return true;
+	}
+
+	return false;
+}
+
+/**
+ * Does the NAN checks of sexp_number_compare() for one node
+ */
+static bool sexp_compare_nan(int node, int *result)
+{
+	if (node == -1)
+		return false;
+
+	if (Sexp_nodes[node].value == SEXP_NAN) {
+		*result = SEXP_FALSE;
+		return true;
+	}
+
+	if (Sexp_nodes[node].value == SEXP_NAN_FOREVER) {
+		*result = SEXP_KNOWN_FALSE;
+		return true;
+	}
+
+	return false;
+}
+
+static int sexp_run(int pc);
+
+static bool sexp_run_is_true(int pc)
+{
+	int result = sexp_run(pc);
+
+	return (result == SEXP_TRUE) || (result == SEXP_KNOWN_TRUE);
+}
+
+/**
+ * Runs a ported operator, returning what its tree walking implementation returns
+ */
+static int sexp_run_operator_value(int pc)
+{
+	const sexp_instruction *insn = &Sexp_program[pc];
+	int first = pc + 1;
+	int end = insn->end;
+	int arg, value, result;
+
+	switch (insn->op_num)
+	{
+		case OP_TRUE:
+			return SEXP_KNOWN_TRUE;
+
+		case OP_FALSE:
+			return SEXP_KNOWN_FALSE;
+
+		case OP_MISSION_TIME:
+			return sexp_mission_time();
+
+		case OP_HAS_TIME_ELAPSED:
+			return (f2i(Missiontime) >= sexp_run(first)) ? SEXP_KNOWN_TRUE : SEXP_FALSE;
+
+		// see sexp_and()
+		case OP_AND:
+		{
+			bool all_true = true;
+			bool bool_result = true;
+
+			for (arg = first; arg < end; arg = Sexp_program[arg].end) {
+				bool_result = sexp_run_is_true(arg) && bool_result;
+
+				value = Sexp_nodes[Sexp_program[arg].node].value;
+				if (value == SEXP_KNOWN_FALSE || value == SEXP_NAN_FOREVER)
+					return SEXP_KNOWN_FALSE;
+				if (value != SEXP_KNOWN_TRUE)
+					all_true = false;
+			}
+
+			if (all_true)
+				return SEXP_KNOWN_TRUE;
+
+			return bool_result ? SEXP_TRUE : SEXP_FALSE;
+		}
+
+		// see sexp_or()
+		case OP_OR:
+		{
+			bool all_false = true;
+			bool bool_result = false;
+
+			for (arg = first; arg < end; arg = Sexp_program[arg].end) {
+				bool_result = sexp_run_is_true(arg) || bool_result;
+
+				value = Sexp_nodes[Sexp_program[arg].node].value;
+				if (value == SEXP_KNOWN_TRUE)
+					return SEXP_KNOWN_TRUE;
+				if (value != SEXP_KNOWN_FALSE)
+					all_false = false;
+			}
+
+			if (all_false)
+				return SEXP_KNOWN_FALSE;
+
+			return bool_result ? SEXP_TRUE : SEXP_FALSE;
+		}
+
+		// see sexp_not()
+		case OP_NOT:
+		{
+			bool bool_result = sexp_run_is_true(first);
+
+			value = Sexp_nodes[Sexp_program[first].node].value;
+			if (value == SEXP_KNOWN_FALSE || value == SEXP_NAN_FOREVER)
+				return SEXP_KNOWN_TRUE;
+			else if (value == SEXP_KNOWN_TRUE)
+				return SEXP_KNOWN_FALSE;
+			else if (value == SEXP_NAN)
+				return SEXP_TRUE;
+
+			return bool_result ? SEXP_FALSE : SEXP_TRUE;
+		}
+
+		// see add_sexps()
+		case OP_PLUS:
+			result = 0;
+			for (arg = first; arg < end; arg = Sexp_program[arg].end) {
+				int val = sexp_run(arg);
+
+				value = Sexp_nodes[Sexp_program[arg].node].value;
+				if (value == SEXP_NAN)
+					return SEXP_NAN;
+				else if (value == SEXP_NAN_FOREVER)
+					return SEXP_NAN_FOREVER;
+
+				result += val;
+			}
+			return result;
+
+		// see sub_sexps() and mul_sexps()
+		case OP_MINUS:
+		case OP_MUL:
+			result = sexp_run(first);
+			for (arg = Sexp_program[first].end; arg < end; arg = Sexp_program[arg].end) {
+				if (insn->op_num == OP_MINUS)
+					result -= sexp_run(arg);
+				else
+					result *= sexp_run(arg);
+			}
+			return result;
+
+		// see sexp_number_compare(), the arguments are all cells
+		case OP_EQUALS:
+		case OP_GREATER_THAN:
+		case OP_LESS_THAN:
+		case OP_NOT_EQUAL:
+		case OP_GREATER_OR_EQUAL:
+		case OP_LESS_OR_EQUAL:
+		{
+			int first_number = sexp_run(first);
+			int cell = Sexp_program[first].node;
+
+			if (sexp_compare_nan(CAR(cell), &result) || sexp_compare_nan(CDR(cell), &result))
+				return result;
+
+			for (arg = Sexp_program[first].end; arg < end; arg = Sexp_program[arg].end) {
+				cell = Sexp_program[arg].node;
+
+				if (sexp_compare_nan(CAR(cell), &result) || sexp_compare_nan(CDR(cell), &result))
+					return result;
+
+				int current_number = sexp_run(arg);
+
+				switch (insn->op_num)
+				{
+					case OP_EQUALS:
+						if (first_number != current_number) return SEXP_FALSE;
+						break;
+
+					case OP_NOT_EQUAL:
+						if (first_number == current_number) return SEXP_FALSE;
+						break;
+
+					case OP_GREATER_THAN:
+						if (first_number <= current_number) return SEXP_FALSE;
+						break;
+
+					case OP_GREATER_OR_EQUAL:
+						if (first_number < current_number) return SEXP_FALSE;
+						break;
+
+					case OP_LESS_THAN:
+						if (first_number >= current_number) return SEXP_FALSE;
+						break;
+
+					case OP_LESS_OR_EQUAL:
+						if (first_number > current_number) return SEXP_FALSE;
+						break;
+				}
+			}
+
+			return SEXP_TRUE;
+		}
+
+		// see eval_when(), only the plain forms without special arguments are compiled
+		case OP_WHEN:
+		case OP_EVERY_TIME:
+		{
+			int val = sexp_run(first);
+			int cond = Sexp_program[first].node;
+
+			if (val == SEXP_TRUE)
+				eval_when_do_then_actions(CDR(CDR(insn->node)), insn->op_num);
+
+			if (insn->op_num == OP_EVERY_TIME) {
+				flush_sexp_tree(CDR(insn->node));
+				return SEXP_NAN;
+			}
+
+			if (Sexp_nodes[cond].value == SEXP_KNOWN_FALSE || Sexp_nodes[cond].value == SEXP_NAN_FOREVER)
+				return SEXP_KNOWN_FALSE;
+
+			return val;
+		}
+
+		default:
+			UNREACHABLE("Operator %d is not compiled!", insn->op_num);
+			return SEXP_FALSE;
+	}
+}
+
+/**
+ * Runs the instruction at pc, returning what eval_sexp() returns for its node
+ */
+static int sexp_run(int pc)
+{
+	const sexp_instruction *insn = &Sexp_program[pc];
+	int result;
+
+	switch (insn->type)
+	{
+		case SEXP_INSN_NUMBER:
+			// nothing that is compiled marks a number atom as known
+			return insn->value;
+
+		case SEXP_INSN_CELL:
+			if (sexp_known_result(insn->node, &result))
+				return result;
+
+			result = sexp_run(pc + 1);
+			Sexp_nodes[insn->node].value = Sexp_nodes[Sexp_program[pc + 1].node].value;	// higher level node gets node value
+			return result;
+
+		case SEXP_INSN_OPERATOR:
+			if (sexp_known_result(insn->node, &result))
+				return result;
+
+			Current_sexp_operator.push_back(insn->op_num);
+			result = sexp_run_operator_value(pc);
+			Current_sexp_operator.pop_back();
+
+			return sexp_set_operator_result(insn->node, result, insn->positive ? 1 : 0);
+
+		default:
+			return eval_sexp(insn->node);
+	}
+}
+
+/**
+ * Evaluates a formula through its compiled form, or through eval_sexp() if it has none
+ *
+ * The result and the values left in the nodes are the same as eval_sexp(node) gives.  Event logging is only done by
+ * the tree walker, so formulas are not run compiled while Log_event is set.
+ *
+ * @param program The compiled formula as returned by sexp_compile(), or -1
+ * @param node The formula the program was compiled from
+ */
+int eval_compiled_sexp(int program, int node)
+{
+	if (program < 0 || !Sexp_compiled_formulas || Log_event)
+		return eval_sexp(node);
+
+	Assertion(program < (int) Sexp_program.size() && Sexp_program[program].node == node, "Compiled formula %d does not belong to node %d!", program, node);
+
+	return sexp_run(program);
+}
+
+DCF_BOOL(sexp_compiled_formulas, Sexp_compiled_formulas);
+
+DCF(sexp_compiled_bench, "Checks the compiled event conditions against eval_sexp() and times both")
+{
+	int iterations = 100;
+
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: sexp_compiled_bench [iterations]\n. Compiles the conditions of the loaded mission's events, compares each result and the node values it leaves against eval_sexp() and times both over [iterations] passes (default 100). The node values are restored afterwards.\n");
+		return;
+	}
+
+	dc_maybe_stuff_int(&iterations);
+
+	if (Fred_running || Sexp_nodes == NULL || Num_mission_events == 0) {
+		dc_printf("No events to check\n");
+		return;
+	}
+
+	// compile the condition of every event that has one, the actions would be run by evaluating it
+	SCP_vector<std::pair<int, int>> conditions;		// program, node
+	size_t compiled_size = Sexp_program.size();
+	int instructions = 0, fallbacks = 0;
+
+	for (int i = 0; i < Num_mission_events; i++) {
+		int op_node = Mission_events[i].formula;
+		if (op_node >= 0 && Sexp_nodes[op_node].first != -1)
+			op_node = CAR(op_node);
+
+		if (op_node < 0)
+			continue;
+
+		int op_num = get_operator_const(op_node);
+		if ((op_num != OP_WHEN && op_num != OP_EVERY_TIME) || CDR(op_node) == -1 || CADR(op_node) == -1)
+			continue;
+
+		int cond = CADR(op_node);
+		int program = (int) Sexp_program.size();
+		sexp_compile_node(cond, op_node, 0);
+
+		for (size_t pc = program; pc < Sexp_program.size(); pc++) {
+			instructions++;
+			if (Sexp_program[pc].type == SEXP_INSN_FALLBACK)
+				fallbacks++;
+		}
+
+		conditions.push_back(std::make_pair(program, cond));
+	}
+
+	// the evaluations below only touch the node values, and those are put back afterwards
+	SCP_vector<sexp_node> saved(Sexp_nodes, Sexp_nodes + Num_sexp_nodes);
+	SCP_vector<sexp_node> walked;
+	int saved_directive_count = Directive_count;
+	int saved_useful_number = Sexp_useful_number;
+	bool saved_log_event = Log_event;
+	int mismatches = 0;
+
+	Log_event = false;
+
+	for (auto &condition : conditions) {
+		SCP_vector<sexp_node> before(Sexp_nodes, Sexp_nodes + Num_sexp_nodes);
+
+		int expected = eval_sexp(condition.second);
+		walked.assign(Sexp_nodes, Sexp_nodes + Num_sexp_nodes);
+
+		std::copy(before.begin(), before.end(), Sexp_nodes);
+		int result = sexp_run(condition.first);
+
+		bool values_match = true;
+		for (int n = 0; n < Num_sexp_nodes; n++) {
+			if (Sexp_nodes[n].value != walked[n].value) {
+				values_match = false;
+				break;
+			}
+		}
+
+		if (result != expected || !values_match) {
+			SCP_string text;
+			convert_sexp_to_string(text, condition.second, SEXP_ERROR_CHECK_MODE);
+			dc_printf("Mismatch: %s returned %d, compiled %d%s\n", text.c_str(), expected, result, values_match ? "" : ", node values differ");
+			mismatches++;
+		}
+	}
+
+	// both passes start from the same node values
+	std::copy(saved.begin(), saved.end(), Sexp_nodes);
+	auto start = timer_get_microseconds();
+	for (int i = 0; i < iterations; i++) {
+		for (auto &condition : conditions)
+			eval_sexp(condition.second);
+	}
+	auto walker_time = timer_get_microseconds() - start;
+
+	std::copy(saved.begin(), saved.end(), Sexp_nodes);
+	start = timer_get_microseconds();
+	for (int i = 0; i < iterations; i++) {
+		for (auto &condition : conditions)
+			sexp_run(condition.first);
+	}
+	auto compiled_time = timer_get_microseconds() - start;
+
+	std::copy(saved.begin(), saved.end(), Sexp_nodes);
+	Directive_count = saved_directive_count;
+	Sexp_useful_number = saved_useful_number;
+	Log_event = saved_log_event;
+	Sexp_program.resize(compiled_size);
+
+	dc_printf("Checked %d conditions (%d instructions, %d fall back to eval_sexp), %d mismatches\n",
+		(int) conditions.size(), instructions, fallbacks, mismatches);
+	dc_printf("%d passes: eval_sexp %d us, compiled %d us\n", iterations, (int) walker_time, (int) compiled_time);
+}
+
 // Goober5000
 int get_sexp_id(char *sexp_name)
 {
@@ -1061,6 +1061,14 @@ typedef struct sexp_node {
 	int	rest;						// index into Sexp_nodes of rest of parameters
 	int	value;					// known to be true, known to be false, or not known
 	int flags;					// Goober5000
+	bool is_argument;			// the text is SEXP_ARGUMENT_STRING, resolved when the node is allocated
+	int variable_index;			// index into Sexp_variables for variable atoms, resolved when the node is allocated (-1 in FRED)
+	int number_value;			// atoi() of the text, only meaningful for constant number atoms
+
+	// cached result of sexp_ship_name_lookup() for this node
+	int cached_ship;
+	int cached_ship_inc_players;
+	uint32_t cached_ship_generation;	// ship_name_lookup_generation() when the result was cached, 0 if nothing is cached
 } sexp_node;
 
 // Goober5000
@@ -1154,6 +1162,7 @@ extern int is_sexp_top_level( int node );
 
 // Goober5000 - renamed these to be more clear, to prevent bugs :p
 extern int get_operator_index(const char *token);
+extern int sexp_ship_name_lookup(int node, int inc_players = 0);
 extern int get_operator_const(const char *token);
 
 extern int check_sexp_syntax(int node, int return_type = OPR_BOOL, int recursive = 0, int *bad_node = 0 /*NULL*/, int mode = 0);
@@ -1162,6 +1171,9 @@ extern int run_sexp(const char* sexpression); // debug and lua sexps
 extern int stuff_sexp_variable_list();
 extern int eval_sexp(int cur_node, int referenced_node = -1);
 extern int eval_num(int n);
+extern int sexp_compile(int node);
+extern void sexp_clear_compiled();
+extern int eval_compiled_sexp(int program, int node);
 extern bool is_sexp_true(int cur_node, int referenced_node = -1);
 extern int query_operator_return_type(int op);
 extern int query_operator_argument_type(int op, int argnum);
@@ -1169,6 +1181,16 @@ extern void update_sexp_references(const char *old_name, const char *new_name);
 extern void update_sexp_references(const char *old_name, const char *new_name, int format);
 extern int query_referenced_in_sexp(int mode, const char *name, int *node);
 extern int verify_vector(char *text);
+
+// What a formula can depend on, used to skip re-evaluating formulas whose inputs haven't changed
+#define SEXP_DEP_MISSION_LOG	(1<<0)	// the mission log and which ships are present
+#define SEXP_DEP_EVENTS			(1<<1)	// the status of other events
+#define SEXP_DEP_UNTRACKED		(1<<30)	// anything else, the formula must always be evaluated
+
+extern int sexp_get_dependencies(int node);
+extern void sexp_mark_dependency_changed(int dependencies);
+extern uint32_t sexp_get_dependency_stamp(int dependencies);
+extern bool sexp_dependency_tracking_enabled();
 extern void skip_white(char **str);
 extern int validate_float(char **str);
 extern int build_sexp_string(SCP_string &accumulator, int cur_node, int level, int mode);
@@ -24,7 +24,142 @@ using namespace particle;
 
 namespace
 {
-	SCP_vector<::particle::particle> Particles;
+	/**
+	 * @brief The per-particle data which is not needed by the move pass
+	 *
+	 * This is only touched when a particle is created, rendered or if it is attached to an object.
+	 */
+	struct particle_attributes {
+		float	radius;
+		int		type;
+		int		optional_data;
+		int		nframes;
+		int		attached_objnum;
+		int		attached_sig;
+		bool	reverse;
+		int		particle_index;
+	};
+
+	particle_attributes get_attributes(const ::particle::particle* part)
+	{
+		particle_attributes attr;
+
+		attr.radius = part->radius;
+		attr.type = part->type;
+		attr.optional_data = part->optional_data;
+		attr.nframes = part->nframes;
+		attr.attached_objnum = part->attached_objnum;
+		attr.attached_sig = part->attached_sig;
+		attr.reverse = part->reverse;
+		attr.particle_index = part->particle_index;
+
+		return attr;
+	}
+
+	/**
+	 * @brief Structure-of-arrays storage for non-persistent particles
+	 *
+	 * The fields used by the move pass are kept in separate, tightly packed float arrays so that the integration and
+	 * expiry loops in move_all() can be vectorized by the compiler. Everything else lives in #attributes. Non-persistent
+	 * particles never loop so there is no looping flag in here.
+	 */
+	struct particle_pool {
+		SCP_vector<float> pos_x, pos_y, pos_z;
+		SCP_vector<float> vel_x, vel_y, vel_z;
+		SCP_vector<float> age;
+		SCP_vector<float> max_life;
+		SCP_vector<int> expired;
+
+		SCP_vector<particle_attributes> attributes;
+
+		size_t size() const { return age.size(); }
+
+		bool empty() const { return age.empty(); }
+
+		void push_back(const ::particle::particle& part)
+		{
+			pos_x.push_back(part.pos.xyz.x);
+			pos_y.push_back(part.pos.xyz.y);
+			pos_z.push_back(part.pos.xyz.z);
+			vel_x.push_back(part.velocity.xyz.x);
+			vel_y.push_back(part.velocity.xyz.y);
+			vel_z.push_back(part.velocity.xyz.z);
+			age.push_back(part.age);
+			max_life.push_back(part.max_life);
+			expired.push_back(0);
+
+			attributes.push_back(get_attributes(&part));
+		}
+
+		void clear()
+		{
+			pos_x.clear();
+			pos_y.clear();
+			pos_z.clear();
+			vel_x.clear();
+			vel_y.clear();
+			vel_z.clear();
+			age.clear();
+			max_life.clear();
+			expired.clear();
+
+			attributes.clear();
+		}
+
+		/**
+		 * @brief Removes all particles which have been marked as expired
+		 *
+		 * The remaining particles keep their relative order.
+		 */
+		void compact()
+		{
+			auto n = size();
+			size_t out = 0;
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (expired[i])
+				{
+					continue;
+				}
+
+				if (out != i)
+				{
+					pos_x[out] = pos_x[i];
+					pos_y[out] = pos_y[i];
+					pos_z[out] = pos_z[i];
+					vel_x[out] = vel_x[i];
+					vel_y[out] = vel_y[i];
+					vel_z[out] = vel_z[i];
+					age[out] = age[i];
+					max_life[out] = max_life[i];
+					attributes[out] = attributes[i];
+				}
+				expired[out] = 0;
+
+				++out;
+			}
+
+			if (out == n)
+			{
+				return;
+			}
+
+			pos_x.resize(out);
+			pos_y.resize(out);
+			pos_z.resize(out);
+			vel_x.resize(out);
+			vel_y.resize(out);
+			vel_z.resize(out);
+			age.resize(out);
+			max_life.resize(out);
+			expired.resize(out);
+
+			attributes.resize(out);
+		}
+	};
+
+	particle_pool Particles;
 	SCP_vector<ParticlePtr> Persistent_particles;
 
 	int Anim_bitmap_id_fire = -1;
@@ -313,6 +448,78 @@ namespace particle
 		return false;
 	}
 
+	/**
+	 * @brief Moves all non-persistent particles and removes the expired ones
+	 *
+	 * Does the same as move_particle() but split into branch-free passes over the packed arrays of the particle pool
+	 * so that the compiler can vectorize them with whatever instruction set the build targets.
+	 *
+	 * @param frametime The length of the current frame
+	 */
+	static void move_pool(float frametime) {
+		auto n = Particles.size();
+
+		if (n == 0)
+		{
+			return;
+		}
+
+		auto age = Particles.age.data();
+		auto max_life = Particles.max_life.data();
+		auto expired = Particles.expired.data();
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			auto a = (age[i] == 0.0f) ? 0.00001f : (age[i] + frametime);
+			age[i] = a;
+
+			// special case, if max_life is 0 then we want it to render at least once
+			expired[i] = (a > max_life[i]) & ((a > frametime) | (max_life[i] > 0.0f));
+		}
+
+		auto pos_x = Particles.pos_x.data();
+		auto pos_y = Particles.pos_y.data();
+		auto pos_z = Particles.pos_z.data();
+		auto vel_x = Particles.vel_x.data();
+		auto vel_y = Particles.vel_y.data();
+		auto vel_z = Particles.vel_z.data();
+
+		// expired particles are moved as well, they will be dropped by the compaction below anyway
+		for (size_t i = 0; i < n; ++i)
+		{
+			pos_x[i] += vel_x[i] * frametime;
+			pos_y[i] += vel_y[i] * frametime;
+			pos_z[i] += vel_z[i] * frametime;
+		}
+
+		// if the particle is attached to an object which has become invalid, kill it
+		bool any_expired = false;
+		for (size_t i = 0; i < n; ++i)
+		{
+			auto& attr = Particles.attributes[i];
+
+			if (attr.attached_objnum >= 0)
+			{
+				// if the signature has changed, or it's bogus, kill it
+				if ((attr.attached_objnum >= MAX_OBJECTS) ||
+					(attr.attached_sig != Objects[attr.attached_objnum].signature))
+				{
+					expired[i] = 1;
+				}
+			}
+
+			if (expired[i])
+			{
+				any_expired = true;
+			}
+		}
+
+		if (any_expired)
+		{
+			Particles.compact();
+		}
+	}
+
 	void move_all(float frametime)
 	{
 		TRACE_SCOPE(tracing::ParticlesMoveAll);
@@ -323,6 +530,8 @@ namespace particle
 		if (Persistent_particles.empty() && Particles.empty())
 			return;
 
+		move_pool(frametime);
+
 		for (auto p = Persistent_particles.begin(); p != Persistent_particles.end();)
 		{
 			ParticlePtr part = *p;
@@ -343,26 +552,6 @@ namespace particle
 			// next particle
 			++p;
 		}
-
-		for (auto p = Particles.begin(); p != Particles.end();)
-		{
-			if (move_particle(frametime, &(*p)))
-			{
-				// if we're sitting on the very last particle, popping-back will invalidate the iterator!
-				if (p + 1 == Particles.end())
-				{
-					Particles.pop_back();
-					break;
-				}
-
-				*p = Particles.back();
-				Particles.pop_back();
-				continue;
-			}
-
-			// next particle
-			++p;
-		}
 	}
 
 	// kill all active particles
@@ -375,21 +564,25 @@ namespace particle
 
 	/**
 	 * @brief Renders a single particle
-	 * @param part The particle to render
+	 * @param part_pos The position of the particle, relative to the attached object if there is one
+	 * @param age How long the particle has been alive
+	 * @param max_life The lifetime of the particle
+	 * @param looping @c true if the animation of the particle loops
+	 * @param attr The remaining properties of the particle
 	 * @return @c true if the particle has been added to the rendering batch, @c false otherwise
 	 */
-	static bool render_particle(particle* part) {
+	static bool render_particle(const vec3d* part_pos, float age, float max_life, bool looping, const particle_attributes& attr) {
 		// skip back-facing particles (ripped from fullneb code)
 		// Wanderer - add support for attached particles
 		vec3d p_pos;
-		if (part->attached_objnum >= 0)
+		if (attr.attached_objnum >= 0)
 		{
-			vm_vec_unrotate(&p_pos, &part->pos, &Objects[part->attached_objnum].orient);
-			vm_vec_add2(&p_pos, &Objects[part->attached_objnum].pos);
+			vm_vec_unrotate(&p_pos, part_pos, &Objects[attr.attached_objnum].orient);
+			vm_vec_add2(&p_pos, &Objects[attr.attached_objnum].pos);
 		}
 		else
 		{
-			p_pos = part->pos;
+			p_pos = *part_pos;
 		}
 
 		if (vm_vec_dot_to_point(&Eye_matrix.vec.fvec, &Eye_position, &p_pos) <= 0.0f)
@@ -419,27 +612,27 @@ namespace particle
 		// figure out which frame we should be using
 		int framenum;
 		int cur_frame;
-		if (part->nframes > 1) {
-			framenum = bm_get_anim_frame(part->optional_data, part->age, part->max_life, part->looping);
-			cur_frame = part->reverse ? (part->nframes - framenum - 1) : framenum;
+		if (attr.nframes > 1) {
+			framenum = bm_get_anim_frame(attr.optional_data, age, max_life, looping);
+			cur_frame = attr.reverse ? (attr.nframes - framenum - 1) : framenum;
 		}
 		else
 		{
 			cur_frame = 0;
 		}
 
-		if (part->type == PARTICLE_DEBUG)
+		if (attr.type == PARTICLE_DEBUG)
 		{
 			gr_set_color(255, 0, 0);
-			g3_draw_sphere_ez(&p_pos, part->radius);
+			g3_draw_sphere_ez(&p_pos, attr.radius);
 		}
 		else
 		{
-			framenum = part->optional_data;
+			framenum = attr.optional_data;
 
-			Assert( cur_frame < part->nframes );
+			Assert( cur_frame < attr.nframes );
 
-			batching_add_volume_bitmap(framenum + cur_frame, &pos, part->particle_index % 8, part->radius, alpha);
+			batching_add_volume_bitmap(framenum + cur_frame, &pos, attr.particle_index % 8, attr.radius, alpha);
 
 			return true;
 		}
@@ -461,13 +654,19 @@ namespace particle
 			return;
 
 		for (auto& part : Persistent_particles) {
-			if (render_particle(part.get())) {
+			if (render_particle(&part->pos, part->age, part->max_life, part->looping, get_attributes(part.get()))) {
 				render_batch = true;
 			}
 		}
 
-		for (auto& part : Particles) {
-			if (render_particle(&part)) {
+		auto n = Particles.size();
+		for (size_t i = 0; i < n; ++i) {
+			vec3d part_pos;
+			part_pos.xyz.x = Particles.pos_x[i];
+			part_pos.xyz.y = Particles.pos_y[i];
+			part_pos.xyz.z = Particles.pos_z[i];
+
+			if (render_particle(&part_pos, Particles.age[i], Particles.max_life[i], false, Particles.attributes[i])) {
 				render_batch = true;
 			}
 		}
@@ -246,7 +246,7 @@ ADE_VIRTVAR(Name, l_Ship, "string", "Ship name. This is the actual name of the s
 	ship *shipp = &Ships[objh->objp->instance];
 
 	if(ADE_SETTING_VAR && s != NULL) {
-		strncpy(shipp->ship_name, s, sizeof(shipp->ship_name)-1);
+		ship_set_name(shipp, s);
 	}
 
 	return ade_set_args(L, "s", shipp->ship_name);
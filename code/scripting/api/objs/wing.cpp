@@ -51,7 +51,7 @@ ADE_VIRTVAR(Name, l_Wing, "string", "Name of Wing", "string", "Wing name, or emp
 		return ade_set_error(L, "s", "");
 
 	if(ADE_SETTING_VAR && s != NULL) {
-		strncpy(Wings[wdx].name, s, sizeof(Wings[wdx].name)-1);
+		wing_set_name(wdx, s);
 	}
 
 	return ade_set_args(L, "s", Wings[wdx].name);
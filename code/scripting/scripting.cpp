@@ -3,12 +3,15 @@
 
 #include "bmpman/bmpman.h"
 #include "controlconfig/controlsconfig.h"
+#include "debugconsole/console.h"
 #include "freespace.h"
 #include "gamesequence/gamesequence.h"
+#include "globalincs/linklist.h"
 #include "globalincs/systemvars.h"
 #include "globalincs/version.h"
 #include "hud/hud.h"
 #include "io/key.h"
+#include "io/timer.h"
 #include "mission/missioncampaign.h"
 #include "parse/parselo.h"
 #include "scripting/scripting.h"
@@ -213,8 +216,123 @@ DCF(script, "Evaluates a line of scripting")
 }
 */
 
+DCF(hook_bench, "Measures what binding the variables of a hook costs")
+{
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: hook_bench\n");
+		dc_printf("Binds and removes the variables of a collision hook a number of times and prints the average cost.\n");
+		dc_printf("Needs a mission with at least two objects.\n");
+		return;
+	}
+
+	const int NUM_HOOKS = 100000;
+
+	object *first = GET_FIRST(&obj_used_list);
+	object *second = (first != END_OF_LIST(&obj_used_list)) ? GET_NEXT(first) : first;
+	if (first == END_OF_LIST(&obj_used_list) || second == END_OF_LIST(&obj_used_list)) {
+		dc_printf("There have to be at least two objects to bind.\n");
+		return;
+	}
+
+	auto start = timer_get_nanoseconds();
+	for (int i = 0; i < NUM_HOOKS; ++i) {
+		Script_system.SetHookObjects(4, "Ship", first, "Weapon", second, "Self", first, "Object", second);
+		Script_system.RemHookVars(4, "Ship", "Weapon", "Self", "Object");
+	}
+	auto ns = timer_get_nanoseconds() - start;
+
+	dc_printf("Binding and removing the variables of a hook took %.1f ns on average\n", (double)ns / NUM_HOOKS);
+}
+
 //*************************CLASS: ConditionedScript*************************
 extern char Game_current_mission_filename[];
+
+// Looks up the table entry the name of a ship class, ship type or weapon class condition refers to. This can only be
+// done once the tables are loaded, which happens after the hooks are parsed, so it is done the first time it's needed.
+static int script_condition_index(script_condition *scp)
+{
+	if (scp->index != CONDITION_INDEX_UNRESOLVED)
+		return scp->index;
+
+	int index = -1;
+	switch (scp->condition_type)
+	{
+		case CHC_SHIPCLASS:
+			if (Ship_info.empty())
+				return -1;
+			for (size_t i = 0; i < Ship_info.size(); i++) {
+				if (!stricmp(Ship_info[i].name, scp->data.name)) {
+					index = (int)i;
+					break;
+				}
+			}
+			break;
+		case CHC_SHIPTYPE:
+			if (Ship_types.empty())
+				return -1;
+			index = ship_type_name_lookup(scp->data.name);
+			break;
+		case CHC_WEAPONCLASS:
+			if (Num_weapon_types <= 0)
+				return -1;
+			index = weapon_info_lookup(scp->data.name);
+			break;
+		default:
+			Int3();
+			return -1;
+	}
+
+	scp->index = index;
+	return index;
+}
+
+// Resolves the conditions which don't depend on any table when the hook is parsed
+static void script_condition_resolve_static(script_condition *scp)
+{
+	switch (scp->condition_type)
+	{
+		case CHC_STATE:
+			scp->index = gameseq_get_state_idx(scp->data.name);
+			break;
+		case CHC_OBJECTTYPE:
+			scp->index = -1;
+			for (int i = 0; i < MAX_OBJECT_TYPES; i++) {
+				if (Object_type_names[i] != NULL && !stricmp(Object_type_names[i], scp->data.name)) {
+					scp->index = i;
+					break;
+				}
+			}
+			break;
+		case CHC_VERSION:
+			{
+				// Goober5000: I'm going to assume scripting doesn't care about SVN revision
+				char buf[32];
+				sprintf(buf, "%i.%i.%i", FS_VERSION_MAJOR, FS_VERSION_MINOR, FS_VERSION_BUILD);
+				scp->index = !stricmp(buf, scp->data.name) ? 1 : 0;
+
+				//In case some people are lazy and say "3.7" instead of "3.7.0" or something
+				if(!scp->index && FS_VERSION_BUILD == 0)
+				{
+					sprintf(buf, "%i.%i", FS_VERSION_MAJOR, FS_VERSION_MINOR);
+					scp->index = !stricmp(buf, scp->data.name) ? 1 : 0;
+				}
+				break;
+			}
+		case CHC_APPLICATION:
+			if(Fred_running)
+			{
+				scp->index = (!stricmp("FRED2_Open", scp->data.name) || !stricmp("FRED2Open", scp->data.name) || !stricmp("FRED 2", scp->data.name) || !stricmp("FRED", scp->data.name)) ? 1 : 0;
+			}
+			else
+			{
+				scp->index = (!stricmp("FS2_Open", scp->data.name) || !stricmp("FS2Open", scp->data.name) || !stricmp("Freespace 2", scp->data.name) || !stricmp("Freespace", scp->data.name)) ? 1 : 0;
+			}
+			break;
+		default:
+			break;
+	}
+}
+
 bool ConditionedHook::AddCondition(script_condition *sc)
 {
 	for(int i = 0; i < MAX_HOOK_CONDITIONS; i++)
@@ -222,6 +340,7 @@ bool ConditionedHook::AddCondition(script_condition *sc)
 		if(Conditions[i].condition_type == CHC_NONE)
 		{
 			Conditions[i] = *sc;
+			script_condition_resolve_static(&Conditions[i]);
 			return true;
 		}
 	}
@@ -249,12 +368,17 @@ bool ConditionedHook::ConditionsValid(int action, object *objp, int more_data)
 	for(i = 0; i < MAX_HOOK_CONDITIONS; i++)
 	{
 		scp = &Conditions[i];
+
+		// Conditions are added in order so there are none after the first empty slot
+		if(scp->condition_type == CHC_NONE)
+			break;
+
 		switch(scp->condition_type)
 		{
 			case CHC_STATE:
 				if(gameseq_get_depth() < 0)
 					return false;
-				if(stricmp(GS_state_text[gameseq_get_state(0)], scp->data.name) != 0)
+				if(gameseq_get_state(0) != scp->index)
 					return false;
 				break;
 			case CHC_SHIPTYPE:
@@ -263,13 +387,13 @@ bool ConditionedHook::ConditionsValid(int action, object *objp, int more_data)
 				sip = &Ship_info[Ships[objp->instance].ship_info_index];
 				if(sip->class_type < 0)
 					return false;
-				if(stricmp(Ship_types[sip->class_type].name, scp->data.name) != 0)
+				if(sip->class_type != script_condition_index(scp))
 					return false;
 				break;
 			case CHC_SHIPCLASS:
 				if(objp == NULL || objp->type != OBJ_SHIP)
 					return false;
-				if(stricmp(Ship_info[Ships[objp->instance].ship_info_index].name, scp->data.name) != 0)
+				if(Ships[objp->instance].ship_info_index != script_condition_index(scp))
 					return false;
 				break;
 			case CHC_SHIP:
@@ -306,14 +430,14 @@ bool ConditionedHook::ConditionsValid(int action, object *objp, int more_data)
 			case CHC_WEAPONCLASS:
 				{
 					if (action == CHA_COLLIDEWEAPON) {
-						if (stricmp(Weapon_info[more_data].name, scp->data.name) != 0)
+						if (more_data != script_condition_index(scp))
 							return false;
 					} else if (!(action == CHA_ONWPSELECTED || action == CHA_ONWPDESELECTED || action == CHA_ONWPEQUIPPED || action == CHA_ONWPFIRED || action == CHA_ONTURRETFIRED )) {
 						if(objp == NULL || (objp->type != OBJ_WEAPON && objp->type != OBJ_BEAM))
 							return false;
-						else if (( objp->type == OBJ_WEAPON) && (stricmp(Weapon_info[Weapons[objp->instance].weapon_info_index].name, scp->data.name) != 0 ))
+						else if (( objp->type == OBJ_WEAPON) && (Weapons[objp->instance].weapon_info_index != script_condition_index(scp)))
 							return false;
-						else if (( objp->type == OBJ_BEAM) && (stricmp(Weapon_info[Beams[objp->instance].weapon_info_index].name, scp->data.name) != 0 ))
+						else if (( objp->type == OBJ_BEAM) && (Beams[objp->instance].weapon_info_index != script_condition_index(scp)))
 							return false;
 					} else if(objp == NULL || objp->type != OBJ_SHIP) {
 						return false;
@@ -324,11 +448,17 @@ bool ConditionedHook::ConditionsValid(int action, object *objp, int more_data)
 
 						// Okay, if we're still here, then objp is both valid and a ship
 						ship* shipp = &Ships[objp->instance];
+						int weapon_index = script_condition_index(scp);
+
+						// No weapon has that name so none of the checks below can succeed
+						if (weapon_index < 0)
+							return false;
+
 						bool primary = false, secondary = false, prev_primary = false, prev_secondary = false;
 						switch (action) {
 							case CHA_ONWPSELECTED:
-								primary = stricmp(Weapon_info[shipp->weapons.primary_bank_weapons[shipp->weapons.current_primary_bank]].name, scp->data.name) == 0;
-								secondary = stricmp(Weapon_info[shipp->weapons.secondary_bank_weapons[shipp->weapons.current_secondary_bank]].name, scp->data.name) == 0;
+								primary = shipp->weapons.primary_bank_weapons[shipp->weapons.current_primary_bank] == weapon_index;
+								secondary = shipp->weapons.secondary_bank_weapons[shipp->weapons.current_secondary_bank] == weapon_index;
 								
 								if (!(primary || secondary))
 									return false;
@@ -338,10 +468,10 @@ bool ConditionedHook::ConditionsValid(int action, object *objp, int more_data)
 								
 								break;
 							case CHA_ONWPDESELECTED:
-								primary = stricmp(Weapon_info[shipp->weapons.primary_bank_weapons[shipp->weapons.current_primary_bank]].name, scp->data.name) == 0;
-								prev_primary = stricmp(Weapon_info[shipp->weapons.primary_bank_weapons[shipp->weapons.previous_primary_bank]].name, scp->data.name) == 0;
-								secondary = stricmp(Weapon_info[shipp->weapons.secondary_bank_weapons[shipp->weapons.current_secondary_bank]].name, scp->data.name) == 0;
-								prev_secondary = stricmp(Weapon_info[shipp->weapons.secondary_bank_weapons[shipp->weapons.previous_secondary_bank]].name, scp->data.name) == 0;
+								primary = shipp->weapons.primary_bank_weapons[shipp->weapons.current_primary_bank] == weapon_index;
+								prev_primary = shipp->weapons.primary_bank_weapons[shipp->weapons.previous_primary_bank] == weapon_index;
+								secondary = shipp->weapons.secondary_bank_weapons[shipp->weapons.current_secondary_bank] == weapon_index;
+								prev_secondary = shipp->weapons.secondary_bank_weapons[shipp->weapons.previous_secondary_bank] == weapon_index;
 
 								if ((shipp->flags[Ship::Ship_Flags::Primary_linked]) && prev_primary && (Weapon_info[shipp->weapons.primary_bank_weapons[shipp->weapons.previous_primary_bank]].wi_flags[Weapon::Info_Flags::Nolink]))
 									return true;
@@ -365,21 +495,17 @@ bool ConditionedHook::ConditionsValid(int action, object *objp, int more_data)
 							case CHA_ONWPEQUIPPED: {
 								bool equipped = false;
 								for(int j = 0; j < MAX_SHIP_PRIMARY_BANKS; j++) {
-									if (!equipped && (shipp->weapons.primary_bank_weapons[j] >= 0) && (shipp->weapons.primary_bank_weapons[j] < MAX_WEAPON_TYPES) ) {
-										if ( !stricmp(Weapon_info[shipp->weapons.primary_bank_weapons[j]].name, scp->data.name) ) {
-											equipped = true;
-											break;
-										}
+									if (shipp->weapons.primary_bank_weapons[j] == weapon_index) {
+										equipped = true;
+										break;
 									}
 								}
 							
 								if (!equipped) {
 									for(int j = 0; j < MAX_SHIP_SECONDARY_BANKS; j++) {
-										if (!equipped && (shipp->weapons.secondary_bank_weapons[j] >= 0) && (shipp->weapons.secondary_bank_weapons[j] < MAX_WEAPON_TYPES) ) {
-											if ( !stricmp(Weapon_info[shipp->weapons.secondary_bank_weapons[j]].name, scp->data.name) ) {
-												equipped = true;
-												break;
-											}
+										if (shipp->weapons.secondary_bank_weapons[j] == weapon_index) {
+											equipped = true;
+											break;
 										}
 									}
 								}
@@ -391,11 +517,11 @@ bool ConditionedHook::ConditionsValid(int action, object *objp, int more_data)
 							}
 							case CHA_ONWPFIRED: {
 								if (more_data == 1) {
-									primary = stricmp(Weapon_info[shipp->weapons.primary_bank_weapons[shipp->weapons.current_primary_bank]].name, scp->data.name) == 0;
+									primary = shipp->weapons.primary_bank_weapons[shipp->weapons.current_primary_bank] == weapon_index;
 									secondary = false;
 								} else {
 									primary = false;
-									secondary = stricmp(Weapon_info[shipp->weapons.secondary_bank_weapons[shipp->weapons.current_secondary_bank]].name, scp->data.name) == 0;
+									secondary = shipp->weapons.secondary_bank_weapons[shipp->weapons.current_secondary_bank] == weapon_index;
 								}
 
 								if ((shipp->flags[Ship::Ship_Flags::Primary_linked]) && primary && (Weapon_info[shipp->weapons.primary_bank_weapons[shipp->weapons.current_primary_bank]].wi_flags[Weapon::Info_Flags::Nolink]))
@@ -406,22 +532,22 @@ bool ConditionedHook::ConditionsValid(int action, object *objp, int more_data)
 								break;
 							}
 							case CHA_ONTURRETFIRED: {
-								if (! (stricmp(Weapon_info[shipp->last_fired_turret->last_fired_weapon_info_index].name, scp->data.name) == 0))
+								if (shipp->last_fired_turret->last_fired_weapon_info_index != weapon_index)
 									return false;
 								break;
 							}
 							case CHA_PRIMARYFIRE: {
-								if (stricmp(Weapon_info[shipp->weapons.primary_bank_weapons[shipp->weapons.current_primary_bank]].name, scp->data.name) != 0)
+								if (shipp->weapons.primary_bank_weapons[shipp->weapons.current_primary_bank] != weapon_index)
 									return false;
 								break;
 							}
 							case CHA_SECONDARYFIRE: {
-								if (stricmp(Weapon_info[shipp->weapons.secondary_bank_weapons[shipp->weapons.current_secondary_bank]].name, scp->data.name) != 0)
+								if (shipp->weapons.secondary_bank_weapons[shipp->weapons.current_secondary_bank] != weapon_index)
 									return false;
 								break;
 							}
 							case CHA_BEAMFIRE: {
-								if (!(stricmp(Weapon_info[more_data].name, scp->data.name) == 0))
+								if (more_data != weapon_index)
 									return false;
 								break;
 							}
@@ -433,7 +559,7 @@ bool ConditionedHook::ConditionsValid(int action, object *objp, int more_data)
 			case CHC_OBJECTTYPE:
 				if(objp == NULL)
 					return false;
-				if(stricmp(Object_type_names[objp->type], scp->data.name) != 0)
+				if(objp->type != scp->index)
 					return false;
 				break;
 			case CHC_KEYPRESS:
@@ -460,39 +586,10 @@ bool ConditionedHook::ConditionsValid(int action, object *objp, int more_data)
 					break;
 				}
 			case CHC_VERSION:
-				{
-					// Goober5000: I'm going to assume scripting doesn't care about SVN revision
-					char buf[32];
-					sprintf(buf, "%i.%i.%i", FS_VERSION_MAJOR, FS_VERSION_MINOR, FS_VERSION_BUILD);
-					if(stricmp(buf, scp->data.name) != 0)
-					{
-						//In case some people are lazy and say "3.7" instead of "3.7.0" or something
-						if(FS_VERSION_BUILD == 0)
-						{
-							sprintf(buf, "%i.%i", FS_VERSION_MAJOR, FS_VERSION_MINOR);
-							if(stricmp(buf, scp->data.name) != 0)
-								return false;
-						}
-						else
-						{
-							return false;
-						}
-					}
-					break;
-				}
 			case CHC_APPLICATION:
-				{
-					if(Fred_running)
-					{
-						if(stricmp("FRED2_Open", scp->data.name) != 0 && stricmp("FRED2Open", scp->data.name) != 0 && stricmp("FRED 2", scp->data.name) != 0 && stricmp("FRED", scp->data.name) != 0)
-							return false;
-					}
-					else
-					{
-						if(stricmp("FS2_Open", scp->data.name) != 0 && stricmp("FS2Open", scp->data.name) != 0 && stricmp("Freespace 2", scp->data.name) != 0 && stricmp("Freespace", scp->data.name) != 0)
-							return false;
-					}
-				}
+				if(!scp->index)
+					return false;
+				break;
 			default:
 				break;
 		}
@@ -501,6 +598,16 @@ bool ConditionedHook::ConditionsValid(int action, object *objp, int more_data)
 	return true;
 }
 
+bool ConditionedHook::HasAction(int action) const
+{
+	for (auto& Action : Actions) {
+		if (Action.action_type == action)
+			return true;
+	}
+
+	return false;
+}
+
 bool ConditionedHook::IsOverride(script_state* sys, int action)
 {
 	Assert(sys != NULL);
@@ -543,6 +650,13 @@ void script_state::SetHookObject(const char *name, object *objp)
 
 void script_state::SetHookObjects(int num, ...)
 {
+	// Hooks often bind one object to several names, like "Ship" and "Self". Those names share one handle instead of
+	// creating a new one for each name.
+	const int MAX_SHARED_HANDLES = 8;
+	object *handle_objs[MAX_SHARED_HANDLES];
+	int handle_ldxs[MAX_SHARED_HANDLES];
+	int num_handles = 0;
+
 	va_list vl;
 	va_start(vl, num);
 	if(this->OpenHookVarTable())
@@ -552,16 +666,38 @@ void script_state::SetHookObjects(int num, ...)
 		{
 			char *name = va_arg(vl, char*);
 			object *objp = va_arg(vl, object*);
-			
-			ade_set_object_with_breed(LuaState, OBJ_INDEX(objp));
-			int data_ldx = lua_gettop(LuaState);
+
+			int data_ldx = -1;
+			for(int j = 0; j < num_handles; j++)
+			{
+				if(handle_objs[j] == objp)
+				{
+					data_ldx = handle_ldxs[j];
+					break;
+				}
+			}
+
+			if(data_ldx < 0)
+			{
+				ade_set_object_with_breed(LuaState, OBJ_INDEX(objp));
+				data_ldx = lua_gettop(LuaState);
+
+				if(num_handles < MAX_SHARED_HANDLES)
+				{
+					handle_objs[num_handles] = objp;
+					handle_ldxs[num_handles] = data_ldx;
+					num_handles++;
+				}
+			}
 
 			lua_pushstring(LuaState, name);
 			lua_pushvalue(LuaState, data_ldx);
 			lua_rawset(LuaState, amt_ldx);
-
-			lua_pop(LuaState, 1);	//data_ldx
 		}
+
+		// Remove the handles
+		lua_settop(LuaState, amt_ldx);
+
 		this->CloseHookVarTable();
 	}
 	else
@@ -583,6 +719,20 @@ bool script_state::OpenHookVarTable()
 	if(ohvt_isopen)
 		Error(LOCATION, "OpenHookVarTable was called twice with no call to CloseHookVarTable - missing call ahoy!");
 
+	// The table is looked up once and then kept in the registry since this runs several times for every hook
+	if(HookVarTable == nullptr && !FindHookVarTable())
+		return false;
+
+	HookVarTable->pushValue();
+	ohvt_isopen = 1;
+	ohvt_poststack = lua_gettop(LuaState);
+	return true;
+}
+
+bool script_state::FindHookVarTable()
+{
+	bool found = false;
+
 	lua_pushstring(LuaState, "hv");
 	lua_gettable(LuaState, LUA_GLOBALSINDEX);
 	int sv_ldx = lua_gettop(LuaState);
@@ -599,9 +749,8 @@ bool script_state::OpenHookVarTable()
 			int amt_ldx = lua_gettop(LuaState);
 			if(lua_istable(LuaState, amt_ldx))
 			{
-				ohvt_isopen = 3;
-				ohvt_poststack = amt_ldx;
-				return true;
+				HookVarTable = luacpp::UniqueLuaReference::create(LuaState, amt_ldx);
+				found = true;
 			}
 			lua_pop(LuaState, 1);	//amt
 		}
@@ -609,7 +758,7 @@ bool script_state::OpenHookVarTable()
 	}
 	lua_pop(LuaState, 1);	//Library
 	
-	return false;
+	return found;
 }
 
 //Call when you are done with CloseHookVarTable,
@@ -700,14 +849,44 @@ void script_state::UnloadImages()
 	ScriptImages.clear();
 }
 
+void script_state::AddConditionalHook(ConditionedHook&& hook)
+{
+	auto hook_index = ConditionalHooks.size();
+	ConditionalHooks.push_back(std::move(hook));
+
+	auto& added = ConditionalHooks.back();
+	for (int i = 0; i < Num_script_actions; i++)
+	{
+		int action = Script_actions[i].def;
+		if (!added.HasAction(action))
+			continue;
+
+		if (action >= (int)HooksByAction.size())
+			HooksByAction.resize(action + 1);
+
+		HooksByAction[action].push_back(hook_index);
+	}
+}
+
+const SCP_vector<size_t>& script_state::GetHooksForAction(int action) const
+{
+	static const SCP_vector<size_t> no_hooks;
+
+	if (action < 0 || action >= (int)HooksByAction.size())
+		return no_hooks;
+
+	return HooksByAction[action];
+}
+
 int script_state::RunCondition(int action, object* objp, int more_data)
 {
 	int num = 0;
-	for(SCP_vector<ConditionedHook>::iterator chp = ConditionalHooks.begin(); chp != ConditionalHooks.end(); ++chp) 
+	for (auto hook_index : GetHooksForAction(action))
 	{
-		if(chp->ConditionsValid(action, objp, more_data))
+		auto& hook = ConditionalHooks[hook_index];
+		if(hook.ConditionsValid(action, objp, more_data))
 		{
-			chp->Run(this, action);
+			hook.Run(this, action);
 			num++;
 		}
 	}
@@ -716,12 +895,12 @@ int script_state::RunCondition(int action, object* objp, int more_data)
 
 bool script_state::IsConditionOverride(int action, object *objp)
 {
-	//bool b = false;
-	for(SCP_vector<ConditionedHook>::iterator chp = ConditionalHooks.begin(); chp != ConditionalHooks.end(); ++chp)
+	for (auto hook_index : GetHooksForAction(action))
 	{
-		if(chp->ConditionsValid(action, objp))
+		auto& hook = ConditionalHooks[hook_index];
+		if(hook.ConditionsValid(action, objp))
 		{
-			if(chp->IsOverride(this, action))
+			if(hook.IsOverride(this, action))
 				return true;
 		}
 	}
@@ -737,6 +916,8 @@ void script_state::Clear()
 {
 	// Free all lua value references
 	ConditionalHooks.clear();
+	HooksByAction.clear();
+	HookVarTable = nullptr;
 
 	if(LuaState != NULL) {
 		OnStateDestroy(LuaState);
@@ -771,6 +952,7 @@ void script_state::SetLuaSession(lua_State *L)
 {
 	if(LuaState != NULL)
 	{
+		HookVarTable = nullptr;
 		lua_close(LuaState);
 	}
 	LuaState = L;
@@ -1053,11 +1235,12 @@ void script_state::ParseGlobalChunk(int hookType, const char* debug_str) {
 	//Add the action
 	hook.AddAction(&sat);
 
-	ConditionalHooks.push_back(hook);
+	AddConditionalHook(std::move(hook));
 }
 bool script_state::ParseCondition(const char *filename)
 {
-	ConditionedHook *chp = NULL;
+	ConditionedHook hook;
+	bool conditions_added = false;
 	int condition;
 
 	for(condition = script_parse_condition(); condition != CHC_NONE; condition = script_parse_condition())
@@ -1082,19 +1265,15 @@ bool script_state::ParseCondition(const char *filename)
 				break;
 		}
 
-		if(chp == NULL)
-		{
-			ConditionalHooks.push_back(ConditionedHook());
-			chp = &ConditionalHooks[ConditionalHooks.size()-1];
-		}
+		conditions_added = true;
 
-		if(!chp->AddCondition(&sct))
+		if(!hook.AddCondition(&sct))
 		{
 			Warning(LOCATION, "Could not add condition to conditional hook in file '%s'; you may have more than %d", filename, MAX_HOOK_CONDITIONS);
 		}
 	}
 
-	if(chp == NULL)
+	if(!conditions_added)
 	{
 		return false;
 	}
@@ -1116,17 +1295,18 @@ bool script_state::ParseCondition(const char *filename)
 		vm_free(buf);
 
 		//Add the action
-		if(chp->AddAction(&sat))
+		if(hook.AddAction(&sat))
 			actions_added = true;
 	}
 
 	if(!actions_added)
 	{
 		Warning(LOCATION, "No actions specified for conditional hook in file '%s'", filename);
-		ConditionalHooks.pop_back();
 		return false;
 	}
 
+	AddConditionalHook(std::move(hook));
+
 	return true;
 }
 
@@ -111,6 +111,9 @@ void scripting_state_init();
 void scripting_state_close();
 void scripting_state_do_frame(float frametime);
 
+// The table index of a condition has not been looked up yet
+#define CONDITION_INDEX_UNRESOLVED	-2
+
 class script_condition
 {
 public:
@@ -120,8 +123,13 @@ public:
 		char name[CONDITION_LENGTH];
 	} data;
 
+	// What the name refers to, so that checking the condition is an integer compare. Depending on the type this is a
+	// game state, object type, ship class, ship type or weapon class index or -1 if nothing has that name.
+	// Constant conditions like the version store 1 if they are met and 0 if not.
+	int index;
+
 	script_condition()
-		: condition_type(CHC_NONE)
+		: condition_type(CHC_NONE), index(CONDITION_INDEX_UNRESOLVED)
 	{
 		memset(data.name, 0, sizeof(data.name));
 	}
@@ -149,6 +157,7 @@ public:
 	bool AddAction(script_action *sa);
 
 	bool ConditionsValid(int action, class object *objp=NULL, int more_data = 0);
+	bool HasAction(int action) const;
 	bool IsOverride(class script_state *sys, int action);
 	bool Run(class script_state* sys, int action);
 };
@@ -167,6 +176,12 @@ private:
 	SCP_vector<image_desc> ScriptImages;
 	SCP_vector<ConditionedHook> ConditionalHooks;
 
+	// The indices into ConditionalHooks of the hooks which have an action of a type, indexed by the CHA_* value
+	SCP_vector<SCP_vector<size_t>> HooksByAction;
+
+	// The member table of the hook variable library
+	luacpp::LuaReference HookVarTable;
+
 private:
 
 	void ParseChunkSub(script_function& out_func, const char* debug_str=NULL);
@@ -174,10 +189,14 @@ private:
 	void SetLuaSession(struct lua_State *L);
 
 	void OutputLuaMeta(FILE *fp);
+
+	void AddConditionalHook(ConditionedHook&& hook);
+	const SCP_vector<size_t>& GetHooksForAction(int action) const;
 	
 	//Lua private helper functions
 	bool OpenHookVarTable();
 	bool CloseHookVarTable();
+	bool FindHookVarTable();
 
 	//Internal Lua helper functions
 	void EndLuaFrame();
@@ -14,8 +14,10 @@
 #include "iff_defs/iff_defs.h"
 #include "io/timer.h"
 #include "mission/missionparse.h"
+#include "model/model.h"
 #include "nebula/neb.h"
 #include "network/multi.h"
+#include "object/objectgrid.h"
 #include "ship/awacs.h"
 #include "ship/ship.h"
 #include "species_defs/species_defs.h"
@@ -43,11 +45,32 @@ typedef struct awacs_entry {
 awacs_entry Awacs[MAX_AWACS];
 int Awacs_count = 0;
 
+// the AWACS subsystems of every ship, so that only the first update after a ship appears has to walk all of its
+// subsystems.  The subsystem list of a ship is rebuilt when it changes class so that is checked as well.
+typedef struct awacs_subsys_cache {
+	int signature = -1;
+	int ship_info_index = -1;
+	ship_subsys *first_subsys = NULL;
+	SCP_vector<ship_subsys*> subsystems;
+} awacs_subsys_cache;
+static awacs_subsys_cache Awacs_subsys_cache[MAX_SHIPS];
+
 // TEAM SHIP VISIBILITY
 // team-wide shared visibility info
 // at start of each frame (maybe timestamp), compute visibility 
 ubyte Ship_visibility_by_team[MAX_IFFS][MAX_SHIPS];
 
+// the ships that can see or be seen, per team, in Ship_obj_list order.  Kept between updates so that they do not have
+// to be allocated every time.
+static SCP_vector<int> Team_visibility_ships[MAX_IFFS];
+
+// the ships that got a column in Ship_visibility_by_team in the last update, everything else is 0
+static SCP_vector<int> Team_visibility_listed;
+static SCP_vector<int> Team_visibility_prev_listed;
+
+// which ships can act as a viewer in the current update, i.e. are listed and are not cargo or nav buoys
+static ubyte Team_visibility_viewer[MAX_SHIPS];
+
 // ----------------------------------------------------------------------------------------------------
 // AWACS FORWARD DECLARATIONS
 //
@@ -68,6 +91,17 @@ void awacs_level_init()
 {
 	// set the update timestamp to -1 
 	Awacs_stamp = -1;
+
+	for (auto& cache : Awacs_subsys_cache)
+	{
+		cache.signature = -1;
+		cache.subsystems.clear();
+	}
+
+	// the updates only clear the entries of ships they have seen so start from a clean slate
+	memset(Ship_visibility_by_team, 0, MAX_IFFS * MAX_SHIPS * sizeof(ubyte));
+	Team_visibility_listed.clear();
+	Team_visibility_prev_listed.clear();
 }
 
 // call every frame to process AWACS details
@@ -97,7 +131,6 @@ void awacs_update_all_levels()
 {
 	ship_obj *moveup;	
 	ship *shipp;
-	ship_subsys *ship_system;
 	int idx;
 
 	// zero all levels
@@ -107,7 +140,6 @@ void awacs_update_all_levels()
 
 	Awacs_count = 0;
 
-	// we need to traverse all subsystems on all ships	
 	for (moveup = GET_FIRST(&Ship_obj_list); moveup != END_OF_LIST(&Ship_obj_list); moveup = GET_NEXT(moveup))
 	{
 		// make sure its a valid ship
@@ -115,7 +147,8 @@ void awacs_update_all_levels()
 			continue;
 		
 		// get a handle to the ship
-		shipp = &Ships[Objects[moveup->objnum].instance];
+		int ship_num = Objects[moveup->objnum].instance;
+		shipp = &Ships[ship_num];
 
 		// ignore dying, departing, or arriving ships
 		if ((shipp->is_dying_or_departing() || shipp->is_arriving()))
@@ -125,23 +158,34 @@ void awacs_update_all_levels()
 		if (!(Ship_info[shipp->ship_info_index].flags[Ship::Info_Flags::Has_awacs]))
 			continue;
 
-		// traverse all subsystems
-		for (ship_system = GET_FIRST(&shipp->subsys_list); ship_system != END_OF_LIST(&shipp->subsys_list); ship_system = GET_NEXT(ship_system))
+		// only walk the subsystems of a ship the first time we see it
+		auto& cache = Awacs_subsys_cache[ship_num];
+		if ((cache.signature != Objects[moveup->objnum].signature) || (cache.ship_info_index != shipp->ship_info_index) || (cache.first_subsys != GET_FIRST(&shipp->subsys_list)))
 		{
-			// if this is an AWACS subsystem
-			if ((ship_system->system_info != NULL) && (ship_system->system_info->flags[Model::Subsystem_Flags::Awacs]))
+			cache.signature = Objects[moveup->objnum].signature;
+			cache.ship_info_index = shipp->ship_info_index;
+			cache.first_subsys = GET_FIRST(&shipp->subsys_list);
+			cache.subsystems.clear();
+
+			for (auto ship_system = GET_FIRST(&shipp->subsys_list); ship_system != END_OF_LIST(&shipp->subsys_list); ship_system = GET_NEXT(ship_system))
 			{
-				// add the intensity to the team total
-				Awacs_team[shipp->team] += ship_system->awacs_intensity * (ship_system->current_hits / ship_system->max_hits);
+				if ((ship_system->system_info != NULL) && (ship_system->system_info->flags[Model::Subsystem_Flags::Awacs]))
+					cache.subsystems.push_back(ship_system);
+			}
+		}
 
-				// add an Awacs source
-				if (Awacs_count < MAX_AWACS)
-				{
-					Awacs[Awacs_count].subsys = ship_system;
-					Awacs[Awacs_count].team = shipp->team;
-					Awacs[Awacs_count].objp = &Objects[moveup->objnum];				
-					Awacs_count++;
-				}
+		for (auto ship_system : cache.subsystems)
+		{
+			// add the intensity to the team total
+			Awacs_team[shipp->team] += ship_system->awacs_intensity * (ship_system->current_hits / ship_system->max_hits);
+
+			// add an Awacs source
+			if (Awacs_count < MAX_AWACS)
+			{
+				Awacs[Awacs_count].subsys = ship_system;
+				Awacs[Awacs_count].team = shipp->team;
+				Awacs[Awacs_count].objp = &Objects[moveup->objnum];				
+				Awacs_count++;
 			}
 		}
 	}
@@ -345,18 +389,41 @@ float awacs_get_level(object *target, ship *viewer, int use_awacs)
 }
 
 
+// whether any of the listed ships of a team can see the target, see team_visibility_update()
+static bool team_visibility_viewer_sees(object *target, int viewer_num)
+{
+	if (!Team_visibility_viewer[viewer_num])
+		return false;
+
+	int team = Ships[viewer_num].team;
+
+	// AWACS is only checked once per team, with the first ship on the list
+	return awacs_get_level(target, &Ships[viewer_num], (viewer_num == Team_visibility_ships[team].front())) > 1.0f;
+}
+
 // update team visibility
+//
+// A team can see a ship if at least one of its ships gets a level above 1.0 from awacs_get_level().  Most of the
+// ships of a team can only do that if they are close enough to the target: within the targeting range of the HUD,
+// or within sensor range in a nebula.  Those ships are found with the object grid instead of trying every ship of
+// every team.  The only ships which can see a target from further away are the first ship of each team (which is
+// the one that checks AWACS) and the player when observing, so they are always tried.
 void team_visibility_update()
 {
-	int team_count[MAX_IFFS];
-	int team_ships[MAX_IFFS][MAX_SHIPS];
-
 	ship_obj *moveup;
 	ship *shipp;
+	int team;
 
-	// zero out stuff for each team
-	memset(team_count, 0, MAX_IFFS * sizeof(int));
-	memset(Ship_visibility_by_team, 0, MAX_IFFS * MAX_SHIPS * sizeof(ubyte));
+	for (team = 0; team < MAX_IFFS; team++)
+		Team_visibility_ships[team].clear();
+
+	memset(Team_visibility_viewer, 0, sizeof(Team_visibility_viewer));
+
+	std::swap(Team_visibility_listed, Team_visibility_prev_listed);
+	Team_visibility_listed.clear();
+
+	// the furthest any ship can be from a target and still see it through the nebula
+	float max_species_multiplier = 0.0f;
 
 	// Go through list of ships and mark those visible for their own team
 	for (moveup = GET_FIRST(&Ship_obj_list); moveup != END_OF_LIST(&Ship_obj_list); moveup = GET_NEXT(moveup))
@@ -381,58 +448,117 @@ void team_visibility_update()
 		if ((shipp->flags[Ship::Ship_Flags::Stealth] && shipp->flags[Ship::Ship_Flags::Friendly_stealth_invis]))
 			continue;
 
-		Ship_visibility_by_team[shipp->team][ship_num] = 1;
-		team_ships[shipp->team][team_count[shipp->team]] = ship_num;
-		team_count[shipp->team]++;
+		Team_visibility_ships[shipp->team].push_back(ship_num);
+		Team_visibility_listed.push_back(ship_num);
+
+		// ignore nav buoys and cargo containers
+		auto sip = &Ship_info[shipp->ship_info_index];
+		if (!sip->flags[Ship::Info_Flags::Cargo] && !sip->flags[Ship::Info_Flags::Navbuoy])
+		{
+			Team_visibility_viewer[ship_num] = 1;
+			max_species_multiplier = MAX(max_species_multiplier, Species_info[sip->species].awacs_multiplier);
+		}
+	}
+
+	// clear the ships which are gone since the last update, the listed ones get all of their entries written below
+	for (auto ship_num : Team_visibility_prev_listed)
+	{
+		for (team = 0; team < MAX_IFFS; team++)
+			Ship_visibility_by_team[team][ship_num] = 0;
 	}
 
-	int idx, en_idx, cur_count, en_count;
-	int *cur_team_ships, *en_team_ships;
+	float max_half_scan_range = MAX(0.5f * Neb2_awacs * max_species_multiplier, 0.0f);
+	int nebula_enabled = (The_mission.flags[Mission::Mission_Flags::Fullneb]);
+	bool use_grid = obj_grid_available();
+
+	int player_num = (Player_ship != NULL) ? (int)(Player_ship - Ships) : -1;
 
-	// Do for all teams that cooperate with visibility
-	for (int cur_team = 0; cur_team < MAX_IFFS; cur_team++)
+	for (auto ship_num : Team_visibility_listed)
 	{
-		// set up current team
-		cur_count = team_count[cur_team];
-		cur_team_ships = team_ships[cur_team];
+		shipp = &Ships[ship_num];
+		object *target = &Objects[shipp->objnum];
 
-		// short circuit if team has no presence
-		if (cur_count == 0)
-			continue;	// Goober5000 10/06/2005 changed from break; probably a bug
+		int stealth_ship = (shipp->flags[Ship::Ship_Flags::Stealth]);
+		bool tagged = (shipp->tag_left > 0.0f || shipp->level2_tag_left > 0.0f);
 
+		// how far away a ship may be and still see the target, if nothing else limits it
+		bool unlimited = false;
+		float reach = -1.0f;
+		if (tagged || (!stealth_ship && !nebula_enabled))
+		{
+			if (Hud_max_targeting_range > 0)
+				reach = (float) (Hud_max_targeting_range + 1);
+			else
+				unlimited = true;
+		}
+		else if (!stealth_ship)
+		{
+			reach = max_half_scan_range;
 
-		// check against all enemy teams
-		for (int en_team = 0; en_team < MAX_IFFS; en_team++)
+			// huge ships check the viewer against their bounding box instead of their center
+			auto sip = &Ship_info[shipp->ship_info_index];
+			if (sip->is_huge_ship())
+			{
+				polymodel *pm = model_get(sip->model_num);
+
+				vec3d extent;
+				for (int i = 0; i < 3; i++)
+					extent.a1d[i] = MAX(fl_abs(pm->mins.a1d[i]), fl_abs(pm->maxs.a1d[i]));
+
+				reach = vm_vec_mag(&extent) + reach * 1.7321f;
+			}
+
+			if (Hud_max_targeting_range > 0)
+				reach = MIN(reach, (float) (Hud_max_targeting_range + 1));
+		}
+		// a stealth ship which is not tagged can only be seen through AWACS
+
+		int teams_left = 0;
+		for (team = 0; team < MAX_IFFS; team++)
 		{
-			// NOTE: we no longer skip our own team because we must adjust visibility for friendly-stealth-invisible ships
-			// if (en_team == cur_team)
-			//	continue;
+			auto& team_ships = Team_visibility_ships[team];
+			auto& visible = Ship_visibility_by_team[team][ship_num];
 
-			// set up enemy team
-			en_count = team_count[en_team];
-			en_team_ships = team_ships[en_team];
+			visible = (team == shipp->team) ? 1 : 0;
+			if (visible || team_ships.empty())
+				continue;
 
-			// check if current team can see enemy team's ships
-			for (en_idx = 0; en_idx < en_count; en_idx++)
+			if (team_visibility_viewer_sees(target, team_ships.front()))
+				visible = 1;
+			else if ((player_num >= 0) && (Ships[player_num].team == team) && team_visibility_viewer_sees(target, player_num))
+				visible = 1;
+			else if (unlimited || (reach >= 0.0f && !use_grid))
 			{
-				// for each ship on other team
-				for (idx = 0; idx < cur_count; idx++)
+				for (auto viewer_num : team_ships)
 				{
-					// ignore nav buoys and cargo containers
-                    if (Ship_info[Ships[cur_team_ships[idx]].ship_info_index].flags[Ship::Info_Flags::Cargo] || Ship_info[Ships[cur_team_ships[idx]].ship_info_index].flags[Ship::Info_Flags::Navbuoy])
+					if (team_visibility_viewer_sees(target, viewer_num))
 					{
-						continue;
-					}
-
-					// check against each ship on my team (and AWACS only once)
-					if (awacs_get_level(&Objects[Ships[en_team_ships[en_idx]].objnum], &Ships[cur_team_ships[idx]], (idx == 0)) > 1.0f)
-					{
-						Ship_visibility_by_team[cur_team][en_team_ships[en_idx]] = 1;
+						visible = 1;
 						break;
 					}
 				}
 			}
+
+			if (!visible)
+				teams_left++;
 		}
+
+		if (teams_left == 0 || unlimited || reach < 0.0f || !use_grid)
+			continue;
+
+		obj_grid_query_sphere(&target->pos, reach, OBJ_GRID_TYPE_MASK(OBJ_SHIP), [&](int objnum) {
+			if (teams_left == 0 || Objects[objnum].type != OBJ_SHIP || Objects[objnum].instance < 0)
+				return;
+
+			int viewer_num = Objects[objnum].instance;
+			auto& visible = Ship_visibility_by_team[Ships[viewer_num].team][ship_num];
+
+			if (!visible && team_visibility_viewer_sees(target, viewer_num))
+			{
+				visible = 1;
+				teams_left--;
+			}
+		});
 	}
 }
 
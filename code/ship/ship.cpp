@@ -86,6 +86,7 @@
 #include "weapon/weapon.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/NameIndex.h"
 #include "ship.h"
 
 
@@ -125,6 +126,11 @@ int	Num_wings = 0;
 int	Num_reinforcements = 0;
 ship	Ships[MAX_SHIPS];
 
+// Case-insensitive name indices for ship_name_lookup() and the wing lookups.  These are only used in the game since
+// the editors write to ship and wing names directly in too many places to keep them up to date.
+static util::NameIndex<int> Ship_name_index;
+static util::NameIndex<int> Wing_name_index;
+
 ship	*Player_ship;
 int		*Player_cockpit_textures;
 SCP_vector<cockpit_display> Player_displays;
@@ -5341,8 +5347,10 @@ void ship_level_init()
 		Ships[i].ship_name[0] = '\0';
 		Ships[i].objnum = -1;
 	}
+	Ship_name_index.clear();
 
 	Num_wings = 0;
+	Wing_name_index.clear();
 	for (i = 0; i < MAX_WINGS; i++ )
 	{
 		Wings[i].num_waves = -1;
@@ -6322,6 +6330,7 @@ void ship_subsys::clear()
 	favor_current_facing = 0.0f;
 	targeted_subsys = NULL;
 	scripting_target_override = false;
+	turret_target_eval = -1;
 	last_fired_weapon_info_index = -1;
 
 	turret_pick_big_attack_point_timestamp = timestamp(0);
@@ -7075,6 +7084,8 @@ void ship_delete( object * obj )
 	ship_subsystems_delete(&Ships[num]);
 	shipp->objnum = -1;
 
+	Ship_name_index.remove(shipp->ship_name, num);
+
 	if (shipp->shield_integrity != NULL) {
 		vm_free(shipp->shield_integrity);
 		shipp->shield_integrity = NULL;
@@ -9315,6 +9326,8 @@ int ship_create(matrix* orient, vec3d* pos, int ship_type, const char* ship_name
 	ship_set_default_weapons(shipp, sip);	//	Moved up here because ship_set requires that weapon info be valid.  MK, 4/28/98
 	ship_set(n, objnum, ship_type);
 
+	Ship_name_index.add(shipp->ship_name, n);
+
 	init_ai_object(objnum);
 	ai_clear_ship_goals( &Ai_info[Ships[n].ai_index] );		// only do this one here.  Can't do it in init_ai because it might wipe out goals in mission file
 
@@ -12441,28 +12454,29 @@ void wing_bash_ship_name(char *ship_name, const char *wing_name, int index)
  */
 int wing_name_lookup(const char *name, int ignore_count)
 {
-	int i, wing_limit;
+	int i;
 
 	if (name == NULL)
 		return -1;
 
-	if ( Fred_running )
-		wing_limit = MAX_WINGS;
-	else
-		wing_limit = Num_wings;
-
-	if (Fred_running || ignore_count ) {  // current_count not used for Fred..
-		for (i=0; i<wing_limit; i++)
+	if ( Fred_running ) {
+		// current_count not used for Fred..
+		for (i=0; i<MAX_WINGS; i++)
 			if (Wings[i].wave_count && !stricmp(Wings[i].name, name))
 				return i;
 
-	} else {
-		for (i=0; i<wing_limit; i++)
-			if (Wings[i].current_count && !stricmp(Wings[i].name, name))
-				return i;
+		return -1;
 	}
 
-	return -1;
+	return Wing_name_index.find(name, [&](int wingnum) {
+		if (wingnum >= Num_wings)
+			return false;
+
+		if (ignore_count ? !Wings[wingnum].wave_count : !Wings[wingnum].current_count)
+			return false;
+
+		return !stricmp(Wings[wingnum].name, name);
+	}, -1);
 }
 
 /**
@@ -12472,6 +12486,13 @@ int wing_name_lookup(const char *name, int ignore_count)
 int wing_lookup(const char *name)
 {
    int idx;
+
+	if (!Fred_running) {
+		return Wing_name_index.find(name, [&](int wingnum) {
+			return wingnum < Num_wings && !stricmp(Wings[wingnum].name, name);
+		}, -1);
+	}
+
 	for(idx=0;idx<Num_wings;idx++)
 		if(stricmp(Wings[idx].name,name)==0)
 		   return idx;
@@ -12479,6 +12500,37 @@ int wing_lookup(const char *name)
 	return -1;
 }
 
+/**
+ * Adds a wing which has just been set up to the wing name index
+ */
+void wing_name_index_add(int wingnum)
+{
+	Assert((wingnum >= 0) && (wingnum < MAX_WINGS));
+
+	Wing_name_index.add(Wings[wingnum].name, wingnum);
+}
+
+void wing_name_index_clear()
+{
+	Wing_name_index.clear();
+}
+
+/**
+ * Renames a wing and keeps the wing name index up to date
+ */
+void wing_set_name(int wingnum, const char *name)
+{
+	Assert((wingnum >= 0) && (wingnum < MAX_WINGS));
+	Assert(name != NULL);
+
+	Wing_name_index.remove(Wings[wingnum].name, wingnum);
+
+	strncpy(Wings[wingnum].name, name, NAME_LENGTH - 1);
+	Wings[wingnum].name[NAME_LENGTH - 1] = '\0';
+
+	Wing_name_index.add(Wings[wingnum].name, wingnum);
+}
+
 /**
  * Return the index of Ship_info[].name that is *token.
  */
@@ -12633,6 +12685,18 @@ int ship_info_lookup(const char *token)
 /**
  * Return the ship index of the ship with name *name.
  */
+static bool ship_name_matches(int shipnum, const char *name, int inc_players)
+{
+	if (Ships[shipnum].objnum < 0)
+		return false;
+
+	auto type = Objects[Ships[shipnum].objnum].type;
+	if (type != OBJ_SHIP && !(type == OBJ_START && inc_players))
+		return false;
+
+	return !stricmp(name, Ships[shipnum].ship_name);
+}
+
 int ship_name_lookup(const char *name, int inc_players)
 {
 	int	i;
@@ -12642,13 +12706,13 @@ int ship_name_lookup(const char *name, int inc_players)
 		return -1;
 	}
 
+	if (!Fred_running) {
+		return Ship_name_index.find(name, [&](int shipnum) { return ship_name_matches(shipnum, name, inc_players); }, -1);
+	}
+
 	for (i=0; i<MAX_SHIPS; i++){
-		if (Ships[i].objnum >= 0){
-			if (Objects[Ships[i].objnum].type == OBJ_SHIP || (Objects[Ships[i].objnum].type == OBJ_START && inc_players)){
-				if (!stricmp(name, Ships[i].ship_name)){
-					return i;
-				}
-			}
+		if (ship_name_matches(i, name, inc_players)){
+			return i;
 		}
 	}
 	
@@ -12656,6 +12720,35 @@ int ship_name_lookup(const char *name, int inc_players)
 	return -1;
 }
 
+/**
+ * Returns a counter which changes whenever a ship is created, deleted or renamed, i.e. whenever a result of
+ * ship_name_lookup() may have changed.  Never 0.
+ */
+uint32_t ship_name_lookup_generation()
+{
+	return Ship_name_index.generation();
+}
+
+/**
+ * Renames a ship and keeps the ship name index up to date
+ */
+void ship_set_name(ship *shipp, const char *name)
+{
+	Assert(shipp != NULL);
+	Assert(name != NULL);
+
+	auto shipnum = SHIP_INDEX(shipp);
+
+	Ship_name_index.remove(shipp->ship_name, shipnum);
+
+	strncpy(shipp->ship_name, name, NAME_LENGTH - 1);
+	shipp->ship_name[NAME_LENGTH - 1] = '\0';
+
+	if (shipp->objnum >= 0) {
+		Ship_name_index.add(shipp->ship_name, shipnum);
+	}
+}
+
 int ship_type_name_lookup(const char *name)
 {
 	// bogus
@@ -322,6 +322,7 @@ public:
 	float	favor_current_facing;					        
 	ship_subsys	*targeted_subsys;					//	subsystem this turret is attacking
 	bool	scripting_target_override;
+	int		turret_target_eval;					//	entry in the turret targeting batch, see ai_turret_evaluate_targets()
 	int		last_fired_weapon_info_index;		// which weapon class was last fired
 
 	int		turret_pick_big_attack_point_timestamp;	//	Next time to pick an attack point for this turret
@@ -1422,10 +1423,17 @@ extern int get_subsystem_pos(vec3d *pos, object *objp, ship_subsys *subsysp);
 
 extern int ship_info_lookup(const char *name = NULL);
 extern int ship_name_lookup(const char *name, int inc_players = 0);	// returns the index into Ship array of name
+extern void ship_set_name(ship *shipp, const char *name);			// use this instead of writing to ship_name directly
+extern uint32_t ship_name_lookup_generation();						// changes whenever ship_name_lookup() results may change
 extern int ship_type_name_lookup(const char *name);
 
 extern int wing_lookup(const char *name);
 
+// keep the wing name index used by the lookups above up to date
+extern void wing_name_index_add(int wingnum);
+extern void wing_name_index_clear();
+extern void wing_set_name(int wingnum, const char *name);
+
 // returns 0 if no conflict, 1 if conflict, -1 on some kind of error with wing struct
 extern int wing_has_conflicting_teams(int wing_index);
 
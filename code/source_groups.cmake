@@ -720,6 +720,8 @@ add_file_folder("Model"
 	model/model.h
 	model/modelanim.cpp
 	model/modelanim.h
+	model/modelcache.cpp
+	model/modelcache.h
 	model/modelcollide.cpp
 	model/modelinterp.cpp
 	model/modeloctant.cpp
@@ -754,6 +756,8 @@ add_file_folder("Network"
 	network/multi_endgame.h
 	network/multi_ingame.cpp
 	network/multi_ingame.h
+	network/multi_interest.cpp
+	network/multi_interest.h
 	network/multi_kick.cpp
 	network/multi_kick.h
 	network/multi_log.cpp
@@ -830,6 +834,8 @@ add_file_folder("Object"
 	object/object.h
 	object/objectdock.cpp
 	object/objectdock.h
+	object/objectgrid.cpp
+	object/objectgrid.h
 	object/objectshield.cpp
 	object/objectshield.h
 	object/objectsnd.cpp
@@ -1301,7 +1307,11 @@ add_file_folder("Utils"
 	utils/HeapAllocator.cpp
 	utils/HeapAllocator.h
 	utils/id.h
+	utils/JobSystem.cpp
+	utils/JobSystem.h
+	utils/NameIndex.h
 	utils/RandomRange.h
+	utils/SPSCQueue.h
 	utils/string_utils.cpp
 	utils/string_utils.h
 	utils/strings.h
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <type_traits>
 
 #include "tracing/categories.h"
@@ -24,18 +25,32 @@ class MonitorBase {
 	MonitorBase& operator=(MonitorBase&&) = delete;
 };
 
+/**
+ * @brief A value which is reported to the tracing system whenever it changes
+ *
+ * Monitors may be changed from jobs running on other threads so the value is atomic. The reported values are the ones
+ * each change produced but with multiple threads they may arrive out of order.
+ */
 template<typename T>
 class Monitor: public MonitorBase {
-	T _value;
+	std::atomic<T> _value;
 
 	static_assert(std::is_convertible<T, float>::value, "Monitor values must be convertible to float!");
+
+	T add(const T& val) {
+		// std::atomic only has fetch_add for integral types so do it by hand
+		T old_val = _value.load(std::memory_order_relaxed);
+		while (!_value.compare_exchange_weak(old_val, old_val + val, std::memory_order_relaxed)) {
+		}
+		return old_val + val;
+	}
  public:
 	Monitor(const char* name, const T& defaultVal) : MonitorBase(name), _value(defaultVal) {
 	}
 
 	void changeValue(const T& val) {
-		_value = val;
-		valueChanged(_value);
+		_value.store(val, std::memory_order_relaxed);
+		valueChanged((float)val);
 	}
 
 	Monitor<T>& operator=(const T& val) {
@@ -44,15 +59,13 @@ class Monitor: public MonitorBase {
 	}
 
 	Monitor<T>& operator+=(const T& val) {
-		_value += val;
-		valueChanged((float)_value);
+		valueChanged((float)add(val));
 
 		return *this;
 	}
 
 	Monitor<T>& operator-=(const T& val) {
-		_value -= val;
-		valueChanged((float)_value);
+		valueChanged((float)add(-val));
 
 		return *this;
 	}
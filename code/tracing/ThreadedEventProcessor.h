@@ -3,8 +3,12 @@
 #include "globalincs/pstypes.h"
 #include "tracing/tracing.h"
 
-#include "utils/boost/syncboundedqueue.h"
+#include "utils/SPSCQueue.h"
 
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <mutex>
 #include <thread>
 
 
@@ -26,51 +30,140 @@ namespace tracing {
  *
  * This function will be called in a background-thread whenever a new event arrives.
  *
+ * Every thread which submits events gets a lock-free buffer of its own which the background thread drains in batches.
+ * Submitting an event never waits. If a buffer is full the event is dropped and counted instead, see droppedEvents().
+ * Events of one thread are processed in the order they were submitted, there is no order between threads.
+ *
  * @tparam Processor Your processor implementation
- * @tparam QUEUE_SIZE The maximum size of the internal event buffer
+ * @tparam BUFFER_SIZE The number of events each thread can have in flight
  */
-template<class Processor, size_t QUEUE_SIZE = 200>
+template<class Processor, size_t BUFFER_SIZE = 4096>
 class ThreadedEventProcessor {
-	sync_bounded_queue<trace_event> _event_queue;
+	struct thread_buffer {
+		util::SPSCQueue<trace_event> events;
+		std::atomic<std::uint64_t> dropped;
 
-	std::thread _worker_thread;
+		thread_buffer() : events(BUFFER_SIZE), dropped(0) {}
+	};
+
+	// Threads beyond this do not get a buffer and all their events are dropped
+	static const size_t MAX_THREADS = 64;
+
+	// The number of events taken from one buffer before the next buffer gets a turn
+	static const size_t DRAIN_BATCH_SIZE = 256;
 
 	Processor _processor;
 
+	// Only taken the first time a thread submits an event
+	std::mutex _register_lock;
+	std::unique_ptr<thread_buffer> _buffers[MAX_THREADS];
+	std::atomic<size_t> _num_buffers;
+	std::atomic<std::uint64_t> _unbuffered_dropped;
+
+	// Tells the buffers of this processor apart from those of an earlier processor of the same type
+	std::uint64_t _id;
+
+	std::atomic<bool> _stopping;
+	std::thread _worker_thread;
+
+	static std::uint64_t nextId() {
+		static std::atomic<std::uint64_t> id(0);
+		return ++id;
+	}
+
+	thread_buffer* getBuffer() {
+		static thread_local std::uint64_t cached_id = 0;
+		static thread_local thread_buffer* cached_buffer = nullptr;
+
+		if (cached_id == _id) {
+			return cached_buffer;
+		}
+
+		std::lock_guard<std::mutex> guard(_register_lock);
+
+		thread_buffer* buffer = nullptr;
+		auto count = _num_buffers.load(std::memory_order_relaxed);
+		if (count < MAX_THREADS) {
+			_buffers[count].reset(new thread_buffer());
+			buffer = _buffers[count].get();
+
+			// The worker only looks at buffers below this count so the buffer must be complete before it is published
+			_num_buffers.store(count + 1, std::memory_order_release);
+		}
+
+		cached_id = _id;
+		cached_buffer = buffer;
+		return buffer;
+	}
+
+	size_t drain() {
+		size_t processed = 0;
+
+		auto count = _num_buffers.load(std::memory_order_acquire);
+		for (size_t i = 0; i < count; ++i) {
+			processed += _buffers[i]->events.pop_batch([this](const trace_event& evt) { _processor.processEvent(&evt); },
+			                                           DRAIN_BATCH_SIZE);
+		}
+
+		return processed;
+	}
+
 	void workerThread() {
-		while (!_event_queue.closed()) {
-			try {
-				trace_event evt;
-				auto status = _event_queue.wait_pull_front(evt);
+		while (true) {
+			// Checked before draining so that everything submitted before the destructor was called gets processed
+			auto stopping = _stopping.load(std::memory_order_acquire);
+
+			auto processed = drain();
 
-				if (status != success) {
+			if (processed == 0) {
+				if (stopping) {
 					break;
 				}
 
-				_processor.processEvent(&evt);
-			}
-			catch (const sync_queue_is_closed&) {
-				// We are done here
-				break;
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
 			}
 		}
 	}
  public:
 	template<typename... Params>
 	explicit ThreadedEventProcessor(Params&& ... params)
-		: _event_queue(QUEUE_SIZE), _worker_thread(&ThreadedEventProcessor<Processor>::workerThread, this),
-		  _processor(std::forward<Params>(params)...) {}
+		: _processor(std::forward<Params>(params)...), _num_buffers(0), _unbuffered_dropped(0), _id(nextId()),
+		  _stopping(false), _worker_thread(&ThreadedEventProcessor<Processor, BUFFER_SIZE>::workerThread, this) {}
 	~ThreadedEventProcessor() {
-		_event_queue.close();
+		_stopping.store(true, std::memory_order_release);
 		_worker_thread.join();
+
+		auto dropped = droppedEvents();
+		if (dropped > 0) {
+			mprintf(("Tracing: %" PRIu64 " events were dropped because their buffer was full.\n", dropped));
+		}
 	}
 
 	void processEvent(const trace_event* event) {
-		try {
-			_event_queue.wait_push_back(*event);
-		} catch (const sync_queue_is_closed&) {
-			mprintf(("Stream queue was closed in processEvent! This should not be possible..."));
+		auto buffer = getBuffer();
+
+		if (buffer == nullptr) {
+			_unbuffered_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
 		}
+
+		if (!buffer->events.try_push(*event)) {
+			buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * @brief Gets the number of events which were dropped because their buffer was full
+	 */
+	std::uint64_t droppedEvents() const {
+		auto dropped = _unbuffered_dropped.load(std::memory_order_relaxed);
+
+		auto count = _num_buffers.load(std::memory_order_acquire);
+		for (size_t i = 0; i < count; ++i) {
+			dropped += _buffers[i]->dropped.load(std::memory_order_relaxed);
+		}
+
+		return dropped;
 	}
 };
 
@@ -23,6 +23,8 @@ const char* getTypeStr(tracing::EventType type) {
 			return "e";
 		case EventType::Counter:
 			return "C";
+		case EventType::Metadata:
+			return "M";
 		default: 
 			UNREACHABLE("Invalid enum value!");
 			return "";
@@ -71,6 +73,16 @@ void TraceEventWriter::processEvent(const trace_event* event) {
 	if (!_first_line) {
 		_out << ",";
 	}
+
+	if (event->type == EventType::Metadata) {
+		// Currently only used for naming threads
+		_out << "\n{\"tid\": " << event->tid << ",\"pid\":" << event->pid << ",\"name\":\"thread_name\",\"ph\":\"M\"";
+		_out << ",\"args\": {\"name\": \"" << event->thread_name << "\"}}";
+
+		_first_line = false;
+		return;
+	}
+
 	_out << "\n{\"tid\": " << event->tid << ",\"ts\":";
 
 	writeTime(_out, event->timestamp);
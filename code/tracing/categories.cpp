@@ -35,6 +35,12 @@ Category LoadBatchingBuffers("Load batching buffers", true);
 Category SortColliders("Sort Colliders", false);
 Category FindOverlapColliders("Find overlap colliders", false);
 Category CollidePair("Collide Pair", false);
+Category CollideGeometry("Collide geometry", false);
+Category TurretTargetEvaluate("Turret target evaluate", false);
+Category CollideGeometryJob("Collide geometry job", false);
+Category TurretTargetEvaluateJob("Turret target evaluate job", false);
+Category PhysicsJob("Physics job", false);
+Category BitmapDecodeJob("Bitmap decode job", false);
 
 Category WeaponPostMove("Weapon post move", false);
 Category ShipPostMove("Ship post move", false);
@@ -78,6 +84,7 @@ Category BuildShadowMap("Build Shadow Map", true);
 Category RenderScene("Render scene", true);
 Category RenderTrails("Render trails", true);
 Category MoveObjects("Move Objects", false);
+Category ObjectGridRebuild("Object grid rebuild", false);
 Category ProcessParticleEffects("Process particle effects", false);
 Category TrailsMoveAll("Trails move all", false);
 Category Simulation("Simulation", false);
@@ -89,6 +96,8 @@ Category RenderTargettingBracket("Render Target bracket", true);
 Category RenderNavBracket("Render Nav bracket", true);
 Category MainFrame("Main Frame", true);
 Category PageFlip("Page flip", true);
+Category TraceEventsDropped("Dropped trace events", false);
+Category TraceBenchmark("Trace benchmark", false);
 
 Category NanoVGFlushFrame("NanoVG flush frame", true);
 Category NanoVGDrawFill("NanoVG Draw fill", true);
@@ -118,6 +127,8 @@ Category ModelParseBSPTree("Parse BSP tree", false);
 Category ModelConfigureVertexBuffers("Model configure vertex buffers", false);
 Category ModelCreateTransparencyIndexBuffer("Model create transparency buffer", false);
 Category ModelCreateDetailIndexBuffers("Model create detail index buffers", false);
+Category ModelCacheRestore("Restore model from cache", false);
+Category ModelCacheStore("Store model in cache", false);
 
 Category PreloadMissionSounds("Preload mission sounds", false);
 Category LoadSound("Load Sound", false);
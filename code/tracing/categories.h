@@ -47,6 +47,12 @@ extern Category LoadBatchingBuffers;
 extern Category SortColliders;
 extern Category FindOverlapColliders;
 extern Category CollidePair;
+extern Category CollideGeometry;
+extern Category TurretTargetEvaluate;
+extern Category CollideGeometryJob;
+extern Category TurretTargetEvaluateJob;
+extern Category PhysicsJob;
+extern Category BitmapDecodeJob;
 
 extern Category WeaponPostMove;
 extern Category ShipPostMove;
@@ -90,6 +96,7 @@ extern Category BuildShadowMap;
 extern Category RenderScene;
 extern Category RenderTrails;
 extern Category MoveObjects;
+extern Category ObjectGridRebuild;
 extern Category ProcessParticleEffects;
 extern Category TrailsMoveAll;
 extern Category Simulation;
@@ -101,6 +108,8 @@ extern Category RenderTargettingBracket;
 extern Category RenderNavBracket;
 extern Category MainFrame;
 extern Category PageFlip;
+extern Category TraceEventsDropped;
+extern Category TraceBenchmark;
 
 extern Category NanoVGFlushFrame;
 extern Category NanoVGDrawFill;
@@ -131,6 +140,8 @@ extern Category ModelParseBSPTree;
 extern Category ModelConfigureVertexBuffers;
 extern Category ModelCreateTransparencyIndexBuffer;
 extern Category ModelCreateDetailIndexBuffers;
+extern Category ModelCacheRestore;
+extern Category ModelCacheStore;
 
 extern Category PreloadMissionSounds;
 extern Category LoadSound;
@@ -1,5 +1,6 @@
 
 #include "tracing/tracing.h"
+#include "debugconsole/console.h"
 #include "graphics/2d.h"
 #include "parse/parselo.h"
 #include "io/timer.h"
@@ -8,6 +9,7 @@
 #include "MainFrameTimer.h"
 #include "FrameProfiler.h"
 
+#include <atomic>
 #include <cinttypes>
 #include <fstream>
 #include <future>
@@ -18,18 +20,18 @@
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 
-static int64_t get_tid() {
+static int64_t query_tid() {
     return (int64_t) GetCurrentThreadId();
 }
 #elif __LINUX__
 #include <sys/syscall.h>
-static int64_t get_tid() {
+static int64_t query_tid() {
 	return (int64_t) syscall(SYS_gettid);
 }
 #else
 #include <pthread.h>
 
-static int64_t get_tid() {
+static int64_t query_tid() {
 // This is not a reliable way of getting the tid but it's better than nothing
     return (int64_t) pthread_self();
 }
@@ -37,17 +39,28 @@ static int64_t get_tid() {
 
 // A function for getting the id of the current process
 #ifdef WIN32
-static int64_t get_pid() {
+static int64_t query_pid() {
     return (int64_t)GetCurrentProcessId();
 }
 #else
 #include <unistd.h>
 
-static int64_t get_pid() {
+static int64_t query_pid() {
 	return (int64_t) getpid();
 }
 #endif
 
+// Every event needs both ids and asking for them is a system call on some platforms, so that is only done once
+static int64_t get_tid() {
+	static thread_local int64_t tid = query_tid();
+	return tid;
+}
+
+static int64_t get_pid() {
+	static const int64_t pid = query_pid();
+	return pid;
+}
+
 namespace {
 
 using namespace tracing;
@@ -102,11 +115,15 @@ bool do_async_events = false;
 bool do_counter_events = false;
 std::int64_t main_thread_id = -1;
 
+// The drop count which was last written as a counter event
+std::uint64_t last_dropped_events = 0;
+
 int gpu_start_query = -1;
 std::uint64_t gpu_start_time = 0;
 std::uint64_t cpu_start_time = 0;
 
-std::uint64_t current_id = 0;
+// Events may be generated by multiple threads
+std::atomic<std::uint64_t> current_id(0);
 
 void submit_event(trace_event* evt) {
 	if (evt->pid == GPU_PID) {
@@ -124,7 +141,8 @@ void submit_event(trace_event* evt) {
 		mainFrameTimer->processEvent(evt);
 	}
 
-	if (frameProfiler) {
+	// The frame profiler is not thread-safe and only looks at the main thread anyway
+	if (frameProfiler && evt->tid == main_thread_id) {
 		frameProfiler->processEvent(evt);
 	}
 }
@@ -238,6 +256,7 @@ void init() {
 	cpu_start_time = timer_get_nanoseconds();
 
 	main_thread_id = get_tid();
+	last_dropped_events = 0;
 
 	initialized = true;
 }
@@ -247,6 +266,26 @@ void process_events() {
 		// Process pending GPU events
 		process_gpu_events();
 	}
+
+	// Makes gaps in the trace visible next to the other counters
+	auto dropped = dropped_events();
+	if (dropped != last_dropped_events) {
+		last_dropped_events = dropped;
+		counter::value(TraceEventsDropped, (float)dropped);
+	}
+}
+
+std::uint64_t dropped_events() {
+	std::uint64_t dropped = 0;
+
+	if (traceEventWriter) {
+		dropped += traceEventWriter->droppedEvents();
+	}
+	if (mainFrameTimer) {
+		dropped += mainFrameTimer->droppedEvents();
+	}
+
+	return dropped;
 }
 void frame_profile_process_frame() {
 	Assertion(frameProfiler, "Frame profiling must be enabled for this function!");
@@ -279,6 +318,21 @@ void shutdown() {
 	initialized = false;
 }
 
+void set_thread_name(const char* name) {
+	if (!initialized || !traceEventWriter) {
+		return;
+	}
+
+	trace_event evt;
+	evt.type = EventType::Metadata;
+	evt.pid = get_pid();
+	evt.tid = get_tid();
+	evt.thread_name = name;
+
+	// Only the trace event writer knows what to do with this
+	traceEventWriter->processEvent(&evt);
+}
+
 namespace complete {
 
 void start(const Category& category, trace_event* evt) {
@@ -419,3 +473,48 @@ void value(const Category& category, float value) {
 }
 
 }
+
+DCF(trace_bench, "Measures what a traced scope costs the thread it runs on")
+{
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Usage: trace_bench\n");
+		dc_printf("Runs empty traced scopes on this thread and prints the cost of one scope with the current tracing\n");
+		dc_printf("options, and how many of them fit into 1%% of a frame at 60 FPS.\n");
+		return;
+	}
+
+	// The scopes run in rounds which fit into the event buffer of the thread so that the common case is measured and
+	// not that of dropping events. The writer thread gets time to empty the buffer between rounds.
+	const int NUM_ROUNDS = 50;
+	const int SCOPES_PER_ROUND = 2000;
+
+	std::uint64_t dropped_before = tracing::dropped_events();
+	std::uint64_t empty_time = 0;
+	std::uint64_t scope_time = 0;
+
+	for (int round = 0; round < NUM_ROUNDS; ++round) {
+		auto start = timer_get_nanoseconds();
+		for (int i = 0; i < SCOPES_PER_ROUND; ++i) {
+			std::atomic_signal_fence(std::memory_order_seq_cst);
+		}
+		empty_time += timer_get_nanoseconds() - start;
+
+		start = timer_get_nanoseconds();
+		for (int i = 0; i < SCOPES_PER_ROUND; ++i) {
+			TRACE_SCOPE(tracing::TraceBenchmark);
+		}
+		scope_time += timer_get_nanoseconds() - start;
+
+		os_sleep(2);
+	}
+
+	const int num_scopes = NUM_ROUNDS * SCOPES_PER_ROUND;
+	double ns_per_scope = (double)((scope_time > empty_time) ? (scope_time - empty_time) : 0) / num_scopes;
+
+	dc_printf("Trace events are %s\n", (initialized && do_trace_events) ? "collected" : "not collected");
+	dc_printf("A traced scope costs %.1f ns on average, %" PRIu64 " of %d events were dropped\n", ns_per_scope,
+		tracing::dropped_events() - dropped_before, num_scopes);
+	if (ns_per_scope > 0.0) {
+		dc_printf("1%% of a frame at 60 FPS allows about %d traced scopes per frame\n", (int)(1000000000.0 / 60.0 / 100.0 / ns_per_scope));
+	}
+}
@@ -33,7 +33,9 @@ enum class EventType {
 
 	AsyncBegin, AsyncStep, AsyncEnd,
 
-	Counter
+	Counter,
+
+	Metadata
 };
 
 /**
@@ -54,6 +56,8 @@ struct trace_event {
 	std::int64_t pid = -1;
 
 	float value = -1.f;
+
+	const char* thread_name = nullptr;
 };
 
 /**
@@ -66,6 +70,11 @@ void init();
  */
 void process_events();
 
+/**
+ * @brief Gets the number of events which were dropped because they were submitted faster than they could be processed
+ */
+std::uint64_t dropped_events();
+
 void frame_profile_process_frame();
 
 /**
@@ -79,6 +88,13 @@ SCP_string get_frame_profile_output();
  */
 void shutdown();
 
+/**
+ * @brief Gives the calling thread a name in the trace output
+ *
+ * @param name The name of the thread, must stay valid until the tracing subsystem is shut down
+ */
+void set_thread_name(const char* name);
+
 namespace complete {
 /**
  * @brief Starts a complete event
@@ -0,0 +1,452 @@
+#include "utils/JobSystem.h"
+
+#include "tracing/tracing.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+using namespace util::jobs;
+
+struct job {
+	std::function<void()> fn;
+	JobCounter* counter = nullptr;
+};
+
+struct job_queue {
+	std::mutex lock;
+	SCP_deque<job> jobs;
+};
+
+bool initialized = false;
+
+// One queue per thread, index 0 belongs to the main thread
+SCP_vector<std::unique_ptr<job_queue>> queues;
+
+// The ids of the threads the queues belong to, used to find the queue of the calling thread
+SCP_vector<std::thread::id> thread_ids;
+
+SCP_vector<std::thread> worker_threads;
+
+// The tracing system keeps a pointer to the names so they have to live as long as the workers
+SCP_vector<SCP_string> thread_names;
+
+std::mutex main_thread_lock;
+SCP_deque<std::function<void()>> main_thread_jobs;
+
+// Idle workers sleep on this until there is something to do
+std::mutex sleep_lock;
+std::condition_variable sleep_cv;
+std::atomic<int> queued_jobs(0);
+std::atomic<bool> stopping(false);
+
+// Workers wait for this before they touch any queue so that they see all of thread_ids
+bool workers_released = false;
+
+// Returns the index of the queue of the calling thread, or -1 if the thread does not belong to the job system
+int current_index() {
+	auto id = std::this_thread::get_id();
+	for (size_t i = 0; i < thread_ids.size(); ++i) {
+		if (thread_ids[i] == id) {
+			return (int) i;
+		}
+	}
+	return -1;
+}
+
+void execute(job& j) {
+	j.fn();
+
+	if (j.counter != nullptr) {
+		j.counter->done();
+	}
+}
+
+bool pop_job(size_t index, bool steal, job& out) {
+	auto& queue = *queues[index];
+	std::lock_guard<std::mutex> guard(queue.lock);
+
+	if (queue.jobs.empty()) {
+		return false;
+	}
+
+	// The owner works on its newest job since its data is most likely still in the cache, thieves take the oldest one
+	if (steal) {
+		out = std::move(queue.jobs.front());
+		queue.jobs.pop_front();
+	} else {
+		out = std::move(queue.jobs.back());
+		queue.jobs.pop_back();
+	}
+
+	--queued_jobs;
+	return true;
+}
+
+bool run_main_thread_job() {
+	std::function<void()> fn;
+	{
+		std::lock_guard<std::mutex> guard(main_thread_lock);
+		if (main_thread_jobs.empty()) {
+			return false;
+		}
+		fn = std::move(main_thread_jobs.front());
+		main_thread_jobs.pop_front();
+	}
+
+	fn();
+	return true;
+}
+
+bool run_one_job(int index) {
+	if (index == 0 && run_main_thread_job()) {
+		return true;
+	}
+
+	job j;
+	if (index >= 0 && pop_job((size_t) index, false, j)) {
+		execute(j);
+		return true;
+	}
+
+	auto num_queues = queues.size();
+	auto start = index >= 0 ? (size_t) index + 1 : 0;
+	for (size_t i = 0; i < num_queues; ++i) {
+		auto victim = (start + i) % num_queues;
+		if ((int) victim == index) {
+			continue;
+		}
+
+		if (pop_job(victim, true, j)) {
+			execute(j);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void worker_thread(int index) {
+	tracing::set_thread_name(thread_names[index].c_str());
+
+	{
+		std::unique_lock<std::mutex> lock(sleep_lock);
+		sleep_cv.wait(lock, []() { return workers_released; });
+	}
+
+	while (true) {
+		if (run_one_job(index)) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleep_lock);
+		sleep_cv.wait(lock, []() { return stopping.load() || queued_jobs.load() > 0; });
+
+		if (stopping.load() && queued_jobs.load() <= 0) {
+			break;
+		}
+	}
+}
+
+void wake_worker() {
+	// Taking the lock makes sure that a worker which is about to go to sleep sees the new job
+	{
+		std::lock_guard<std::mutex> guard(sleep_lock);
+	}
+	sleep_cv.notify_one();
+}
+
+void run_traced(const tracing::Category* category, const std::function<void()>& fn) {
+	if (category != nullptr) {
+		TRACE_SCOPE(*category);
+		fn();
+	} else {
+		fn();
+	}
+}
+}
+
+namespace util {
+namespace jobs {
+
+void init(int num_workers) {
+	Assertion(!initialized, "The job system has already been initialized!");
+
+	if (num_workers < 0) {
+		num_workers = (int) std::thread::hardware_concurrency() - 1;
+	}
+	num_workers = MAX(num_workers, 0);
+
+	// Reserve everything first so that nothing moves around while the workers are running
+	queues.reserve(num_workers + 1);
+	thread_ids.reserve(num_workers + 1);
+	thread_names.reserve(num_workers + 1);
+
+	for (int i = 0; i <= num_workers; ++i) {
+		queues.emplace_back(new job_queue());
+		if (i == 0) {
+			thread_names.push_back("Main thread");
+		} else {
+			thread_names.push_back("Job worker " + std::to_string(i));
+		}
+	}
+
+	thread_ids.push_back(std::this_thread::get_id());
+	tracing::set_thread_name(thread_names[0].c_str());
+
+	stopping = false;
+	queued_jobs = 0;
+	workers_released = false;
+
+	// The ids of the workers are only known once they have been started so they get a placeholder first. The workers
+	// are held back until all of them are filled in since current_index() reads them without a lock.
+	thread_ids.resize(num_workers + 1);
+	for (int i = 1; i <= num_workers; ++i) {
+		worker_threads.emplace_back(worker_thread, i);
+		thread_ids[i] = worker_threads.back().get_id();
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(sleep_lock);
+		workers_released = true;
+	}
+	sleep_cv.notify_all();
+
+	mprintf(("Job system started with %d worker threads\n", num_workers));
+
+	initialized = true;
+}
+
+void shutdown() {
+	if (!initialized) {
+		return;
+	}
+
+	while (run_one_job(0)) {
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(sleep_lock);
+		stopping = true;
+	}
+	sleep_cv.notify_all();
+
+	for (auto& thread : worker_threads) {
+		thread.join();
+	}
+
+	worker_threads.clear();
+	queues.clear();
+	thread_ids.clear();
+	thread_names.clear();
+
+	initialized = false;
+}
+
+size_t num_threads() {
+	return initialized ? queues.size() : 1;
+}
+
+bool is_main_thread() {
+	return !initialized || thread_ids[0] == std::this_thread::get_id();
+}
+
+void process_main_thread_jobs() {
+	Assertion(is_main_thread(), "Main thread jobs may only be processed on the main thread!");
+
+	while (run_main_thread_job()) {
+	}
+}
+
+void run_on_main_thread(std::function<void()> fn) {
+	std::lock_guard<std::mutex> guard(main_thread_lock);
+	main_thread_jobs.push_back(std::move(fn));
+}
+
+void submit(std::function<void()> fn, JobCounter* counter) {
+	if (counter != nullptr) {
+		counter->add(1);
+	}
+
+	job j;
+	j.fn = std::move(fn);
+	j.counter = counter;
+
+	if (num_threads() <= 1) {
+		execute(j);
+		return;
+	}
+
+	// Jobs from threads that do not belong to the job system end up on the queue of the main thread
+	auto index = MAX(current_index(), 0);
+	{
+		auto& queue = *queues[index];
+		std::lock_guard<std::mutex> guard(queue.lock);
+		queue.jobs.push_back(std::move(j));
+		++queued_jobs;
+	}
+
+	wake_worker();
+}
+
+void wait(JobCounter* counter) {
+	auto index = current_index();
+
+	while (!counter->finished()) {
+		if (!initialized || !run_one_job(index)) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+TaskGraph::TaskId TaskGraph::add(std::function<void()> fn, const tracing::Category* category) {
+	task t;
+	t.fn = std::move(fn);
+	t.category = category;
+	_tasks.push_back(std::move(t));
+
+	return _tasks.size() - 1;
+}
+
+TaskGraph::TaskId TaskGraph::add_main_thread(std::function<void()> fn, const tracing::Category* category) {
+	auto id = add(std::move(fn), category);
+	_tasks[id].main_thread = true;
+
+	return id;
+}
+
+void TaskGraph::depends_on(TaskId task, TaskId dependency) {
+	Assertion(task < _tasks.size() && dependency < _tasks.size(), "Invalid task id!");
+	Assertion(task != dependency, "A task can not depend on itself!");
+
+	_tasks[dependency].successors.push_back(task);
+	++_tasks[task].num_dependencies;
+}
+
+SCP_vector<TaskGraph::TaskId> TaskGraph::topological_order() const {
+	// Kahn's algorithm, tasks that are part of a cycle never become ready
+	SCP_vector<int> remaining;
+	SCP_vector<TaskId> ready;
+	SCP_vector<TaskId> order;
+	remaining.reserve(_tasks.size());
+	order.reserve(_tasks.size());
+
+	for (TaskId i = 0; i < _tasks.size(); ++i) {
+		remaining.push_back(_tasks[i].num_dependencies);
+		if (_tasks[i].num_dependencies == 0) {
+			ready.push_back(i);
+		}
+	}
+
+	while (!ready.empty()) {
+		auto id = ready.back();
+		ready.pop_back();
+		order.push_back(id);
+
+		for (auto succ : _tasks[id].successors) {
+			if (--remaining[succ] == 0) {
+				ready.push_back(succ);
+			}
+		}
+	}
+
+	return order;
+}
+
+void TaskGraph::run() {
+	auto order = topological_order();
+	if (order.size() != _tasks.size()) {
+		Assertion(false, "The task graph contains a cycle!");
+		return;
+	}
+
+	if (num_threads() <= 1) {
+		for (auto id : order) {
+			run_traced(_tasks[id].category, _tasks[id].fn);
+		}
+		return;
+	}
+
+	bool has_main_thread_tasks = false;
+	for (auto& t : _tasks) {
+		has_main_thread_tasks = has_main_thread_tasks || t.main_thread;
+	}
+	Assertion(!has_main_thread_tasks || is_main_thread(),
+	          "A task graph with main thread tasks must be run from the main thread!");
+
+	std::unique_ptr<std::atomic<int>[]> remaining(new std::atomic<int>[_tasks.size()]);
+	for (size_t i = 0; i < _tasks.size(); ++i) {
+		remaining[i] = _tasks[i].num_dependencies;
+	}
+
+	JobCounter counter;
+	counter.add((int) _tasks.size());
+
+	std::function<void(TaskId)> schedule = [&](TaskId id) {
+		auto body = [&, id]() {
+			run_traced(_tasks[id].category, _tasks[id].fn);
+
+			for (auto succ : _tasks[id].successors) {
+				if (remaining[succ].fetch_sub(1) == 1) {
+					schedule(succ);
+				}
+			}
+
+			counter.done();
+		};
+
+		if (_tasks[id].main_thread) {
+			run_on_main_thread(body);
+		} else {
+			submit(body, nullptr);
+		}
+	};
+
+	for (TaskId i = 0; i < _tasks.size(); ++i) {
+		if (_tasks[i].num_dependencies == 0) {
+			schedule(i);
+		}
+	}
+
+	wait(&counter);
+}
+
+namespace detail {
+
+void parallel_for_impl(size_t begin, size_t end, size_t grain, const tracing::Category* category,
+                       const std::function<void(size_t, size_t)>& chunk) {
+	if (end <= begin) {
+		return;
+	}
+
+	auto count = end - begin;
+	auto threads = num_threads();
+	grain = MAX(grain, (size_t) 1);
+
+	if (threads <= 1 || count <= grain) {
+		run_traced(category, [&]() { chunk(begin, end); });
+		return;
+	}
+
+	// A few chunks per thread so that a thread which got the expensive part of the range does not hold up the others
+	auto num_chunks = MIN((count + grain - 1) / grain, threads * 4);
+	auto chunk_size = (count + num_chunks - 1) / num_chunks;
+
+	JobCounter counter;
+	for (auto start = begin + chunk_size; start < end; start += chunk_size) {
+		auto stop = MIN(start + chunk_size, end);
+		submit([&chunk, category, start, stop]() { run_traced(category, [&]() { chunk(start, stop); }); }, &counter);
+	}
+
+	// The calling thread does the first chunk itself instead of just waiting
+	run_traced(category, [&]() { chunk(begin, MIN(begin + chunk_size, end)); });
+
+	wait(&counter);
+}
+
+}
+
+}
+}
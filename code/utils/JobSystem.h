@@ -0,0 +1,179 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "tracing/categories.h"
+
+#include <atomic>
+#include <functional>
+
+/** @file
+ *  @brief A small work-stealing job system
+ *
+ * The job system owns a number of worker threads which execute jobs submitted by the game code. Every thread that
+ * takes part (the workers and the main thread) has its own queue. Jobs are pushed to the queue of the thread which
+ * submits them and idle threads steal from the queues of the others. A thread which waits for jobs to finish does not
+ * block but executes pending jobs in the meantime so nesting jobs is fine.
+ *
+ * The job system does not make any game code thread-safe. Only code which does not modify shared state (or which
+ * synchronizes itself) may be run in a job. The usual pattern is to split work into an evaluate phase which only reads
+ * game state and writes its results to a per-item buffer and a commit phase which applies those results on the main
+ * thread.
+ *
+ * If the job system is not initialized or has no workers (see -job_threads) everything is executed on the calling
+ * thread so code using it does not need a separate serial path.
+ */
+
+namespace util {
+namespace jobs {
+
+/**
+ * @brief Starts the worker threads
+ *
+ * @param num_workers The number of worker threads to start in addition to the main thread. A negative value uses one
+ * less than the number of hardware threads.
+ */
+void init(int num_workers = -1);
+
+/**
+ * @brief Executes all remaining jobs and stops the worker threads
+ */
+void shutdown();
+
+/**
+ * @brief Gets the number of threads which execute jobs, including the main thread
+ */
+size_t num_threads();
+
+/**
+ * @brief Checks if the calling thread is the main thread, i.e. the one which called init()
+ */
+bool is_main_thread();
+
+/**
+ * @brief Runs the continuations queued with run_on_main_thread()
+ *
+ * Should be called regularly from the main loop. Continuations are also run while the main thread waits for jobs.
+ */
+void process_main_thread_jobs();
+
+/**
+ * @brief Queues a function which must be executed on the main thread
+ *
+ * This can be called from any thread. Use this from a job to hand results to code which is not thread-safe.
+ */
+void run_on_main_thread(std::function<void()> fn);
+
+/**
+ * @brief A counter of unfinished jobs
+ *
+ * Every job that is submitted with a counter increments it and decrements it again once it has been executed.
+ */
+class JobCounter {
+	std::atomic<int> _pending;
+
+ public:
+	JobCounter() : _pending(0) {}
+
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	void add(int count) { _pending.fetch_add(count, std::memory_order_relaxed); }
+
+	void done() { _pending.fetch_sub(1, std::memory_order_acq_rel); }
+
+	bool finished() const { return _pending.load(std::memory_order_acquire) == 0; }
+};
+
+/**
+ * @brief Submits a job
+ *
+ * @param fn The job
+ * @param counter If not @c nullptr this counter is incremented now and decremented once the job is done
+ */
+void submit(std::function<void()> fn, JobCounter* counter);
+
+/**
+ * @brief Waits until all jobs of a counter are done
+ *
+ * The calling thread executes other jobs while it waits. On the main thread that includes main-thread continuations.
+ */
+void wait(JobCounter* counter);
+
+/**
+ * @brief Calls @c fn for every index in [begin, end)
+ *
+ * The range is split into chunks of at least @c grain indices which are executed in parallel. The function returns
+ * once all indices have been processed. The order in which the indices are visited is not defined.
+ *
+ * @param begin The first index
+ * @param end One past the last index
+ * @param grain The smallest number of indices which are worth a job of their own
+ * @param category If not @c nullptr every chunk is traced with this category so that it shows up on its worker thread
+ * @param fn Called with every index
+ */
+template<typename Function>
+void parallel_for(size_t begin, size_t end, size_t grain, const tracing::Category* category, Function fn);
+
+/**
+ * @brief A set of tasks with dependencies between them
+ *
+ * The graph can be run as often as needed. A task is only started once all tasks it depends on are done. Tasks
+ * added with add_main_thread() are only executed on the main thread which makes them a safe place to apply the results
+ * of the other tasks.
+ */
+class TaskGraph {
+ public:
+	typedef size_t TaskId;
+
+	/**
+	 * @brief Adds a task which may run on any thread
+	 */
+	TaskId add(std::function<void()> fn, const tracing::Category* category = nullptr);
+
+	/**
+	 * @brief Adds a task which only runs on the main thread
+	 */
+	TaskId add_main_thread(std::function<void()> fn, const tracing::Category* category = nullptr);
+
+	/**
+	 * @brief Makes sure that @c task only starts after @c dependency is done
+	 */
+	void depends_on(TaskId task, TaskId dependency);
+
+	/**
+	 * @brief Executes all tasks and waits until they are done
+	 *
+	 * If the graph has main thread tasks this must be called from the main thread.
+	 */
+	void run();
+
+ private:
+	struct task {
+		std::function<void()> fn;
+		const tracing::Category* category = nullptr;
+		bool main_thread = false;
+		int num_dependencies = 0;
+		SCP_vector<TaskId> successors;
+	};
+
+	SCP_vector<task> _tasks;
+
+	SCP_vector<TaskId> topological_order() const;
+};
+
+namespace detail {
+void parallel_for_impl(size_t begin, size_t end, size_t grain, const tracing::Category* category,
+                       const std::function<void(size_t, size_t)>& chunk);
+}
+
+template<typename Function>
+void parallel_for(size_t begin, size_t end, size_t grain, const tracing::Category* category, Function fn) {
+	detail::parallel_for_impl(begin, end, grain, category, [&fn](size_t chunk_begin, size_t chunk_end) {
+		for (auto i = chunk_begin; i < chunk_end; ++i) {
+			fn(i);
+		}
+	});
+}
+
+}
+}
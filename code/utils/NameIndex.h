@@ -0,0 +1,142 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+
+namespace util {
+
+/**
+ * @brief A case-insensitive index from object names to handles
+ *
+ * This only stores a hash of the name so that a lookup does not need to allocate anything. As a consequence a lookup
+ * may produce candidates with a different name that happen to hash to the same value so the caller always has to
+ * verify the candidates. Usually that happens anyway since the caller also needs to check if the object is still valid.
+ *
+ * The index does not know when a name changes. Whoever owns the names is responsible for calling remove() with the old
+ * name and add() with the new one.
+ *
+ * @tparam T The handle type, e.g. an array index or a pointer into a list with stable nodes
+ */
+template<typename T>
+class NameIndex {
+	SCP_unordered_map<uint32_t, SCP_vector<T>> _buckets;
+
+	uint32_t _generation = 1;
+
+ public:
+	/**
+	 * @brief Computes the case-insensitive hash of a name
+	 * @param name The name
+	 * @return The hash value, equal for names which only differ in case
+	 */
+	static uint32_t hash(const char* name) {
+		// 32-bit FNV-1a of the lower case name
+		uint32_t hash = 2166136261u;
+		for (auto c = name; *c != '\0'; ++c) {
+			hash ^= (uint32_t) tolower((unsigned char) *c);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	/**
+	 * @brief Adds a handle under the specified name
+	 *
+	 * Handles with the same hash are kept in ascending order so that find() returns the lowest one first.
+	 *
+	 * @param name The name of the object
+	 * @param handle The handle of the object
+	 */
+	void add(const char* name, const T& handle) {
+		auto& bucket = _buckets[hash(name)];
+
+		auto iter = std::lower_bound(bucket.begin(), bucket.end(), handle, std::less<T>());
+		if (iter != bucket.end() && *iter == handle) {
+			// Already in the index
+			return;
+		}
+		bucket.insert(iter, handle);
+		++_generation;
+	}
+
+	/**
+	 * @brief Removes a handle from the index
+	 * @param name The name the handle was added with
+	 * @param handle The handle of the object
+	 * @return @c true if the handle was in the index, @c false otherwise
+	 */
+	bool remove(const char* name, const T& handle) {
+		auto bucket_iter = _buckets.find(hash(name));
+		if (bucket_iter == _buckets.end()) {
+			return false;
+		}
+
+		auto& bucket = bucket_iter->second;
+		auto iter = std::find(bucket.begin(), bucket.end(), handle);
+		if (iter == bucket.end()) {
+			return false;
+		}
+		bucket.erase(iter);
+
+		if (bucket.empty()) {
+			_buckets.erase(bucket_iter);
+		}
+		++_generation;
+		return true;
+	}
+
+	/**
+	 * @brief Removes all handles from the index
+	 */
+	void clear() {
+		_buckets.clear();
+		++_generation;
+	}
+
+	/**
+	 * @brief Looks up a name
+	 *
+	 * @param name The name to look for
+	 * @param accept Called for every candidate in ascending order. Must return @c true if the candidate really has the
+	 * requested name and is acceptable for the caller.
+	 * @param invalid The value to return if there is no acceptable candidate
+	 * @return The first accepted candidate or @c invalid
+	 */
+	template<typename Predicate>
+	T find(const char* name, Predicate accept, const T& invalid) const {
+		auto bucket_iter = _buckets.find(hash(name));
+		if (bucket_iter == _buckets.end()) {
+			return invalid;
+		}
+
+		for (auto& handle : bucket_iter->second) {
+			if (accept(handle)) {
+				return handle;
+			}
+		}
+
+		return invalid;
+	}
+
+	/**
+	 * @brief Gets a counter which changes every time a handle is added or removed
+	 *
+	 * Can be used to invalidate results of find() that were cached elsewhere. It starts at 1 so 0 can be used to mark
+	 * a cache as empty.
+	 */
+	uint32_t generation() const {
+		return _generation;
+	}
+
+	/**
+	 * @brief Gets the number of distinct name hashes in the index
+	 */
+	size_t size() const {
+		return _buckets.size();
+	}
+};
+
+}
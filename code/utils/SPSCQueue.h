@@ -0,0 +1,115 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <atomic>
+#include <memory>
+
+namespace util {
+
+/**
+ * @brief A bounded ring buffer for exactly one producer and one consumer thread
+ *
+ * Neither side takes a lock or waits for the other. If the buffer is full try_push() fails and the caller decides what
+ * to do with the item. The consumer takes items in batches so that it only has to synchronize once per batch.
+ *
+ * @tparam T The type of the items, must be copy-assignable and default-constructible
+ */
+template<typename T>
+class SPSCQueue {
+	// The indices of the two sides are kept in different cache lines so that they do not slow each other down
+	static const size_t CACHE_LINE_SIZE = 64;
+
+	std::unique_ptr<T[]> _items;
+	size_t _mask;
+
+	// Producer side
+	std::atomic<size_t> _tail;
+	size_t _cached_head = 0;
+	char _producer_padding[CACHE_LINE_SIZE];
+
+	// Consumer side
+	std::atomic<size_t> _head;
+	size_t _cached_tail = 0;
+	char _consumer_padding[CACHE_LINE_SIZE];
+
+	static size_t round_up_pow2(size_t value) {
+		size_t result = 1;
+		while (result < value) {
+			result <<= 1;
+		}
+		return result;
+	}
+
+ public:
+	/**
+	 * @param capacity The number of items the buffer can hold, rounded up to the next power of two
+	 */
+	explicit SPSCQueue(size_t capacity) : _tail(0), _head(0) {
+		auto size = round_up_pow2(MAX(capacity, (size_t)1));
+
+		_items.reset(new T[size]);
+		_mask = size - 1;
+	}
+
+	SPSCQueue(const SPSCQueue&) = delete;
+	SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+	size_t capacity() const { return _mask + 1; }
+
+	/**
+	 * @brief Adds an item, may only be called from the producer thread
+	 *
+	 * @return @c false if the buffer is full
+	 */
+	bool try_push(const T& item) {
+		auto tail = _tail.load(std::memory_order_relaxed);
+
+		// The consumer's index is only read again once the buffer looks full
+		if (tail - _cached_head > _mask) {
+			_cached_head = _head.load(std::memory_order_acquire);
+
+			if (tail - _cached_head > _mask) {
+				return false;
+			}
+		}
+
+		_items[tail & _mask] = item;
+		_tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/**
+	 * @brief Takes up to @c max_items items, may only be called from the consumer thread
+	 *
+	 * The slots of the items are only handed back to the producer once @c fn has been called for all of them.
+	 *
+	 * @param fn Called with every item in the order the items were pushed
+	 * @param max_items The most items to take at once
+	 * @return The number of items that were taken
+	 */
+	template<typename Function>
+	size_t pop_batch(Function fn, size_t max_items) {
+		auto head = _head.load(std::memory_order_relaxed);
+
+		if (head == _cached_tail) {
+			_cached_tail = _tail.load(std::memory_order_acquire);
+
+			if (head == _cached_tail) {
+				return 0;
+			}
+		}
+
+		auto count = MIN(_cached_tail - head, max_items);
+		for (size_t i = 0; i < count; ++i) {
+			fn(_items[(head + i) & _mask]);
+		}
+
+		_head.store(head + count, std::memory_order_release);
+
+		return count;
+	}
+};
+
+}
@@ -172,6 +172,7 @@
 #include "stats/stats.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/JobSystem.h"
 #include "weapon/beam.h"
 #include "weapon/emp.h"
 #include "weapon/flak.h"
@@ -1800,8 +1801,8 @@ void game_init()
 /////////////////////////////
 
 	std::unique_ptr<SDLGraphicsOperations> sdlGraphicsOperations;
-	if (!Is_standalone) {
-		// Standalone mode doesn't require graphics operations
+	if (!Is_standalone && !Cmdline_headless_benchmark) {
+		// Standalone mode and the headless benchmark don't require graphics operations
 		sdlGraphicsOperations.reset(new SDLGraphicsOperations());
 	}
 	if ( gr_init(std::move(sdlGraphicsOperations)) == false ) {
@@ -1819,6 +1820,9 @@ void game_init()
 	// This needs to happen after graphics initialization
 	tracing::init();
 
+	// After tracing so that the worker threads show up in the trace
+	util::jobs::init(Cmdline_job_threads);
+
 // Karajorma - Moved here from the sound init code cause otherwise windows complains
 #ifdef FS2_VOICER
 	if(Cmdline_voice_recognition)
@@ -1852,7 +1856,7 @@ void game_init()
 	font::init();					// loads up all fonts
 	
 	// add title screen
-	if(!Is_standalone){
+	if(!Is_standalone && !Cmdline_headless_benchmark){
 		// #Kazan# - moved this down - WATCH THESE calls - anything that shares code between standalone and normal
 		// cannot make gr_* calls in standalone mode because all gr_ calls are NULL pointers
 		gr_set_gamma(FreeSpace_gamma);
@@ -1936,7 +1940,7 @@ void game_init()
 	log_string(LOGFILE_EVENT_LOG,"FS2_Open Mission Log - Opened \n\n", 1);
 
 	// standalone's don't use the joystick and it seems to sometimes cause them to not get shutdown properly
-	if(!Is_standalone){
+	if(!Is_standalone && !Cmdline_headless_benchmark){
 		io::joystick::init();
 	}
 
@@ -1988,7 +1992,7 @@ void game_init()
 	pilot_load_pic_list();	
 	pilot_load_squad_pic_list();
 
-	if (!Is_standalone) {
+	if (!Is_standalone && !Cmdline_headless_benchmark) {
 		// Load the default cursor and enable it
 		io::mouse::Cursor* cursor = io::mouse::CursorManager::get()->loadCursor("cursor", true);
 		if (cursor) {
@@ -6690,6 +6694,156 @@ DCF(pofspew, "Spews POF info without shutting down the game")
 	game_spew_pof_info();
 }
 
+/**
+ * Object state which goes into the checksum of a headless benchmark
+ */
+struct benchmark_object_state {
+	int type;
+	int signature;
+	vec3d pos;
+	matrix orient;
+	vec3d vel;
+	vec3d rotvel;
+	float hull_strength;
+};
+
+static uint game_benchmark_checksum()
+{
+	uint checksum = 0;
+
+	for (auto objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+		if (objp->flags[Object::Object_Flags::Should_be_dead]) {
+			continue;
+		}
+
+		// Zeroed so that padding bytes don't change the result
+		benchmark_object_state state;
+		memset(&state, 0, sizeof(state));
+
+		state.type = objp->type;
+		state.signature = objp->signature;
+		state.pos = objp->pos;
+		state.orient = objp->orient;
+		state.vel = objp->phys_info.vel;
+		state.rotvel = objp->phys_info.rotvel;
+		state.hull_strength = objp->hull_strength;
+
+		checksum = cf_add_chksum_long(checksum, reinterpret_cast<ubyte*>(&state), sizeof(state));
+	}
+
+	return checksum;
+}
+
+/**
+ * Runs the mission given with -headless_benchmark for a fixed number of frames and reports how long they took
+ *
+ * Every frame advances the simulation by exactly 1/60 of a second and the random number generator is seeded with
+ * -benchmark_seed so two runs of the same build do the same work. The checksum of the final object state shows if
+ * that was the case. Nothing is rendered and the player ship gets no input.
+ *
+ * @returns 0 on success, 1 if the mission could not be run
+ */
+static int game_run_headless_benchmark()
+{
+	const fix BENCHMARK_FRAMETIME = F1_0 / 60;
+
+	char mission_name[MAX_FILENAME_LEN];
+	strcpy_s(mission_name, Cmdline_headless_benchmark);
+	if (!strchr(mission_name, '.')) {
+		strcat_s(mission_name, FS_MISSION_FILE_EXT);
+	}
+
+	// game_start_mission() pops up a message box if the mission fails to load, check it before that can happen
+	if (get_mission_info(mission_name) != 0) {
+		mprintf(("Benchmark: Could not read mission '%s'!\n", mission_name));
+		return 1;
+	}
+
+	// A throwaway pilot, it is never saved
+	Player_num = 0;
+	Player = &Players[Player_num];
+	Player->reset();
+	strcpy_s(Player->callsign, "Benchmark");
+	Player->flags |= PLAYER_FLAGS_STRUCTURE_IN_USE;
+	Game_mode = GM_NORMAL;
+
+	srand(static_cast<unsigned int>(Cmdline_benchmark_seed));
+
+	strcpy_s(Game_current_mission_filename, mission_name);
+	if (!game_start_mission()) {
+		Player = NULL;
+		return 1;
+	}
+
+	set_current_hud();
+	Game_mode |= GM_IN_MISSION;
+
+	mprintf(("Benchmark: Running '%s' for %d frames with seed %d\n", mission_name, Cmdline_benchmark_frames,
+	         Cmdline_benchmark_seed));
+
+	std::uint64_t total_time = 0;
+	std::uint64_t min_time = UINT64_MAX;
+	std::uint64_t max_time = 0;
+
+	for (int frame = 0; frame < Cmdline_benchmark_frames; ++frame) {
+		auto frame_start = timer_get_nanoseconds();
+
+		Frametime = BENCHMARK_FRAMETIME;
+		flFrametime = flRealframetime = f2fl(Frametime);
+		timestamp_inc(Frametime);
+		FrametimeOverall += Frametime;
+		game_update_missiontime();
+
+		{
+			TRACE_SCOPE(tracing::MainFrame);
+
+			if (Missiontime > Entry_delay_time) {
+				Pre_player_entry = 0;
+			}
+
+			shield_frame_init();
+			game_whack_reset();
+			light_reset();
+
+			game_simulation_frame();
+		}
+
+		auto frame_time = timer_get_nanoseconds() - frame_start;
+		total_time += frame_time;
+		min_time = std::min(min_time, frame_time);
+		max_time = std::max(max_time, frame_time);
+
+		tracing::process_events();
+		util::jobs::process_main_thread_jobs();
+		tracing::frame_profile_process_frame();
+
+		++Framecount;
+	}
+
+	auto checksum = game_benchmark_checksum();
+
+	SCP_string report;
+	sprintf(report, "Mission: %s\nSeed: %d\nFrames: %d\nFrame time: avg %.3f ms, min %.3f ms, max %.3f ms\n"
+	                "State checksum: %08x\n\n", mission_name, Cmdline_benchmark_seed, Cmdline_benchmark_frames,
+	        total_time / 1000000.0 / Cmdline_benchmark_frames, min_time / 1000000.0, max_time / 1000000.0, checksum);
+	report += tracing::get_frame_profile_output();
+
+	mprintf(("Benchmark results:\n%s\n", report.c_str()));
+
+	auto out = cfopen("benchmark.txt", "wt", CFILE_NORMAL, CF_TYPE_DATA);
+	if (out != NULL) {
+		cfputs(report.c_str(), out);
+		cfclose(out);
+	}
+
+	freespace_stop_mission();
+
+	// Keeps game_shutdown() from saving the pilot
+	Player = NULL;
+
+	return 0;
+}
+
 /**
 * Does some preliminary checks and then enters main event loop.
 *
@@ -6783,6 +6937,12 @@ int game_main(int argc, char *argv[])
 		return 0;
 	}
 
+	if (Cmdline_headless_benchmark) {
+		auto result = game_run_headless_benchmark();
+		game_shutdown();
+		return result;
+	}
+
 	if (!Is_standalone) {
 		movie::play("intro.mve");
 	}
@@ -6806,6 +6966,8 @@ int game_main(int argc, char *argv[])
 
 		// Since tracing is always active this needs to happen in the main loop
 		tracing::process_events();
+
+		util::jobs::process_main_thread_jobs();
 	} 
 
 	game_shutdown();
@@ -6947,6 +7109,8 @@ void game_shutdown(void)
 	model_free_all();
 	bm_unload_all();			// unload/free bitmaps, has to be called *after* model_free_all()!
 
+	util::jobs::shutdown();
+
 	tracing::shutdown();
 
 #ifndef NDEBUG
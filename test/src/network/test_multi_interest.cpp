@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include "network/multi_interest.h"
+
+#include <algorithm>
+
+namespace {
+vec3d make_vec(float x, float y, float z) {
+	vec3d v;
+	vm_vec_make(&v, x, y, z);
+	return v;
+}
+
+interest_params make_params() {
+	interest_params params;
+	params.near_dist = 1000.0f;
+	params.view_dist = 3000.0f;
+	params.view_dot = 0.9f;
+	params.hysteresis = 1.25f;
+	params.view_dot_margin = 0.1f;
+	params.max_far = 5;
+	return params;
+}
+
+// A few objects which only exist as positions
+struct fake_objects {
+	SCP_vector<vec3d> pos;
+	SCP_vector<int> signature;
+
+	void add(float x, float y, float z) {
+		pos.push_back(make_vec(x, y, z));
+		signature.push_back((int)signature.size() + 1);
+	}
+
+	SCP_vector<int> all() const {
+		SCP_vector<int> objnums;
+		for (int i = 0; i < (int)pos.size(); ++i) {
+			objnums.push_back(i);
+		}
+		return objnums;
+	}
+
+	bool locate(int objnum, int* sig, vec3d* out) const {
+		if ((*sig != -1) && (*sig != signature[objnum])) {
+			return false;
+		}
+		*sig = signature[objnum];
+		*out = pos[objnum];
+		return true;
+	}
+};
+
+void update(interest_set& set, const fake_objects& objects, const vec3d& fvec) {
+	auto viewer = make_vec(0.0f, 0.0f, 0.0f);
+	set.update(&viewer, &fvec, make_params(), objects.all(), [&](int objnum, int* sig, vec3d* pos) {
+		return objects.locate(objnum, sig, pos);
+	});
+}
+}
+
+TEST(MultiInterestTests, hysteresis) {
+	// Looking away from the objects so only the near distance counts
+	auto fvec = make_vec(-1.0f, 0.0f, 0.0f);
+
+	fake_objects objects;
+	objects.add(900.0f, 0.0f, 0.0f);
+	objects.add(1100.0f, 0.0f, 0.0f);
+
+	interest_set set;
+	update(set, objects, fvec);
+	ASSERT_TRUE(set.contains(0));
+	ASSERT_FALSE(set.contains(1));
+
+	// Both are past the near distance now but only the member is allowed to stay
+	objects.pos[0] = make_vec(1200.0f, 0.0f, 0.0f);
+	update(set, objects, fvec);
+	ASSERT_TRUE(set.contains(0));
+	ASSERT_FALSE(set.contains(1));
+
+	objects.pos[0] = make_vec(1300.0f, 0.0f, 0.0f);
+	update(set, objects, fvec);
+	ASSERT_FALSE(set.contains(0));
+
+	// An object which took the slot of a member is not that member
+	objects.pos[0] = make_vec(500.0f, 0.0f, 0.0f);
+	update(set, objects, fvec);
+	ASSERT_TRUE(set.contains(0));
+	objects.signature[0] = 100;
+	objects.pos[0] = make_vec(1200.0f, 0.0f, 0.0f);
+	update(set, objects, fvec);
+	ASSERT_FALSE(set.contains(0));
+}
+
+TEST(MultiInterestTests, viewCone) {
+	auto fvec = make_vec(1.0f, 0.0f, 0.0f);
+
+	fake_objects objects;
+	objects.add(2500.0f, 0.0f, 0.0f);
+	objects.add(-2500.0f, 0.0f, 0.0f);
+	objects.add(2500.0f, 2500.0f, 0.0f);
+
+	interest_set set;
+	update(set, objects, fvec);
+	ASSERT_TRUE(set.contains(0));
+	ASSERT_FALSE(set.contains(1));
+	ASSERT_FALSE(set.contains(2));
+
+	// Turning a bit keeps the object, turning away drops it
+	auto turned = make_vec(0.85f, 0.0f, 0.0f);
+	turned.xyz.z = sqrtf(1.0f - 0.85f * 0.85f);
+	update(set, objects, turned);
+	ASSERT_TRUE(set.contains(0));
+
+	update(set, objects, make_vec(0.0f, 0.0f, 1.0f));
+	ASSERT_FALSE(set.contains(0));
+}
+
+TEST(MultiInterestTests, farObjectsTakeTurns) {
+	const int NUM_SLOTS = 20;
+
+	fake_objects objects;
+	objects.add(100.0f, 0.0f, 0.0f);
+	for (int i = 1; i < NUM_SLOTS; ++i) {
+		objects.add(10000.0f, 0.0f, (float)i * 100.0f);
+	}
+
+	interest_set set;
+	update(set, objects, make_vec(-1.0f, 0.0f, 0.0f));
+	ASSERT_EQ(1u, set.members().size());
+
+	// Slot 7 is empty, the member is never handed out
+	SCP_vector<int> handed_out;
+	for (int i = 0; i < 4; ++i) {
+		auto count = set.for_each_far(NUM_SLOTS, make_params().max_far, [](int slot) { return slot == 7 ? -1 : slot; },
+		                              [&](int objnum) { handed_out.push_back(objnum); });
+		ASSERT_LE(count, make_params().max_far);
+	}
+
+	std::sort(handed_out.begin(), handed_out.end());
+	SCP_vector<int> expected;
+	for (int i = 1; i < NUM_SLOTS; ++i) {
+		if (i != 7) {
+			expected.push_back(i);
+		}
+	}
+	expected.push_back(1);
+	expected.push_back(2);
+	std::sort(expected.begin(), expected.end());
+
+	ASSERT_EQ(expected, handed_out);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "object/object.h"
+#include "object/objectgrid.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace {
+typedef std::function<void(const object_grid_entry&)> visitor;
+
+vec3d make_vec(float x, float y, float z) {
+	vec3d v;
+	vm_vec_make(&v, x, y, z);
+	return v;
+}
+
+object_grid_entry make_entry(int objnum, int type, float x, float y, float z, float radius) {
+	object_grid_entry entry;
+	entry.objnum = objnum;
+	entry.signature = objnum + 1;
+	entry.type = type;
+	entry.pos = make_vec(x, y, z);
+	entry.radius = radius;
+	return entry;
+}
+
+SCP_vector<object_grid_entry> make_entries() {
+	SCP_vector<object_grid_entry> entries;
+	entries.push_back(make_entry(0, OBJ_SHIP, 0.0f, 0.0f, 0.0f, 10.0f));
+	entries.push_back(make_entry(1, OBJ_SHIP, 300.0f, 0.0f, 0.0f, 10.0f));
+	entries.push_back(make_entry(2, OBJ_WEAPON, 0.0f, 300.0f, 0.0f, 1.0f));
+	entries.push_back(make_entry(3, OBJ_SHIP, -5000.0f, 0.0f, 0.0f, 10.0f));
+	entries.push_back(make_entry(4, OBJ_SHIP, 0.0f, 0.0f, 4000.0f, 2000.0f));
+	entries.push_back(make_entry(5, OBJ_ASTEROID, 0.0f, 0.0f, -1000.0f, 50.0f));
+	return entries;
+}
+
+SCP_vector<int> collect(const std::function<void(const visitor&)>& query) {
+	SCP_vector<int> found;
+	query([&](const object_grid_entry& entry) { found.push_back(entry.objnum); });
+	std::sort(found.begin(), found.end());
+	return found;
+}
+}
+
+TEST(ObjectGridTests, sphereQuery) {
+	object_grid grid(500.0f);
+	grid.build(make_entries());
+
+	ASSERT_EQ(6, (int)grid.size());
+
+	auto center = make_vec(0.0f, 0.0f, 0.0f);
+	auto all_types = OBJ_GRID_TYPE_MASK(OBJ_SHIP) | OBJ_GRID_TYPE_MASK(OBJ_WEAPON) | OBJ_GRID_TYPE_MASK(OBJ_ASTEROID);
+
+	ASSERT_EQ(SCP_vector<int>({ 0, 1, 2 }), collect([&](const visitor& fn) {
+		grid.for_each_in_sphere(&center, 500.0f, all_types, 0.0f, fn);
+	}));
+
+	// The large ship reaches to 2000 units of the origin
+	ASSERT_EQ(SCP_vector<int>({ 0, 1, 2, 4, 5 }), collect([&](const visitor& fn) {
+		grid.for_each_in_sphere(&center, 2100.0f, all_types, 0.0f, fn);
+	}));
+
+	// The ship at 300 units is just out of reach without the slack
+	ASSERT_EQ(SCP_vector<int>({ 0 }), collect([&](const visitor& fn) {
+		grid.for_each_in_sphere(&center, 280.0f, OBJ_GRID_TYPE_MASK(OBJ_SHIP), 0.0f, fn);
+	}));
+	ASSERT_EQ(SCP_vector<int>({ 0, 1 }), collect([&](const visitor& fn) {
+		grid.for_each_in_sphere(&center, 280.0f, OBJ_GRID_TYPE_MASK(OBJ_SHIP), 20.0f, fn);
+	}));
+}
+
+TEST(ObjectGridTests, coneQuery) {
+	object_grid grid(500.0f);
+	grid.build(make_entries());
+
+	auto apex = make_vec(0.0f, 0.0f, -100.0f);
+	auto forward = make_vec(1.0f, 0.0f, 0.0f);
+	auto backward = make_vec(-1.0f, 0.0f, 0.0f);
+	auto ships = OBJ_GRID_TYPE_MASK(OBJ_SHIP);
+
+	ASSERT_EQ(SCP_vector<int>({ 1 }), collect([&](const visitor& fn) {
+		grid.for_each_in_cone(&apex, &forward, 0.9f, 10000.0f, ships, 0.0f, fn);
+	}));
+	ASSERT_EQ(SCP_vector<int>({ 3 }), collect([&](const visitor& fn) {
+		grid.for_each_in_cone(&apex, &backward, 0.9f, 10000.0f, ships, 0.0f, fn);
+	}));
+
+	// A cone with a dot of -1 is a sphere
+	ASSERT_EQ(SCP_vector<int>({ 0, 1, 3, 4 }), collect([&](const visitor& fn) {
+		grid.for_each_in_cone(&apex, &forward, -1.0f, 10000.0f, ships, 0.0f, fn);
+	}));
+}
+
+TEST(ObjectGridTests, matchesLinearScan) {
+	// Spread out enough that the queries below only look at a few cells
+	SCP_vector<object_grid_entry> entries;
+	for (int i = 0; i < 1000; ++i) {
+		entries.push_back(make_entry(i, OBJ_SHIP, (float)((i * 37) % 100) * 97.0f, (float)((i * 11) % 100) * 89.0f, (float)(i % 10) * 113.0f, (float)(i % 7) * 20.0f));
+	}
+
+	object_grid grid(250.0f);
+	grid.build(entries);
+
+	for (int i = 0; i < 50; ++i) {
+		auto center = make_vec((float)(i * 193), (float)(i * 173), (float)(i * 13));
+		float radius = 100.0f + (float)i * 10.0f;
+
+		SCP_vector<int> expected;
+		for (auto& entry : entries) {
+			if (vm_vec_dist(&center, &entry.pos) <= radius + entry.radius) {
+				expected.push_back(entry.objnum);
+			}
+		}
+
+		ASSERT_EQ(expected, collect([&](const visitor& fn) {
+			grid.for_each_in_sphere(&center, radius, OBJ_GRID_TYPE_MASK(OBJ_SHIP), 0.0f, fn);
+		}));
+	}
+}
@@ -0,0 +1,26 @@
+#include "scripting/ScriptingTestFixture.h"
+
+#include "object/object.h"
+
+class HookVariablesTest : public test::scripting::ScriptingTestFixture {
+ public:
+	HookVariablesTest() : test::scripting::ScriptingTestFixture(INIT_CFILE) {
+	}
+};
+
+TEST_F(HookVariablesTest, setAndRemoveObjects) {
+	_state->SetHookObjects(3, "Ship", &Objects[0], "Self", &Objects[0], "Object", &Objects[1]);
+
+	bool result = false;
+	ASSERT_TRUE(_state->EvalStringWithReturn("hv.Ship ~= nil and hv.Object ~= nil", "b", &result));
+	ASSERT_TRUE(result);
+
+	// The same object is bound to both names so it only gets one handle
+	ASSERT_TRUE(_state->EvalStringWithReturn("rawequal(hv.Ship, hv.Self)", "b", &result));
+	ASSERT_TRUE(result);
+
+	_state->RemHookVars(3, "Ship", "Self", "Object");
+
+	ASSERT_TRUE(_state->EvalStringWithReturn("hv.Ship == nil and hv.Self == nil and hv.Object == nil", "b", &result));
+	ASSERT_TRUE(result);
+}
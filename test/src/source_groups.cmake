@@ -28,6 +28,14 @@ add_file_folder("mod"
     mod/test_mod_table.cpp
 )
 
+add_file_folder("Network"
+    network/test_multi_interest.cpp
+)
+
+add_file_folder("Object"
+    object/test_objectgrid.cpp
+)
+
 add_file_folder("Parse"
     parse/test_parselo.cpp
 )
@@ -38,6 +46,7 @@ add_file_folder("Pilotfile"
 
 add_file_folder("Scripting"
     scripting/ade_args.cpp
+    scripting/hook_vars.cpp
     scripting/require.cpp
     scripting/ScriptingTestFixture.h
     scripting/ScriptingTestFixture.cpp
@@ -66,8 +75,14 @@ add_file_folder("Test Util"
     util/test_util.h
 )
 
+add_file_folder("Tracing"
+    tracing/ThreadedEventProcessorTest.cpp
+)
+
 add_file_folder("Utils"
     utils/HeapAllocatorTest.cpp
+    utils/JobSystemTest.cpp
+    utils/NameIndexTest.cpp
 )
 
 add_file_folder("Weapon"
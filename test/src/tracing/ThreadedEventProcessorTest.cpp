@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "tracing/ThreadedEventProcessor.h"
+
+using namespace tracing;
+
+namespace {
+struct received_events {
+	std::mutex lock;
+	SCP_map<std::int64_t, SCP_vector<std::uint64_t>> ids;
+	std::atomic<bool> blocked;
+
+	received_events() : blocked(false) {}
+};
+
+class RecordingProcessor {
+	received_events* _events;
+
+ public:
+	explicit RecordingProcessor(received_events* events) : _events(events) {}
+
+	void processEvent(const trace_event* event) {
+		while (_events->blocked.load()) {
+			std::this_thread::yield();
+		}
+
+		std::lock_guard<std::mutex> guard(_events->lock);
+		_events->ids[event->tid].push_back(event->event_id);
+	}
+};
+
+void submit_events(ThreadedEventProcessor<RecordingProcessor, 1 << 16>& processor, std::int64_t tid, int count) {
+	for (int i = 0; i < count; ++i) {
+		trace_event evt;
+		evt.type = EventType::Complete;
+		evt.tid = tid;
+		evt.event_id = (std::uint64_t) i;
+		processor.processEvent(&evt);
+	}
+}
+}
+
+TEST(ThreadedEventProcessorTest, eventsOfAThreadStayInOrder) {
+	const int NUM_THREADS = 4;
+	const int NUM_EVENTS = 10000;
+
+	received_events events;
+	{
+		ThreadedEventProcessor<RecordingProcessor, 1 << 16> processor(&events);
+
+		SCP_vector<std::thread> threads;
+		for (int i = 0; i < NUM_THREADS; ++i) {
+			threads.emplace_back(submit_events, std::ref(processor), i, NUM_EVENTS);
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		ASSERT_EQ(0u, processor.droppedEvents());
+	}
+
+	// Everything which was submitted has to be processed before the processor is gone
+	ASSERT_EQ((size_t) NUM_THREADS, events.ids.size());
+	for (auto& thread_ids : events.ids) {
+		ASSERT_EQ((size_t) NUM_EVENTS, thread_ids.second.size());
+
+		for (size_t i = 0; i < thread_ids.second.size(); ++i) {
+			ASSERT_EQ(i, thread_ids.second[i]) << "Thread " << thread_ids.first;
+		}
+	}
+}
+
+TEST(ThreadedEventProcessorTest, fullBufferDropsEvents) {
+	const size_t BUFFER_SIZE = 256;
+
+	received_events events;
+	events.blocked = true;
+	{
+		ThreadedEventProcessor<RecordingProcessor, BUFFER_SIZE> processor(&events);
+
+		// The worker is stuck on the first event so no slot is freed
+		for (size_t i = 0; i < BUFFER_SIZE + 100; ++i) {
+			trace_event evt;
+			evt.tid = 0;
+			evt.event_id = i;
+			processor.processEvent(&evt);
+		}
+
+		// Not an ASSERT, returning early would leave the worker blocked and the destructor waiting for it forever
+		EXPECT_EQ(100u, processor.droppedEvents());
+
+		events.blocked = false;
+	}
+
+	ASSERT_EQ(BUFFER_SIZE, events.ids[0].size());
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "utils/JobSystem.h"
+
+#include <mutex>
+
+using namespace util;
+
+namespace {
+class JobSystemTest : public ::testing::TestWithParam<int> {
+ protected:
+	void SetUp() override {
+		jobs::init(GetParam());
+	}
+	void TearDown() override {
+		jobs::shutdown();
+	}
+};
+}
+
+TEST_P(JobSystemTest, parallelForVisitsEveryIndex) {
+	SCP_vector<std::atomic<int>> visits(1000);
+	for (auto& visit : visits) {
+		visit = 0;
+	}
+
+	jobs::parallel_for(0, visits.size(), 7, nullptr, [&](size_t i) { ++visits[i]; });
+
+	for (size_t i = 0; i < visits.size(); ++i) {
+		ASSERT_EQ(1, visits[i].load()) << "Index " << i;
+	}
+
+	// Nested loops must not dead lock
+	std::atomic<int> count(0);
+	jobs::parallel_for(0, 10, 1, nullptr, [&](size_t) {
+		jobs::parallel_for(0, 10, 1, nullptr, [&](size_t) { ++count; });
+	});
+	ASSERT_EQ(100, count.load());
+}
+
+TEST_P(JobSystemTest, taskGraphOrder) {
+	std::mutex lock;
+	SCP_vector<int> order;
+	auto record = [&](int id) {
+		return [&, id]() {
+			std::lock_guard<std::mutex> guard(lock);
+			order.push_back(id);
+		};
+	};
+
+	// 0 -> 1, 2 -> 3 (main thread)
+	jobs::TaskGraph graph;
+	auto a = graph.add(record(0));
+	auto b = graph.add(record(1));
+	auto c = graph.add(record(2));
+	auto d = graph.add_main_thread([&]() {
+		ASSERT_TRUE(jobs::is_main_thread());
+		record(3)();
+	});
+	graph.depends_on(b, a);
+	graph.depends_on(c, a);
+	graph.depends_on(d, b);
+	graph.depends_on(d, c);
+
+	for (int run = 0; run < 2; ++run) {
+		order.clear();
+		graph.run();
+
+		ASSERT_EQ(4, (int) order.size());
+		ASSERT_EQ(0, order.front());
+		ASSERT_EQ(3, order.back());
+	}
+}
+
+TEST_P(JobSystemTest, mainThreadContinuations) {
+	int value = 0;
+	jobs::JobCounter counter;
+
+	jobs::submit([&]() { jobs::run_on_main_thread([&]() { value = 42; }); }, &counter);
+	jobs::wait(&counter);
+	jobs::process_main_thread_jobs();
+
+	ASSERT_EQ(42, value);
+}
+
+INSTANTIATE_TEST_CASE_P(WorkerCounts, JobSystemTest, ::testing::Values(0, 1, 4));
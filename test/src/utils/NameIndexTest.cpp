@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "utils/NameIndex.h"
+
+using namespace util;
+
+namespace {
+const char* Names[] = { "Alpha 1", "Alpha 2", "GTD Aquitaine", "alpha 1" };
+
+int find_name(const NameIndex<int>& index, const char* name) {
+	return index.find(name, [&](int handle) { return !stricmp(Names[handle], name); }, -1);
+}
+}
+
+TEST(NameIndexTests, caseInsensitive) {
+	ASSERT_EQ(NameIndex<int>::hash("GTD Aquitaine"), NameIndex<int>::hash("gtd AQUITAINE"));
+
+	NameIndex<int> index;
+	index.add(Names[2], 2);
+
+	ASSERT_EQ(2, find_name(index, "gtd aquitaine"));
+	ASSERT_EQ(-1, find_name(index, "Alpha 1"));
+}
+
+TEST(NameIndexTests, lowestHandleFirst) {
+	NameIndex<int> index;
+	index.add(Names[3], 3);
+	index.add(Names[0], 0);
+
+	ASSERT_EQ(0, find_name(index, "ALPHA 1"));
+
+	ASSERT_TRUE(index.remove(Names[0], 0));
+	ASSERT_EQ(3, find_name(index, "ALPHA 1"));
+}
+
+TEST(NameIndexTests, removeAndRename) {
+	NameIndex<int> index;
+	index.add(Names[0], 0);
+
+	ASSERT_FALSE(index.remove(Names[1], 0));
+	ASSERT_FALSE(index.remove(Names[0], 1));
+
+	ASSERT_TRUE(index.remove(Names[0], 0));
+	ASSERT_EQ((size_t)0, index.size());
+	ASSERT_EQ(-1, find_name(index, "Alpha 1"));
+
+	index.add(Names[1], 0);
+	ASSERT_EQ(-1, find_name(index, "Alpha 1"));
+
+	index.clear();
+	ASSERT_EQ((size_t)0, index.size());
+}